@@ -0,0 +1,307 @@
+// SPDX-FileCopyrightText: NVIDIA CORPORATION & AFFILIATES
+// Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef NVIDIA_GXF_INDEXED_EVENT_LIST_HPP_
+#define NVIDIA_GXF_INDEXED_EVENT_LIST_HPP_
+
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "gxf/core/expected.hpp"
+#include "gxf/core/gxf.h"
+
+namespace nvidia {
+namespace gxf {
+
+// A thread safe list of unique events with O(1) push, remove and lookup.
+//
+// This is a replacement for EventList and UniqueEventList when the number of events is large, for
+// example entity ids in a big graph. Events are kept in insertion order in an intrusive doubly
+// linked list whose nodes live in a single vector and are linked by index. Events are located with
+// an open-addressing hash table (linear probing, backward shift deletion) which maps an event to its
+// node. Nodes are recycled through a free list, so once the list reached its peak size no operation
+// allocates memory.
+//
+// As with UniqueEventList, pushing an event which is already in the list has no effect. This also
+// matches the behavior of EventList::removeEvent, which removes all the copies of an event.
+//
+// Instead of copying the list with `exportList`, the events are handed out with `drain`, which
+// moves them into a vector provided by the caller. Reusing that vector keeps the operation free of
+// memory allocations.
+template <typename T, typename Hash = std::hash<T>>
+class IndexedEventList {
+ public:
+  IndexedEventList() = default;
+  IndexedEventList(const IndexedEventList&) = delete;
+  IndexedEventList& operator=(const IndexedEventList&) = delete;
+
+  // Pre-allocates space for the given number of events.
+  void reserve(size_t capacity) {
+    std::lock_guard<std::mutex> lock(list_mutex_);
+    nodes_.reserve(capacity);
+    if (2 * capacity > table_.size()) {
+      rehash(2 * capacity);
+    }
+  }
+
+  // Adds an item at the end of the event list. Returns false if the item is already in the list.
+  bool pushEvent(T item) {
+    std::lock_guard<std::mutex> lock(list_mutex_);
+    if (find(item) != kNil) { return false; }
+    if (2 * (size_ + 1) > table_.size()) {
+      rehash(2 * (size_ + 1));
+    }
+    const uint32_t node = allocateNode(std::move(item));
+    linkBack(node);
+    insertIndex(node);
+    size_++;
+    return true;
+  }
+
+  // Removes an event from the list if it exists and returns true, returns false otherwise
+  bool removeEvent(const T& item) {
+    std::lock_guard<std::mutex> lock(list_mutex_);
+    const uint32_t node = find(item);
+    if (node == kNil) { return false; }
+    release(node);
+    return true;
+  }
+
+  // pops the first element in the list
+  Expected<T> popEvent() {
+    std::lock_guard<std::mutex> lock(list_mutex_);
+    if (head_ == kNil) { return Unexpected{GXF_FAILURE}; }
+    // The node is released first as the table needs its item; its storage stays valid.
+    const uint32_t node = head_;
+    release(node);
+    return std::move(nodes_[node].item);
+  }
+
+  // Moves all the events, in order, into `events` and empties the list. Previous content of
+  // `events` is discarded. Returns the number of events.
+  size_t drain(std::vector<T>& events) {
+    std::lock_guard<std::mutex> lock(list_mutex_);
+    events.clear();
+    events.reserve(size_);
+    for (uint32_t node = head_; node != kNil; node = nodes_[node].next) {
+      // The slot of the item is computed before the item is moved.
+      clearRun(node);
+      events.push_back(std::move(nodes_[node].item));
+    }
+    resetNodes();
+    return events.size();
+  }
+
+  // Copies the events, in order, into `events` without modifying the list. Previous content of
+  // `events` is discarded. Returns the number of events.
+  size_t exportTo(std::vector<T>& events) const {
+    std::lock_guard<std::mutex> lock(list_mutex_);
+    events.clear();
+    events.reserve(size_);
+    for (uint32_t node = head_; node != kNil; node = nodes_[node].next) {
+      events.push_back(nodes_[node].item);
+    }
+    return events.size();
+  }
+
+  // checks if the list is empty
+  bool empty() const {
+    std::lock_guard<std::mutex> lock(list_mutex_);
+    return size_ == 0;
+  }
+
+  // returns size of the event list
+  size_t size() const {
+    std::lock_guard<std::mutex> lock(list_mutex_);
+    return size_;
+  }
+
+  // checks if the list has event
+  bool hasEvent(const T& item) const {
+    std::lock_guard<std::mutex> lock(list_mutex_);
+    return find(item) != kNil;
+  }
+
+  // clears the event list
+  void clear() {
+    std::lock_guard<std::mutex> lock(list_mutex_);
+    clearImpl();
+  }
+
+ private:
+  // Index used for "no node" in links and empty slots in the table.
+  static constexpr uint32_t kNil = UINT32_MAX;
+  // Minimum number of slots of the hash table.
+  static constexpr size_t kMinimumTableSize = 16;
+
+  // A node of the intrusive list. Free nodes are chained through `next`.
+  struct Node {
+    T item;
+    uint32_t prev;
+    uint32_t next;
+  };
+
+  // Home slot of an item in the table. The hash is mixed as std::hash is the identity for integers,
+  // which would cluster consecutive ids.
+  size_t slotOf(const T& item) const {
+    uint64_t x = static_cast<uint64_t>(Hash()(item));
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    return static_cast<size_t>(x) & (table_.size() - 1);
+  }
+
+  // Returns the node holding the item or kNil.
+  uint32_t find(const T& item) const {
+    if (table_.empty()) { return kNil; }
+    const size_t mask = table_.size() - 1;
+    for (size_t slot = slotOf(item);; slot = (slot + 1) & mask) {
+      const uint32_t node = table_[slot];
+      if (node == kNil || nodes_[node].item == item) { return node; }
+    }
+  }
+
+  // Adds a node to the table. The item must not be in the table already.
+  void insertIndex(uint32_t node) {
+    const size_t mask = table_.size() - 1;
+    size_t slot = slotOf(nodes_[node].item);
+    while (table_[slot] != kNil) { slot = (slot + 1) & mask; }
+    table_[slot] = node;
+  }
+
+  // Removes a node from the table using backward shift deletion.
+  void eraseIndex(uint32_t node) {
+    const size_t mask = table_.size() - 1;
+    size_t hole = slotOf(nodes_[node].item);
+    while (table_[hole] != node) { hole = (hole + 1) & mask; }
+    for (size_t slot = (hole + 1) & mask; table_[slot] != kNil; slot = (slot + 1) & mask) {
+      // An entry can be moved into the hole only if the hole is between its home slot and its
+      // current position.
+      const size_t home = slotOf(nodes_[table_[slot]].item);
+      if (((slot - home) & mask) >= ((slot - hole) & mask)) {
+        table_[hole] = table_[slot];
+        hole = slot;
+      }
+    }
+    table_[hole] = kNil;
+  }
+
+  // Resizes the table to at least the given number of slots and re-inserts all the nodes.
+  void rehash(size_t minimum_size) {
+    size_t table_size = kMinimumTableSize;
+    while (table_size < minimum_size) { table_size <<= 1; }
+    table_.assign(table_size, kNil);
+    for (uint32_t node = head_; node != kNil; node = nodes_[node].next) {
+      insertIndex(node);
+    }
+  }
+
+  // Gets a node from the free list, or creates a new one.
+  uint32_t allocateNode(T&& item) {
+    if (free_ != kNil) {
+      const uint32_t node = free_;
+      free_ = nodes_[node].next;
+      nodes_[node].item = std::move(item);
+      return node;
+    }
+    nodes_.push_back(Node{std::move(item), kNil, kNil});
+    return static_cast<uint32_t>(nodes_.size() - 1);
+  }
+
+  // Appends a node at the end of the list.
+  void linkBack(uint32_t node) {
+    nodes_[node].prev = tail_;
+    nodes_[node].next = kNil;
+    if (tail_ != kNil) {
+      nodes_[tail_].next = node;
+    } else {
+      head_ = node;
+    }
+    tail_ = node;
+  }
+
+  // Unlinks a node, removes it from the table and puts it on the free list.
+  void release(uint32_t node) {
+    eraseIndex(node);
+    Node& current = nodes_[node];
+    if (current.prev != kNil) {
+      nodes_[current.prev].next = current.next;
+    } else {
+      head_ = current.next;
+    }
+    if (current.next != kNil) {
+      nodes_[current.next].prev = current.prev;
+    } else {
+      tail_ = current.prev;
+    }
+    current.next = free_;
+    free_ = node;
+    size_--;
+  }
+
+  // Empties the slots of the table from the home slot of a node to the end of its run of occupied
+  // slots. The slot of every node lies in the run starting at its home slot, and clearing a run
+  // from an earlier home slot empties the rest of it, so doing this for all the nodes empties the
+  // table.
+  void clearRun(uint32_t node) {
+    const size_t mask = table_.size() - 1;
+    for (size_t slot = slotOf(nodes_[node].item); table_[slot] != kNil; slot = (slot + 1) & mask) {
+      table_[slot] = kNil;
+    }
+  }
+
+  // Empties the list while keeping the allocated memory. Only the slots of the table used by the
+  // events are visited, so the cost depends on the number of events and not on the size the table
+  // reached.
+  void clearImpl() {
+    for (uint32_t node = head_; node != kNil; node = nodes_[node].next) {
+      clearRun(node);
+    }
+    resetNodes();
+  }
+
+  // Removes all the nodes. The table must already be empty.
+  void resetNodes() {
+    nodes_.clear();
+    head_ = kNil;
+    tail_ = kNil;
+    free_ = kNil;
+    size_ = 0;
+  }
+
+  mutable std::mutex list_mutex_;
+  // Storage for the nodes of the list, used and free.
+  std::vector<Node> nodes_;
+  // Open-addressing table of node indices. Its size is a power of two and at least twice the
+  // number of events.
+  std::vector<uint32_t> table_;
+  // First and last node of the list.
+  uint32_t head_ = kNil;
+  uint32_t tail_ = kNil;
+  // First node of the free list.
+  uint32_t free_ = kNil;
+  // Number of events in the list.
+  size_t size_ = 0;
+};
+
+}  // namespace gxf
+}  // namespace nvidia
+
+#endif  // NVIDIA_GXF_INDEXED_EVENT_LIST_HPP_
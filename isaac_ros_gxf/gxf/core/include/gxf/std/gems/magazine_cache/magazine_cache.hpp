@@ -0,0 +1,315 @@
+// SPDX-FileCopyrightText: NVIDIA CORPORATION & AFFILIATES
+// Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef NVIDIA_GXF_STD_GEMS_MAGAZINE_CACHE_MAGAZINE_CACHE_HPP_
+#define NVIDIA_GXF_STD_GEMS_MAGAZINE_CACHE_MAGAZINE_CACHE_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "common/byte.hpp"
+#include "gxf/core/expected.hpp"
+#include "gxf/std/allocator.hpp"
+#include "gxf/std/block_memory_pool.hpp"
+
+namespace nvidia {
+namespace gxf {
+
+// Per-thread caches of memory blocks in front of a fixed block pool, following the magazine design
+// of Bonwick's slab allocator.
+//
+// A magazine is a bounded stack of free blocks. Every cache owns two magazines, `loaded` and
+// `previous`, and allocations and frees are served from them with only the lock of the cache, which
+// is not shared with other threads in the common case. When both magazines are exhausted (or full),
+// a cache exchanges a magazine with a global depot of full and empty magazines, and only goes to the
+// pool when the depot cannot help. This means that a thread which allocates and frees blocks at a
+// steady rate does not touch any shared lock at all, and that blocks freed by one thread reach the
+// others through the depot in batches.
+//
+// Calling threads are assigned one of `number_caches` caches round robin on their first use.
+//
+// The pool has to provide `allocate(size, storage_type)`, `free(pointer)`, `block_size()` and
+// `num_blocks()` like BlockMemoryPool. All the allocations from the pool must go through the cache
+// for `available_blocks` to be exact.
+template <typename Pool>
+class MagazineCache {
+ public:
+  // Default number of blocks in a magazine
+  static constexpr size_t kDefaultMagazineSize = 16;
+  // Default number of full magazines the depot can hold
+  static constexpr size_t kDefaultDepotSize = 8;
+
+  MagazineCache() = default;
+  MagazineCache(const MagazineCache&) = delete;
+  MagazineCache& operator=(const MagazineCache&) = delete;
+  ~MagazineCache() { deinitialize(); }
+
+  // Prepares the caches for the given pool. `number_caches` defaults to the number of hardware
+  // threads. All the memory used by the caches is allocated here.
+  Expected<void> initialize(Pool* pool, MemoryStorageType storage_type,
+                            size_t magazine_size = kDefaultMagazineSize,
+                            size_t depot_size = kDefaultDepotSize, size_t number_caches = 0) {
+    if (pool == nullptr) { return Unexpected{GXF_ARGUMENT_NULL}; }
+    if (magazine_size == 0) { return Unexpected{GXF_ARGUMENT_INVALID}; }
+    if (pool_ != nullptr) { return Unexpected{GXF_INVALID_LIFECYCLE_STAGE}; }
+    if (number_caches == 0) {
+      number_caches = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    }
+    pool_ = pool;
+    storage_type_ = storage_type;
+    magazine_size_ = magazine_size;
+    total_blocks_ = pool->num_blocks();
+    caches_.reset(new Cache[number_caches]);
+    number_caches_ = number_caches;
+    for (size_t i = 0; i < number_caches_; i++) {
+      caches_[i].loaded.reserve(magazine_size_);
+      caches_[i].previous.reserve(magazine_size_);
+    }
+    depot_.reset(new Magazine[depot_size]);
+    depot_size_ = depot_size;
+    depot_full_count_ = 0;
+    for (size_t i = 0; i < depot_size_; i++) { depot_[i].reserve(magazine_size_); }
+    pooled_blocks_ = 0;
+    return Success;
+  }
+
+  // Returns all the cached blocks to the pool and releases the caches.
+  Expected<void> deinitialize() {
+    if (pool_ == nullptr) { return Success; }
+    Expected<void> result = flush();
+    caches_.reset();
+    number_caches_ = 0;
+    depot_.reset();
+    depot_size_ = 0;
+    depot_full_count_ = 0;
+    pool_ = nullptr;
+    return result;
+  }
+
+  // Allocates one block
+  Expected<byte*> allocate() {
+    if (pool_ == nullptr) { return Unexpected{GXF_INVALID_LIFECYCLE_STAGE}; }
+    Cache& cache = localCache();
+    std::unique_lock<std::mutex> lock(cache.mutex);
+    if (cache.loaded.empty()) {
+      if (!cache.previous.empty()) {
+        std::swap(cache.loaded, cache.previous);
+      } else if (!exchangeForFull(cache) && !refill(cache)) {
+        lock.unlock();
+        return reclaim();
+      }
+    }
+    byte* pointer = cache.loaded.back();
+    cache.loaded.pop_back();
+    cache.outstanding += 1;
+    return pointer;
+  }
+
+  // Frees a block which was allocated with this cache
+  Expected<void> free(byte* pointer) {
+    if (pool_ == nullptr) { return Unexpected{GXF_INVALID_LIFECYCLE_STAGE}; }
+    if (pointer == nullptr) { return Unexpected{GXF_ARGUMENT_NULL}; }
+    Cache& cache = localCache();
+    std::unique_lock<std::mutex> lock(cache.mutex);
+    if (cache.loaded.size() == magazine_size_) {
+      if (cache.previous.empty()) {
+        std::swap(cache.loaded, cache.previous);
+      } else if (!exchangeForEmpty(cache)) {
+        // The depot is full: give the previous magazine back to the pool.
+        const auto result = drain(cache.previous);
+        if (!result) { return result; }
+        std::swap(cache.loaded, cache.previous);
+      }
+    }
+    cache.loaded.push_back(pointer);
+    cache.outstanding -= 1;
+    return Success;
+  }
+
+  // Returns all the cached blocks to the pool
+  Expected<void> flush() {
+    if (pool_ == nullptr) { return Success; }
+    Expected<void> result = Success;
+    for (size_t i = 0; i < number_caches_; i++) {
+      std::unique_lock<std::mutex> lock(caches_[i].mutex);
+      result &= drain(caches_[i].loaded);
+      result &= drain(caches_[i].previous);
+    }
+    std::unique_lock<std::mutex> lock(depot_mutex_);
+    for (size_t i = 0; i < depot_full_count_; i++) { result &= drain(depot_[i]); }
+    depot_full_count_ = 0;
+    return result;
+  }
+
+  // Number of blocks which can still be allocated, whether they are in the pool or parked in a
+  // magazine
+  uint64_t available_blocks() const {
+    const Counts counts = snapshot();
+    return total_blocks_ - counts.outstanding;
+  }
+
+  // Number of free blocks currently parked in the magazines of the caches and the depot
+  uint64_t cached_blocks() const {
+    const Counts counts = snapshot();
+    return counts.pooled - counts.outstanding;
+  }
+
+  // Block size of the pool
+  uint64_t block_size() const { return pool_ != nullptr ? pool_->block_size() : 0; }
+
+ private:
+  using Magazine = std::vector<byte*>;
+
+  // A cache used by one or a few threads. Aligned to avoid false sharing between caches.
+  struct alignas(64) Cache {
+    mutable std::mutex mutex;
+    Magazine loaded;
+    Magazine previous;
+    // Blocks allocated minus blocks freed through this cache. Counters are kept per cache so that
+    // allocations do not write to a shared cache line; a block allocated through one cache and freed
+    // through another makes the counters of both off by one, but not their sum. Only accessed while
+    // holding the lock of the cache.
+    int64_t outstanding = 0;
+  };
+
+  // Block counters read at a single point in time
+  struct Counts {
+    // Blocks handed out to users
+    uint64_t outstanding;
+    // Blocks taken from the pool, either handed out to users or parked in a magazine
+    uint64_t pooled;
+  };
+
+  // Reads the counters while holding the locks of all the caches and of the depot. Summing the
+  // per-cache counters without the locks can observe a block freed through one cache but not its
+  // allocation through another one, and miscount the blocks parked in magazines.
+  Counts snapshot() const {
+    std::vector<std::unique_lock<std::mutex>> locks;
+    locks.reserve(number_caches_ + 1);
+    int64_t outstanding = 0;
+    for (size_t i = 0; i < number_caches_; i++) {
+      locks.emplace_back(caches_[i].mutex);
+      outstanding += caches_[i].outstanding;
+    }
+    locks.emplace_back(depot_mutex_);
+    return Counts{static_cast<uint64_t>(outstanding), pooled_blocks_};
+  }
+
+  // Returns the cache of the calling thread.
+  Cache& localCache() {
+    static std::atomic<size_t> next_thread{0};
+    thread_local const size_t thread_index = next_thread.fetch_add(1, std::memory_order_relaxed);
+    return caches_[thread_index % number_caches_];
+  }
+
+  // Both magazines of the cache are empty: trades the empty previous magazine for a full one from
+  // the depot. Requires the lock of the cache.
+  bool exchangeForFull(Cache& cache) {
+    std::unique_lock<std::mutex> lock(depot_mutex_);
+    if (depot_full_count_ == 0) { return false; }
+    depot_full_count_--;
+    std::swap(cache.loaded, depot_[depot_full_count_]);
+    return true;
+  }
+
+  // Both magazines of the cache are full: trades the full previous magazine for an empty one from
+  // the depot. Requires the lock of the cache.
+  bool exchangeForEmpty(Cache& cache) {
+    std::unique_lock<std::mutex> lock(depot_mutex_);
+    if (depot_full_count_ == depot_size_) { return false; }
+    std::swap(cache.previous, depot_[depot_full_count_]);
+    depot_full_count_++;
+    std::swap(cache.loaded, cache.previous);
+    return true;
+  }
+
+  // Fills half of the loaded magazine from the pool. Returns false if the pool is exhausted.
+  // Requires the lock of the cache.
+  bool refill(Cache& cache) {
+    const size_t count = std::max<size_t>(magazine_size_ / 2, 1);
+    for (size_t i = 0; i < count; i++) {
+      auto maybe = pool_->allocate(pool_->block_size(), storage_type_);
+      if (!maybe) { break; }
+      cache.loaded.push_back(maybe.value());
+      pooled_blocks_++;
+    }
+    return !cache.loaded.empty();
+  }
+
+  // Returns all the blocks of a magazine to the pool.
+  Expected<void> drain(Magazine& magazine) {
+    Expected<void> result = Success;
+    for (byte* pointer : magazine) {
+      result &= pool_->free(pointer);
+      pooled_blocks_--;
+    }
+    magazine.clear();
+    return result;
+  }
+
+  // The pool and the depot are exhausted: takes a block cached by another thread.
+  Expected<byte*> reclaim() {
+    for (size_t i = 0; i < number_caches_; i++) {
+      Cache& cache = caches_[i];
+      std::unique_lock<std::mutex> lock(cache.mutex);
+      for (Magazine* magazine : {&cache.loaded, &cache.previous}) {
+        if (!magazine->empty()) {
+          byte* pointer = magazine->back();
+          magazine->pop_back();
+          cache.outstanding += 1;
+          return pointer;
+        }
+      }
+    }
+    return Unexpected{GXF_OUT_OF_MEMORY};
+  }
+
+  Pool* pool_ = nullptr;
+  MemoryStorageType storage_type_ = MemoryStorageType::kHost;
+  size_t magazine_size_ = 0;
+  uint64_t total_blocks_ = 0;
+
+  std::unique_ptr<Cache[]> caches_;
+  size_t number_caches_ = 0;
+
+  // Protects the depot
+  mutable std::mutex depot_mutex_;
+  // Magazines available to all the caches, allocated once in initialize. The first
+  // `depot_full_count_` magazines are full and the others are empty. Magazines are exchanged with
+  // the caches by swapping them, so they keep their storage for the lifetime of the cache.
+  std::unique_ptr<Magazine[]> depot_;
+  size_t depot_size_ = 0;
+  size_t depot_full_count_ = 0;
+
+  // Number of blocks taken from the pool, either handed out to users or held in magazines. Written
+  // while holding the lock of one cache, or of the depot during a flush.
+  std::atomic<uint64_t> pooled_blocks_{0};
+};
+
+// Magazine caches in front of a BlockMemoryPool
+using BlockMemoryPoolCache = MagazineCache<BlockMemoryPool>;
+
+}  // namespace gxf
+}  // namespace nvidia
+
+#endif  // NVIDIA_GXF_STD_GEMS_MAGAZINE_CACHE_MAGAZINE_CACHE_HPP_
@@ -0,0 +1,380 @@
+// SPDX-FileCopyrightText: NVIDIA CORPORATION & AFFILIATES
+// Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+#ifndef NVIDIA_GXF_STD_GEMS_LOCK_FREE_STAGING_QUEUE_HPP
+#define NVIDIA_GXF_STD_GEMS_LOCK_FREE_STAGING_QUEUE_HPP
+
+#include <atomic>
+#include <memory>
+#include <utility>
+
+#include "gxf/std/gems/staging_queue/staging_queue.hpp"
+#include "gxf/std/gems/staging_queue/staging_queue_iterator.hpp"
+
+namespace gxf {
+namespace staging_queue {
+
+// A lock-free double-buffered queue with the same main stage / back stage semantics and overflow
+// behaviors as StagingQueue.
+//
+// The back stage is a bounded multi-producer queue using a sequence number per slot (as described
+// by D. Vyukov): any number of threads can call push concurrently. The main stage is a ring buffer
+// which is only modified by the consumer through sync, pop and popAll. Both rings use a power of
+// two number of slots so that positions are wrapped with a mask instead of a modulo, and all
+// positions are monotonically increasing atomic counters.
+//
+// Thread-safety:
+//  - push can be called concurrently from any number of threads.
+//  - sync, pop, popAll, peek, latest, begin and end operate on the main stage and must be called
+//    from one consumer thread at a time.
+//  - size, back_size, empty and capacity are wait-free and can be called from any thread. Their
+//    result is a snapshot which may be outdated by the time it is used.
+//  - peek_backstage is only valid if no push is running concurrently.
+//
+// Overflow behaviors are the same as for StagingQueue: on push, kPop drops the oldest item of the
+// back stage, kReject drops the new item and kFault returns false. On sync, kPop drops the oldest
+// items of the main stage, kReject drops the newest items coming from the back stage and kFault
+// returns false leaving the items which did not fit in the back stage.
+template <typename T>
+class LockFreeStagingQueue {
+ public:
+  using const_iterator_t = StagingQueueIterator<T>;
+
+  // Creates a new staging queue. See StagingQueue for the meaning of the arguments. Each stage
+  // allocates the next power of two larger or equal to 'capacity' slots.
+  LockFreeStagingQueue(size_t capacity, OverflowBehavior overflow_behavior, T null);
+
+  // Creates an empty staging queue with no capacity and Fault overflow behavior
+  LockFreeStagingQueue();
+
+  LockFreeStagingQueue(const LockFreeStagingQueue&) = delete;
+  LockFreeStagingQueue& operator=(const LockFreeStagingQueue&) = delete;
+
+  // Gets the overflow behavior which is used by this queue
+  OverflowBehavior overflow_behavior() const { return overflow_behavior_; }
+
+  // Returns true if there are no elements in the main stage of the queue.
+  bool empty() const { return size() == 0; }
+  // Returns the number of elements in the main stage of the queue.
+  size_t size() const;
+  // Returns the maximum number of elements which can be stored in the main stage.
+  size_t capacity() const { return capacity_; }
+  // Returns the number of elements in the back stage of the queue.
+  size_t back_size() const;
+
+  // Gets the item at position 'index' in the main stage of the queue starting with the oldest item.
+  // Returns a reference to the null object if there are no items in the main stage.
+  const T& peek(size_t index = 0) const;
+  // Gets the item at position 'index' in the back stage of the queue starting with the oldest item.
+  // Returns a reference to the null object if there are no items in the back stage.
+  const T& peek_backstage(size_t index = 0) const;
+  // Gets the item at position 'index' in the main stage of the queue starting with the newest item.
+  // Returns a reference to the null object if there are no items in the main stage.
+  const T& latest(size_t index = 0) const;
+
+  // Gives an iterator pointing to the first element in the main stage.
+  const_iterator_t begin() const;
+  // Gives an iterator pointing to the element after the last element in the main stage.
+  const_iterator_t end() const;
+
+  // Removes the oldest item from the queue's main stage and returns it, or a copy of the null
+  // object if the main stage is empty.
+  T pop();
+  // Removes all items from the main stage.
+  void popAll();
+
+  // Adds a new item to the back stage. In case the back stage is at capacity the overflow behavior
+  // is used to decide what to do.
+  bool push(T item);
+
+  // Moves all items from the back stage to the main stage. In case the main stage is too full
+  // to receive all items from the back stage the overflow behavior is used to decide what to do.
+  bool sync();
+
+ private:
+  // A slot of the back stage. 'sequence' tells which position the slot is ready for: it is equal
+  // to the position when the slot is free to be written, and to position + 1 once it was written.
+  struct BackstageSlot {
+    std::atomic<size_t> sequence;
+    T item;
+  };
+
+  // Pads the counters to avoid false sharing between producers and the consumer.
+  struct alignas(64) PaddedCounter {
+    std::atomic<size_t> value{0};
+  };
+
+  // Returns the smallest power of two larger or equal to 'value' (at least 1).
+  static size_t RoundUpPowerOfTwo(size_t value) {
+    size_t result = 1;
+    while (result < value) {
+      result <<= 1;
+    }
+    return result;
+  }
+
+  // Takes the oldest item out of the back stage. Returns false if the back stage is empty.
+  bool dequeueBackstage(T& item);
+
+  // Returns the main stage slot for a given position.
+  const T& mainstage(size_t position) const { return mainstage_[position & mainstage_mask_]; }
+  T& mainstage(size_t position) { return mainstage_[position & mainstage_mask_]; }
+
+  // The maximum number of items in the main stage and in the back stage.
+  const size_t capacity_;
+  // This behavior defines what happens if either push or sync would exceed the capacity.
+  const OverflowBehavior overflow_behavior_;
+  // The null value is used for empty slots and as return value for out of bounds accesses.
+  T null_;
+
+  // Number of slots of each stage minus one.
+  size_t mainstage_mask_;
+  size_t backstage_mask_;
+  // Ring buffer for the main stage.
+  std::unique_ptr<T[]> mainstage_;
+  // Ring buffer for the back stage.
+  std::unique_ptr<BackstageSlot[]> backstage_;
+
+  // Position of the first item of the main stage. Only modified by the consumer.
+  PaddedCounter mainstage_begin_;
+  // Position after the last item of the main stage. Only modified by the consumer.
+  PaddedCounter mainstage_end_;
+  // Position of the oldest item of the back stage.
+  PaddedCounter backstage_begin_;
+  // Position after the newest item of the back stage.
+  PaddedCounter backstage_end_;
+};
+
+//--------------------------------------------------------------------------------------------------
+
+template <typename T>
+LockFreeStagingQueue<T>::LockFreeStagingQueue(size_t capacity, OverflowBehavior overflow_behavior,
+                                              T null)
+    : capacity_(capacity),
+      overflow_behavior_(overflow_behavior),
+      null_(null),
+      mainstage_mask_(RoundUpPowerOfTwo(capacity) - 1),
+      backstage_mask_(RoundUpPowerOfTwo(capacity) - 1),
+      mainstage_(new T[mainstage_mask_ + 1]),
+      backstage_(new BackstageSlot[backstage_mask_ + 1]) {
+  for (size_t i = 0; i <= mainstage_mask_; i++) {
+    mainstage_[i] = null_;
+  }
+  for (size_t i = 0; i <= backstage_mask_; i++) {
+    backstage_[i].sequence.store(i, std::memory_order_relaxed);
+    backstage_[i].item = null_;
+  }
+}
+
+template <typename T>
+LockFreeStagingQueue<T>::LockFreeStagingQueue()
+    : LockFreeStagingQueue(0, OverflowBehavior::kFault, T()) {}
+
+template <typename T>
+size_t LockFreeStagingQueue<T>::size() const {
+  // Load begin first: end only increases, so the difference can't underflow.
+  const size_t begin = mainstage_begin_.value.load(std::memory_order_acquire);
+  const size_t end = mainstage_end_.value.load(std::memory_order_acquire);
+  return end - begin;
+}
+
+template <typename T>
+size_t LockFreeStagingQueue<T>::back_size() const {
+  const size_t begin = backstage_begin_.value.load(std::memory_order_acquire);
+  const size_t end = backstage_end_.value.load(std::memory_order_acquire);
+  // A producer may have claimed a slot which is not yet visible in begin; clamp to capacity.
+  const size_t size = end > begin ? end - begin : 0;
+  return size < capacity_ ? size : capacity_;
+}
+
+template <typename T>
+const T& LockFreeStagingQueue<T>::peek(size_t index) const {
+  const size_t begin = mainstage_begin_.value.load(std::memory_order_relaxed);
+  const size_t end = mainstage_end_.value.load(std::memory_order_relaxed);
+  return index < end - begin ? mainstage(begin + index) : null_;
+}
+
+template <typename T>
+const T& LockFreeStagingQueue<T>::peek_backstage(size_t index) const {
+  const size_t begin = backstage_begin_.value.load(std::memory_order_acquire);
+  const size_t end = backstage_end_.value.load(std::memory_order_acquire);
+  if (index >= end - begin) {
+    return null_;
+  }
+  const BackstageSlot& slot = backstage_[(begin + index) & backstage_mask_];
+  // The slot may have been claimed by a producer which did not finish writing it yet.
+  if (slot.sequence.load(std::memory_order_acquire) != begin + index + 1) {
+    return null_;
+  }
+  return slot.item;
+}
+
+template <typename T>
+const T& LockFreeStagingQueue<T>::latest(size_t index) const {
+  const size_t begin = mainstage_begin_.value.load(std::memory_order_relaxed);
+  const size_t end = mainstage_end_.value.load(std::memory_order_relaxed);
+  return index < end - begin ? mainstage(end - index - 1) : null_;
+}
+
+template <typename T>
+typename LockFreeStagingQueue<T>::const_iterator_t LockFreeStagingQueue<T>::begin() const {
+  return const_iterator_t(mainstage_.get(), mainstage_mask_ + 1,
+                          mainstage_begin_.value.load(std::memory_order_relaxed) &
+                              mainstage_mask_);
+}
+
+template <typename T>
+typename LockFreeStagingQueue<T>::const_iterator_t LockFreeStagingQueue<T>::end() const {
+  const size_t begin = mainstage_begin_.value.load(std::memory_order_relaxed);
+  const size_t end = mainstage_end_.value.load(std::memory_order_relaxed);
+  return const_iterator_t(mainstage_.get(), mainstage_mask_ + 1,
+                          (begin & mainstage_mask_) + (end - begin));
+}
+
+template <typename T>
+T LockFreeStagingQueue<T>::pop() {
+  const size_t begin = mainstage_begin_.value.load(std::memory_order_relaxed);
+  const size_t end = mainstage_end_.value.load(std::memory_order_relaxed);
+  T result = null_;
+  if (begin != end) {
+    std::swap(mainstage(begin), result);
+    mainstage_begin_.value.store(begin + 1, std::memory_order_release);
+  }
+  return result;
+}
+
+template <typename T>
+void LockFreeStagingQueue<T>::popAll() {
+  size_t begin = mainstage_begin_.value.load(std::memory_order_relaxed);
+  const size_t end = mainstage_end_.value.load(std::memory_order_relaxed);
+  while (begin != end) {
+    mainstage(begin++) = null_;
+  }
+  mainstage_begin_.value.store(end, std::memory_order_release);
+}
+
+template <typename T>
+bool LockFreeStagingQueue<T>::push(T item) {
+  if (capacity_ == 0) {
+    return overflow_behavior_ != OverflowBehavior::kFault;
+  }
+  size_t position = backstage_end_.value.load(std::memory_order_relaxed);
+  while (true) {
+    // The back stage is full if it holds 'capacity' items. 'begin' can only move forward, so the
+    // check is conservative if it is outdated.
+    const size_t begin = backstage_begin_.value.load(std::memory_order_acquire);
+    if (position - begin >= capacity_) {
+      switch (overflow_behavior_) {
+        case OverflowBehavior::kPop: {
+          // Make room by dropping the oldest item and retry.
+          T dropped = null_;
+          dequeueBackstage(dropped);
+          position = backstage_end_.value.load(std::memory_order_relaxed);
+          continue;
+        }
+        case OverflowBehavior::kReject:
+          return true;
+        case OverflowBehavior::kFault:
+        default:
+          return false;
+      }
+    }
+    BackstageSlot& slot = backstage_[position & backstage_mask_];
+    const size_t sequence = slot.sequence.load(std::memory_order_acquire);
+    const intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+    if (difference == 0) {
+      // The slot is free: try to claim it.
+      if (backstage_end_.value.compare_exchange_weak(position, position + 1,
+                                                     std::memory_order_relaxed)) {
+        slot.item = std::move(item);
+        slot.sequence.store(position + 1, std::memory_order_release);
+        return true;
+      }
+      // 'position' was updated by compare_exchange_weak.
+    } else if (difference < 0) {
+      // The slot is still being read by a consumer: the ring is full, retry the overflow check.
+      position = backstage_end_.value.load(std::memory_order_relaxed);
+    } else {
+      // Another producer claimed this position.
+      position = backstage_end_.value.load(std::memory_order_relaxed);
+    }
+  }
+}
+
+template <typename T>
+bool LockFreeStagingQueue<T>::dequeueBackstage(T& item) {
+  size_t position = backstage_begin_.value.load(std::memory_order_relaxed);
+  while (true) {
+    BackstageSlot& slot = backstage_[position & backstage_mask_];
+    const size_t sequence = slot.sequence.load(std::memory_order_acquire);
+    const intptr_t difference =
+        static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position + 1);
+    if (difference == 0) {
+      if (backstage_begin_.value.compare_exchange_weak(position, position + 1,
+                                                       std::memory_order_relaxed)) {
+        item = std::move(slot.item);
+        slot.item = null_;
+        slot.sequence.store(position + backstage_mask_ + 1, std::memory_order_release);
+        return true;
+      }
+    } else if (difference < 0) {
+      // Empty, or the oldest slot was claimed but not yet written.
+      return false;
+    } else {
+      position = backstage_begin_.value.load(std::memory_order_relaxed);
+    }
+  }
+}
+
+template <typename T>
+bool LockFreeStagingQueue<T>::sync() {
+  // Only move the items which are in the back stage when sync starts, so that a fast producer can
+  // not keep the consumer busy forever.
+  const size_t count = back_size();
+  size_t begin = mainstage_begin_.value.load(std::memory_order_relaxed);
+  size_t end = mainstage_end_.value.load(std::memory_order_relaxed);
+  bool result = true;
+  for (size_t i = 0; i < count; i++) {
+    if (end - begin == capacity_) {
+      if (overflow_behavior_ == OverflowBehavior::kPop) {
+        // Pop the oldest item of the main stage to make room.
+        mainstage(begin++) = null_;
+      } else if (overflow_behavior_ == OverflowBehavior::kReject) {
+        // Reject the remaining new items.
+        T dropped = null_;
+        for (; i < count && dequeueBackstage(dropped); i++) {
+          dropped = null_;
+        }
+        break;
+      } else {
+        result = false;
+        break;
+      }
+    }
+    if (!dequeueBackstage(mainstage(end))) {
+      break;
+    }
+    end++;
+  }
+  mainstage_begin_.value.store(begin, std::memory_order_release);
+  mainstage_end_.value.store(end, std::memory_order_release);
+  return result;
+}
+
+}  // namespace staging_queue
+}  // namespace gxf
+
+#endif
@@ -0,0 +1,131 @@
+// SPDX-FileCopyrightText: NVIDIA CORPORATION & AFFILIATES
+// Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+#ifndef NVIDIA_GXF_STD_GEMS_SUBALLOCATORS_SEGREGATED_FIT_ALLOCATOR_HPP
+#define NVIDIA_GXF_STD_GEMS_SUBALLOCATORS_SEGREGATED_FIT_ALLOCATOR_HPP
+
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <utility>
+
+#include "common/expected.hpp"
+#include "gxf/std/gems/suballocators/segregated_fit_allocator_base.hpp"
+
+namespace nvidia {
+namespace gxf {
+
+// Memory management class with the same interface as FirstFitAllocator, backed by
+// SegregatedFitAllocatorBase to limit fragmentation under mixed-size workloads.
+// Only the allocate function is doing some memory allocation, other functions are using constant
+// amount of memory on the stack.
+template<class T>
+class SegregatedFitAllocator {
+ public:
+  using Policy = SegregatedFitAllocatorBase::Policy;
+  using Stats = SegregatedFitAllocatorBase::Stats;
+  // Expected type used by this class.
+  template <typename E>
+  using expected_t = nvidia::Expected<E, FirstFitAllocatorBase::Error>;
+  // Unexpected type used by this class.
+  using unexpected_t = nvidia::Unexpected<FirstFitAllocatorBase::Error>;
+
+  SegregatedFitAllocator() = default;
+
+  // Allocates the require memory to handle the query for a chunk of memory of a give size.
+  // It fails if size is invalid (too big or negative).
+  // As with FirstFitAllocator, a minimum chunk size can be provided, the memory acquired will
+  // always be a multiple of this size.
+  // The total memory allocated will be around sizeof(T) * size + 17 * size / chunk_size.
+  expected_t<int32_t> allocate(const int32_t size, const int chunk_size = 1,
+                               const Policy policy = Policy::kBestFit) {
+    if (buffer_.get() != nullptr) {
+      return unexpected_t(FirstFitAllocatorBase::Error::kAlreadyInUse);
+    }
+    if (size < 0 || chunk_size <= 0) {
+      return unexpected_t(FirstFitAllocatorBase::Error::kInvalidSize);
+    }
+    chunk_size_ = chunk_size;
+    const int32_t number_of_chunks = getNumberOfChunks(size);
+    // Allocate memory
+    buffer_.reset(new(std::nothrow) T[number_of_chunks * chunk_size_]);
+    if (buffer_.get() == nullptr) {
+      return unexpected_t(FirstFitAllocatorBase::Error::kOutOfMemory);
+    }
+    // Prepare the memory management.
+    auto res = memory_management_.allocate(number_of_chunks, policy);
+    if (!res) {
+      return unexpected_t(res.error());
+    }
+    return size;
+  }
+
+  // Attempts to acquire a block of memory of a given size.
+  // If such a contiguous block exists, it will return a pointer to that block and the actual size
+  // acquired (will be the smallest multiple of chunk_size_ that exceed or equal size).
+  // If no block exists, it will return FirstFitAllocatorBase::Error::kOutOfMemory.
+  expected_t<std::pair<T*, int32_t>> acquire(const int32_t size) {
+    const int32_t number_of_chunks = getNumberOfChunks(size);
+    auto res = memory_management_.acquire(number_of_chunks);
+    if (!res) {
+      return unexpected_t(res.error());
+    }
+    return std::make_pair(&buffer_.get()[res.value() * chunk_size_],
+                          number_of_chunks * chunk_size_);
+  }
+
+  // Releases a block of memory that has been acquired with the function above.
+  // Note once a block of memory has been released, it can't be released again.
+  expected_t<void> release(const T* ptr) {
+    const int32_t index = std::distance<const T*>(buffer_.get(), ptr);
+    if (index % chunk_size_ != 0) {
+      return unexpected_t(FirstFitAllocatorBase::Error::kInvalidSize);
+    }
+    return memory_management_.release(index / chunk_size_);
+  }
+
+  // Changes the strategy used for the next acquisitions.
+  void setPolicy(Policy policy) { memory_management_.setPolicy(policy); }
+
+  // Returns fragmentation metrics. Sizes are expressed in number of T, but the histogram bins the
+  // free blocks by their size in chunks, as chunk_size is not necessarily a power of two.
+  Stats stats() const {
+    Stats stats = memory_management_.stats();
+    stats.total_size *= chunk_size_;
+    stats.free_size *= chunk_size_;
+    stats.largest_free_block *= chunk_size_;
+    return stats;
+  }
+
+ private:
+  // Returns the number of chunks of memory needed to have at least a given size.
+  int32_t getNumberOfChunks(const int32_t size) const {
+    return (size + chunk_size_ - 1) / chunk_size_;
+  }
+
+  // Real memory management.
+  SegregatedFitAllocatorBase memory_management_;
+  // Size of the chunk of memory. Only multiple of this size can be acquired.
+  int32_t chunk_size_ = 1;
+  // Buffer holding the pre-allocated memory that is provided on demand.
+  std::unique_ptr<T[]> buffer_;
+};
+
+}  // namespace gxf
+}  // namespace nvidia
+
+#endif  // NVIDIA_GXF_STD_GEMS_SUBALLOCATORS_SEGREGATED_FIT_ALLOCATOR_HPP
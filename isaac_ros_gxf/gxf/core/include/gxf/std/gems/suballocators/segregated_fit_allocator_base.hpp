@@ -0,0 +1,344 @@
+// SPDX-FileCopyrightText: NVIDIA CORPORATION & AFFILIATES
+// Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+#ifndef NVIDIA_GXF_STD_GEMS_SUBALLOCATORS_SEGREGATED_FIT_ALLOCATOR_BASE_HPP
+#define NVIDIA_GXF_STD_GEMS_SUBALLOCATORS_SEGREGATED_FIT_ALLOCATOR_BASE_HPP
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <new>
+
+#include "common/expected.hpp"
+#include "gxf/std/gems/suballocators/first_fit_allocator_base.hpp"
+
+namespace nvidia {
+namespace gxf {
+
+// Memory management helper class with the same interface as FirstFitAllocatorBase, designed to
+// limit fragmentation when blocks of very different sizes share one arena for a long time.
+//
+// FirstFitAllocatorBase always returns the lowest index where a block fits, which tends to cut the
+// large free regions at the beginning of the arena into small pieces. This class instead keeps free
+// blocks in segregated lists by size class (a power of two split in kNumSubClasses linear
+// sub-classes) and picks a block based on its size:
+//  - Policy::kBestFit returns the smallest free block which is large enough. It scans at most the
+//    list of the size class of the request and of the next non-empty class.
+//  - Policy::kGoodFit returns any block from the smallest class whose blocks are all large enough.
+//    This is O(1) but can waste up to 1 / kNumSubClasses of a block.
+// Free blocks are merged with their free neighbors when released.
+//
+// Fragmentation metrics can be queried at any time with `stats`.
+//
+// This class works only with indexes and rely on an external class to hold the memory. All the
+// memory it needs is allocated in `allocate`: 17 bytes per unit of size.
+class SegregatedFitAllocatorBase {
+ public:
+  using Error = FirstFitAllocatorBase::Error;
+  // Expected type used by this class.
+  template <typename T>
+  using expected_t = nvidia::Expected<T, Error>;
+  // Unexpected type used by this class.
+  using unexpected_t = nvidia::Unexpected<Error>;
+
+  // Strategy used to select a free block
+  enum class Policy {
+    kBestFit,
+    kGoodFit,
+  };
+
+  // Number of power of two size classes
+  static constexpr int32_t kNumClasses = 32;
+  // Number of linear sub-classes for each power of two
+  static constexpr int32_t kSubClassBits = 3;
+  static constexpr int32_t kNumSubClasses = 1 << kSubClassBits;
+
+  // Fragmentation metrics
+  struct Stats {
+    // Total size managed
+    int32_t total_size;
+    // Sum of the sizes of all the free blocks
+    int32_t free_size;
+    // Size of the largest free block
+    int32_t largest_free_block;
+    // Number of free blocks
+    int32_t number_free_blocks;
+    // Number of free blocks per power of two: histogram[i] counts blocks of size [2^i, 2^(i+1)[, in
+    // the unit of this allocator (chunks for SegregatedFitAllocator<T>)
+    std::array<int32_t, kNumClasses> histogram;
+
+    // External fragmentation ratio: 1 - largest_free_block / free_size. It is 0 when all the free
+    // memory is contiguous and gets close to 1 when the free memory is split in many small blocks.
+    double externalFragmentation() const {
+      return free_size == 0 ? 0.0
+                            : 1.0 - static_cast<double>(largest_free_block) / free_size;
+    }
+  };
+
+  SegregatedFitAllocatorBase() : policy_(Policy::kBestFit) {}
+
+  // Allocates the memory needed to manage a region of a given size.
+  // It fails if size is invalid (negative) or if the region is already in use.
+  expected_t<void> allocate(int32_t size, Policy policy = Policy::kBestFit) {
+    if (size < 0) { return unexpected_t(Error::kInvalidSize); }
+    if (total_size_ > 0 && stats_free_size_ != total_size_) {
+      return unexpected_t(Error::kAlreadyInUse);
+    }
+    const size_t count = static_cast<size_t>(size) + 1;
+    size_.reset(new (std::nothrow) int32_t[count]);
+    previous_.reset(new (std::nothrow) int32_t[count]);
+    next_free_.reset(new (std::nothrow) int32_t[count]);
+    previous_free_.reset(new (std::nothrow) int32_t[count]);
+    state_.reset(new (std::nothrow) uint8_t[count]);
+    if (!size_ || !previous_ || !next_free_ || !previous_free_ || !state_) {
+      size_.reset();
+      previous_.reset();
+      next_free_.reset();
+      previous_free_.reset();
+      state_.reset();
+      total_size_ = 0;
+      return unexpected_t(Error::kOutOfMemory);
+    }
+    total_size_ = size;
+    policy_ = policy;
+    class_bitmap_ = 0;
+    sub_class_bitmap_.fill(0);
+    for (auto& classes : heads_) { classes.fill(kNone); }
+    for (int32_t i = 0; i < size; i++) { state_[i] = kInterior; }
+    stats_free_size_ = 0;
+    number_free_blocks_ = 0;
+    histogram_.fill(0);
+    if (size > 0) {
+      size_[0] = size;
+      previous_[0] = kNone;
+      insertFree(0);
+    }
+    return expected_t<void>{};
+  }
+
+  // Changes the strategy used for the next acquisitions.
+  void setPolicy(Policy policy) { policy_ = policy; }
+
+  // Attempts to acquire a block of memory of a given size and returns its index.
+  // If no block exists, it will return Error::kOutOfMemory.
+  expected_t<int32_t> acquire(int32_t size) {
+    if (size <= 0 || size > total_size_) { return unexpected_t(Error::kInvalidSize); }
+    const int32_t index = policy_ == Policy::kBestFit ? findBestFit(size) : findGoodFit(size);
+    if (index == kNone) { return unexpected_t(Error::kOutOfMemory); }
+    removeFree(index);
+    const int32_t remaining = size_[index] - size;
+    if (remaining > 0) {
+      const int32_t split = index + size;
+      size_[split] = remaining;
+      previous_[split] = index;
+      const int32_t next = split + remaining;
+      if (next < total_size_) { previous_[next] = split; }
+      size_[index] = size;
+      insertFree(split);
+    }
+    state_[index] = kUsed;
+    return index;
+  }
+
+  // Releases a block of memory that has been acquired with the function above.
+  // Note once a block of memory has been released, it can't be released again.
+  expected_t<void> release(int32_t index) {
+    if (index < 0 || index >= total_size_ || state_[index] != kUsed) {
+      return unexpected_t(Error::kBlockNotAllocated);
+    }
+    int32_t start = index;
+    int32_t size = size_[index];
+    // Merge with the next block
+    const int32_t next = start + size;
+    if (next < total_size_ && state_[next] == kFree) {
+      removeFree(next);
+      state_[next] = kInterior;
+      size += size_[next];
+    }
+    // Merge with the previous block
+    const int32_t previous = previous_[start];
+    if (previous != kNone && state_[previous] == kFree) {
+      removeFree(previous);
+      state_[start] = kInterior;
+      size += size_[previous];
+      start = previous;
+    }
+    size_[start] = size;
+    if (start + size < total_size_) { previous_[start + size] = start; }
+    insertFree(start);
+    return expected_t<void>{};
+  }
+
+  // Returns fragmentation metrics. This costs a scan of the free blocks of the largest non-empty
+  // size class.
+  Stats stats() const {
+    Stats stats;
+    stats.total_size = total_size_;
+    stats.free_size = stats_free_size_;
+    stats.number_free_blocks = number_free_blocks_;
+    stats.histogram = histogram_;
+    stats.largest_free_block = 0;
+    if (class_bitmap_ != 0) {
+      const int32_t fl = 31 - __builtin_clz(class_bitmap_);
+      const int32_t sl = 31 - __builtin_clz(sub_class_bitmap_[fl]);
+      for (int32_t i = heads_[fl][sl]; i != kNone; i = next_free_[i]) {
+        if (size_[i] > stats.largest_free_block) { stats.largest_free_block = size_[i]; }
+      }
+    }
+    return stats;
+  }
+
+ private:
+  // Values of state_
+  static constexpr uint8_t kInterior = 0;  // Not the first index of a block
+  static constexpr uint8_t kFree = 1;      // First index of a free block
+  static constexpr uint8_t kUsed = 2;      // First index of an acquired block
+  static constexpr int32_t kNone = -1;
+
+  // Computes the size class of a size.
+  static void mapping(int32_t size, int32_t& fl, int32_t& sl) {
+    if (size < kNumSubClasses) {
+      fl = 0;
+      sl = size;
+    } else {
+      const int32_t log2 = 31 - __builtin_clz(static_cast<uint32_t>(size));
+      fl = log2 - kSubClassBits + 1;
+      sl = (size >> (log2 - kSubClassBits)) - kNumSubClasses;
+    }
+  }
+
+  // Finds the first non-empty class at or after (fl, sl), returns false if none.
+  bool findClass(int32_t& fl, int32_t& sl) const {
+    if (fl >= kNumClasses) { return false; }
+    uint32_t sub_classes = sl >= kNumSubClasses ? 0 : sub_class_bitmap_[fl] & (~0u << sl);
+    if (sub_classes == 0) {
+      const uint32_t classes = fl + 1 >= kNumClasses ? 0 : class_bitmap_ & (~0u << (fl + 1));
+      if (classes == 0) { return false; }
+      fl = __builtin_ctz(classes);
+      sub_classes = sub_class_bitmap_[fl];
+    }
+    sl = __builtin_ctz(sub_classes);
+    return true;
+  }
+
+  // Returns the smallest block of the list at least as large as size, or kNone.
+  int32_t smallestInList(int32_t fl, int32_t sl, int32_t size) const {
+    int32_t best = kNone;
+    for (int32_t i = heads_[fl][sl]; i != kNone; i = next_free_[i]) {
+      if (size_[i] >= size && (best == kNone || size_[i] < size_[best])) {
+        best = i;
+        if (size_[i] == size) { break; }
+      }
+    }
+    return best;
+  }
+
+  int32_t findBestFit(int32_t size) const {
+    int32_t fl, sl;
+    mapping(size, fl, sl);
+    // Blocks in the class of the request may be smaller than the request.
+    const int32_t best = smallestInList(fl, sl, size);
+    if (best != kNone) { return best; }
+    // All the blocks of the next classes are large enough.
+    sl++;
+    if (!findClass(fl, sl)) { return kNone; }
+    return smallestInList(fl, sl, size);
+  }
+
+  int32_t findGoodFit(int32_t size) const {
+    // Rounds the size up to the next class, so that any block of the class found fits.
+    int32_t fl, sl;
+    mapping(size, fl, sl);
+    int32_t lower_fl, lower_sl;
+    mapping(size - 1, lower_fl, lower_sl);
+    if (size > 1 && lower_fl == fl && lower_sl == sl) { sl++; }
+    if (sl >= kNumSubClasses) {
+      fl++;
+      sl = 0;
+    }
+    if (!findClass(fl, sl)) {
+      // The request may still fit a block of its own class.
+      mapping(size, fl, sl);
+      return smallestInList(fl, sl, size);
+    }
+    return heads_[fl][sl];
+  }
+
+  // Adds a block to the free lists
+  void insertFree(int32_t index) {
+    int32_t fl, sl;
+    mapping(size_[index], fl, sl);
+    state_[index] = kFree;
+    previous_free_[index] = kNone;
+    next_free_[index] = heads_[fl][sl];
+    if (heads_[fl][sl] != kNone) { previous_free_[heads_[fl][sl]] = index; }
+    heads_[fl][sl] = index;
+    class_bitmap_ |= 1u << fl;
+    sub_class_bitmap_[fl] |= 1u << sl;
+    stats_free_size_ += size_[index];
+    number_free_blocks_++;
+    histogram_[31 - __builtin_clz(static_cast<uint32_t>(size_[index]))]++;
+  }
+
+  // Removes a block from the free lists
+  void removeFree(int32_t index) {
+    int32_t fl, sl;
+    mapping(size_[index], fl, sl);
+    if (previous_free_[index] != kNone) {
+      next_free_[previous_free_[index]] = next_free_[index];
+    } else {
+      heads_[fl][sl] = next_free_[index];
+    }
+    if (next_free_[index] != kNone) { previous_free_[next_free_[index]] = previous_free_[index]; }
+    if (heads_[fl][sl] == kNone) {
+      sub_class_bitmap_[fl] &= ~(1u << sl);
+      if (sub_class_bitmap_[fl] == 0) { class_bitmap_ &= ~(1u << fl); }
+    }
+    state_[index] = kInterior;
+    stats_free_size_ -= size_[index];
+    number_free_blocks_--;
+    histogram_[31 - __builtin_clz(static_cast<uint32_t>(size_[index]))]--;
+  }
+
+  // Size of the block starting at a given index. Only valid at the first index of a block.
+  std::unique_ptr<int32_t[]> size_;
+  // First index of the block physically before a given block, or kNone.
+  std::unique_ptr<int32_t[]> previous_;
+  // Links of the free lists
+  std::unique_ptr<int32_t[]> next_free_;
+  std::unique_ptr<int32_t[]> previous_free_;
+  // State of each index, see kInterior, kFree and kUsed
+  std::unique_ptr<uint8_t[]> state_;
+
+  // Heads of the free lists for each size class
+  std::array<std::array<int32_t, kNumSubClasses>, kNumClasses> heads_;
+  // Bit fl is set if one of the sub-classes of fl is not empty
+  uint32_t class_bitmap_ = 0;
+  // Bit sl of sub_class_bitmap_[fl] is set if the list (fl, sl) is not empty
+  std::array<uint32_t, kNumClasses> sub_class_bitmap_;
+
+  int32_t total_size_ = 0;
+  Policy policy_;
+  // Running fragmentation metrics
+  int32_t stats_free_size_ = 0;
+  int32_t number_free_blocks_ = 0;
+  std::array<int32_t, kNumClasses> histogram_{};
+};
+
+}  // namespace gxf
+}  // namespace nvidia
+
+#endif  // NVIDIA_GXF_STD_GEMS_SUBALLOCATORS_SEGREGATED_FIT_ALLOCATOR_BASE_HPP
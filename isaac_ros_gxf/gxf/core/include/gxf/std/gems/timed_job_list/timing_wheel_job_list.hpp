@@ -0,0 +1,478 @@
+// SPDX-FileCopyrightText: NVIDIA CORPORATION & AFFILIATES
+// Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef NVIDIA_GXF_STD_GEMS_TIMED_JOB_LIST_TIMING_WHEEL_JOB_LIST_HPP_
+#define NVIDIA_GXF_STD_GEMS_TIMED_JOB_LIST_TIMING_WHEEL_JOB_LIST_HPP_
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdlib>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "gxf/core/expected.hpp"
+
+namespace nvidia {
+namespace gxf {
+
+// A thread-safe job list with the same interface as TimedJobList, backed by a hierarchical timing
+// wheel and per-worker ready queues with work stealing.
+//
+// TimedJobList keeps all future jobs in a priority queue and all overdue jobs in a list behind a
+// single mutex, so every insert and every pop costs O(log(n)) while holding a lock all workers
+// contend on. In this implementation:
+//  - Future jobs are stored in a hierarchical timing wheel of kNumLevels levels of kNumSlots slots.
+//    Time is quantized in ticks of `resolution` nanoseconds and a job is stored at the level of the
+//    highest 6 bits group in which its tick differs from the current tick. Inserting is O(1) and
+//    the next non-empty slot is found with one bit scan per level. Jobs further in the future than
+//    the wheel can represent are kept in an overflow list.
+//  - When jobs expire, they are sorted with the same ordering as TimedJobList (earliest deadline
+//    first, with the priority as tie breaker) and handed out round robin to per-worker ready
+//    queues. A worker pops from its own queue first and steals from the other queues when its own
+//    queue is empty. Only one worker at a time advances the wheel.
+//  - The de-duplication set is sharded to avoid a global lock on insert and pop.
+//
+// Jobs are never executed before their target time; they are executed at most `resolution`
+// nanoseconds (plus wake-up latency) after it.
+//
+// The interface and the constructor match TimedJobList, so a scheduler built from source switches
+// by changing the type of its job lists. The schedulers of the prebuilt GXF std extension keep
+// using TimedJobList.
+template <typename JobT>
+class TimingWheelJobList {
+ public:
+  using Clock_t = std::function<int64_t()>;
+
+  // Number of levels of the wheel and number of slots per level. With the default resolution of
+  // 1 us the wheel covers 2^36 us (about 19 hours).
+  static constexpr int kNumLevels = 6;
+  static constexpr int kSlotBits = 6;
+  static constexpr int kNumSlots = 1 << kSlotBits;
+  // Default duration of a tick in nanoseconds
+  static constexpr int64_t kDefaultResolution = 1'000;
+
+  // Creates a job list for the given number of workers. Workers calling waitForJob with an index
+  // must each use a different index in [0, number_workers). The defaults make
+  // TimingWheelJobList(clock) a drop-in replacement for TimedJobList(clock).
+  TimingWheelJobList(Clock_t clock, size_t number_workers = 1,
+                     int64_t resolution = kDefaultResolution)
+      : clock_(clock),
+        resolution_(std::max<int64_t>(resolution, 1)),
+        is_running_(false),
+        current_tick_(clock_() / resolution_),
+        workers_(std::max<size_t>(number_workers, 1)) {
+    for (auto& worker : workers_) {
+      worker = std::make_unique<WorkerQueue>();
+    }
+    for (auto& level : levels_) {
+      level.occupied = 0;
+    }
+  }
+
+  // Number of queued jobs. This should only be used for logging purposes.
+  size_t sizeUnsafe() const { return size(); }
+
+  // Number of queued jobs (waiting or overdue).
+  size_t size() const { return size_.load(std::memory_order_relaxed); }
+
+  // Adds a job to the list to be executed at the given target time. Returns false if the job is
+  // already in the list. O(1)
+  bool insert(JobT job, int64_t target_time, int64_t slack, int priority) {
+    if (!shard(job).insert(job)) {
+      return false;
+    }
+    size_.fetch_add(1, std::memory_order_relaxed);
+    {
+      std::unique_lock<std::mutex> lock(wheel_mutex_);
+      Item item{std::move(job), target_time, slack, priority};
+      if (toTick(target_time) <= current_tick_) {
+        expired_.push_back(std::move(item));
+        distributeExpiredLocked();
+      } else {
+        insertLocked(std::move(item));
+      }
+    }
+    wheel_cv_.notify_one();
+    return true;
+  }
+
+  // Notify that a job has completed.
+  void notifyDone(JobT /* job */) { wakeOne(); }
+
+  // This is a blocking call which will wait for a job. `worker` is the index of the calling worker
+  // and selects its local ready queue.
+  void waitForJob(JobT& job, size_t worker) {
+    worker %= workers_.size();
+    while (is_running_) {
+      if (popReady(worker, job)) {
+        return;
+      }
+      std::unique_lock<std::mutex> lock(wheel_mutex_);
+      if (!is_running_) {
+        return;
+      }
+      const int64_t now = clock_();
+      if (advanceLocked(now / resolution_)) {
+        // New jobs are available: wake up other workers to help.
+        lock.unlock();
+        wheel_cv_.notify_all();
+        continue;
+      }
+      if (hasReady()) {
+        continue;
+      }
+      const auto next = nextTickLocked();
+      if (next) {
+        const int64_t wait_duration = std::max<int64_t>(next.value() * resolution_ - now, 0);
+        if (wait_duration > 0) {
+          wheel_cv_.wait_for(lock, std::chrono::nanoseconds(wait_duration));
+        }
+      } else {
+        wheel_cv_.wait(lock);
+      }
+    }
+  }
+
+  // Same as above for callers which don't track worker indices. Each calling thread is assigned a
+  // worker queue on its first call.
+  void waitForJob(JobT& job) {
+    static std::atomic<size_t> next_worker{0};
+    thread_local const size_t worker = next_worker.fetch_add(1);
+    waitForJob(job, worker);
+  }
+
+  // Sets the job list to a running state
+  void start() { is_running_.store(true); }
+  // Sets the job list to a stopped state and wakes all waiting threads to flush.
+  void stop() {
+    std::unique_lock<std::mutex> lock(wheel_mutex_);
+    is_running_.store(false);
+    wheel_cv_.notify_all();
+  }
+
+  // Gets the target time of the next waiting job; or returns an error if there is no job
+  Expected<int64_t> getNextTargetTime() const {
+    std::unique_lock<std::mutex> lock(wheel_mutex_);
+    const auto location = earliestLocked();
+    if (!location) {
+      return Unexpected{GXF_QUERY_NOT_FOUND};
+    }
+    return location.value().slot->at(location.value().index).target_time;
+  }
+
+  // wakes up one waiting thread
+  void wakeOne() { wheel_cv_.notify_one(); }
+  // wakes all waiting threads
+  void wakeAll() { wheel_cv_.notify_all(); }
+
+  // Pops the next pending or waiting job regardless of their target execution time
+  Expected<JobT> popFront() {
+    JobT job;
+    if (popReady(0, job)) {
+      return job;
+    }
+    std::unique_lock<std::mutex> lock(wheel_mutex_);
+    const auto location = earliestLocked();
+    if (!location) {
+      return Unexpected{GXF_FAILURE};
+    }
+    std::vector<Item>& slot = *location.value().slot;
+    job = std::move(slot[location.value().index].job);
+    slot[location.value().index] = std::move(slot.back());
+    slot.pop_back();
+    if (slot.empty() && location.value().level >= 0) {
+      levels_[location.value().level].occupied &= ~(uint64_t(1) << location.value().slot_index);
+    }
+    lock.unlock();
+    shard(job).erase(job);
+    size_.fetch_sub(1, std::memory_order_relaxed);
+    return job;
+  }
+
+  // Checks if there any pending or waiting jobs
+  bool empty() const { return size() == 0; }
+
+ private:
+  // Number of shards of the de-duplication set
+  static constexpr size_t kNumShards = 16;
+
+  // Helper class used to store jobs with additional information
+  struct Item {
+    // The job to execute
+    JobT job;
+    // The target time at which the job should be executed
+    int64_t target_time;
+    // The amount of time the target time can slip by
+    int64_t slack;
+    // The priority is used as a tie breaker when two jobs would be scheduled close together.
+    int priority;
+  };
+
+  // Same ordering as TimedJobList: returns true if `a` should run before `b`.
+  static bool RunsBefore(const Item& a, const Item& b) {
+    constexpr int64_t kTimeFudge = 1;
+    const int64_t a_time = a.target_time + a.slack;
+    const int64_t b_time = b.target_time + b.slack;
+    if (std::abs(a_time - b_time) < kTimeFudge && a.priority != b.priority) {
+      return a.priority > b.priority;
+    }
+    return a_time < b_time;
+  }
+
+  // A level of the wheel. Bit i of `occupied` is set if slot i is not empty.
+  struct Level {
+    std::array<std::vector<Item>, kNumSlots> slots;
+    uint64_t occupied;
+  };
+
+  // Ready queue owned by a worker.
+  struct WorkerQueue {
+    std::mutex mutex;
+    std::deque<JobT> jobs;
+  };
+
+  // One shard of the de-duplication set.
+  struct Shard {
+    std::mutex mutex;
+    std::unordered_set<JobT> jobs;
+
+    bool insert(const JobT& job) {
+      std::unique_lock<std::mutex> lock(mutex);
+      return jobs.insert(job).second;
+    }
+    void erase(const JobT& job) {
+      std::unique_lock<std::mutex> lock(mutex);
+      jobs.erase(job);
+    }
+  };
+
+  // Location of a job in the wheel. `level` is -1 for the overflow list.
+  struct Location {
+    int level;
+    int slot_index;
+    std::vector<Item>* slot;
+    size_t index;
+  };
+
+  // Converts a time to the first tick at or after it.
+  int64_t toTick(int64_t time) const {
+    const int64_t tick = time / resolution_;
+    return tick * resolution_ < time ? tick + 1 : tick;
+  }
+
+  Shard& shard(const JobT& job) { return shards_[std::hash<JobT>()(job) % kNumShards]; }
+
+  // Stores a job in the level matching its tick. The job must be in the future.
+  void insertLocked(Item&& item) {
+    const uint64_t tick = static_cast<uint64_t>(toTick(item.target_time));
+    const uint64_t difference = tick ^ static_cast<uint64_t>(current_tick_);
+    for (int level = 0; level < kNumLevels; level++) {
+      if ((difference >> (kSlotBits * (level + 1))) == 0) {
+        const int slot = static_cast<int>((tick >> (kSlotBits * level)) & (kNumSlots - 1));
+        levels_[level].slots[slot].push_back(std::move(item));
+        levels_[level].occupied |= uint64_t(1) << slot;
+        return;
+      }
+    }
+    overflow_.push_back(std::move(item));
+  }
+
+  // Returns the first occupied slot of a level after the slot of the current tick, or -1. Slots at
+  // or before the current one are always empty as they were processed already.
+  int firstSlotLocked(int level) const {
+    const int current =
+        static_cast<int>((current_tick_ >> (kSlotBits * level)) & (kNumSlots - 1));
+    const uint64_t later = current + 1 < kNumSlots ? ~((uint64_t(2) << current) - 1) : 0;
+    const uint64_t candidates = levels_[level].occupied & later;
+    return candidates == 0 ? -1 : __builtin_ctzll(candidates);
+  }
+
+  // Returns the first tick after the current tick at which a slot needs to be processed. For
+  // levels above 0 this is the beginning of the range of ticks covered by the slot. Lower levels
+  // cover earlier ticks, so the first level with an occupied slot gives the answer.
+  Expected<int64_t> nextTickLocked() const {
+    for (int level = 0; level < kNumLevels; level++) {
+      const int64_t slot = firstSlotLocked(level);
+      if (slot >= 0) {
+        const int shift = kSlotBits * level;
+        const int64_t block = (current_tick_ >> (shift + kSlotBits)) << (shift + kSlotBits);
+        return block | (slot << shift);
+      }
+    }
+    if (!overflow_.empty()) {
+      int64_t earliest = toTick(overflow_.front().target_time);
+      for (const Item& item : overflow_) {
+        earliest = std::min(earliest, toTick(item.target_time));
+      }
+      return earliest;
+    }
+    return Unexpected{GXF_QUERY_NOT_FOUND};
+  }
+
+  // Moves the wheel forward to the given tick and moves all the jobs due at or before it to the
+  // ready queues. Returns true if any job expired.
+  bool advanceLocked(int64_t target_tick) {
+    while (current_tick_ < target_tick) {
+      const auto next = nextTickLocked();
+      if (!next || next.value() > target_tick) {
+        // Nothing is due before the target: jump directly. Occupied slots are all after the
+        // target, so the placement of the stored jobs stays valid.
+        current_tick_ = target_tick;
+        break;
+      }
+      current_tick_ = next.value();
+      // Re-distribute the jobs of the slot (or of the overflow list) which starts at this tick.
+      // Jobs due at this exact tick expire, others go to a lower level. Lower levels are empty at
+      // this point, so the first occupied slot starting at this tick is the one to process.
+      std::vector<Item>& items = cascade_;
+      bool found = false;
+      for (int level = 0; level < kNumLevels && !found; level++) {
+        const int shift = kSlotBits * level;
+        const int slot = static_cast<int>((current_tick_ >> shift) & (kNumSlots - 1));
+        if ((levels_[level].occupied & (uint64_t(1) << slot)) != 0 &&
+            ((current_tick_ & ((int64_t(1) << shift) - 1)) == 0)) {
+          items.swap(levels_[level].slots[slot]);
+          levels_[level].occupied &= ~(uint64_t(1) << slot);
+          found = true;
+        }
+      }
+      if (!found) {
+        items.swap(overflow_);
+      }
+      for (Item& item : items) {
+        if (toTick(item.target_time) <= current_tick_) {
+          expired_.push_back(std::move(item));
+        } else {
+          insertLocked(std::move(item));
+        }
+      }
+      items.clear();
+    }
+    return distributeExpiredLocked();
+  }
+
+  // Hands the expired jobs out to the worker queues. Returns true if there was any.
+  bool distributeExpiredLocked() {
+    if (expired_.empty()) {
+      return false;
+    }
+    std::sort(expired_.begin(), expired_.end(), RunsBefore);
+    for (Item& item : expired_) {
+      WorkerQueue& queue = *workers_[next_queue_++ % workers_.size()];
+      std::unique_lock<std::mutex> lock(queue.mutex);
+      queue.jobs.push_back(std::move(item.job));
+    }
+    expired_.clear();
+    return true;
+  }
+
+  // Finds the waiting job with the earliest target time. It is in the first occupied slot of the
+  // lowest non-empty level, or in the overflow list if the wheel is empty.
+  Expected<Location> earliestLocked() const {
+    int level = 0;
+    int slot_index = -1;
+    for (; level < kNumLevels && slot_index < 0; level++) {
+      slot_index = firstSlotLocked(level);
+    }
+    const std::vector<Item>& slot =
+        slot_index < 0 ? overflow_ : levels_[level - 1].slots[slot_index];
+    if (slot.empty()) {
+      return Unexpected{GXF_QUERY_NOT_FOUND};
+    }
+    size_t earliest = 0;
+    for (size_t i = 1; i < slot.size(); i++) {
+      if (slot[i].target_time < slot[earliest].target_time) {
+        earliest = i;
+      }
+    }
+    return Location{slot_index < 0 ? -1 : level - 1, slot_index,
+                    const_cast<std::vector<Item>*>(&slot), earliest};
+  }
+
+  // Returns true if any worker queue holds a job.
+  bool hasReady() {
+    for (auto& worker : workers_) {
+      std::unique_lock<std::mutex> lock(worker->mutex);
+      if (!worker->jobs.empty()) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // Pops a job from the given worker queue, or steals one from another worker.
+  bool popReady(size_t worker, JobT& job) {
+    for (size_t i = 0; i < workers_.size(); i++) {
+      WorkerQueue& queue = *workers_[(worker + i) % workers_.size()];
+      std::unique_lock<std::mutex> lock(queue.mutex);
+      if (!queue.jobs.empty()) {
+        job = std::move(queue.jobs.front());
+        queue.jobs.pop_front();
+        lock.unlock();
+        shard(job).erase(job);
+        size_.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // This function pointer should be set to utilize the desired clock for the queue.
+  Clock_t clock_;
+  // Duration of a tick in nanoseconds
+  const int64_t resolution_;
+  // state variable to control if threads should block on waiting for jobs
+  std::atomic<bool> is_running_;
+  // Number of jobs in the list
+  std::atomic<size_t> size_{0};
+
+  // Protects the wheel, the overflow list and the list of expired jobs.
+  mutable std::mutex wheel_mutex_;
+  std::condition_variable wheel_cv_;
+  // Tick up to which the wheel was processed.
+  int64_t current_tick_;
+  // Levels of the wheel.
+  std::array<Level, kNumLevels> levels_;
+  // Jobs which are too far in the future for the wheel.
+  std::vector<Item> overflow_;
+  // Scratch storage for the jobs of the slot being processed. Swapping it with the slot keeps the
+  // capacity of the vectors so that the wheel does not allocate once warmed up.
+  std::vector<Item> cascade_;
+  // Jobs which expired and need to be given to a worker.
+  std::vector<Item> expired_;
+  // Index of the next worker queue which receives an expired job.
+  size_t next_queue_ = 0;
+
+  // Ready queues of the workers.
+  std::vector<std::unique_ptr<WorkerQueue>> workers_;
+  // Sharded set of the jobs currently in the list to avoid duplicates.
+  std::array<Shard, kNumShards> shards_;
+};
+
+}  // namespace gxf
+}  // namespace nvidia
+
+#endif  // NVIDIA_GXF_STD_GEMS_TIMED_JOB_LIST_TIMING_WHEEL_JOB_LIST_HPP_
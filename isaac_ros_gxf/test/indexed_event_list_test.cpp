@@ -0,0 +1,61 @@
+// SPDX-FileCopyrightText: NVIDIA CORPORATION & AFFILIATES
+// Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+#include <gtest/gtest.h>
+
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "gxf/std/gems/event_list/indexed_event_list.hpp"
+
+namespace nvidia {
+namespace gxf {
+
+TEST(IndexedEventList, ClearsAndDrainsAfterShrinking) {
+  IndexedEventList<std::string> list;
+  std::mt19937 rng(1);
+  for (int round = 0; round < 100; round++) {
+    // Rounds of varying size, so that the table is often much larger than the list.
+    std::set<std::string> expected;
+    const int count = static_cast<int>(rng() % 300);
+    for (int i = 0; i < count; i++) {
+      const std::string event = std::to_string(rng() % 500);
+      EXPECT_EQ(list.pushEvent(event), expected.insert(event).second);
+    }
+    for (int i = 0; i < count / 3; i++) {
+      const std::string event = std::to_string(rng() % 500);
+      EXPECT_EQ(list.removeEvent(event), expected.erase(event) == 1);
+    }
+    ASSERT_EQ(list.size(), expected.size());
+
+    std::vector<std::string> events;
+    if (round % 2 == 0) {
+      EXPECT_EQ(list.drain(events), expected.size());
+      EXPECT_EQ(std::set<std::string>(events.begin(), events.end()), expected);
+    } else {
+      list.clear();
+    }
+    EXPECT_TRUE(list.empty());
+    for (int i = 0; i < 500; i++) {
+      EXPECT_FALSE(list.hasEvent(std::to_string(i)));
+    }
+  }
+}
+
+}  // namespace gxf
+}  // namespace nvidia
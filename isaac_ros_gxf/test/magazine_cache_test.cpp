@@ -0,0 +1,158 @@
+// SPDX-FileCopyrightText: NVIDIA CORPORATION & AFFILIATES
+// Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+#include <gtest/gtest.h>
+
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "gxf/std/gems/magazine_cache/magazine_cache.hpp"
+
+namespace nvidia {
+namespace gxf {
+
+namespace {
+
+// Pool of fixed blocks with the interface of BlockMemoryPool, counting the blocks handed out
+class FakePool {
+ public:
+  FakePool(uint64_t block_size, uint64_t num_blocks)
+      : block_size_(block_size), storage_(block_size * num_blocks) {
+    for (uint64_t i = 0; i < num_blocks; i++) { free_.push_back(storage_.data() + i * block_size); }
+  }
+
+  Expected<byte*> allocate(uint64_t size, MemoryStorageType) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (size > block_size_ || free_.empty()) { return Unexpected{GXF_OUT_OF_MEMORY}; }
+    byte* pointer = free_.back();
+    free_.pop_back();
+    return pointer;
+  }
+
+  Expected<void> free(byte* pointer) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    free_.push_back(pointer);
+    return Success;
+  }
+
+  uint64_t block_size() const { return block_size_; }
+  uint64_t num_blocks() const { return storage_.size() / block_size_; }
+  uint64_t free_blocks() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    return free_.size();
+  }
+
+ private:
+  uint64_t block_size_;
+  std::vector<byte> storage_;
+  std::vector<byte*> free_;
+  std::mutex mutex_;
+};
+
+}  // namespace
+
+TEST(MagazineCache, AllocatesAllBlocks) {
+  FakePool pool(64, 100);
+  MagazineCache<FakePool> cache;
+  ASSERT_TRUE(cache.initialize(&pool, MemoryStorageType::kHost, 8, 2, 4));
+
+  std::set<byte*> blocks;
+  for (int i = 0; i < 100; i++) {
+    auto maybe = cache.allocate();
+    ASSERT_TRUE(maybe);
+    EXPECT_TRUE(blocks.insert(maybe.value()).second);
+  }
+  EXPECT_FALSE(cache.allocate());
+  EXPECT_EQ(cache.available_blocks(), 0u);
+
+  for (byte* block : blocks) { ASSERT_TRUE(cache.free(block)); }
+  EXPECT_EQ(cache.available_blocks(), 100u);
+  ASSERT_TRUE(cache.flush());
+  EXPECT_EQ(cache.cached_blocks(), 0u);
+  EXPECT_EQ(pool.free_blocks(), 100u);
+}
+
+TEST(MagazineCache, CountsBlocksParkedInMagazines) {
+  FakePool pool(64, 256);
+  MagazineCache<FakePool> cache;
+  ASSERT_TRUE(cache.initialize(&pool, MemoryStorageType::kHost, 4, 3, 1));
+
+  // Cycles enough blocks through the cache to fill both magazines and the whole depot
+  std::vector<byte*> blocks;
+  for (int i = 0; i < 40; i++) { blocks.push_back(cache.allocate().value()); }
+  for (int i = 0; i < 30; i++) {
+    ASSERT_TRUE(cache.free(blocks.back()));
+    blocks.pop_back();
+  }
+  EXPECT_EQ(cache.available_blocks(), 256u - blocks.size());
+  EXPECT_EQ(cache.cached_blocks() + pool.free_blocks(), 256u - blocks.size());
+  // At most two magazines per cache and the depot hold blocks
+  EXPECT_LE(cache.cached_blocks(), 4u * (2 + 3));
+
+  for (byte* block : blocks) { ASSERT_TRUE(cache.free(block)); }
+  ASSERT_TRUE(cache.deinitialize());
+  EXPECT_EQ(pool.free_blocks(), 256u);
+}
+
+TEST(MagazineCache, ConcurrentThreads) {
+  constexpr int kThreads = 4;
+  constexpr int kIterations = 2000;
+  FakePool pool(64, 64);
+  MagazineCache<FakePool> cache;
+  ASSERT_TRUE(cache.initialize(&pool, MemoryStorageType::kHost, 4, 2, 2));
+
+  // Every thread frees the blocks allocated by the next one, so that blocks move between caches
+  std::vector<std::vector<byte*>> handoff(kThreads);
+  std::vector<std::mutex> mutexes(kThreads);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; t++) {
+    threads.emplace_back([&, t] {
+      for (int i = 0; i < kIterations; i++) {
+        auto maybe = cache.allocate();
+        if (maybe) {
+          std::unique_lock<std::mutex> lock(mutexes[t]);
+          handoff[t].push_back(maybe.value());
+        }
+        const int other = (t + 1) % kThreads;
+        byte* pointer = nullptr;
+        {
+          std::unique_lock<std::mutex> lock(mutexes[other]);
+          if (!handoff[other].empty()) {
+            pointer = handoff[other].back();
+            handoff[other].pop_back();
+          }
+        }
+        if (pointer != nullptr) { ASSERT_TRUE(cache.free(pointer)); }
+        EXPECT_LE(cache.available_blocks(), 64u);
+      }
+    });
+  }
+  for (auto& thread : threads) { thread.join(); }
+
+  size_t held = 0;
+  for (const auto& blocks : handoff) { held += blocks.size(); }
+  EXPECT_EQ(cache.available_blocks(), 64u - held);
+  for (const auto& blocks : handoff) {
+    for (byte* block : blocks) { ASSERT_TRUE(cache.free(block)); }
+  }
+  ASSERT_TRUE(cache.flush());
+  EXPECT_EQ(pool.free_blocks(), 64u);
+}
+
+}  // namespace gxf
+}  // namespace nvidia
@@ -0,0 +1,244 @@
+// SPDX-FileCopyrightText: NVIDIA CORPORATION & AFFILIATES
+// Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "gxf/std/gems/suballocators/segregated_fit_allocator.hpp"
+#include "gxf/std/gems/suballocators/segregated_fit_allocator_base.hpp"
+
+namespace nvidia {
+namespace gxf {
+
+namespace {
+
+using Policy = SegregatedFitAllocatorBase::Policy;
+
+// Free runs of a bitmap of used units: (start, size) of every maximal run of free units
+std::vector<std::pair<int32_t, int32_t>> FreeRuns(const std::vector<bool>& used) {
+  std::vector<std::pair<int32_t, int32_t>> runs;
+  for (int32_t i = 0; i < static_cast<int32_t>(used.size()); i++) {
+    if (used[i]) { continue; }
+    if (i == 0 || used[i - 1]) {
+      runs.emplace_back(i, 0);
+    }
+    runs.back().second++;
+  }
+  return runs;
+}
+
+// Checks that the metrics match fully merged free blocks
+void ExpectStats(const SegregatedFitAllocatorBase& allocator, const std::vector<bool>& used) {
+  const auto runs = FreeRuns(used);
+  const auto stats = allocator.stats();
+  int32_t free_size = 0;
+  int32_t largest = 0;
+  std::array<int32_t, SegregatedFitAllocatorBase::kNumClasses> histogram{};
+  for (const auto& run : runs) {
+    free_size += run.second;
+    largest = std::max(largest, run.second);
+    histogram[31 - __builtin_clz(static_cast<uint32_t>(run.second))]++;
+  }
+  ASSERT_EQ(stats.total_size, static_cast<int32_t>(used.size()));
+  ASSERT_EQ(stats.free_size, free_size);
+  ASSERT_EQ(stats.largest_free_block, largest);
+  ASSERT_EQ(stats.number_free_blocks, static_cast<int32_t>(runs.size()));
+  ASSERT_EQ(stats.histogram, histogram);
+}
+
+// Replays random acquisitions and releases of mixed sizes against a bitmap of the used units
+void ReplayRandomTrace(Policy policy, uint32_t seed) {
+  constexpr int32_t kSize = 4096;
+  SegregatedFitAllocatorBase allocator;
+  ASSERT_TRUE(allocator.allocate(kSize, policy));
+  std::vector<bool> used(kSize, false);
+  std::vector<std::pair<int32_t, int32_t>> blocks;
+  std::mt19937 rng(seed);
+  // Mostly small blocks with a few large ones, which fragments a first fit allocator
+  auto random_size = [&rng]() {
+    return rng() % 8 == 0 ? 64 + static_cast<int32_t>(rng() % 512)
+                          : 1 + static_cast<int32_t>(rng() % 32);
+  };
+  for (int step = 0; step < 5000; step++) {
+    if (blocks.empty() || rng() % 5 < 3) {
+      const int32_t size = random_size();
+      const auto runs = FreeRuns(used);
+      int32_t smallest_fit = 0;
+      for (const auto& run : runs) {
+        if (run.second >= size && (smallest_fit == 0 || run.second < smallest_fit)) {
+          smallest_fit = run.second;
+        }
+      }
+      const auto maybe_index = allocator.acquire(size);
+      // A block is found whenever a free run is large enough
+      ASSERT_EQ(maybe_index.has_value(), smallest_fit != 0) << "step " << step;
+      if (!maybe_index) {
+        ASSERT_EQ(maybe_index.error(), FirstFitAllocatorBase::Error::kOutOfMemory);
+        continue;
+      }
+      const int32_t index = maybe_index.value();
+      ASSERT_GE(index, 0);
+      ASSERT_LE(index + size, kSize);
+      const auto run = std::find_if(runs.begin(), runs.end(), [&](const auto& run) {
+        return run.first <= index && index < run.first + run.second;
+      });
+      ASSERT_NE(run, runs.end()) << "step " << step;
+      // Blocks are cut at the start of a free block, which is a whole free run
+      ASSERT_EQ(run->first, index);
+      ASSERT_GE(run->second, size);
+      if (policy == Policy::kBestFit) {
+        ASSERT_EQ(run->second, smallest_fit) << "step " << step;
+      }
+      std::fill(used.begin() + index, used.begin() + index + size, true);
+      blocks.emplace_back(index, size);
+    } else {
+      const size_t k = rng() % blocks.size();
+      ASSERT_TRUE(allocator.release(blocks[k].first));
+      std::fill(used.begin() + blocks[k].first,
+                used.begin() + blocks[k].first + blocks[k].second, false);
+      blocks[k] = blocks.back();
+      blocks.pop_back();
+    }
+    ExpectStats(allocator, used);
+  }
+  for (const auto& block : blocks) {
+    ASSERT_TRUE(allocator.release(block.first));
+  }
+  const auto stats = allocator.stats();
+  EXPECT_EQ(stats.free_size, kSize);
+  EXPECT_EQ(stats.largest_free_block, kSize);
+  EXPECT_EQ(stats.number_free_blocks, 1);
+  EXPECT_EQ(stats.externalFragmentation(), 0.0);
+}
+
+}  // namespace
+
+TEST(SegregatedFitAllocatorBase, AcquiresAndReleases) {
+  SegregatedFitAllocatorBase allocator;
+  EXPECT_EQ(allocator.allocate(-1).error(), FirstFitAllocatorBase::Error::kInvalidSize);
+  ASSERT_TRUE(allocator.allocate(100));
+  EXPECT_EQ(allocator.acquire(0).error(), FirstFitAllocatorBase::Error::kInvalidSize);
+  EXPECT_EQ(allocator.acquire(101).error(), FirstFitAllocatorBase::Error::kInvalidSize);
+
+  const auto a = allocator.acquire(60);
+  ASSERT_TRUE(a);
+  EXPECT_EQ(allocator.acquire(41).error(), FirstFitAllocatorBase::Error::kOutOfMemory);
+  const auto b = allocator.acquire(40);
+  ASSERT_TRUE(b);
+  EXPECT_EQ(allocator.stats().free_size, 0);
+  EXPECT_EQ(allocator.acquire(1).error(), FirstFitAllocatorBase::Error::kOutOfMemory);
+  // The arena can't be reset while blocks are in use
+  EXPECT_EQ(allocator.allocate(100).error(), FirstFitAllocatorBase::Error::kAlreadyInUse);
+
+  ASSERT_TRUE(allocator.release(a.value()));
+  EXPECT_EQ(allocator.release(a.value()).error(),
+            FirstFitAllocatorBase::Error::kBlockNotAllocated);
+  EXPECT_EQ(allocator.release(-1).error(), FirstFitAllocatorBase::Error::kBlockNotAllocated);
+  EXPECT_EQ(allocator.release(100).error(), FirstFitAllocatorBase::Error::kBlockNotAllocated);
+  ASSERT_TRUE(allocator.release(b.value()));
+  EXPECT_TRUE(allocator.allocate(100));
+}
+
+TEST(SegregatedFitAllocatorBase, CoalescesFreeNeighbors) {
+  SegregatedFitAllocatorBase allocator;
+  ASSERT_TRUE(allocator.allocate(40));
+  std::vector<int32_t> blocks;
+  for (int i = 0; i < 4; i++) {
+    blocks.push_back(allocator.acquire(10).value());
+  }
+  EXPECT_EQ(allocator.stats().number_free_blocks, 0);
+
+  // Releasing every other block leaves two holes which can't hold 20 units
+  ASSERT_TRUE(allocator.release(blocks[0]));
+  ASSERT_TRUE(allocator.release(blocks[2]));
+  auto stats = allocator.stats();
+  EXPECT_EQ(stats.number_free_blocks, 2);
+  EXPECT_EQ(stats.largest_free_block, 10);
+  EXPECT_DOUBLE_EQ(stats.externalFragmentation(), 0.5);
+  EXPECT_EQ(allocator.acquire(20).error(), FirstFitAllocatorBase::Error::kOutOfMemory);
+
+  // Releasing the block in between merges it with both neighbors
+  ASSERT_TRUE(allocator.release(blocks[1]));
+  stats = allocator.stats();
+  EXPECT_EQ(stats.number_free_blocks, 1);
+  EXPECT_EQ(stats.largest_free_block, 30);
+  EXPECT_EQ(stats.externalFragmentation(), 0.0);
+  const auto merged = allocator.acquire(30);
+  ASSERT_TRUE(merged);
+  EXPECT_EQ(merged.value(), blocks[0]);
+  ASSERT_TRUE(allocator.release(merged.value()));
+  ASSERT_TRUE(allocator.release(blocks[3]));
+  EXPECT_EQ(allocator.stats().largest_free_block, 40);
+}
+
+TEST(SegregatedFitAllocatorBase, BestFitKeepsLargeBlocks) {
+  SegregatedFitAllocatorBase allocator;
+  ASSERT_TRUE(allocator.allocate(200, Policy::kBestFit));
+  // Leaves a hole of 100 units followed by a hole of 12 units
+  const int32_t large = allocator.acquire(100).value();
+  const int32_t separator = allocator.acquire(1).value();
+  const int32_t small = allocator.acquire(12).value();
+  const int32_t tail = allocator.acquire(87).value();
+  ASSERT_TRUE(allocator.release(large));
+  ASSERT_TRUE(allocator.release(small));
+
+  // A first fit would cut the large hole
+  EXPECT_EQ(allocator.acquire(10).value(), small);
+  EXPECT_EQ(allocator.stats().largest_free_block, 100);
+  EXPECT_EQ(allocator.acquire(100).value(), large);
+  ASSERT_TRUE(allocator.release(separator));
+  ASSERT_TRUE(allocator.release(tail));
+}
+
+TEST(SegregatedFitAllocatorBase, MatchesModelOnRandomTraces) {
+  for (const Policy policy : {Policy::kBestFit, Policy::kGoodFit}) {
+    for (uint32_t seed = 0; seed < 3; seed++) {
+      ReplayRandomTrace(policy, seed);
+    }
+  }
+}
+
+TEST(SegregatedFitAllocator, UsesChunks) {
+  SegregatedFitAllocator<float> allocator;
+  EXPECT_EQ(allocator.allocate(100, 0).error(), FirstFitAllocatorBase::Error::kInvalidSize);
+  ASSERT_EQ(allocator.allocate(100, 8).value(), 100);
+  EXPECT_EQ(allocator.allocate(100, 8).error(), FirstFitAllocatorBase::Error::kAlreadyInUse);
+
+  const auto a = allocator.acquire(10);
+  ASSERT_TRUE(a);
+  EXPECT_EQ(a.value().second, 16);
+  const auto b = allocator.acquire(8);
+  ASSERT_TRUE(b);
+  EXPECT_EQ(b.value().second, 8);
+  EXPECT_EQ(b.value().first - a.value().first, 16);
+  // The size is rounded up to 13 chunks of 8
+  EXPECT_EQ(allocator.stats().total_size, 104);
+  EXPECT_EQ(allocator.stats().free_size, 80);
+
+  EXPECT_EQ(allocator.release(a.value().first + 1).error(),
+            FirstFitAllocatorBase::Error::kInvalidSize);
+  ASSERT_TRUE(allocator.release(a.value().first));
+  ASSERT_TRUE(allocator.release(b.value().first));
+  EXPECT_EQ(allocator.stats().largest_free_block, 104);
+}
+
+}  // namespace gxf
+}  // namespace nvidia
@@ -0,0 +1,114 @@
+// SPDX-FileCopyrightText: NVIDIA CORPORATION & AFFILIATES
+// Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "gxf/std/gems/staging_queue/lock_free_staging_queue.hpp"
+#include "gxf/std/gems/staging_queue/staging_queue.hpp"
+
+namespace gxf {
+namespace staging_queue {
+
+namespace {
+
+// Applies the same random sequence of operations to both queues and checks that they behave the
+// same. Capacities are powers of two, since the lock-free queue rounds them up.
+void ExpectSameBehavior(OverflowBehavior overflow_behavior, size_t capacity, uint32_t seed) {
+  StagingQueue<int> reference(capacity, overflow_behavior, -1);
+  LockFreeStagingQueue<int> queue(capacity, overflow_behavior, -1);
+  std::mt19937 rng(seed);
+  std::uniform_int_distribution<int> operation(0, 9);
+  int next = 0;
+  for (int step = 0; step < 5000; step++) {
+    const int op = operation(rng);
+    if (op < 5) {
+      ASSERT_EQ(reference.push(next), queue.push(next));
+      next++;
+    } else if (op < 7) {
+      const bool synced = reference.sync();
+      ASSERT_EQ(synced, queue.sync());
+      if (!synced) {
+        // A failed sync with kFault leaves the queues in an error state which is not specified.
+        return;
+      }
+    } else if (op < 9) {
+      ASSERT_EQ(reference.pop(), queue.pop());
+    } else {
+      reference.popAll();
+      queue.popAll();
+    }
+    ASSERT_EQ(reference.size(), queue.size());
+    ASSERT_EQ(reference.back_size(), queue.back_size());
+    ASSERT_EQ(reference.peek(), queue.peek());
+    ASSERT_EQ(reference.latest(), queue.latest());
+    ASSERT_EQ(reference.peek_backstage(), queue.peek_backstage());
+  }
+}
+
+}  // namespace
+
+TEST(LockFreeStagingQueue, BehavesLikeStagingQueue) {
+  for (const auto overflow_behavior :
+       {OverflowBehavior::kPop, OverflowBehavior::kReject, OverflowBehavior::kFault}) {
+    for (const size_t capacity : {1, 4, 16}) {
+      ExpectSameBehavior(overflow_behavior, capacity, static_cast<uint32_t>(capacity));
+    }
+  }
+}
+
+TEST(LockFreeStagingQueue, ReceivesEveryItemFromConcurrentProducers) {
+  constexpr int kProducers = 4;
+  constexpr int kCount = 20000;
+  LockFreeStagingQueue<int> queue(64, OverflowBehavior::kFault, -1);
+  std::vector<std::thread> threads;
+  for (int p = 0; p < kProducers; p++) {
+    threads.emplace_back([&queue, p]() {
+      for (int i = 0; i < kCount; i++) {
+        while (!queue.push(p * kCount + i)) {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+  std::vector<int> last(kProducers, -1);
+  int received = 0;
+  while (received < kProducers * kCount) {
+    queue.sync();
+    while (!queue.empty()) {
+      const int item = queue.pop();
+      const int producer = item / kCount;
+      // Items of a producer are received in order.
+      ASSERT_GT(item % kCount, last[producer]);
+      last[producer] = item % kCount;
+      received++;
+    }
+    std::this_thread::yield();
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  for (int p = 0; p < kProducers; p++) {
+    EXPECT_EQ(last[p], kCount - 1);
+  }
+}
+
+}  // namespace staging_queue
+}  // namespace gxf
@@ -0,0 +1,99 @@
+// SPDX-FileCopyrightText: NVIDIA CORPORATION & AFFILIATES
+// Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <numeric>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "gxf/std/gems/timed_job_list/timed_job_list.hpp"
+#include "gxf/std/gems/timed_job_list/timing_wheel_job_list.hpp"
+
+namespace nvidia {
+namespace gxf {
+
+namespace {
+
+using Job = int64_t;
+constexpr Job kNoJob = -1;
+
+// Inserts jobs with distinct random target times, then moves the clock past all of them and
+// returns the order in which a single worker receives the jobs.
+template <typename JobList>
+std::vector<Job> ExpiredOrder(uint32_t seed) {
+  constexpr int kNumberJobs = 500;
+  std::atomic<int64_t> now{1'000'000};
+  JobList list([&now]() { return now.load(); });
+  list.start();
+  std::mt19937 rng(seed);
+  std::vector<int64_t> times(kNumberJobs);
+  std::iota(times.begin(), times.end(), 0);
+  std::shuffle(times.begin(), times.end(), rng);
+  for (Job job = 0; job < kNumberJobs; job++) {
+    // 10 us apart, so that ties between deadlines don't depend on the priority.
+    EXPECT_TRUE(list.insert(job, now + 10'000 * times[job], 0, 0));
+  }
+  EXPECT_FALSE(list.insert(0, now, 0, 0));
+  now += 10'000 * kNumberJobs;
+  std::vector<Job> order;
+  for (int i = 0; i < kNumberJobs; i++) {
+    Job job = kNoJob;
+    list.waitForJob(job);
+    order.push_back(job);
+  }
+  EXPECT_TRUE(list.empty());
+  list.stop();
+  return order;
+}
+
+}  // namespace
+
+TEST(TimingWheelJobList, ExpiresJobsInTheSameOrderAsTimedJobList) {
+  for (uint32_t seed = 0; seed < 3; seed++) {
+    EXPECT_EQ(ExpiredOrder<TimedJobList<Job>>(seed), ExpiredOrder<TimingWheelJobList<Job>>(seed));
+  }
+}
+
+TEST(TimingWheelJobList, NeverRunsJobsEarly) {
+  std::atomic<int64_t> now{0};
+  TimingWheelJobList<Job> list([&now]() { return now.load(); }, 1, 1'000);
+  list.start();
+  ASSERT_TRUE(list.insert(7, 5'000'000, 0, 0));
+  EXPECT_EQ(list.getNextTargetTime().value(), 5'000'000);
+  std::atomic<Job> received{kNoJob};
+  std::thread worker([&]() {
+    Job job = kNoJob;
+    list.waitForJob(job);
+    received = job;
+  });
+  for (now = 0; now < 5'000'000; now += 250'000) {
+    std::this_thread::sleep_for(std::chrono::microseconds(200));
+    EXPECT_EQ(received.load(), kNoJob);
+  }
+  now = 5'000'000;
+  list.wakeAll();
+  worker.join();
+  EXPECT_EQ(received.load(), 7);
+  list.stop();
+}
+
+}  // namespace gxf
+}  // namespace nvidia
@@ -0,0 +1,165 @@
+// SPDX-FileCopyrightText: NVIDIA CORPORATION & AFFILIATES
+// Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+#include "gems/pose_tree/pose_tree.hpp"
+#include "gems/pose_tree/pose_tree_batch_query.hpp"
+
+namespace nvidia {
+namespace isaac {
+
+namespace {
+
+constexpr double kTolerance = 1e-9;
+
+void InitPoseTree(PoseTree& pose_tree) {
+  ASSERT_TRUE(pose_tree.init(64, 256, 1024, 8, 16, 8, 16));
+}
+
+// Returns a random pose with a translation in [-1, 1]^3.
+Pose3d RandomPose(std::mt19937& rng) {
+  std::uniform_real_distribution<double> value(-1.0, 1.0);
+  const Vector3d axis(value(rng), value(rng), value(rng) + 2.0);
+  return Pose3d{SO3d::FromAxisAngle(axis.normalized(), 3.0 * value(rng)),
+                Vector3d(value(rng), value(rng), value(rng))};
+}
+
+// Creates `count` frames linked as a random tree, with two poses per edge at time 0 and 1.
+std::vector<PoseTree::frame_t> CreateRandomTree(PoseTree& pose_tree, int count,
+                                                std::mt19937& rng) {
+  std::vector<PoseTree::frame_t> frames;
+  for (int i = 0; i < count; i++) {
+    const auto frame = pose_tree.createFrame();
+    EXPECT_TRUE(frame);
+    if (i > 0) {
+      const auto parent = frames[std::uniform_int_distribution<int>(0, i - 1)(rng)];
+      // Edges are set in both directions to exercise the inversions.
+      const bool forward = rng() % 2 == 0;
+      const auto lhs = forward ? parent : frame.value();
+      const auto rhs = forward ? frame.value() : parent;
+      EXPECT_TRUE(pose_tree.set(lhs, rhs, 0.0, RandomPose(rng)));
+      EXPECT_TRUE(pose_tree.set(lhs, rhs, 1.0, RandomPose(rng)));
+    }
+    frames.push_back(frame.value());
+  }
+  return frames;
+}
+
+// Checks every result of a batch against PoseTree::get.
+void ExpectSameAsGet(const PoseTree& pose_tree,
+                     const std::vector<PoseTreeBatchQuery::Query>& queries, double time,
+                     PoseTree::version_t version,
+                     const std::vector<PoseTree::Expected<Pose3d>>& results) {
+  ASSERT_EQ(results.size(), queries.size());
+  for (size_t i = 0; i < queries.size(); i++) {
+    const auto expected = pose_tree.get(queries[i].lhs, queries[i].rhs, time,
+                                        PoseTreeEdgeHistory::AccessMethod::kDefault, version);
+    ASSERT_EQ(results[i].has_value(), expected.has_value()) << "query " << i;
+    if (expected) {
+      EXPECT_LT((results[i].value().matrix() - expected.value().matrix()).norm(), kTolerance)
+          << "query " << i;
+    } else {
+      EXPECT_EQ(results[i].error(), expected.error()) << "query " << i;
+    }
+  }
+}
+
+}  // namespace
+
+TEST(PoseTreeBatchQuery, MatchesGetOnRandomTrees) {
+  std::mt19937 rng(0);
+  PoseTreeBatchQuery batch_query;
+  std::vector<PoseTree::Expected<Pose3d>> results;
+  for (int trial = 0; trial < 10; trial++) {
+    PoseTree pose_tree;
+    InitPoseTree(pose_tree);
+    const auto frames = CreateRandomTree(pose_tree, 24, rng);
+    std::uniform_int_distribution<size_t> frame_index(0, frames.size() - 1);
+    std::vector<PoseTreeBatchQuery::Query> queries;
+    for (int i = 0; i < 40; i++) {
+      queries.push_back({frames[frame_index(rng)], frames[frame_index(rng)]});
+    }
+    for (const double time : {0.0, 0.25, 1.0}) {
+      batch_query.get(pose_tree, queries, time, results);
+      ExpectSameAsGet(pose_tree, queries, time, pose_tree.getPoseTreeVersion(), results);
+      // Every edge is interpolated at most once per anchor.
+      EXPECT_LE(batch_query.number_lookups(), static_cast<int32_t>(frames.size()));
+    }
+  }
+}
+
+TEST(PoseTreeBatchQuery, ResolvesDisconnectedTreesAndErrors) {
+  std::mt19937 rng(1);
+  PoseTree pose_tree;
+  InitPoseTree(pose_tree);
+  const auto a = CreateRandomTree(pose_tree, 6, rng);
+  const auto b = CreateRandomTree(pose_tree, 6, rng);
+  const auto lonely = pose_tree.createFrame();
+  ASSERT_TRUE(lonely);
+
+  const std::vector<PoseTreeBatchQuery::Query> queries = {
+      {a[0], a[5]}, {b[1], b[4]}, {a[2], b[3]}, {a[3], a[3]}, {lonely.value(), a[1]},
+      {b[5], b[0]}, {a[4], a[1]},
+  };
+  PoseTreeBatchQuery batch_query;
+  std::vector<PoseTree::Expected<Pose3d>> results;
+  batch_query.get(pose_tree, queries, 0.5, results);
+  ExpectSameAsGet(pose_tree, queries, 0.5, pose_tree.getPoseTreeVersion(), results);
+  EXPECT_TRUE(results[0]);
+  EXPECT_TRUE(results[1]);
+  EXPECT_FALSE(results[2]);
+  EXPECT_TRUE(results[3]);
+  EXPECT_FALSE(results[4]);
+
+  // Queries before the first pose succeed or fail like the direct query.
+  batch_query.get(pose_tree, queries, -1.0, PoseTreeEdgeHistory::AccessMethod::kPrevious,
+                  results);
+  ASSERT_EQ(results.size(), queries.size());
+  for (size_t i = 0; i < queries.size(); i++) {
+    const auto expected = pose_tree.get(queries[i].lhs, queries[i].rhs, -1.0,
+                                        PoseTreeEdgeHistory::AccessMethod::kPrevious);
+    EXPECT_EQ(results[i].has_value(), expected.has_value()) << "query " << i;
+  }
+}
+
+TEST(PoseTreeBatchQuery, UsesRequestedVersion) {
+  std::mt19937 rng(2);
+  PoseTree pose_tree;
+  InitPoseTree(pose_tree);
+  const auto frames = CreateRandomTree(pose_tree, 8, rng);
+  const PoseTree::version_t version = pose_tree.getPoseTreeVersion();
+  ASSERT_TRUE(pose_tree.set(frames[0], frames[1], 2.0, RandomPose(rng)));
+
+  std::vector<PoseTreeBatchQuery::Query> queries;
+  for (size_t i = 1; i < frames.size(); i++) {
+    queries.push_back({frames[0], frames[i]});
+    queries.push_back({frames[i], frames[i - 1]});
+  }
+  PoseTreeBatchQuery batch_query;
+  std::vector<PoseTree::Expected<Pose3d>> results;
+  batch_query.get(pose_tree, queries, 1.5, PoseTreeEdgeHistory::AccessMethod::kDefault, version,
+                  results);
+  ExpectSameAsGet(pose_tree, queries, 1.5, version, results);
+  batch_query.get(pose_tree, queries, 1.5, results);
+  ExpectSameAsGet(pose_tree, queries, 1.5, pose_tree.getPoseTreeVersion(), results);
+}
+
+}  // namespace isaac
+}  // namespace nvidia
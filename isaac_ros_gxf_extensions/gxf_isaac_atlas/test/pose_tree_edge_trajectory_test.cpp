@@ -0,0 +1,179 @@
+// SPDX-FileCopyrightText: NVIDIA CORPORATION & AFFILIATES
+// Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "gems/pose_tree/pose_tree_edge_history.hpp"
+#include "gems/pose_tree/pose_tree_edge_trajectory.hpp"
+
+namespace nvidia {
+namespace isaac {
+
+namespace {
+
+using AccessMethod = PoseTreeEdgeHistory::AccessMethod;
+
+constexpr int32_t kMaximumSize = 64;
+constexpr double kTolerance = 1e-9;
+
+constexpr AccessMethod kMethods[] = {
+    AccessMethod::kNearest,           AccessMethod::kInterpolateLinearly,
+    AccessMethod::kExtrapolateLinearly, AccessMethod::kInterpolateSlerp,
+    AccessMethod::kExtrapolateSlerp,  AccessMethod::kPrevious,
+};
+
+// Fills a history and a trajectory with the same random poses and disconnections, and returns
+// the time of the last pose.
+double FillRandom(std::mt19937& rng, int32_t count, double disconnect_probability,
+                  PoseTreeEdgeHistory& history, PoseTreeEdgeTrajectory& trajectory) {
+  std::uniform_real_distribution<double> unit(-1.0, 1.0);
+  std::uniform_real_distribution<double> gap(0.01, 0.2);
+  std::bernoulli_distribution disconnect(disconnect_probability);
+  double time = 1.0;
+  for (int32_t i = 0; i < count; i++) {
+    time += gap(rng);
+    const PoseTreeEdgeHistory::version_t version = i + 1;
+    if (i > 0 && disconnect(rng)) {
+      EXPECT_TRUE(history.disconnect(time, version));
+      EXPECT_TRUE(trajectory.disconnect(time));
+      continue;
+    }
+    const Pose3d pose{
+        SO3d::FromAxisAngle(Vector3d(unit(rng), unit(rng), unit(rng)).normalized(), unit(rng)),
+        Vector3d(unit(rng), unit(rng), unit(rng))};
+    EXPECT_TRUE(history.set(time, pose, version));
+    EXPECT_TRUE(trajectory.set(time, pose));
+  }
+  return time;
+}
+
+// Checks that the trajectory resolves the given times exactly like the history.
+void ExpectSameAsHistory(const PoseTreeEdgeHistory& history,
+                         const PoseTreeEdgeTrajectory& trajectory,
+                         const std::vector<double>& times) {
+  for (const AccessMethod method : kMethods) {
+    for (const double time : times) {
+      const auto expected = history.get(time, method, ~PoseTreeEdgeHistory::version_t{0});
+      const auto actual = trajectory.get(time, method);
+      ASSERT_EQ(expected.has_value(), actual.has_value())
+          << "method " << static_cast<int>(method) << " time " << time;
+      if (!expected) {
+        EXPECT_EQ(expected.error(), actual.error())
+            << "method " << static_cast<int>(method) << " time " << time;
+        continue;
+      }
+      EXPECT_NEAR((expected.value().translation - actual.value().translation).norm(), 0.0,
+                  kTolerance)
+          << "method " << static_cast<int>(method) << " time " << time;
+      EXPECT_NEAR((expected.value().rotation.matrix() - actual.value().rotation.matrix()).norm(),
+                  0.0, kTolerance)
+          << "method " << static_cast<int>(method) << " time " << time;
+    }
+  }
+}
+
+}  // namespace
+
+TEST(PoseTreeEdgeTrajectory, MatchesHistory) {
+  std::mt19937 rng(42);
+  for (const double disconnect_probability : {0.0, 0.2}) {
+    std::vector<PoseTreeEdgeHistory::TimedPose> buffer(kMaximumSize);
+    PoseTreeEdgeHistory history(0, 1, kMaximumSize, AccessMethod::kInterpolateLinearly,
+                                buffer.data());
+    PoseTreeEdgeTrajectory trajectory;
+    ASSERT_TRUE(trajectory.init(kMaximumSize, AccessMethod::kInterpolateLinearly));
+    const double last_time = FillRandom(rng, kMaximumSize, disconnect_probability, history,
+                                        trajectory);
+
+    // Times before the first pose, between poses, on poses and after the last pose.
+    std::vector<double> times;
+    std::uniform_real_distribution<double> query(0.5, last_time + 1.0);
+    for (int i = 0; i < 2000; i++) {
+      times.push_back(query(rng));
+    }
+    for (int32_t i = 0; i < trajectory.size(); i++) {
+      times.push_back(trajectory.times()[i]);
+    }
+    ExpectSameAsHistory(history, trajectory, times);
+  }
+}
+
+TEST(PoseTreeEdgeTrajectory, MatchesHistoryWithFewPoses) {
+  std::mt19937 rng(7);
+  for (int32_t count = 0; count <= 2; count++) {
+    std::vector<PoseTreeEdgeHistory::TimedPose> buffer(kMaximumSize);
+    PoseTreeEdgeHistory history(0, 1, kMaximumSize, AccessMethod::kInterpolateLinearly,
+                                buffer.data());
+    PoseTreeEdgeTrajectory trajectory;
+    ASSERT_TRUE(trajectory.init(kMaximumSize, AccessMethod::kInterpolateLinearly));
+    const double last_time = FillRandom(rng, count, 0.0, history, trajectory);
+    ExpectSameAsHistory(history, trajectory, {0.0, 1.0, last_time - 0.001, last_time,
+                                              last_time + 0.5});
+  }
+}
+
+TEST(PoseTreeEdgeTrajectory, BatchMatchesSingleQueries) {
+  std::mt19937 rng(3);
+  std::vector<PoseTreeEdgeHistory::TimedPose> buffer(kMaximumSize);
+  PoseTreeEdgeHistory history(0, 1, kMaximumSize, AccessMethod::kInterpolateLinearly,
+                              buffer.data());
+  PoseTreeEdgeTrajectory trajectory;
+  ASSERT_TRUE(trajectory.init(kMaximumSize, AccessMethod::kInterpolateLinearly));
+  const double last_time = FillRandom(rng, kMaximumSize, 0.0, history, trajectory);
+
+  // Sorted and unsorted batches within the range of the poses.
+  std::vector<double> times;
+  std::uniform_real_distribution<double> query(trajectory.times()[0], last_time);
+  for (int i = 0; i < 1000; i++) {
+    times.push_back(query(rng));
+  }
+  for (const bool sorted : {false, true}) {
+    if (sorted) {
+      std::sort(times.begin(), times.end());
+    }
+    std::vector<Pose3d> poses(times.size());
+    ASSERT_TRUE(trajectory.get(times.data(), static_cast<int32_t>(times.size()),
+                               AccessMethod::kInterpolateLinearly, poses.data()));
+    for (size_t i = 0; i < times.size(); i++) {
+      const auto single = trajectory.get(times[i], AccessMethod::kInterpolateLinearly);
+      ASSERT_TRUE(single);
+      EXPECT_NEAR((single.value().translation - poses[i].translation).norm(), 0.0, kTolerance);
+    }
+  }
+}
+
+TEST(PoseTreeEdgeTrajectory, AssignsFromHistory) {
+  std::mt19937 rng(11);
+  std::vector<PoseTreeEdgeHistory::TimedPose> buffer(kMaximumSize);
+  PoseTreeEdgeHistory history(0, 1, kMaximumSize, AccessMethod::kInterpolateLinearly,
+                              buffer.data());
+  PoseTreeEdgeTrajectory filled;
+  ASSERT_TRUE(filled.init(kMaximumSize, AccessMethod::kInterpolateLinearly));
+  const double last_time = FillRandom(rng, kMaximumSize, 0.2, history, filled);
+
+  PoseTreeEdgeTrajectory assigned;
+  ASSERT_TRUE(assigned.init(kMaximumSize, AccessMethod::kInterpolateLinearly));
+  ASSERT_TRUE(assigned.assign(history, ~PoseTreeEdgeHistory::version_t{0}));
+  ASSERT_EQ(assigned.size(), filled.size());
+  ExpectSameAsHistory(history, assigned, {0.5, 2.0, 3.0, 4.0, last_time, last_time + 1.0});
+}
+
+}  // namespace isaac
+}  // namespace nvidia
@@ -0,0 +1,101 @@
+// SPDX-FileCopyrightText: NVIDIA CORPORATION & AFFILIATES
+// Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+#include <gtest/gtest.h>
+
+#include "gems/pose_tree/pose_tree.hpp"
+#include "gems/pose_tree/pose_tree_frame_index.hpp"
+
+namespace nvidia {
+namespace isaac {
+
+namespace {
+
+constexpr gxf_uid_t kIndexCid = 1;
+
+void InitPoseTree(PoseTree& pose_tree) {
+  ASSERT_TRUE(pose_tree.init(64, 256, 1024, 8, 16, 8, 16));
+}
+
+}  // namespace
+
+TEST(PoseTreeFrameIndex, FindsFrames) {
+  PoseTree pose_tree;
+  InitPoseTree(pose_tree);
+  PoseTreeFrameIndex index;
+  ASSERT_TRUE(index.init(64));
+  ASSERT_TRUE(index.attach(pose_tree, kIndexCid));
+
+  const auto world = pose_tree.createFrame("world");
+  const auto robot = pose_tree.createFrame("robot");
+  ASSERT_TRUE(world);
+  ASSERT_TRUE(robot);
+
+  for (int i = 0; i < 2; i++) {
+    EXPECT_EQ(index.find(pose_tree, "world").value(), world.value());
+    EXPECT_EQ(index.find(pose_tree, "robot").value(), robot.value());
+  }
+  EXPECT_EQ(index.find(pose_tree, "missing").error(), PoseTree::Error::kFrameNotFound);
+  EXPECT_EQ(index.size(), 2);
+
+  ASSERT_TRUE(pose_tree.set(world.value(), robot.value(), 1.0, Pose3d::Translation(1.0, 2.0, 3.0)));
+  const auto maybe_pose = index.get(pose_tree, PoseTreeFrameIndex::MakeFrameName("world"),
+                                    PoseTreeFrameIndex::MakeFrameName("robot"), 1.0);
+  ASSERT_TRUE(maybe_pose);
+  EXPECT_DOUBLE_EQ(maybe_pose.value().translation.y(), 2.0);
+  ASSERT_TRUE(index.detach(pose_tree, kIndexCid));
+}
+
+TEST(PoseTreeFrameIndex, FollowsRecreatedFrames) {
+  PoseTree pose_tree;
+  InitPoseTree(pose_tree);
+  PoseTreeFrameIndex index;
+  ASSERT_TRUE(index.init(64));
+  ASSERT_TRUE(index.attach(pose_tree, kIndexCid));
+
+  const auto world = pose_tree.createFrame("world");
+  const auto old_robot = pose_tree.createFrame("robot");
+  ASSERT_TRUE(index.find(pose_tree, "robot"));
+
+  // Deleting a frame is noticed on the first query failing because of it.
+  ASSERT_TRUE(pose_tree.deleteFrame(old_robot.value()));
+  EXPECT_FALSE(index.get(pose_tree, PoseTreeFrameIndex::MakeFrameName("world"),
+                         PoseTreeFrameIndex::MakeFrameName("robot"), 0.0));
+  EXPECT_EQ(index.find(pose_tree, "robot").error(), PoseTree::Error::kFrameNotFound);
+
+  // Creating a frame invalidates all the entries.
+  const auto new_robot = pose_tree.createFrame("robot");
+  ASSERT_TRUE(new_robot);
+  EXPECT_EQ(index.find(pose_tree, "robot").value(), new_robot.value());
+  EXPECT_EQ(index.find(pose_tree, "world").value(), world.value());
+  ASSERT_TRUE(index.detach(pose_tree, kIndexCid));
+}
+
+TEST(PoseTreeFrameIndex, ValidatesHitsWhenNotAttached) {
+  PoseTree pose_tree;
+  InitPoseTree(pose_tree);
+  PoseTreeFrameIndex index;
+  ASSERT_TRUE(index.init(64));
+
+  const auto old_robot = pose_tree.createFrame("robot");
+  ASSERT_TRUE(index.find(pose_tree, "robot"));
+  ASSERT_TRUE(pose_tree.deleteFrame(old_robot.value()));
+  const auto new_robot = pose_tree.createFrame("robot");
+  EXPECT_EQ(index.find(pose_tree, "robot").value(), new_robot.value());
+}
+
+}  // namespace isaac
+}  // namespace nvidia
@@ -0,0 +1,121 @@
+// SPDX-FileCopyrightText: NVIDIA CORPORATION & AFFILIATES
+// Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+#include <gtest/gtest.h>
+
+#include "gems/pose_tree/pose_tree.hpp"
+#include "gems/pose_tree/pose_tree_query_cache.hpp"
+
+namespace nvidia {
+namespace isaac {
+
+namespace {
+
+void InitPoseTree(PoseTree& pose_tree) {
+  ASSERT_TRUE(pose_tree.init(64, 256, 1024, 8, 16, 8, 16));
+}
+
+}  // namespace
+
+TEST(PoseTreeQueryCache, RequiresInit) {
+  PoseTree pose_tree;
+  InitPoseTree(pose_tree);
+  PoseTreeQueryCache cache;
+  const auto world = pose_tree.createFrame("world");
+  EXPECT_EQ(cache.get(pose_tree, world.value(), world.value(), 0.0).error(),
+            PoseTree::Error::kLogicError);
+  EXPECT_EQ(cache.init(0, 0.0).error(), PoseTree::Error::kInvalidArgument);
+  EXPECT_EQ(cache.init(16, -1.0).error(), PoseTree::Error::kInvalidArgument);
+}
+
+TEST(PoseTreeQueryCache, InvalidatedBySet) {
+  PoseTree pose_tree;
+  InitPoseTree(pose_tree);
+  PoseTreeQueryCache cache;
+  ASSERT_TRUE(cache.init(16, 0.0));
+
+  const auto world = pose_tree.createFrame("world");
+  const auto robot = pose_tree.createFrame("robot");
+  const auto camera = pose_tree.createFrame("camera");
+  ASSERT_TRUE(pose_tree.set(world.value(), robot.value(), 1.0, Pose3d::Translation(1.0, 0.0, 0.0)));
+  ASSERT_TRUE(pose_tree.set(robot.value(), camera.value(), 1.0,
+                            Pose3d::Translation(0.0, 2.0, 0.0)));
+  const PoseTree::version_t version = pose_tree.getPoseTreeVersion();
+
+  // Poses are only known at time 1, so queries at time 3 get the closest pose.
+  // The second query at the same time and version is answered from the cache.
+  for (int i = 0; i < 2; i++) {
+    const auto maybe_pose = cache.get(pose_tree, world.value(), camera.value(), 3.0);
+    ASSERT_TRUE(maybe_pose);
+    EXPECT_DOUBLE_EQ(maybe_pose.value().translation.x(), 1.0);
+    EXPECT_DOUBLE_EQ(maybe_pose.value().translation.y(), 2.0);
+  }
+  EXPECT_EQ(cache.stats().hits, 1u);
+  EXPECT_EQ(cache.stats().misses, 1u);
+
+  // Updating any edge bumps the version, so the cached pose is not returned anymore.
+  ASSERT_TRUE(pose_tree.set(world.value(), robot.value(), 2.0, Pose3d::Translation(5.0, 0.0, 0.0)));
+  ASSERT_NE(pose_tree.getPoseTreeVersion(), version);
+  const auto updated = cache.get(pose_tree, world.value(), camera.value(), 3.0);
+  const auto expected = pose_tree.get(world.value(), camera.value(), 3.0);
+  ASSERT_TRUE(updated);
+  ASSERT_TRUE(expected);
+  EXPECT_DOUBLE_EQ(updated.value().translation.x(), expected.value().translation.x());
+  EXPECT_DOUBLE_EQ(updated.value().translation.x(), 5.0);
+  EXPECT_EQ(cache.stats().hits, 1u);
+  EXPECT_EQ(cache.stats().misses, 2u);
+
+  // Queries at the old version still see the old pose.
+  const auto old_pose = cache.get(pose_tree, world.value(), camera.value(), 3.0,
+                                  PoseTreeEdgeHistory::AccessMethod::kDefault, version);
+  ASSERT_TRUE(old_pose);
+  EXPECT_DOUBLE_EQ(old_pose.value().translation.x(), 1.0);
+  EXPECT_EQ(cache.stats().hits, 2u);
+
+  cache.clear();
+  EXPECT_EQ(cache.stats().hits, 0u);
+  EXPECT_EQ(cache.stats().misses, 0u);
+  ASSERT_TRUE(cache.get(pose_tree, world.value(), camera.value(), 3.0));
+  EXPECT_EQ(cache.stats().misses, 1u);
+}
+
+TEST(PoseTreeQueryCache, TimeBuckets) {
+  PoseTree pose_tree;
+  InitPoseTree(pose_tree);
+  PoseTreeQueryCache cache;
+  ASSERT_TRUE(cache.init(16, 0.5));
+
+  const auto world = pose_tree.createFrame("world");
+  const auto robot = pose_tree.createFrame("robot");
+  ASSERT_TRUE(pose_tree.set(world.value(), robot.value(), 0.0, Pose3d::Translation(0.0, 0.0, 0.0)));
+  ASSERT_TRUE(pose_tree.set(world.value(), robot.value(), 2.0, Pose3d::Translation(2.0, 0.0, 0.0)));
+
+  // Queries in the same bucket share the pose computed for the first one.
+  const auto first = cache.get(pose_tree, world.value(), robot.value(), 1.0);
+  const auto same_bucket = cache.get(pose_tree, world.value(), robot.value(), 1.25);
+  const auto next_bucket = cache.get(pose_tree, world.value(), robot.value(), 1.5);
+  ASSERT_TRUE(first);
+  ASSERT_TRUE(same_bucket);
+  ASSERT_TRUE(next_bucket);
+  EXPECT_DOUBLE_EQ(same_bucket.value().translation.x(), first.value().translation.x());
+  EXPECT_DOUBLE_EQ(next_bucket.value().translation.x(),
+                   pose_tree.get(world.value(), robot.value(), 1.5).value().translation.x());
+  EXPECT_EQ(cache.stats().hits, 1u);
+  EXPECT_EQ(cache.stats().misses, 2u);
+}
+
+}  // namespace isaac
+}  // namespace nvidia
@@ -98,6 +98,26 @@ gxf::Expected<T> CompositeFromTensor(
   return derived;
 }
 
+// Same as above, but the copy plan is kept in `plan_cache` and only rebuilt when the schemas
+// change. Runs of consecutive elements are copied as blocks.
+template <typename T>
+gxf::Expected<T> CompositeFromTensor(
+    ::nvidia::isaac::CpuTensorConstView<typename T::scalar_t, 1> tensor,
+    const composite::Schema& tensor_schema,
+    const composite::Schema& composite_schema,
+    CompositeCopyPlanCache& plan_cache) {
+  static_assert(from_tensor_details::is_composite_data<T>::value, "Type must be a composite data "
+                "container, since we cannot guarantee parameter order");
+  T derived;
+  const auto maybe_plan = plan_cache.get(composite_schema, tensor_schema, derived.size());
+  if (!maybe_plan) {
+    return gxf::Unexpected{GXF_INVALID_DATA_FORMAT};
+  }
+
+  FromSchemaTensor(tensor, **maybe_plan, derived);
+  return derived;
+}
+
 // Constructs CompositeArray or CompositeEigen from Tensor and schemas
 template <typename T>
 gxf::Expected<T> CompositeFromTensor(::nvidia::isaac::CpuTensor<typename T::scalar_t, 1>& tensor,
@@ -16,8 +16,12 @@
 // SPDX-License-Identifier: Apache-2.0
 #pragma once
 
+#include <algorithm>
 #include <array>
 #include <cstdint>
+#include <optional>
+#include <string>
+#include <utility>
 #include <vector>
 
 #include "common/expected.hpp"
@@ -47,11 +51,127 @@ static Expected<CompositeIndexMap, Error> Create(const composite::Schema& source
   // Private constructor to force initialization through static builder for RAII.
   CompositeIndexMap(int size) : indices_(size) {}
 
-  // Stores the source index for each target index.
-  // FIXME Use a stack allocated, bounded data type once available.
+  // Stores the source index for each target index. The layout of this class is shared with the
+  // prebuilt implementation of Create, so it can not be changed to a bounded inline storage here.
+  // Users which decode many composites should use a CompositeCopyPlan instead, which keeps its
+  // runs inline.
   std::vector<int32_t> indices_;
 };
 
+// A plan to read the elements of a composite through an index map. The map is split into runs of
+// consecutive indices, and maps made of few and long runs are copied run by run. Building a plan
+// costs allocations, so plans are meant to be built once and reused, see CompositeCopyPlanCache.
+class CompositeCopyPlan {
+ public:
+  // Maximum number of runs for which a map is copied run by run. Maps with more runs, or with runs
+  // shorter than kMinAverageRunLength on average, are copied element by element, which is faster
+  // than copying many short blocks.
+  static constexpr int32_t kMaxRuns = 32;
+  static constexpr int32_t kMinAverageRunLength = 4;
+
+  // A range of consecutive target indices which maps to consecutive source indices
+  struct Run {
+    int32_t target;
+    int32_t source;
+    int32_t length;
+  };
+
+  // Creates a plan for the given source index of every target index
+  static CompositeCopyPlan Create(std::vector<int32_t> indices) {
+    CompositeCopyPlan plan;
+    plan.indices_ = std::move(indices);
+    plan.computeRuns();
+    return plan;
+  }
+
+  // Creates a plan for the first `size` target indices of an index map
+  static CompositeCopyPlan Create(const CompositeIndexMap& index_map, int32_t size) {
+    std::vector<int32_t> indices(size);
+    for (int32_t i = 0; i < size; i++) {
+      indices[i] = index_map(i);
+    }
+    return Create(std::move(indices));
+  }
+
+  // Map a target index to the corresponding source index
+  int32_t operator()(int32_t target) const { return indices_[target]; }
+
+  // Number of target indices
+  int32_t size() const { return static_cast<int32_t>(indices_.size()); }
+  // The source index for each target index
+  const int32_t* data() const { return indices_.data(); }
+
+  // Number of ranges of consecutive indices which map to consecutive indices. Zero if the map is
+  // copied element by element.
+  int32_t num_runs() const { return num_runs_; }
+  // The ranges of consecutive indices, covering all target indices in order
+  const Run* runs() const { return runs_.data(); }
+
+ private:
+  CompositeCopyPlan() = default;
+
+  // Splits the map into runs of consecutive indices, unless there are too many
+  void computeRuns() {
+    num_runs_ = 0;
+    const int32_t size = this->size();
+    for (int32_t i = 0; i < size;) {
+      int32_t end = i + 1;
+      while (end < size && indices_[end] == indices_[end - 1] + 1) {
+        end++;
+      }
+      if (num_runs_ == kMaxRuns) {
+        num_runs_ = 0;
+        return;
+      }
+      runs_[num_runs_++] = Run{i, indices_[i], end - i};
+      i = end;
+    }
+    if (num_runs_ * kMinAverageRunLength > size) {
+      num_runs_ = 0;
+    }
+  }
+
+  // Stores the source index for each target index
+  std::vector<int32_t> indices_;
+  // Runs of consecutive indices. The number of runs is bounded, so they are stored inline.
+  std::array<Run, kMaxRuns> runs_;
+  // Number of valid entries in `runs_`, or zero if there are too many runs
+  int32_t num_runs_ = 0;
+};
+
+// Keeps the copy plan of the last pair of schemas it was asked for, so that the plan is only
+// rebuilt when the schemas change. It is meant to be owned by a single user, for example a codelet
+// reading composites, and is not thread-safe. Schemas without a hash are never matched, and their
+// plan is rebuilt on every call.
+class CompositeCopyPlanCache {
+ public:
+  // Returns the plan for the first `size` target indices of the index map from `source` to
+  // `target`. The plan stays valid until the next call.
+  Expected<const CompositeCopyPlan*, CompositeIndexMap::Error> get(
+      const composite::Schema& source, const composite::Schema& target, int32_t size) {
+    const bool hashed = !source.getHash().empty() && !target.getHash().empty();
+    if (hashed && plan_ && plan_->size() == size && source_hash_ == source.getHash() &&
+        target_hash_ == target.getHash()) {
+      return &*plan_;
+    }
+    auto index_map = CompositeIndexMap::Create(source, target);
+    if (!index_map) {
+      plan_.reset();
+      return Unexpected<CompositeIndexMap::Error>(index_map.error());
+    }
+    plan_ = CompositeCopyPlan::Create(*index_map, size);
+    source_hash_ = hashed ? source.getHash() : std::string();
+    target_hash_ = hashed ? target.getHash() : std::string();
+    return &*plan_;
+  }
+
+ private:
+  std::optional<CompositeCopyPlan> plan_;
+  // Hashes of the schemas of `plan_`
+  std::string source_hash_;
+  std::string target_hash_;
+};
+
 // Helper type to encode a composite into a tensor
 template <typename K>
 struct TensorArchiveEncoder {
@@ -91,6 +211,27 @@ void FromSchemaTensor(
   }
 }
 
+// Reads a composite state from a tensor through a copy plan
+template <typename State>
+void FromSchemaTensor(
+    ::nvidia::isaac::CpuTensorConstView1<typename State::scalar_t> composite_tensor,
+    const CompositeCopyPlan& plan, State& state) {
+  using K = typename State::scalar_t;
+  const K* source = composite_tensor.element_wise_begin();
+  K* target = &state[0];
+  if (plan.num_runs() > 0 && plan.size() == state.size()) {
+    for (int32_t i = 0; i < plan.num_runs(); i++) {
+      const auto& run = plan.runs()[i];
+      std::copy_n(source + run.source, run.length, target + run.target);
+    }
+    return;
+  }
+  const int32_t* indices = plan.data();
+  for (int32_t i = 0; i < state.size(); i++) {
+    target[i] = source[indices[i]];
+  }
+}
+
 // Writes a composite state to a tensor
 template <typename State>
 void ToSchemaTensor(const State& state,
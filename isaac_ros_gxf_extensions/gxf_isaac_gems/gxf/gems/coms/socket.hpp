@@ -48,6 +48,17 @@ class Socket {
     return s;
   }
 
+  // Creates a UDP sending socket
+  // Packets are sent to the remote address and port, from an ephemeral local port
+  static Socket* CreateTxUDPSocket(const std::string& remote_address, uint16_t port) {
+    Socket* s = new Socket(remote_address, port, SOCK_DGRAM);
+    memset(&s->local_address_, 0, sizeof(s->local_address_));
+    s->local_address_.sin_port   = 0;
+    s->local_address_.sin_family = AF_INET;
+    s->local_address_.sin_addr.s_addr = htonl(INADDR_ANY);
+    return s;
+  }
+
   // Creates a TCP receiving socket
   static Socket* CreateRxTCPSocket(const std::string& source_address, uint16_t source_port) {
     return new Socket(source_address, source_port, SOCK_STREAM);
@@ -163,6 +174,12 @@ class Socket {
     return sockfd_;
   }
 
+  // Address of the remote end: the destination of a sending socket, or the source of the last
+  // packet received by a receiving socket
+  const struct sockaddr_in& getRemoteAddress() const {
+    return emitter_address_;
+  }
+
  private:
   int32_t sockfd_;
   struct sockaddr_in local_address_;
@@ -0,0 +1,381 @@
+// SPDX-FileCopyrightText: NVIDIA CORPORATION & AFFILIATES
+// Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#include "gems/core/assert.hpp"
+#include "gems/flatscan/flatscan_types.hpp"
+#include "gems/image/vectorized_utils.hpp"
+
+namespace nvidia {
+namespace isaac {
+
+// Beams of a flatscan stored as structure of arrays, with one contiguous array per field.
+//
+// Flatscan messages store every beam as a row of FlatscanIndices::kSize doubles. Most consumers
+// only need the angle and the range of the beams, which are stored here as floats so that they can
+// be processed with SIMD instructions and copied into ROS messages in one go.
+struct FlatscanSoa {
+  // Angle of every beam in radians
+  std::vector<float> angles;
+  // End of the free range of every beam
+  std::vector<float> ranges;
+  // Intensity of every beam. Empty if the source of the scan has no intensities.
+  std::vector<float> intensities;
+
+  size_t size() const { return ranges.size(); }
+  bool empty() const { return ranges.empty(); }
+
+  // Sets the number of beams. The memory of the arrays is kept when the number of beams shrinks.
+  void resize(size_t count, bool with_intensities = false) {
+    angles.resize(count);
+    ranges.resize(count);
+    intensities.resize(with_intensities ? count : 0);
+  }
+};
+
+// Reads the angles and ranges of `count` beams stored in the flatscan message layout
+inline void UnpackFlatscanBeams(const double* beams, int64_t count, float* angles, float* ranges) {
+  for (int64_t i = 0; i < count; i++) {
+    const double* beam = beams + i * FlatscanIndices::kSize;
+    angles[i] = static_cast<float>(beam[FlatscanIndices::kAngle]);
+    ranges[i] = static_cast<float>(beam[FlatscanIndices::kRangeEnd]);
+  }
+}
+
+// Reads `count` beams stored in the flatscan message layout into `scan`. The message has no
+// intensities.
+inline void UnpackFlatscanBeams(const double* beams, int64_t count, FlatscanSoa& scan) {
+  scan.resize(count);
+  UnpackFlatscanBeams(beams, count, scan.angles.data(), scan.ranges.data());
+}
+
+// Writes `count` beams in the flatscan message layout. The free range starts at the sensor, the
+// visibility range is the range of the beam and the beams have no relative time.
+inline void PackFlatscanBeams(const float* angles, const float* ranges, int64_t count,
+                              double* beams) {
+  for (int64_t i = 0; i < count; i++) {
+    double* beam = beams + i * FlatscanIndices::kSize;
+    beam[FlatscanIndices::kAngle] = angles[i];
+    beam[FlatscanIndices::kRangeStart] = 0.0;
+    beam[FlatscanIndices::kRangeEnd] = ranges[i];
+    beam[FlatscanIndices::kVisibilityRange] = ranges[i];
+    beam[FlatscanIndices::kRelativeTime] = 0.0;
+  }
+}
+
+// Clamps the ranges of all beams to [min, max]. NaN ranges are left unchanged.
+inline void ClampRanges(FlatscanSoa& scan, float min, float max,
+                        SimdBackend backend = DetectSimdBackend());
+
+// Replaces the range of every beam which is not finite or outside of [min, max] with
+// `invalid_range`, and returns the number of valid beams. If `valid` is not null it receives 1 for
+// every valid beam and 0 for every other beam.
+inline int64_t MaskInvalidBeams(FlatscanSoa& scan, float min, float max, float invalid_range,
+                                std::vector<uint8_t>* valid = nullptr,
+                                SimdBackend backend = DetectSimdBackend());
+
+// Reduces the angular resolution of a scan by `factor`. Every group of `factor` consecutive beams
+// is replaced by its beam with the smallest range, so that no obstacle is lost. NaN ranges are
+// only kept if the whole group is NaN.
+inline void DecimateBeams(const FlatscanSoa& scan, int factor, FlatscanSoa& decimated);
+
+// Cosine and sine of the angles of a scan. Scans from the same sensor have the same angles, so
+// directions are only recomputed when the angles change.
+class FlatscanBeamDirections {
+ public:
+  // Computes the directions of the given angles, unless they are the ones of the previous call.
+  // Returns true if the directions were recomputed.
+  bool update(const std::vector<float>& angles) {
+    if (angles.size() == angles_.size() &&
+        std::memcmp(angles.data(), angles_.data(), angles.size() * sizeof(float)) == 0) {
+      return false;
+    }
+    angles_ = angles;
+    cos_.resize(angles.size());
+    sin_.resize(angles.size());
+    for (size_t i = 0; i < angles.size(); i++) {
+      cos_[i] = std::cos(angles[i]);
+      sin_[i] = std::sin(angles[i]);
+    }
+    return true;
+  }
+
+  size_t size() const { return angles_.size(); }
+  const float* cos() const { return cos_.data(); }
+  const float* sin() const { return sin_.data(); }
+
+ private:
+  std::vector<float> angles_;
+  std::vector<float> cos_;
+  std::vector<float> sin_;
+};
+
+// Computes the Cartesian coordinates of the end points of the beams of a scan, which must have
+// the angles `directions` were last updated with.
+inline void PolarToCartesian(const FlatscanSoa& scan, const FlatscanBeamDirections& directions,
+                             std::vector<float>& x, std::vector<float>& y,
+                             SimdBackend backend = DetectSimdBackend());
+
+// -------------------------------------------------------------------------------------------------
+
+namespace flatscan_soa_details {
+
+inline void ClampScalar(float* ranges, int64_t count, float min, float max) {
+  for (int64_t i = 0; i < count; i++) {
+    const float range = ranges[i];
+    ranges[i] = range < min ? min : (range > max ? max : range);
+  }
+}
+
+inline int64_t MaskScalar(float* ranges, uint8_t* valid, int64_t count, float min, float max,
+                          float invalid_range) {
+  int64_t num_valid = 0;
+  for (int64_t i = 0; i < count; i++) {
+    // Comparisons with NaN are false, and infinite values are outside of [min, max]
+    const bool is_valid = ranges[i] >= min && ranges[i] <= max;
+    if (!is_valid) {
+      ranges[i] = invalid_range;
+    }
+    if (valid != nullptr) {
+      valid[i] = is_valid;
+    }
+    num_valid += is_valid;
+  }
+  return num_valid;
+}
+
+inline void PolarToCartesianScalar(const float* ranges, const float* cos, const float* sin,
+                                   float* x, float* y, int64_t count) {
+  for (int64_t i = 0; i < count; i++) {
+    x[i] = ranges[i] * cos[i];
+    y[i] = ranges[i] * sin[i];
+  }
+}
+
+#if defined(ISAAC_IMAGE_HAS_AVX2)
+
+__attribute__((target("avx2")))
+inline void ClampAvx2(float* ranges, int64_t count, float min, float max) {
+  const __m256 lower = _mm256_set1_ps(min);
+  const __m256 upper = _mm256_set1_ps(max);
+  int64_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    const __m256 range = _mm256_loadu_ps(ranges + i);
+    // Selects like the scalar code, so that NaN is kept
+    __m256 result = _mm256_blendv_ps(range, lower, _mm256_cmp_ps(range, lower, _CMP_LT_OQ));
+    result = _mm256_blendv_ps(result, upper, _mm256_cmp_ps(range, upper, _CMP_GT_OQ));
+    _mm256_storeu_ps(ranges + i, result);
+  }
+  ClampScalar(ranges + i, count - i, min, max);
+}
+
+__attribute__((target("avx2")))
+inline int64_t MaskAvx2(float* ranges, uint8_t* valid, int64_t count, float min, float max,
+                        float invalid_range) {
+  const __m256 lower = _mm256_set1_ps(min);
+  const __m256 upper = _mm256_set1_ps(max);
+  const __m256 invalid = _mm256_set1_ps(invalid_range);
+  int64_t num_valid = 0;
+  int64_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    const __m256 range = _mm256_loadu_ps(ranges + i);
+    const __m256 is_valid = _mm256_and_ps(_mm256_cmp_ps(range, lower, _CMP_GE_OQ),
+                                          _mm256_cmp_ps(range, upper, _CMP_LE_OQ));
+    _mm256_storeu_ps(ranges + i, _mm256_blendv_ps(invalid, range, is_valid));
+    num_valid += __builtin_popcount(_mm256_movemask_ps(is_valid));
+    if (valid != nullptr) {
+      // Packs the eight 0 or 1 values to bytes
+      const __m256i ones = _mm256_srli_epi32(_mm256_castps_si256(is_valid), 31);
+      const __m128i words = _mm_packs_epi32(_mm256_castsi256_si128(ones),
+                                            _mm256_extracti128_si256(ones, 1));
+      _mm_storel_epi64(reinterpret_cast<__m128i*>(valid + i), _mm_packs_epi16(words, words));
+    }
+  }
+  return num_valid + MaskScalar(ranges + i, valid != nullptr ? valid + i : nullptr, count - i,
+                                min, max, invalid_range);
+}
+
+__attribute__((target("avx2")))
+inline void PolarToCartesianAvx2(const float* ranges, const float* cos, const float* sin,
+                                 float* x, float* y, int64_t count) {
+  int64_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    const __m256 range = _mm256_loadu_ps(ranges + i);
+    _mm256_storeu_ps(x + i, _mm256_mul_ps(range, _mm256_loadu_ps(cos + i)));
+    _mm256_storeu_ps(y + i, _mm256_mul_ps(range, _mm256_loadu_ps(sin + i)));
+  }
+  PolarToCartesianScalar(ranges + i, cos + i, sin + i, x + i, y + i, count - i);
+}
+
+#endif  // ISAAC_IMAGE_HAS_AVX2
+
+#if defined(ISAAC_IMAGE_HAS_NEON)
+
+inline void ClampNeon(float* ranges, int64_t count, float min, float max) {
+  const float32x4_t lower = vdupq_n_f32(min);
+  const float32x4_t upper = vdupq_n_f32(max);
+  int64_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    const float32x4_t range = vld1q_f32(ranges + i);
+    float32x4_t result = vbslq_f32(vcltq_f32(range, lower), lower, range);
+    result = vbslq_f32(vcgtq_f32(range, upper), upper, result);
+    vst1q_f32(ranges + i, result);
+  }
+  ClampScalar(ranges + i, count - i, min, max);
+}
+
+inline int64_t MaskNeon(float* ranges, uint8_t* valid, int64_t count, float min, float max,
+                        float invalid_range) {
+  const float32x4_t lower = vdupq_n_f32(min);
+  const float32x4_t upper = vdupq_n_f32(max);
+  const float32x4_t invalid = vdupq_n_f32(invalid_range);
+  int64_t num_valid = 0;
+  int64_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    const float32x4_t range = vld1q_f32(ranges + i);
+    const uint32x4_t is_valid = vandq_u32(vcgeq_f32(range, lower), vcleq_f32(range, upper));
+    vst1q_f32(ranges + i, vbslq_f32(is_valid, range, invalid));
+    const uint32x4_t ones = vshrq_n_u32(is_valid, 31);
+    num_valid += vaddvq_u32(ones);
+    if (valid != nullptr) {
+      valid[i] = vgetq_lane_u32(ones, 0);
+      valid[i + 1] = vgetq_lane_u32(ones, 1);
+      valid[i + 2] = vgetq_lane_u32(ones, 2);
+      valid[i + 3] = vgetq_lane_u32(ones, 3);
+    }
+  }
+  return num_valid + MaskScalar(ranges + i, valid != nullptr ? valid + i : nullptr, count - i,
+                                min, max, invalid_range);
+}
+
+inline void PolarToCartesianNeon(const float* ranges, const float* cos, const float* sin,
+                                 float* x, float* y, int64_t count) {
+  int64_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    const float32x4_t range = vld1q_f32(ranges + i);
+    vst1q_f32(x + i, vmulq_f32(range, vld1q_f32(cos + i)));
+    vst1q_f32(y + i, vmulq_f32(range, vld1q_f32(sin + i)));
+  }
+  PolarToCartesianScalar(ranges + i, cos + i, sin + i, x + i, y + i, count - i);
+}
+
+#endif  // ISAAC_IMAGE_HAS_NEON
+
+}  // namespace flatscan_soa_details
+
+inline void ClampRanges(FlatscanSoa& scan, float min, float max, SimdBackend backend) {
+  namespace details = flatscan_soa_details;
+  const int64_t count = static_cast<int64_t>(scan.size());
+  switch (vectorized_details::Resolve(backend)) {
+#if defined(ISAAC_IMAGE_HAS_AVX2)
+    case SimdBackend::kAvx2:
+      details::ClampAvx2(scan.ranges.data(), count, min, max);
+      return;
+#endif
+#if defined(ISAAC_IMAGE_HAS_NEON)
+    case SimdBackend::kNeon:
+      details::ClampNeon(scan.ranges.data(), count, min, max);
+      return;
+#endif
+    default:
+      details::ClampScalar(scan.ranges.data(), count, min, max);
+  }
+}
+
+inline int64_t MaskInvalidBeams(FlatscanSoa& scan, float min, float max, float invalid_range,
+                                std::vector<uint8_t>* valid, SimdBackend backend) {
+  namespace details = flatscan_soa_details;
+  const int64_t count = static_cast<int64_t>(scan.size());
+  uint8_t* valid_data = nullptr;
+  if (valid != nullptr) {
+    valid->resize(scan.size());
+    valid_data = valid->data();
+  }
+  switch (vectorized_details::Resolve(backend)) {
+#if defined(ISAAC_IMAGE_HAS_AVX2)
+    case SimdBackend::kAvx2:
+      return details::MaskAvx2(scan.ranges.data(), valid_data, count, min, max, invalid_range);
+#endif
+#if defined(ISAAC_IMAGE_HAS_NEON)
+    case SimdBackend::kNeon:
+      return details::MaskNeon(scan.ranges.data(), valid_data, count, min, max, invalid_range);
+#endif
+    default:
+      return details::MaskScalar(scan.ranges.data(), valid_data, count, min, max, invalid_range);
+  }
+}
+
+inline void DecimateBeams(const FlatscanSoa& scan, int factor, FlatscanSoa& decimated) {
+  ASSERT(factor > 0, "Invalid decimation factor: %d", factor);
+  ASSERT(&scan != &decimated, "Beams can not be decimated in place");
+  const size_t count = scan.size();
+  const size_t groups = (count + factor - 1) / factor;
+  const bool with_intensities = !scan.intensities.empty();
+  decimated.resize(groups, with_intensities);
+  for (size_t group = 0; group < groups; group++) {
+    const size_t begin = group * factor;
+    const size_t end = std::min(count, begin + factor);
+    size_t closest = begin;
+    for (size_t i = begin + 1; i < end; i++) {
+      if (scan.ranges[i] < scan.ranges[closest] || std::isnan(scan.ranges[closest])) {
+        closest = i;
+      }
+    }
+    decimated.angles[group] = scan.angles[closest];
+    decimated.ranges[group] = scan.ranges[closest];
+    if (with_intensities) {
+      decimated.intensities[group] = scan.intensities[closest];
+    }
+  }
+}
+
+inline void PolarToCartesian(const FlatscanSoa& scan, const FlatscanBeamDirections& directions,
+                             std::vector<float>& x, std::vector<float>& y, SimdBackend backend) {
+  namespace details = flatscan_soa_details;
+  ASSERT(directions.size() == scan.size(), "Directions are for %zu beams, but scan has %zu",
+         directions.size(), scan.size());
+  const int64_t count = static_cast<int64_t>(scan.size());
+  x.resize(scan.size());
+  y.resize(scan.size());
+  switch (vectorized_details::Resolve(backend)) {
+#if defined(ISAAC_IMAGE_HAS_AVX2)
+    case SimdBackend::kAvx2:
+      details::PolarToCartesianAvx2(scan.ranges.data(), directions.cos(), directions.sin(),
+                                    x.data(), y.data(), count);
+      return;
+#endif
+#if defined(ISAAC_IMAGE_HAS_NEON)
+    case SimdBackend::kNeon:
+      details::PolarToCartesianNeon(scan.ranges.data(), directions.cos(), directions.sin(),
+                                    x.data(), y.data(), count);
+      return;
+#endif
+    default:
+      details::PolarToCartesianScalar(scan.ranges.data(), directions.cos(), directions.sin(),
+                                      x.data(), y.data(), count);
+  }
+}
+
+}  // namespace isaac
+}  // namespace nvidia
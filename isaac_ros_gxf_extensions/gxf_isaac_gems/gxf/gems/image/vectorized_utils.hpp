@@ -0,0 +1,640 @@
+// SPDX-FileCopyrightText: NVIDIA CORPORATION & AFFILIATES
+// Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "gems/core/assert.hpp"
+#include "gems/core/image/image.hpp"
+#include "gems/core/math/utils.hpp"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define ISAAC_IMAGE_HAS_AVX2 1
+#include <immintrin.h>
+#endif
+
+#if defined(__aarch64__)
+#define ISAAC_IMAGE_HAS_NEON 1
+#include <arm_neon.h>
+#endif
+
+// CPU backends for some of the image utilities in gems/image/utils.hpp.
+//
+// The functions in the `vectorized` namespace produce exactly the same images as their counterparts
+// in utils.hpp. They split large images in bands of rows processed by several threads, and use
+// AVX2 (selected at runtime) or NEON kernels for the common pixel types. Other pixel types use
+// the scalar code of utils.hpp on every band.
+
+namespace nvidia {
+namespace isaac {
+
+// Instruction sets used by the vectorized image utilities
+enum class SimdBackend {
+  kScalar,
+  kAvx2,
+  kNeon,
+};
+
+// Returns the best instruction set supported by the CPU
+inline SimdBackend DetectSimdBackend() {
+#if defined(ISAAC_IMAGE_HAS_NEON)
+  return SimdBackend::kNeon;
+#elif defined(ISAAC_IMAGE_HAS_AVX2)
+  static const SimdBackend backend =
+      __builtin_cpu_supports("avx2") ? SimdBackend::kAvx2 : SimdBackend::kScalar;
+  return backend;
+#else
+  return SimdBackend::kScalar;
+#endif
+}
+
+// Controls how the vectorized image utilities use the CPU
+struct CpuExecution {
+  // Instruction set to use. It is replaced by kScalar if the CPU does not support it.
+  SimdBackend backend = DetectSimdBackend();
+  // Maximum number of threads. 0 uses one thread per hardware thread.
+  int num_threads = 0;
+  // Images are only split in bands of at least this number of pixels. Small images are processed
+  // on the calling thread as handing bands to other threads would cost more than it saves.
+  int64_t min_pixels_per_thread = 1 << 18;
+};
+
+namespace vectorized {
+
+// Resize down an image by a factor N.
+template <int Factor, typename K, int N, typename Container>
+Image<K, N> Reduce(const ImageBase<K, N, Container>& img, const CpuExecution& execution = {});
+template <typename K, int N, typename Container>
+Image<K, N> Reduce(const ImageBase<K, N, Container>& img, int factor,
+                   const CpuExecution& execution = {});
+
+// Convert an image from a format to another given a pixel conversion function. The function is
+// called concurrently from several threads.
+template <typename Out, typename In, typename F>
+Out Convert(const In& img, F convert, const CpuExecution& execution = {});
+template <typename Out, typename In, typename F>
+void Convert(const In& img, Out& out, F convert, const CpuExecution& execution = {});
+
+// Normalizes an image
+template <typename K, typename Container>
+void Normalize(const ImageBase<K, 1, Container>& input, Image1ub& output,
+               const CpuExecution& execution = {});
+template <typename K, typename Container>
+void Normalize(const ImageBase<K, 1, Container>& input, K min, K max, Image1ub& output,
+               const CpuExecution& execution = {});
+
+}  // namespace vectorized
+
+// -------------------------------------------------------------------------------------------------
+
+namespace vectorized_details {
+
+// Returns the instruction set to use for the given request
+inline SimdBackend Resolve(SimdBackend requested) {
+  const SimdBackend supported = DetectSimdBackend();
+  return requested == supported ? requested : SimdBackend::kScalar;
+}
+
+// Number of bands in which an image is split
+inline int CountTasks(int rows, int64_t pixels_per_row, const CpuExecution& execution) {
+  int threads = execution.num_threads;
+  if (threads <= 0) {
+    threads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+  }
+  const int64_t pixels = static_cast<int64_t>(rows) * pixels_per_row;
+  const int64_t by_size = pixels / std::max<int64_t>(1, execution.min_pixels_per_thread);
+  return static_cast<int>(std::max<int64_t>(1, std::min<int64_t>({threads, rows, by_size})));
+}
+
+// Threads shared by all the vectorized utilities, one less than the number of hardware threads,
+// started on first use. Starting threads for every image would cost more than processing a band
+// of a small image.
+//
+// The calling thread takes part in its own work and runs the tasks no worker has picked up, so
+// calls can be made concurrently and from tasks themselves.
+class WorkerPool {
+ public:
+  static WorkerPool& Get() {
+    static WorkerPool pool;
+    return pool;
+  }
+
+  // Calls `function(task)` for every task of [0, tasks[ and returns once all of them are done
+  template <typename F>
+  void run(int tasks, F& function) {
+    Batch batch;
+    batch.call = [](void* function, int task) { (*static_cast<F*>(function))(task); };
+    batch.function = &function;
+    batch.tasks = tasks;
+    if (!threads_.empty()) {
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        queue_.push_back(&batch);
+      }
+      work_condition_.notify_all();
+    }
+    while (runTask(batch)) {}
+    std::unique_lock<std::mutex> lock(mutex_);
+    removeBatch(batch);
+    done_condition_.wait(lock, [&] {
+      return batch.done.load(std::memory_order_acquire) == tasks && batch.workers == 0;
+    });
+  }
+
+ private:
+  // Tasks of one call to run
+  struct Batch {
+    void (*call)(void*, int);
+    void* function;
+    int tasks;
+    // Next task to run
+    std::atomic<int> next{0};
+    // Number of tasks done
+    std::atomic<int> done{0};
+    // Number of workers which can still access the batch, protected by mutex_
+    int workers = 0;
+  };
+
+  WorkerPool() {
+    const int workers = static_cast<int>(std::thread::hardware_concurrency()) - 1;
+    for (int i = 0; i < workers; i++) {
+      threads_.emplace_back([this] { work(); });
+    }
+  }
+
+  ~WorkerPool() {
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    work_condition_.notify_all();
+    for (auto& thread : threads_) {
+      thread.join();
+    }
+  }
+
+  // Runs the next task of a batch, returns false if all of them were started already
+  bool runTask(Batch& batch) {
+    const int task = batch.next.fetch_add(1, std::memory_order_relaxed);
+    if (task >= batch.tasks) {
+      return false;
+    }
+    batch.call(batch.function, task);
+    if (batch.done.fetch_add(1, std::memory_order_acq_rel) + 1 == batch.tasks) {
+      std::unique_lock<std::mutex> lock(mutex_);
+      done_condition_.notify_all();
+    }
+    return true;
+  }
+
+  // Removes a batch from the queue if it is still there. Requires the lock.
+  void removeBatch(Batch& batch) {
+    const auto it = std::find(queue_.begin(), queue_.end(), &batch);
+    if (it != queue_.end()) {
+      queue_.erase(it);
+    }
+  }
+
+  void work() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+      work_condition_.wait(lock, [this] { return stop_ || !queue_.empty(); });
+      if (stop_) {
+        return;
+      }
+      Batch& batch = *queue_.front();
+      batch.workers++;
+      lock.unlock();
+      while (runTask(batch)) {}
+      lock.lock();
+      removeBatch(batch);
+      batch.workers--;
+      if (batch.workers == 0) {
+        done_condition_.notify_all();
+      }
+    }
+  }
+
+  std::vector<std::thread> threads_;
+  std::mutex mutex_;
+  std::condition_variable work_condition_;
+  std::condition_variable done_condition_;
+  // Batches which still have tasks to start
+  std::deque<Batch*> queue_;
+  bool stop_ = false;
+};
+
+// Calls `function(task, row_begin, row_end)` for `tasks` bands of rows covering [0, rows[. The
+// bands are processed by the calling thread and the threads of the WorkerPool.
+template <typename F>
+void ParallelForRows(int tasks, int rows, F&& function) {
+  if (tasks <= 1) {
+    function(0, 0, rows);
+    return;
+  }
+  auto band = [&](int task) {
+    const int begin = static_cast<int>(static_cast<int64_t>(rows) * task / tasks);
+    const int end = static_cast<int>(static_cast<int64_t>(rows) * (task + 1) / tasks);
+    function(task, begin, end);
+  };
+  WorkerPool::Get().run(tasks, band);
+}
+
+// Scalar conversions of Normalize. Kernels must give the same results.
+template <typename K>
+uint8_t NormalizePixel(K val, K min, K max) {
+  return static_cast<uint8_t>(K(255.9) * (val - min) / (max - min));
+}
+template <typename K>
+uint8_t NormalizeClampedPixel(K val, K min, K max) {
+  return static_cast<uint8_t>(K(255.9) * Clamp01((val - min) / (max - min)));
+}
+
+// Takes every second element of a row
+template <typename K>
+void ReduceRowBy2Scalar(const K* source, K* target, int64_t count) {
+  for (int64_t i = 0; i < count; i++) {
+    target[i] = source[2 * i];
+  }
+}
+
+// Updates min and max with the elements of an array
+template <typename K>
+void MinMaxScalar(const K* data, int64_t count, K& min, K& max) {
+  for (int64_t i = 0; i < count; i++) {
+    min = std::min(min, data[i]);
+    max = std::max(max, data[i]);
+  }
+}
+
+template <typename K>
+void NormalizeScalar(const K* input, uint8_t* output, int64_t count, K min, K max, bool clamp) {
+  if (clamp) {
+    for (int64_t i = 0; i < count; i++) {
+      output[i] = NormalizeClampedPixel(input[i], min, max);
+    }
+  } else {
+    for (int64_t i = 0; i < count; i++) {
+      output[i] = NormalizePixel(input[i], min, max);
+    }
+  }
+}
+
+#if defined(ISAAC_IMAGE_HAS_AVX2)
+
+__attribute__((target("avx2")))
+inline void ReduceRowBy2Avx2(const uint8_t* source, uint8_t* target, int64_t count) {
+  const __m256i even = _mm256_set1_epi16(0x00ff);
+  int64_t i = 0;
+  for (; i + 32 <= count; i += 32) {
+    const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + 2 * i));
+    const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + 2 * i + 32));
+    // Packing works within 128 bit lanes, the permutation restores the order of the lanes
+    const __m256i packed = _mm256_packus_epi16(_mm256_and_si256(a, even),
+                                               _mm256_and_si256(b, even));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(target + i),
+                        _mm256_permute4x64_epi64(packed, _MM_SHUFFLE(3, 1, 2, 0)));
+  }
+  ReduceRowBy2Scalar(source + 2 * i, target + i, count - i);
+}
+
+__attribute__((target("avx2")))
+inline void ReduceRowBy2Avx2(const float* source, float* target, int64_t count) {
+  int64_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    const __m256 a = _mm256_loadu_ps(source + 2 * i);
+    const __m256 b = _mm256_loadu_ps(source + 2 * i + 8);
+    const __m256 shuffled = _mm256_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+    _mm256_storeu_ps(target + i, _mm256_castpd_ps(_mm256_permute4x64_pd(
+        _mm256_castps_pd(shuffled), _MM_SHUFFLE(3, 1, 2, 0))));
+  }
+  ReduceRowBy2Scalar(source + 2 * i, target + i, count - i);
+}
+
+__attribute__((target("avx2")))
+inline void MinMaxAvx2(const float* data, int64_t count, float& min, float& max) {
+  int64_t i = 0;
+  if (count >= 8) {
+    __m256 vmin = _mm256_loadu_ps(data);
+    __m256 vmax = vmin;
+    for (i = 8; i + 8 <= count; i += 8) {
+      const __m256 value = _mm256_loadu_ps(data + i);
+      vmin = _mm256_min_ps(vmin, value);
+      vmax = _mm256_max_ps(vmax, value);
+    }
+    alignas(32) float lanes_min[8];
+    alignas(32) float lanes_max[8];
+    _mm256_store_ps(lanes_min, vmin);
+    _mm256_store_ps(lanes_max, vmax);
+    MinMaxScalar(lanes_min, 8, min, max);
+    MinMaxScalar(lanes_max, 8, min, max);
+  }
+  MinMaxScalar(data + i, count - i, min, max);
+}
+
+// Truncates 32 floats to integers and saturates them to 8 bits
+__attribute__((target("avx2")))
+inline __m256i PackToBytesAvx2(__m256 a, __m256 b, __m256 c, __m256 d) {
+  const __m256i ab = _mm256_packus_epi32(_mm256_cvttps_epi32(a), _mm256_cvttps_epi32(b));
+  const __m256i cd = _mm256_packus_epi32(_mm256_cvttps_epi32(c), _mm256_cvttps_epi32(d));
+  // Packing works within 128 bit lanes, the permutation restores the order of the groups
+  return _mm256_permutevar8x32_epi32(_mm256_packus_epi16(ab, cd),
+                                     _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7));
+}
+
+// Normalizes 8 floats with the same operations in the same order as the scalar conversions
+__attribute__((target("avx2")))
+inline __m256 NormalizeValuesAvx2(const float* values, __m256 min, __m256 range, bool clamp) {
+  const __m256 scale = _mm256_set1_ps(static_cast<float>(255.9));
+  const __m256 value = _mm256_loadu_ps(values);
+  if (clamp) {
+    const __m256 ratio = _mm256_div_ps(_mm256_sub_ps(value, min), range);
+    return _mm256_mul_ps(
+        scale, _mm256_min_ps(_mm256_max_ps(ratio, _mm256_setzero_ps()), _mm256_set1_ps(1.0f)));
+  }
+  return _mm256_div_ps(_mm256_mul_ps(scale, _mm256_sub_ps(value, min)), range);
+}
+
+__attribute__((target("avx2")))
+inline void NormalizeAvx2(const float* input, uint8_t* output, int64_t count, float min,
+                          float max, bool clamp) {
+  const __m256 vmin = _mm256_set1_ps(min);
+  const __m256 range = _mm256_set1_ps(max - min);
+  int64_t i = 0;
+  for (; i + 32 <= count; i += 32) {
+    const __m256i bytes = PackToBytesAvx2(NormalizeValuesAvx2(input + i, vmin, range, clamp),
+                                          NormalizeValuesAvx2(input + i + 8, vmin, range, clamp),
+                                          NormalizeValuesAvx2(input + i + 16, vmin, range, clamp),
+                                          NormalizeValuesAvx2(input + i + 24, vmin, range, clamp));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(output + i), bytes);
+  }
+  NormalizeScalar(input + i, output + i, count - i, min, max, clamp);
+}
+
+#endif  // ISAAC_IMAGE_HAS_AVX2
+
+#if defined(ISAAC_IMAGE_HAS_NEON)
+
+inline void ReduceRowBy2Neon(const uint8_t* source, uint8_t* target, int64_t count) {
+  int64_t i = 0;
+  for (; i + 16 <= count; i += 16) {
+    vst1q_u8(target + i, vld2q_u8(source + 2 * i).val[0]);
+  }
+  ReduceRowBy2Scalar(source + 2 * i, target + i, count - i);
+}
+
+inline void ReduceRowBy2Neon(const float* source, float* target, int64_t count) {
+  int64_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    vst1q_f32(target + i, vld2q_f32(source + 2 * i).val[0]);
+  }
+  ReduceRowBy2Scalar(source + 2 * i, target + i, count - i);
+}
+
+inline void MinMaxNeon(const float* data, int64_t count, float& min, float& max) {
+  int64_t i = 0;
+  if (count >= 4) {
+    float32x4_t vmin = vld1q_f32(data);
+    float32x4_t vmax = vmin;
+    for (i = 4; i + 4 <= count; i += 4) {
+      const float32x4_t value = vld1q_f32(data + i);
+      vmin = vminq_f32(vmin, value);
+      vmax = vmaxq_f32(vmax, value);
+    }
+    min = std::min(min, vminvq_f32(vmin));
+    max = std::max(max, vmaxvq_f32(vmax));
+  }
+  MinMaxScalar(data + i, count - i, min, max);
+}
+
+inline void NormalizeNeon(const float* input, uint8_t* output, int64_t count, float min,
+                          float max, bool clamp) {
+  const float32x4_t vmin = vdupq_n_f32(min);
+  const float32x4_t range = vdupq_n_f32(max - min);
+  const float32x4_t scale = vdupq_n_f32(static_cast<float>(255.9));
+  const float32x4_t zero = vdupq_n_f32(0.0f);
+  const float32x4_t one = vdupq_n_f32(1.0f);
+  // Same operations in the same order as the scalar conversions
+  auto convert = [&](const float* values) {
+    const float32x4_t value = vld1q_f32(values);
+    float32x4_t result;
+    if (clamp) {
+      const float32x4_t ratio = vdivq_f32(vsubq_f32(value, vmin), range);
+      result = vmulq_f32(scale, vminq_f32(vmaxq_f32(ratio, zero), one));
+    } else {
+      result = vdivq_f32(vmulq_f32(scale, vsubq_f32(value, vmin)), range);
+    }
+    return vqmovn_u32(vcvtq_u32_f32(result));
+  };
+  int64_t i = 0;
+  for (; i + 16 <= count; i += 16) {
+    const uint16x8_t low = vcombine_u16(convert(input + i), convert(input + i + 4));
+    const uint16x8_t high = vcombine_u16(convert(input + i + 8), convert(input + i + 12));
+    vst1q_u8(output + i, vcombine_u8(vqmovn_u16(low), vqmovn_u16(high)));
+  }
+  NormalizeScalar(input + i, output + i, count - i, min, max, clamp);
+}
+
+#endif  // ISAAC_IMAGE_HAS_NEON
+
+// Takes every second element of a row using the best available kernel
+template <typename K>
+void ReduceRowBy2(SimdBackend backend, const K* source, K* target, int64_t count) {
+  constexpr bool kHasKernel = std::is_same<K, uint8_t>::value || std::is_same<K, float>::value;
+#if defined(ISAAC_IMAGE_HAS_AVX2)
+  if constexpr (kHasKernel) {
+    if (backend == SimdBackend::kAvx2) {
+      ReduceRowBy2Avx2(source, target, count);
+      return;
+    }
+  }
+#endif
+#if defined(ISAAC_IMAGE_HAS_NEON)
+  if constexpr (kHasKernel) {
+    if (backend == SimdBackend::kNeon) {
+      ReduceRowBy2Neon(source, target, count);
+      return;
+    }
+  }
+#endif
+  (void)backend;
+  (void)kHasKernel;
+  ReduceRowBy2Scalar(source, target, count);
+}
+
+template <typename K>
+void MinMax(SimdBackend backend, const K* data, int64_t count, K& min, K& max) {
+#if defined(ISAAC_IMAGE_HAS_AVX2)
+  if constexpr (std::is_same<K, float>::value) {
+    if (backend == SimdBackend::kAvx2) {
+      MinMaxAvx2(data, count, min, max);
+      return;
+    }
+  }
+#endif
+#if defined(ISAAC_IMAGE_HAS_NEON)
+  if constexpr (std::is_same<K, float>::value) {
+    if (backend == SimdBackend::kNeon) {
+      MinMaxNeon(data, count, min, max);
+      return;
+    }
+  }
+#endif
+  (void)backend;
+  MinMaxScalar(data, count, min, max);
+}
+
+template <typename K>
+void NormalizeElements(SimdBackend backend, const K* input, uint8_t* output, int64_t count,
+                       K min, K max, bool clamp) {
+#if defined(ISAAC_IMAGE_HAS_AVX2)
+  if constexpr (std::is_same<K, float>::value) {
+    if (backend == SimdBackend::kAvx2) {
+      NormalizeAvx2(input, output, count, min, max, clamp);
+      return;
+    }
+  }
+#endif
+#if defined(ISAAC_IMAGE_HAS_NEON)
+  if constexpr (std::is_same<K, float>::value) {
+    if (backend == SimdBackend::kNeon) {
+      NormalizeNeon(input, output, count, min, max, clamp);
+      return;
+    }
+  }
+#endif
+  (void)backend;
+  NormalizeScalar(input, output, count, min, max, clamp);
+}
+
+// Reduces the rows [begin, end[ of the output image
+template <typename K, int N, typename Container>
+void ReduceRows(SimdBackend backend, const ImageBase<K, N, Container>& img, int factor,
+                Image<K, N>& out, int begin, int end) {
+  for (int row = begin; row < end; row++) {
+    const K* source = img.row_pointer(factor * row);
+    K* target = out.row_pointer(row);
+    if (N == 1 && factor == 2) {
+      ReduceRowBy2(backend, source, target, out.cols());
+      continue;
+    }
+    for (int col = 0; col < out.cols(); col++) {
+      std::copy(source + factor * col * N, source + (factor * col + 1) * N, target + col * N);
+    }
+  }
+}
+
+}  // namespace vectorized_details
+
+namespace vectorized {
+
+template <int Factor, typename K, int N, typename Container>
+Image<K, N> Reduce(const ImageBase<K, N, Container>& img, const CpuExecution& execution) {
+  return Reduce(img, Factor, execution);
+}
+
+template <typename K, int N, typename Container>
+Image<K, N> Reduce(const ImageBase<K, N, Container>& img, int factor,
+                   const CpuExecution& execution) {
+  Image<K, N> out(img.rows() / factor, img.cols() / factor);
+  const SimdBackend backend = vectorized_details::Resolve(execution.backend);
+  const int tasks = vectorized_details::CountTasks(out.rows(), out.cols(), execution);
+  vectorized_details::ParallelForRows(tasks, out.rows(), [&](int, int begin, int end) {
+    vectorized_details::ReduceRows(backend, img, factor, out, begin, end);
+  });
+  return out;
+}
+
+template <class Out, class In, typename F>
+Out Convert(const In& img, F convert, const CpuExecution& execution) {
+  Out out(img.rows(), img.cols());
+  Convert(img, out, convert, execution);
+  return out;
+}
+
+template <class Out, class In, typename F>
+void Convert(const In& img, Out& out, F convert, const CpuExecution& execution) {
+  ASSERT(out.dimensions() == img.dimensions(), "dimensions mismatch");
+  const int tasks = vectorized_details::CountTasks(out.rows(), out.cols(), execution);
+  vectorized_details::ParallelForRows(tasks, out.rows(), [&](int, int begin, int end) {
+    const int pixel_end = end * out.cols();
+    for (int pixel = begin * out.cols(); pixel < pixel_end; pixel++) {
+      out[pixel] = convert(img[pixel]);
+    }
+  });
+}
+
+template <typename K, typename Container>
+void Normalize(const ImageBase<K, 1, Container>& input, Image1ub& output,
+               const CpuExecution& execution) {
+  const SimdBackend backend = vectorized_details::Resolve(execution.backend);
+  const int tasks = vectorized_details::CountTasks(input.rows(), input.cols(), execution);
+  const int64_t cols = input.cols();
+
+  // Each band computes its own range, which are then merged
+  std::vector<std::pair<K, K>> ranges(tasks, {input[0], input[0]});
+  vectorized_details::ParallelForRows(tasks, input.rows(), [&](int task, int begin, int end) {
+    vectorized_details::MinMax(backend, input.row_pointer(begin), (end - begin) * cols,
+                               ranges[task].first, ranges[task].second);
+  });
+  K min = input[0];
+  K max = input[0];
+  for (const auto& range : ranges) {
+    min = std::min(min, range.first);
+    max = std::max(max, range.second);
+  }
+  if (min == max) {
+    min -= K(1.0);
+    max += K(1.0);
+  }
+
+  output.resize(input.rows(), input.cols());
+  vectorized_details::ParallelForRows(tasks, input.rows(), [&](int, int begin, int end) {
+    vectorized_details::NormalizeElements(backend, input.row_pointer(begin),
+                                          output.row_pointer(begin), (end - begin) * cols,
+                                          min, max, false);
+  });
+}
+
+template <typename K, typename Container>
+void Normalize(const ImageBase<K, 1, Container>& input, K min, K max, Image1ub& output,
+               const CpuExecution& execution) {
+  ASSERT(min < max, "Invalid range");
+  ASSERT(output.dimensions() == input.dimensions(), "dimensions mismatch");
+  const SimdBackend backend = vectorized_details::Resolve(execution.backend);
+  const int tasks = vectorized_details::CountTasks(input.rows(), input.cols(), execution);
+  const int64_t cols = input.cols();
+  vectorized_details::ParallelForRows(tasks, input.rows(), [&](int, int begin, int end) {
+    vectorized_details::NormalizeElements(backend, input.row_pointer(begin),
+                                          output.row_pointer(begin), (end - begin) * cols,
+                                          min, max, true);
+  });
+}
+
+}  // namespace vectorized
+
+}  // namespace isaac
+}  // namespace nvidia
@@ -0,0 +1,334 @@
+// SPDX-FileCopyrightText: NVIDIA CORPORATION & AFFILIATES
+// Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "gems/core/math/pose3.hpp"
+#include "gems/pose_tree/pose_tree.hpp"
+
+namespace nvidia {
+namespace isaac {
+
+// Resolves a list of lhs_T_rhs queries against a PoseTree at a single time and version.
+//
+// Queries issued one by one with PoseTree::get walk the path between the two frames and
+// interpolate every edge on it again, even though consecutive queries usually share most of their
+// path (for example every sensor to `base` and `base` to `map`). This helper instead picks the
+// frame which appears the most in the batch as an anchor and resolves the tree path from the
+// anchor to every frame of the batch once: the edges of the PoseTree are searched breadth first
+// from the anchor, and anchor_T_frame is composed edge by edge along that search tree. Every edge
+// is interpolated at most once per anchor, so the common prefix of the paths is shared by all the
+// frames below it. The queries are then composed as lhs_T_rhs = anchor_T_lhs^-1 * anchor_T_rhs.
+// Every step of the composition is a pose returned by PoseTree::get at the requested time and
+// version, thus the result is the same as the direct query up to floating point rounding. Frames
+// which can't be reached from the anchor that way (for example because an edge of the search
+// tree is not valid at the requested time) fall back to a direct PoseTree::get. Queries that
+// can't be linked to the anchor at all (for example because the batch spans several disconnected
+// trees) are resolved in a next round using a new anchor.
+//
+// All the queries of a batch are resolved against the same PoseTree version, which guarantees that
+// the returned poses are consistent with each other even if the PoseTree is updated concurrently.
+//
+// The object keeps its scratch buffers between calls, so that resolving batches of similar size
+// only allocates the edge list returned by PoseTree::edges. It is not thread-safe; use one
+// instance per thread.
+class PoseTreeBatchQuery {
+ public:
+  using frame_t = PoseTree::frame_t;
+  using version_t = PoseTree::version_t;
+
+  // A single lhs_T_rhs query.
+  struct Query {
+    frame_t lhs;
+    frame_t rhs;
+  };
+
+  // Resolves all the `queries` at the given time and version. `results` is cleared and filled with
+  // exactly one entry per query, in the same order. A failed query does not prevent the other ones
+  // from being resolved; its entry contains the error PoseTree::get would have returned.
+  void get(const PoseTree& pose_tree, const std::vector<Query>& queries, double time,
+           PoseTreeEdgeHistory::AccessMethod method, version_t version,
+           std::vector<PoseTree::Expected<::nvidia::isaac::Pose3d>>& results) {
+    number_lookups_ = 0;
+    results.clear();
+    results.reserve(queries.size());
+    for (size_t i = 0; i < queries.size(); i++) {
+      results.push_back(PoseTree::Unexpected{PoseTree::Error::kLogicError});
+    }
+
+    pending_.clear();
+    for (size_t i = 0; i < queries.size(); i++) {
+      if (queries[i].lhs == queries[i].rhs) {
+        results[i] = pose_tree.getFrameName(queries[i].lhs).map([](const char*) {
+          return ::nvidia::isaac::Pose3d::Identity();
+        });
+      } else {
+        pending_.push_back(static_cast<int32_t>(i));
+      }
+    }
+
+    if (!pending_.empty()) {
+      buildGraph(pose_tree);
+    }
+
+    // Every round resolves at least all the queries involving the anchor, so this terminates.
+    while (!pending_.empty()) {
+      const frame_t anchor = selectAnchor(queries);
+      resolveFromAnchor(pose_tree, anchor, queries, time, method, version);
+
+      deferred_.clear();
+      for (const int32_t index : pending_) {
+        const Query& query = queries[index];
+        const auto lhs = anchorPose(query.lhs);
+        const auto rhs = anchorPose(query.rhs);
+        if (query.lhs == anchor) {
+          results[index] = *rhs;
+        } else if (query.rhs == anchor) {
+          results[index] = lhs->map([](const ::nvidia::isaac::Pose3d& anchor_T_lhs) {
+            return anchor_T_lhs.inverse();
+          });
+        } else if (lhs->has_value() && rhs->has_value()) {
+          results[index] = lhs->value().inverse() * rhs->value();
+        } else {
+          deferred_.push_back(index);
+        }
+      }
+      std::swap(pending_, deferred_);
+    }
+  }
+
+  // Same as above, but resolves all the queries against the current version of the PoseTree.
+  void get(const PoseTree& pose_tree, const std::vector<Query>& queries, double time,
+           PoseTreeEdgeHistory::AccessMethod method,
+           std::vector<PoseTree::Expected<::nvidia::isaac::Pose3d>>& results) {
+    get(pose_tree, queries, time, method, pose_tree.getPoseTreeVersion(), results);
+  }
+
+  // Same as above, using the default access method of each edge.
+  void get(const PoseTree& pose_tree, const std::vector<Query>& queries, double time,
+           std::vector<PoseTree::Expected<::nvidia::isaac::Pose3d>>& results) {
+    get(pose_tree, queries, time, PoseTreeEdgeHistory::AccessMethod::kDefault, results);
+  }
+
+  // Returns the number of calls made to PoseTree::get during the last batch.
+  int32_t number_lookups() const { return number_lookups_; }
+
+ private:
+  // Resolution state of a frame of the graph for the current anchor.
+  enum class FrameState : uint8_t {
+    kUnvisited,
+    kVisited,
+    kResolved,
+    kFailed,
+  };
+
+  // Pose of a frame relative to the current anchor.
+  struct AnchorPose {
+    frame_t frame;
+    PoseTree::Expected<::nvidia::isaac::Pose3d> anchor_T_frame;
+  };
+
+  // Returns the frame involved in the largest number of pending queries.
+  frame_t selectAnchor(const std::vector<Query>& queries) {
+    frame_counts_.clear();
+    auto count = [this](frame_t frame) {
+      for (auto& entry : frame_counts_) {
+        if (entry.first == frame) {
+          entry.second++;
+          return;
+        }
+      }
+      frame_counts_.emplace_back(frame, 1);
+    };
+    for (const int32_t index : pending_) {
+      count(queries[index].lhs);
+      count(queries[index].rhs);
+    }
+    std::pair<frame_t, int32_t> best = frame_counts_.front();
+    for (const auto& entry : frame_counts_) {
+      if (entry.second > best.second) {
+        best = entry;
+      }
+    }
+    return best.first;
+  }
+
+  // Builds the adjacency lists of the edges of the PoseTree, indexed by position in `frames_`.
+  void buildGraph(const PoseTree& pose_tree) {
+    const auto edges = pose_tree.edges();
+    frames_.clear();
+    for (const auto& edge : edges) {
+      frames_.push_back(edge.first);
+      frames_.push_back(edge.second);
+    }
+    std::sort(frames_.begin(), frames_.end());
+    frames_.erase(std::unique(frames_.begin(), frames_.end()), frames_.end());
+
+    adjacency_offsets_.assign(frames_.size() + 1, 0);
+    for (const auto& edge : edges) {
+      adjacency_offsets_[frameIndex(edge.first) + 1]++;
+      adjacency_offsets_[frameIndex(edge.second) + 1]++;
+    }
+    for (size_t i = 0; i < frames_.size(); i++) {
+      adjacency_offsets_[i + 1] += adjacency_offsets_[i];
+    }
+    adjacency_.resize(adjacency_offsets_.back());
+    fill_.assign(adjacency_offsets_.begin(), adjacency_offsets_.end() - 1);
+    for (const auto& edge : edges) {
+      const int32_t a = frameIndex(edge.first);
+      const int32_t b = frameIndex(edge.second);
+      adjacency_[fill_[a]++] = b;
+      adjacency_[fill_[b]++] = a;
+    }
+  }
+
+  // Returns the index of the frame in `frames_`, or -1 if the frame has no edge.
+  int32_t frameIndex(frame_t frame) const {
+    const auto it = std::lower_bound(frames_.begin(), frames_.end(), frame);
+    if (it == frames_.end() || *it != frame) {
+      return -1;
+    }
+    return static_cast<int32_t>(it - frames_.begin());
+  }
+
+  // Computes anchor_T_frame for every distinct frame involved in the pending queries.
+  void resolveFromAnchor(const PoseTree& pose_tree, frame_t anchor,
+                         const std::vector<Query>& queries, double time,
+                         PoseTreeEdgeHistory::AccessMethod method, version_t version) {
+    anchor_poses_.clear();
+    anchor_poses_.push_back({anchor, ::nvidia::isaac::Pose3d::Identity()});
+
+    // Breadth first search from the anchor over the edges of the PoseTree.
+    const int32_t anchor_index = frameIndex(anchor);
+    states_.assign(frames_.size(), FrameState::kUnvisited);
+    parents_.resize(frames_.size());
+    poses_.resize(frames_.size());
+    if (anchor_index >= 0) {
+      queue_.clear();
+      queue_.push_back(anchor_index);
+      states_[anchor_index] = FrameState::kResolved;
+      poses_[anchor_index] = ::nvidia::isaac::Pose3d::Identity();
+      for (size_t head = 0; head < queue_.size(); head++) {
+        const int32_t current = queue_[head];
+        for (int32_t k = adjacency_offsets_[current]; k < adjacency_offsets_[current + 1]; k++) {
+          const int32_t next = adjacency_[k];
+          if (states_[next] == FrameState::kUnvisited) {
+            states_[next] = FrameState::kVisited;
+            parents_[next] = current;
+            queue_.push_back(next);
+          }
+        }
+      }
+    }
+
+    // Composes anchor_T_frame along the search tree, starting from the deepest ancestor already
+    // resolved. Returns false if the frame can't be resolved that way.
+    auto resolve_path = [&](int32_t index) {
+      path_.clear();
+      while (states_[index] == FrameState::kVisited) {
+        path_.push_back(index);
+        index = parents_[index];
+      }
+      if (states_[index] != FrameState::kResolved) {
+        for (const int32_t unresolved : path_) {
+          states_[unresolved] = FrameState::kFailed;
+        }
+        return false;
+      }
+      for (size_t k = path_.size(); k-- > 0;) {
+        const int32_t child = path_[k];
+        const int32_t parent = parents_[child];
+        number_lookups_++;
+        const auto parent_T_child =
+            pose_tree.get(frames_[parent], frames_[child], time, method, version);
+        if (!parent_T_child) {
+          for (size_t j = 0; j <= k; j++) {
+            states_[path_[j]] = FrameState::kFailed;
+          }
+          return false;
+        }
+        poses_[child] = poses_[parent] * parent_T_child.value();
+        states_[child] = FrameState::kResolved;
+      }
+      return true;
+    };
+
+    auto resolve = [&](frame_t frame) {
+      for (const auto& entry : anchor_poses_) {
+        if (entry.frame == frame) {
+          return;
+        }
+      }
+      const int32_t index = anchor_index >= 0 ? frameIndex(frame) : -1;
+      if (index >= 0 && states_[index] != FrameState::kUnvisited && resolve_path(index)) {
+        anchor_poses_.push_back({frame, poses_[index]});
+        return;
+      }
+      number_lookups_++;
+      anchor_poses_.push_back({frame, pose_tree.get(anchor, frame, time, method, version)});
+    };
+    for (const int32_t index : pending_) {
+      resolve(queries[index].lhs);
+      resolve(queries[index].rhs);
+    }
+  }
+
+  // Returns the pose of the given frame relative to the anchor. The frame must have been resolved
+  // by resolveFromAnchor.
+  const PoseTree::Expected<::nvidia::isaac::Pose3d>* anchorPose(frame_t frame) const {
+    for (const auto& entry : anchor_poses_) {
+      if (entry.frame == frame) {
+        return &entry.anchor_T_frame;
+      }
+    }
+    return nullptr;
+  }
+
+  // Indices of the queries which still need to be resolved.
+  std::vector<int32_t> pending_;
+  // Indices of the queries which could not be resolved using the current anchor.
+  std::vector<int32_t> deferred_;
+  // Number of pending queries involving each frame.
+  std::vector<std::pair<frame_t, int32_t>> frame_counts_;
+  // Poses relative to the current anchor.
+  std::vector<AnchorPose> anchor_poses_;
+  // Sorted list of the frames which have at least one edge.
+  std::vector<frame_t> frames_;
+  // Adjacency lists of the frames: the neighbors of frames_[i] are
+  // adjacency_[adjacency_offsets_[i]] to adjacency_[adjacency_offsets_[i + 1] - 1].
+  std::vector<int32_t> adjacency_offsets_;
+  std::vector<int32_t> adjacency_;
+  // Next free entry of every adjacency list while the graph is built.
+  std::vector<int32_t> fill_;
+  // Search state, parent in the search tree and anchor_T_frame of every frame.
+  std::vector<FrameState> states_;
+  std::vector<int32_t> parents_;
+  std::vector<::nvidia::isaac::Pose3d> poses_;
+  // Breadth first search queue.
+  std::vector<int32_t> queue_;
+  // Frames between a frame and its deepest resolved ancestor.
+  std::vector<int32_t> path_;
+  // Number of calls made to PoseTree::get during the last batch.
+  int32_t number_lookups_ = 0;
+};
+
+}  // namespace isaac
+}  // namespace nvidia
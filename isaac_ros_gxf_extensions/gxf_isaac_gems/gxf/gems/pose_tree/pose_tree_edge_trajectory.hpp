@@ -0,0 +1,398 @@
+// SPDX-FileCopyrightText: NVIDIA CORPORATION & AFFILIATES
+// Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+
+#include "gems/core/math/pose3.hpp"
+#include "gems/pose_tree/pose_tree_edge_history.hpp"
+
+namespace nvidia {
+namespace isaac {
+
+// A structure-of-arrays history of poses along a single edge, optimized to resolve many timestamps
+// in one call, for example to deskew a lidar sweep against the timestamp of every point.
+//
+// PoseTreeEdgeHistory stores an array of TimedPose and resolves one timestamp per (locked) call.
+// This class stores times, translations and rotations in separate contiguous arrays instead. A
+// batch of query times is first resolved to (sample index, interpolation factor) pairs, using a
+// single forward sweep if the query times are sorted and a binary search otherwise, and the poses
+// are then computed chunk by chunk with loops over contiguous arrays that the compiler can
+// vectorize.
+//
+// The access methods have the same meaning as for PoseTreeEdgeHistory. kInterpolateLinearly and
+// kExtrapolateLinearly interpolate the translation linearly and the rotation with a quaternion
+// slerp. kInterpolateSlerp and kExtrapolateSlerp interpolate on SE(3) using Pose3::pow, which is
+// evaluated per query.
+//
+// Memory is allocated once in `init`. This class is not thread-safe.
+class PoseTreeEdgeTrajectory {
+ public:
+  using AccessMethod = PoseTreeEdgeHistory::AccessMethod;
+  using Error = PoseTreeEdgeHistory::Error;
+  template <typename T>
+  using Expected = PoseTreeEdgeHistory::Expected<T>;
+  using Unexpected = PoseTreeEdgeHistory::Unexpected;
+  using version_t = PoseTreeEdgeHistory::version_t;
+
+  PoseTreeEdgeTrajectory() = default;
+  PoseTreeEdgeTrajectory(const PoseTreeEdgeTrajectory&) = delete;
+  PoseTreeEdgeTrajectory& operator=(const PoseTreeEdgeTrajectory&) = delete;
+
+  // Allocates space for `maximum_size` poses. `default_access_method` is used when a query is made
+  // with AccessMethod::kDefault.
+  Expected<void> init(int32_t maximum_size, AccessMethod default_access_method) {
+    if (maximum_size <= 0 || default_access_method == AccessMethod::kDefault) {
+      return Unexpected{Error::kInvalidArgument};
+    }
+    const size_t n = static_cast<size_t>(maximum_size);
+    time_.reset(new (std::nothrow) double[n]);
+    valid_.reset(new (std::nothrow) uint8_t[n]);
+    for (auto& array : translation_) {
+      array.reset(new (std::nothrow) double[n]);
+    }
+    for (auto& array : quaternion_) {
+      array.reset(new (std::nothrow) double[n]);
+    }
+    if (time_ == nullptr || valid_ == nullptr ||
+        std::any_of(translation_, translation_ + 3, [](const auto& a) { return a == nullptr; }) ||
+        std::any_of(quaternion_, quaternion_ + 4, [](const auto& a) { return a == nullptr; })) {
+      return Unexpected{Error::kOutOfRange};
+    }
+    maximum_size_ = maximum_size;
+    default_access_method_ = default_access_method;
+    size_ = 0;
+    return {};
+  }
+
+  // Appends a pose. Times must be strictly increasing. If the trajectory is full, the oldest half
+  // of the poses is dropped.
+  Expected<void> set(double time, const ::nvidia::isaac::Pose3d& pose) {
+    const auto maybe_index = reserve(time);
+    if (!maybe_index) {
+      return Unexpected{maybe_index.error()};
+    }
+    const int32_t index = maybe_index.value();
+    const auto& q = pose.rotation.quaternion();
+    translation_[0][index] = pose.translation.x();
+    translation_[1][index] = pose.translation.y();
+    translation_[2][index] = pose.translation.z();
+    quaternion_[0][index] = q.w();
+    quaternion_[1][index] = q.x();
+    quaternion_[2][index] = q.y();
+    quaternion_[3][index] = q.z();
+    valid_[index] = 1;
+    return {};
+  }
+
+  // Marks the edge as disconnected from the given time until the next pose.
+  Expected<void> disconnect(double time) {
+    const auto maybe_index = reserve(time);
+    if (!maybe_index) {
+      return Unexpected{maybe_index.error()};
+    }
+    valid_[maybe_index.value()] = 0;
+    return {};
+  }
+
+  // Replaces the content of this trajectory with the poses of `history` which are visible for the
+  // given version. If the history holds more poses than this trajectory can store, only the latest
+  // ones are kept. This works with a history owned by the caller; PoseTree does not expose the
+  // histories of its edges, so a trajectory following an edge of a PoseTree has to be fed with
+  // `set` and `disconnect` from the same source as the PoseTree.
+  Expected<void> assign(const PoseTreeEdgeHistory& history, version_t version) {
+    reset();
+    const int32_t size = history.size();
+    for (int32_t i = std::max(0, size - maximum_size_); i < size; i++) {
+      const auto maybe_pose = history.at(i);
+      if (!maybe_pose) {
+        return Unexpected{maybe_pose.error()};
+      }
+      const PoseTreeEdgeHistory::TimedPose& timed_pose = maybe_pose.value();
+      if (timed_pose.version > version) {
+        break;
+      }
+      const auto result = timed_pose.valid ? set(timed_pose.time, timed_pose.pose)
+                                           : disconnect(timed_pose.time);
+      if (!result) {
+        return result;
+      }
+    }
+    return {};
+  }
+
+  // Removes all the poses.
+  void reset() { size_ = 0; }
+
+  // Returns the current number of poses.
+  int32_t size() const { return size_; }
+
+  // Returns the maximum number of poses this trajectory can contain.
+  int32_t maximum_size() const { return maximum_size_; }
+
+  // Returns the contiguous array of pose times.
+  const double* times() const { return time_.get(); }
+
+  // Resolves the pose at each of the `count` given times and stores it in `poses`. If any of the
+  // times can't be resolved, the corresponding error is returned and the content of `poses` is
+  // unspecified. Errors are the same as for PoseTreeEdgeHistory::get.
+  Expected<void> get(const double* times, int32_t count, AccessMethod method,
+                     ::nvidia::isaac::Pose3d* poses) const {
+    if (count < 0 || (count > 0 && (times == nullptr || poses == nullptr))) {
+      return Unexpected{Error::kInvalidArgument};
+    }
+    if (method == AccessMethod::kDefault) {
+      method = default_access_method_;
+    }
+    if (size_ == 0 && count > 0) {
+      return Unexpected{Error::kFramesNotLinked};
+    }
+    const bool sorted = std::is_sorted(times, times + count);
+    int32_t cursor = -1;
+    Sample samples[kChunkSize];
+    for (int32_t start = 0; start < count; start += kChunkSize) {
+      const int32_t chunk = std::min(kChunkSize, count - start);
+      for (int32_t k = 0; k < chunk; k++) {
+        const double time = times[start + k];
+        cursor = sorted ? advance(cursor, time) : search(time);
+        const auto result = resolve(cursor, time, method, samples[k]);
+        if (!result) {
+          return result;
+        }
+      }
+      switch (method) {
+        case AccessMethod::kInterpolateSlerp:
+        case AccessMethod::kExtrapolateSlerp:
+          screwKernel(samples, chunk, poses + start);
+          break;
+        default:
+          linearKernel(samples, chunk, poses + start);
+          break;
+      }
+    }
+    return {};
+  }
+
+  // Resolves the pose at a single time.
+  Expected<::nvidia::isaac::Pose3d> get(double time, AccessMethod method) const {
+    ::nvidia::isaac::Pose3d pose;
+    const auto result = get(&time, 1, method, &pose);
+    if (!result) {
+      return Unexpected{result.error()};
+    }
+    return pose;
+  }
+
+ private:
+  // Number of queries resolved together by the interpolation kernels.
+  static constexpr int32_t kChunkSize = 64;
+
+  // A query resolved to a pair of samples: pose = interpolate(index0, index1, alpha).
+  struct Sample {
+    int32_t index0;
+    int32_t index1;
+    double alpha;
+  };
+
+  // Reserves the slot for a new pose at the given time and returns its index.
+  Expected<int32_t> reserve(double time) {
+    if (maximum_size_ == 0) {
+      return Unexpected{Error::kOutOfRange};
+    }
+    if (size_ > 0 && !(time > time_[size_ - 1])) {
+      return Unexpected{Error::kOutOfOrder};
+    }
+    if (size_ == maximum_size_) {
+      // Drop the oldest half at once so that the cost of moving the arrays is amortized.
+      const int32_t drop = std::max(1, maximum_size_ / 2);
+      const int32_t keep = size_ - drop;
+      auto shift = [&](auto* array) {
+        std::memmove(array, array + drop, sizeof(*array) * static_cast<size_t>(keep));
+      };
+      shift(time_.get());
+      shift(valid_.get());
+      for (auto& array : translation_) shift(array.get());
+      for (auto& array : quaternion_) shift(array.get());
+      size_ = keep;
+    }
+    time_[size_] = time;
+    return size_++;
+  }
+
+  // Returns the index of the last pose with a time lower or equal to `time`, or -1 if there is
+  // none, by moving forward from `cursor`, the result of the previous (smaller) query.
+  int32_t advance(int32_t cursor, double time) const {
+    while (cursor + 1 < size_ && time_[cursor + 1] <= time) {
+      cursor++;
+    }
+    return cursor;
+  }
+
+  // Same as advance, using a binary search.
+  int32_t search(double time) const {
+    return static_cast<int32_t>(std::upper_bound(time_.get(), time_.get() + size_, time) -
+                                time_.get()) - 1;
+  }
+
+  // Returns whether a pose exists and is connected.
+  bool valid(int32_t index) const { return index >= 0 && index < size_ && valid_[index] != 0; }
+
+  // Computes the samples and the interpolation factor used for a query at `time`, given the index
+  // of the last pose at or before `time`. Follows PoseTreeEdgeHistory::get: the edge is not linked
+  // before its first pose nor while it is disconnected, and after the last connected pose of a
+  // range the interpolating methods return that pose while the extrapolating methods extrapolate
+  // from the two last poses of the range.
+  Expected<void> resolve(int32_t index, double time, AccessMethod method, Sample& sample) const {
+    if (!valid(index)) {
+      return Unexpected{Error::kFramesNotLinked};
+    }
+    // The closest connected poses at or before and after the query time.
+    const int32_t before = index;
+    const int32_t after = valid(index + 1) ? index + 1 : -1;
+    auto single = [&](int32_t i) -> Expected<void> {
+      sample = Sample{i, i, 0.0};
+      return {};
+    };
+    auto interpolate = [&](int32_t i0, int32_t i1) -> Expected<void> {
+      sample = Sample{i0, i1, (time - time_[i0]) / (time_[i1] - time_[i0])};
+      return {};
+    };
+    if (time_[before] == time) {
+      return single(before);
+    }
+    switch (method) {
+      case AccessMethod::kPrevious:
+        return single(before);
+      case AccessMethod::kNearest:
+        if (after >= 0 && time_[after] - time < time - time_[before]) {
+          return single(after);
+        }
+        return single(before);
+      case AccessMethod::kInterpolateLinearly:
+      case AccessMethod::kInterpolateSlerp:
+        return after >= 0 ? interpolate(before, after) : single(before);
+      case AccessMethod::kExtrapolateLinearly:
+      case AccessMethod::kExtrapolateSlerp:
+        if (after >= 0) {
+          return interpolate(before, after);
+        }
+        if (valid(before - 1)) {
+          return interpolate(before - 1, before);
+        }
+        return Unexpected{Error::kOutOfRange};
+      default:
+        return Unexpected{Error::kInvalidArgument};
+    }
+  }
+
+  // Linear interpolation of the translation and slerp of the rotation, matching
+  // Eigen::Quaternion::slerp.
+  void linearKernel(const Sample* samples, int32_t count, ::nvidia::isaac::Pose3d* poses) const {
+    double t[3][kChunkSize];
+    double q[4][kChunkSize];
+    double w0[kChunkSize];
+    double w1[kChunkSize];
+    for (int32_t axis = 0; axis < 3; axis++) {
+      const double* __restrict__ src = translation_[axis].get();
+      for (int32_t k = 0; k < count; k++) {
+        const double a = src[samples[k].index0];
+        const double b = src[samples[k].index1];
+        t[axis][k] = a + samples[k].alpha * (b - a);
+      }
+    }
+    for (int32_t k = 0; k < count; k++) {
+      const int32_t i0 = samples[k].index0;
+      const int32_t i1 = samples[k].index1;
+      const double dot = quaternion_[0][i0] * quaternion_[0][i1] +
+                         quaternion_[1][i0] * quaternion_[1][i1] +
+                         quaternion_[2][i0] * quaternion_[2][i1] +
+                         quaternion_[3][i0] * quaternion_[3][i1];
+      const double abs_dot = std::abs(dot);
+      const double alpha = samples[k].alpha;
+      if (abs_dot >= 1.0 - std::numeric_limits<double>::epsilon()) {
+        w0[k] = 1.0 - alpha;
+        w1[k] = alpha;
+      } else {
+        const double theta = std::acos(abs_dot);
+        const double sin_theta = std::sin(theta);
+        w0[k] = std::sin((1.0 - alpha) * theta) / sin_theta;
+        w1[k] = std::sin(alpha * theta) / sin_theta;
+      }
+      if (dot < 0.0) {
+        w1[k] = -w1[k];
+      }
+    }
+    for (int32_t c = 0; c < 4; c++) {
+      const double* __restrict__ src = quaternion_[c].get();
+      for (int32_t k = 0; k < count; k++) {
+        q[c][k] = w0[k] * src[samples[k].index0] + w1[k] * src[samples[k].index1];
+      }
+    }
+    for (int32_t k = 0; k < count; k++) {
+      poses[k] = ::nvidia::isaac::Pose3d{
+          ::nvidia::isaac::SO3d::FromQuaternion(
+              ::nvidia::isaac::Quaterniond(q[0][k], q[1][k], q[2][k], q[3][k])),
+          ::nvidia::isaac::Vector3d(t[0][k], t[1][k], t[2][k])};
+    }
+  }
+
+  // Interpolation on SE(3): pose0 * (pose0^-1 * pose1)^alpha.
+  void screwKernel(const Sample* samples, int32_t count, ::nvidia::isaac::Pose3d* poses) const {
+    for (int32_t k = 0; k < count; k++) {
+      const ::nvidia::isaac::Pose3d pose0 = pose(samples[k].index0);
+      if (samples[k].index0 == samples[k].index1) {
+        poses[k] = pose0;
+        continue;
+      }
+      const ::nvidia::isaac::Pose3d pose1 = pose(samples[k].index1);
+      poses[k] = pose0 * (pose0.inverse() * pose1).pow(samples[k].alpha);
+    }
+  }
+
+  // Returns the pose stored at the given index.
+  ::nvidia::isaac::Pose3d pose(int32_t index) const {
+    return ::nvidia::isaac::Pose3d{
+        ::nvidia::isaac::SO3d::FromQuaternion(::nvidia::isaac::Quaterniond(
+            quaternion_[0][index], quaternion_[1][index], quaternion_[2][index],
+            quaternion_[3][index])),
+        ::nvidia::isaac::Vector3d(translation_[0][index], translation_[1][index],
+                                  translation_[2][index])};
+  }
+
+  // Time of each pose, strictly increasing.
+  std::unique_ptr<double[]> time_;
+  // Whether each pose is connected (1) or marks a disconnection (0).
+  std::unique_ptr<uint8_t[]> valid_;
+  // Translation x, y and z of each pose.
+  std::unique_ptr<double[]> translation_[3];
+  // Rotation quaternion w, x, y and z of each pose.
+  std::unique_ptr<double[]> quaternion_[4];
+  // Maximum number of poses.
+  int32_t maximum_size_ = 0;
+  // Current number of poses.
+  int32_t size_ = 0;
+  // Access method used for AccessMethod::kDefault.
+  AccessMethod default_access_method_ = AccessMethod::kInterpolateLinearly;
+};
+
+}  // namespace isaac
+}  // namespace nvidia
@@ -0,0 +1,315 @@
+// SPDX-FileCopyrightText: NVIDIA CORPORATION & AFFILIATES
+// Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>  // NOLINT(build/include_order)
+
+#include "gems/core/math/pose3.hpp"
+#include "gems/pose_tree/pose_tree.hpp"
+
+namespace nvidia {
+namespace isaac {
+
+// A hash index from frame names to frame uids for a PoseTree.
+//
+// PoseTree::findFrame and the name based PoseTree::get go through an ordered map of names, which
+// costs one strcmp per level of the map. This index instead uses a flat open-addressing table with
+// linear probing, keyed on a 64 bits hash of the name which can be precomputed by the caller (see
+// FrameName). The table is allocated once in `init` and never grows, so lookups and insertions do
+// not allocate memory.
+//
+// The index is filled lazily: the first lookup of a name goes through PoseTree::findFrame and the
+// result is remembered together with the generation of the index at that time. The generation is
+// bumped every time a frame is created in the PoseTree (through a create frame callback registered
+// by `attach`) and every time a query through the index fails because a frame no longer exists.
+// A hit with the current generation is returned without calling the PoseTree at all; older hits
+// are validated once with PoseTree::getFrameName. Thus a frame re-created under the same name is
+// picked up on the next lookup, and a deleted frame on the first failed query. Before `attach` is
+// called, every hit is validated. If the table is full, lookups keep working but fall back to
+// PoseTree::findFrame.
+//
+// This class is thread-safe.
+class PoseTreeFrameIndex {
+ public:
+  using frame_t = PoseTree::frame_t;
+  using version_t = PoseTree::version_t;
+
+  // A frame name with its precomputed hash. Frame names used at high rate (for example coming from
+  // parameters) should be converted once to avoid hashing the string on every query.
+  struct FrameName {
+    const char* name;
+    uint64_t hash;
+  };
+
+  // Hashes a null-terminated frame name (64 bits FNV-1a).
+  static constexpr uint64_t Hash(const char* name) {
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (; *name != '\0'; name++) {
+      hash = (hash ^ static_cast<uint8_t>(*name)) * 0x100000001b3ULL;
+    }
+    return hash;
+  }
+
+  // Creates a FrameName from a null-terminated string. The string must outlive the FrameName.
+  static constexpr FrameName MakeFrameName(const char* name) {
+    return FrameName{name, Hash(name)};
+  }
+
+  PoseTreeFrameIndex() = default;
+  PoseTreeFrameIndex(const PoseTreeFrameIndex&) = delete;
+  PoseTreeFrameIndex& operator=(const PoseTreeFrameIndex&) = delete;
+
+  // Allocates space for the given number of frames. This should be the same number of frames the
+  // PoseTree was initialized with. The table is sized to keep the load factor below 0.5.
+  PoseTree::Expected<void> init(int32_t number_frames) {
+    if (number_frames <= 0) {
+      return PoseTree::Unexpected{PoseTree::Error::kInvalidArgument};
+    }
+    std::unique_lock<std::shared_timed_mutex> lock(mutex_);
+    int32_t capacity = 1;
+    while (capacity < 2 * number_frames) {
+      capacity <<= 1;
+    }
+    slots_.reset(new (std::nothrow) Slot[capacity]);
+    if (slots_ == nullptr) {
+      return PoseTree::Unexpected{PoseTree::Error::kOutOfMemory};
+    }
+    for (int32_t i = 0; i < capacity; i++) {
+      slots_[i].occupied = false;
+    }
+    mask_ = static_cast<uint64_t>(capacity) - 1;
+    maximum_size_ = number_frames;
+    size_ = 0;
+    return {};
+  }
+
+  // Registers a create frame callback on the PoseTree under the given component id, so that hits
+  // no longer need to be validated against the PoseTree. `detach` must be called with the same
+  // component id before the index is destroyed.
+  PoseTree::Expected<void> attach(PoseTree& pose_tree, gxf_uid_t cid) {
+    auto result = pose_tree.addCreateFrameCallback(cid, [this](frame_t) {
+      generation_.fetch_add(1, std::memory_order_acq_rel);
+    });
+    if (result) {
+      attached_.store(true, std::memory_order_release);
+    }
+    return result;
+  }
+
+  // Removes the callback registered by `attach`.
+  PoseTree::Expected<void> detach(PoseTree& pose_tree, gxf_uid_t cid) {
+    attached_.store(false, std::memory_order_release);
+    return pose_tree.removeCreateFrameCallback(cid);
+  }
+
+  // Finds the uid of the frame with the given name. Returns Error::kFrameNotFound if no such frame
+  // exists in the PoseTree.
+  PoseTree::Expected<frame_t> find(const PoseTree& pose_tree, const FrameName& name) {
+    if (slots_ == nullptr) {
+      return PoseTree::Unexpected{PoseTree::Error::kLogicError};
+    }
+    // The generation is read before the PoseTree is, so that a frame created concurrently
+    // invalidates the entry written below.
+    const uint64_t generation = attached_.load(std::memory_order_acquire)
+        ? generation_.load(std::memory_order_acquire)
+        : kUnattachedGeneration;
+    {
+      std::shared_lock<std::shared_timed_mutex> lock(mutex_);
+      const Slot* slot = findSlot(name);
+      if (slot != nullptr) {
+        const frame_t uid = slot->uid;
+        if (generation != kUnattachedGeneration && slot->generation == generation) {
+          return uid;
+        }
+        const auto maybe_name = pose_tree.getFrameName(uid);
+        if (maybe_name && std::strcmp(maybe_name.value(), name.name) == 0) {
+          lock.unlock();
+          std::unique_lock<std::shared_timed_mutex> write_lock(mutex_);
+          insert(name, uid, generation);
+          return uid;
+        }
+      }
+    }
+    // Either the name was never queried or the frame it pointed to was deleted.
+    if (std::strlen(name.name) > static_cast<size_t>(PoseTree::kFrameNameMaximumLength)) {
+      return PoseTree::Unexpected{PoseTree::Error::kInvalidArgument};
+    }
+    auto maybe_uid = pose_tree.findFrame(name.name);
+    std::unique_lock<std::shared_timed_mutex> lock(mutex_);
+    if (maybe_uid) {
+      insert(name, maybe_uid.value(), generation);
+    } else {
+      erase(name);
+    }
+    return maybe_uid;
+  }
+
+  // Same as above, but hashes the name.
+  PoseTree::Expected<frame_t> find(const PoseTree& pose_tree, const char* name) {
+    return find(pose_tree, MakeFrameName(name));
+  }
+
+  // Gets the pose lhs_T_rhs between two named frames. See PoseTree::get.
+  PoseTree::Expected<::nvidia::isaac::Pose3d> get(const PoseTree& pose_tree, const FrameName& lhs,
+                                                  const FrameName& rhs, double time,
+                                                  PoseTreeEdgeHistory::AccessMethod method,
+                                                  version_t version) {
+    const auto lhs_uid = find(pose_tree, lhs);
+    if (!lhs_uid) {
+      return PoseTree::Unexpected{lhs_uid.error()};
+    }
+    const auto rhs_uid = find(pose_tree, rhs);
+    if (!rhs_uid) {
+      return PoseTree::Unexpected{rhs_uid.error()};
+    }
+    auto maybe_pose = pose_tree.get(lhs_uid.value(), rhs_uid.value(), time, method, version);
+    if (!maybe_pose && maybe_pose.error() == PoseTree::Error::kFrameNotFound) {
+      // One of the frames was deleted: all the entries are validated again on their next hit.
+      generation_.fetch_add(1, std::memory_order_acq_rel);
+    }
+    return maybe_pose;
+  }
+
+  // Same as above, but using the current version of the PoseTree.
+  PoseTree::Expected<::nvidia::isaac::Pose3d> get(const PoseTree& pose_tree, const FrameName& lhs,
+                                                  const FrameName& rhs, double time,
+                                                  PoseTreeEdgeHistory::AccessMethod method) {
+    return get(pose_tree, lhs, rhs, time, method, pose_tree.getPoseTreeVersion());
+  }
+
+  // Same as above, using the default access method of each edge.
+  PoseTree::Expected<::nvidia::isaac::Pose3d> get(const PoseTree& pose_tree, const FrameName& lhs,
+                                                  const FrameName& rhs, double time) {
+    return get(pose_tree, lhs, rhs, time, PoseTreeEdgeHistory::AccessMethod::kDefault);
+  }
+
+  // Returns the number of names currently stored in the index.
+  int32_t size() const {
+    std::shared_lock<std::shared_timed_mutex> lock(mutex_);
+    return size_;
+  }
+
+ private:
+  // An entry of the open-addressing table.
+  struct Slot {
+    // Hash of the name, stored to skip most of the string comparisons.
+    uint64_t hash;
+    // Uid of the frame.
+    frame_t uid;
+    // Generation of the index when the uid was last checked against the PoseTree.
+    uint64_t generation;
+    // Whether this slot is used.
+    bool occupied;
+    // Copy of the name, null terminated.
+    char name[PoseTree::kFrameNameMaximumLength + 1];
+  };
+
+  // Returns whether a slot holds the given name.
+  static bool matches(const Slot& slot, const FrameName& name) {
+    return slot.hash == name.hash && std::strcmp(slot.name, name.name) == 0;
+  }
+
+  // Returns the slot holding the given name, or nullptr. Requires mutex_ to be locked.
+  const Slot* findSlot(const FrameName& name) const {
+    for (uint64_t index = name.hash & mask_;; index = (index + 1) & mask_) {
+      const Slot& slot = slots_[index];
+      if (!slot.occupied) {
+        return nullptr;
+      }
+      if (matches(slot, name)) {
+        return &slot;
+      }
+    }
+  }
+
+  // Inserts or updates the uid for a given name. Silently drops the name if the index is full, in
+  // which case lookups will keep using PoseTree::findFrame. Requires mutex_ to be locked.
+  void insert(const FrameName& name, frame_t uid, uint64_t generation) {
+    uint64_t index = name.hash & mask_;
+    for (; slots_[index].occupied; index = (index + 1) & mask_) {
+      if (matches(slots_[index], name)) {
+        slots_[index].uid = uid;
+        slots_[index].generation = generation;
+        return;
+      }
+    }
+    if (size_ >= maximum_size_) {
+      return;
+    }
+    Slot& slot = slots_[index];
+    slot.hash = name.hash;
+    slot.uid = uid;
+    slot.generation = generation;
+    std::strncpy(slot.name, name.name, PoseTree::kFrameNameMaximumLength);
+    slot.name[PoseTree::kFrameNameMaximumLength] = '\0';
+    slot.occupied = true;
+    size_++;
+  }
+
+  // Removes a name from the table using backward shift deletion, which keeps the probe sequences
+  // intact without tombstones. Requires mutex_ to be locked.
+  void erase(const FrameName& name) {
+    uint64_t hole = name.hash & mask_;
+    for (;; hole = (hole + 1) & mask_) {
+      if (!slots_[hole].occupied) {
+        return;
+      }
+      if (matches(slots_[hole], name)) {
+        break;
+      }
+    }
+    for (uint64_t index = (hole + 1) & mask_; slots_[index].occupied;
+         index = (index + 1) & mask_) {
+      // An entry can be moved into the hole only if the hole is between its home slot and its
+      // current position.
+      const uint64_t home = slots_[index].hash & mask_;
+      if (((index - home) & mask_) >= ((index - hole) & mask_)) {
+        slots_[hole] = slots_[index];
+        hole = index;
+      }
+    }
+    slots_[hole].occupied = false;
+    size_--;
+  }
+
+  // Generation used for the entries while the index is not attached to a PoseTree. The generation
+  // of the index never reaches it, so those entries are always validated.
+  static constexpr uint64_t kUnattachedGeneration = ~uint64_t{0};
+
+  // Protects the table.
+  mutable std::shared_timed_mutex mutex_;
+  // Generation of the index, see the class comment.
+  std::atomic<uint64_t> generation_{0};
+  // Whether the create frame callback is registered.
+  std::atomic<bool> attached_{false};
+  // Open-addressing table. Its size is a power of two.
+  std::unique_ptr<Slot[]> slots_;
+  // Size of the table minus one.
+  uint64_t mask_ = 0;
+  // Maximum number of names stored in the table.
+  int32_t maximum_size_ = 0;
+  // Current number of names stored in the table.
+  int32_t size_ = 0;
+};
+
+}  // namespace isaac
+}  // namespace nvidia
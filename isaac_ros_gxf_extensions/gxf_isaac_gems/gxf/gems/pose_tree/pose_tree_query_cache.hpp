@@ -0,0 +1,224 @@
+// SPDX-FileCopyrightText: NVIDIA CORPORATION & AFFILIATES
+// Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+
+#include "gems/core/math/pose3.hpp"
+#include "gems/pose_tree/pose_tree.hpp"
+
+namespace nvidia {
+namespace isaac {
+
+// A memoization cache in front of PoseTree::get.
+//
+// Entries are keyed on (lhs, rhs, access method, time bucket, PoseTree version). Queries made
+// without an explicit version are resolved against the current version of the PoseTree, so any
+// call to PoseTree::set (or any other operation that bumps the version) implicitly invalidates all
+// the entries computed before it.
+//
+// With a time bucket of 0 only queries made at exactly the same time share an entry. With a
+// positive time bucket, all the queries whose time fall in the same bucket of that duration return
+// the pose computed for the first of them; this trades accuracy for hit ratio and should only be
+// used with a bucket much smaller than the motion of the frames involved.
+//
+// The cache is a fixed size direct-mapped table allocated once in `init`: a new entry evicts the
+// entry with the same slot. It is thread-safe.
+class PoseTreeQueryCache {
+ public:
+  using frame_t = PoseTree::frame_t;
+  using version_t = PoseTree::version_t;
+
+  // Statistics about the usage of the cache.
+  struct Stats {
+    // Number of queries answered from the cache.
+    uint64_t hits;
+    // Number of queries forwarded to the PoseTree.
+    uint64_t misses;
+
+    // Returns the fraction of queries answered from the cache, or 0 if no query was made.
+    double hitRatio() const {
+      const uint64_t total = hits + misses;
+      return total == 0 ? 0.0 : static_cast<double>(hits) / static_cast<double>(total);
+    }
+  };
+
+  PoseTreeQueryCache() = default;
+  PoseTreeQueryCache(const PoseTreeQueryCache&) = delete;
+  PoseTreeQueryCache& operator=(const PoseTreeQueryCache&) = delete;
+
+  // Allocates space for `capacity` entries (rounded up to a power of two). `time_bucket` is the
+  // duration of a time bucket in seconds; 0 means that queries are only matched at the exact same
+  // time.
+  PoseTree::Expected<void> init(int32_t capacity, double time_bucket) {
+    if (capacity <= 0 || !(time_bucket >= 0.0)) {
+      return PoseTree::Unexpected{PoseTree::Error::kInvalidArgument};
+    }
+    std::unique_lock<std::mutex> lock(mutex_);
+    int32_t size = 1;
+    while (size < capacity) {
+      size <<= 1;
+    }
+    entries_.reset(new (std::nothrow) Entry[size]);
+    if (entries_ == nullptr) {
+      return PoseTree::Unexpected{PoseTree::Error::kOutOfMemory};
+    }
+    mask_ = static_cast<uint64_t>(size) - 1;
+    time_bucket_ = time_bucket;
+    clearImpl();
+    return {};
+  }
+
+  // Returns lhs_T_rhs at the given time and version, from the cache if possible.
+  PoseTree::Expected<::nvidia::isaac::Pose3d> get(const PoseTree& pose_tree, frame_t lhs,
+                                                  frame_t rhs, double time,
+                                                  PoseTreeEdgeHistory::AccessMethod method,
+                                                  version_t version) {
+    if (entries_ == nullptr) {
+      return PoseTree::Unexpected{PoseTree::Error::kLogicError};
+    }
+    const Key key{lhs, rhs, version, bucket(time), method};
+    const uint64_t slot = hash(key) & mask_;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      const Entry& entry = entries_[slot];
+      if (entry.valid && entry.key == key) {
+        stats_.hits++;
+        return entry.lhs_T_rhs;
+      }
+      stats_.misses++;
+    }
+    // The PoseTree is queried without holding the lock so that a slow query does not block
+    // concurrent hits.
+    auto maybe_pose = pose_tree.get(lhs, rhs, time, method, version);
+    if (maybe_pose) {
+      std::unique_lock<std::mutex> lock(mutex_);
+      Entry& entry = entries_[slot];
+      entry.key = key;
+      entry.lhs_T_rhs = maybe_pose.value();
+      entry.valid = true;
+    }
+    return maybe_pose;
+  }
+
+  // Same as above, but using the current version of the PoseTree.
+  PoseTree::Expected<::nvidia::isaac::Pose3d> get(const PoseTree& pose_tree, frame_t lhs,
+                                                  frame_t rhs, double time,
+                                                  PoseTreeEdgeHistory::AccessMethod method) {
+    return get(pose_tree, lhs, rhs, time, method, pose_tree.getPoseTreeVersion());
+  }
+
+  // Same as above, using the default access method of each edge.
+  PoseTree::Expected<::nvidia::isaac::Pose3d> get(const PoseTree& pose_tree, frame_t lhs,
+                                                  frame_t rhs, double time) {
+    return get(pose_tree, lhs, rhs, time, PoseTreeEdgeHistory::AccessMethod::kDefault);
+  }
+
+  // Returns the statistics accumulated since the last call to `init`, `clear` or `resetStats`.
+  Stats stats() const {
+    std::unique_lock<std::mutex> lock(mutex_);
+    return stats_;
+  }
+
+  // Resets the hit and miss counters.
+  void resetStats() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    stats_ = Stats{0, 0};
+  }
+
+  // Drops all the cached entries and resets the statistics.
+  void clear() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    clearImpl();
+  }
+
+ private:
+  // Key identifying a query.
+  struct Key {
+    frame_t lhs;
+    frame_t rhs;
+    version_t version;
+    int64_t bucket;
+    PoseTreeEdgeHistory::AccessMethod method;
+
+    bool operator==(const Key& other) const {
+      return lhs == other.lhs && rhs == other.rhs && version == other.version &&
+             bucket == other.bucket && method == other.method;
+    }
+  };
+
+  // A slot of the direct-mapped table.
+  struct Entry {
+    Key key;
+    ::nvidia::isaac::Pose3d lhs_T_rhs;
+    bool valid = false;
+  };
+
+  // Returns the bucket a given time falls in. If no bucket duration is used, the bit pattern of the
+  // time is used so that only identical times match.
+  int64_t bucket(double time) const {
+    if (time_bucket_ > 0.0) {
+      return static_cast<int64_t>(std::floor(time / time_bucket_));
+    }
+    int64_t bits;
+    std::memcpy(&bits, &time, sizeof(bits));
+    return bits;
+  }
+
+  // Mixes all the fields of the key (splitmix64 finalizer).
+  static uint64_t hash(const Key& key) {
+    auto mix = [](uint64_t x) {
+      x ^= x >> 30;
+      x *= 0xbf58476d1ce4e5b9ULL;
+      x ^= x >> 27;
+      x *= 0x94d049bb133111ebULL;
+      x ^= x >> 31;
+      return x;
+    };
+    uint64_t h = mix(key.lhs);
+    h = mix(h ^ key.rhs);
+    h = mix(h ^ key.version);
+    h = mix(h ^ static_cast<uint64_t>(key.bucket));
+    return mix(h ^ static_cast<uint64_t>(key.method));
+  }
+
+  // Implementation of clear, requires mutex_ to be locked.
+  void clearImpl() {
+    for (uint64_t i = 0; entries_ != nullptr && i <= mask_; i++) {
+      entries_[i].valid = false;
+    }
+    stats_ = Stats{0, 0};
+  }
+
+  // Protects the entries and the statistics.
+  mutable std::mutex mutex_;
+  // Direct-mapped table of cached poses.
+  std::unique_ptr<Entry[]> entries_;
+  // Number of entries minus one. The number of entries is a power of two.
+  uint64_t mask_ = 0;
+  // Duration of a time bucket in seconds.
+  double time_bucket_ = 0.0;
+  // Usage statistics.
+  Stats stats_{0, 0};
+};
+
+}  // namespace isaac
+}  // namespace nvidia
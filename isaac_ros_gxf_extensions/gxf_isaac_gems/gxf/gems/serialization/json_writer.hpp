@@ -0,0 +1,333 @@
+// SPDX-FileCopyrightText: NVIDIA CORPORATION & AFFILIATES
+// Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "gems/core/assert.hpp"
+#include "gems/core/math/types.hpp"
+#include "gems/serialization/json.hpp"
+
+namespace nvidia {
+namespace isaac {
+namespace serialization {
+
+// Writes JSON text directly into a buffer, without building a Json object first.
+//
+// Values are written in order with begin/end calls for objects and arrays, and `key` calls for
+// the members of objects:
+//
+//   JsonWriter writer;
+//   writer.beginObject().key("name").value("cloud").key("points").array(points, 3 * count);
+//   writer.endObject();
+//   send(writer.str());
+//
+// The buffer is kept by `clear`, so a writer which is reused for every message stops allocating
+// once its buffer is large enough. Numbers are formatted with std::to_chars, which gives the
+// shortest text which reads back as the same value. Floats are written with float precision, and
+// NaN and infinite values are written as null, as Json::dump does.
+class JsonWriter {
+ public:
+  JsonWriter() = default;
+
+  // Pre-allocates the buffer for the given number of characters
+  void reserve(size_t size) { buffer_.reserve(size); }
+
+  // Starts a new document. The memory of the buffer is kept.
+  void clear() {
+    buffer_.clear();
+    scopes_.clear();
+    has_elements_ = false;
+    after_key_ = false;
+  }
+
+  // The text written so far
+  const std::string& str() const { return buffer_; }
+  // Exchanges the text with the given string, for example to hand it over without a copy. The
+  // writer continues with the previous content of `other` as buffer, which should be cleared.
+  void swap(std::string& other) { buffer_.swap(other); }
+
+  // True if all objects and arrays were closed
+  bool complete() const { return scopes_.empty() && !after_key_; }
+
+  JsonWriter& beginObject() { return open('{', kObject); }
+  JsonWriter& endObject() { return close('}', kObject); }
+  JsonWriter& beginArray() { return open('[', kArray); }
+  JsonWriter& endArray() { return close(']', kArray); }
+
+  // Writes the key of the next member of the current object
+  JsonWriter& key(std::string_view name) {
+    ASSERT(!scopes_.empty() && scopes_.back() == kObject && !after_key_,
+           "A key can only be written in an object, before its value");
+    comma();
+    appendString(name);
+    buffer_.push_back(':');
+    after_key_ = true;
+    return *this;
+  }
+
+  JsonWriter& null() {
+    separate();
+    buffer_.append("null");
+    return *this;
+  }
+  JsonWriter& value(bool value) {
+    separate();
+    buffer_.append(value ? "true" : "false");
+    return *this;
+  }
+  JsonWriter& value(std::string_view value) {
+    separate();
+    appendString(value);
+    return *this;
+  }
+  JsonWriter& value(const char* value) { return this->value(std::string_view(value)); }
+  JsonWriter& value(const std::string& value) { return this->value(std::string_view(value)); }
+  template <typename T, std::enable_if_t<std::is_arithmetic_v<T> && !std::is_same_v<T, bool>,
+                                         int> = 0>
+  JsonWriter& value(T value) {
+    separate();
+    appendNumber(value);
+    return *this;
+  }
+
+  // Writes a Json object member by member, without dumping it to an intermediate string
+  JsonWriter& value(const Json& json) {
+    switch (json.type()) {
+      case Json::value_t::object:
+        beginObject();
+        for (auto it = json.begin(); it != json.end(); ++it) {
+          key(it.key());
+          value(it.value());
+        }
+        return endObject();
+      case Json::value_t::array:
+        beginArray();
+        for (const auto& element : json) {
+          value(element);
+        }
+        return endArray();
+      case Json::value_t::string:
+        return value(json.get_ref<const std::string&>());
+      case Json::value_t::boolean:
+        return value(json.get<bool>());
+      case Json::value_t::number_integer:
+        return value(json.get<int64_t>());
+      case Json::value_t::number_unsigned:
+        return value(json.get<uint64_t>());
+      case Json::value_t::number_float:
+        return value(json.get<double>());
+      case Json::value_t::binary:
+        separate();
+        buffer_.append(json.dump());
+        return *this;
+      default:
+        return null();
+    }
+  }
+
+  // Writes vectors and containers as arrays
+  template <typename K, int N>
+  JsonWriter& value(const Vector<K, N>& vector) {
+    return array(vector.data(), static_cast<size_t>(vector.size()));
+  }
+  template <typename T>
+  JsonWriter& value(const std::vector<T>& values) {
+    if constexpr (std::is_arithmetic_v<T> && !std::is_same_v<T, bool>) {
+      return array(values.data(), values.size());
+    } else {
+      beginArray();
+      for (const auto& element : values) {
+        value(element);
+      }
+      return endArray();
+    }
+  }
+  template <typename T, size_t N>
+  JsonWriter& value(const std::array<T, N>& values) {
+    beginArray();
+    for (const auto& element : values) {
+      value(element);
+    }
+    return endArray();
+  }
+  template <typename T1, typename T2>
+  JsonWriter& value(const std::pair<T1, T2>& pair) {
+    return beginArray().value(pair.first).value(pair.second).endArray();
+  }
+  template <typename T>
+  JsonWriter& value(const std::map<std::string, T>& map) {
+    beginObject();
+    for (const auto& kvp : map) {
+      key(kvp.first).value(kvp.second);
+    }
+    return endObject();
+  }
+
+  // Writes `count` numbers as an array
+  template <typename K>
+  JsonWriter& array(const K* data, size_t count) {
+    static_assert(std::is_arithmetic_v<K> && !std::is_same_v<K, bool>, "Numbers expected");
+    separate();
+    buffer_.push_back('[');
+    for (size_t i = 0; i < count; i++) {
+      if (i > 0) {
+        buffer_.push_back(',');
+      }
+      appendNumber(data[i]);
+    }
+    buffer_.push_back(']');
+    return *this;
+  }
+
+  // Writes `rows` x `cols` numbers stored row after row as an array of arrays, for example
+  // the coordinates of points as [[x0,y0,z0],[x1,y1,z1],...]
+  template <typename K>
+  JsonWriter& array(const K* data, size_t rows, size_t cols) {
+    static_assert(std::is_arithmetic_v<K> && !std::is_same_v<K, bool>, "Numbers expected");
+    separate();
+    buffer_.push_back('[');
+    for (size_t row = 0; row < rows; row++) {
+      if (row > 0) {
+        buffer_.push_back(',');
+      }
+      buffer_.push_back('[');
+      for (size_t col = 0; col < cols; col++) {
+        if (col > 0) {
+          buffer_.push_back(',');
+        }
+        appendNumber(data[row * cols + col]);
+      }
+      buffer_.push_back(']');
+    }
+    buffer_.push_back(']');
+    return *this;
+  }
+
+ private:
+  // Kind of the objects and arrays which are open
+  enum Scope : uint8_t { kObject, kArray };
+
+  JsonWriter& open(char bracket, Scope scope) {
+    separate();
+    buffer_.push_back(bracket);
+    scopes_.push_back(scope);
+    has_elements_ = false;
+    return *this;
+  }
+
+  JsonWriter& close(char bracket, Scope scope) {
+    ASSERT(!scopes_.empty() && scopes_.back() == scope && !after_key_,
+           "Mismatched end of object or array");
+    buffer_.push_back(bracket);
+    scopes_.pop_back();
+    // The closed object or array is an element of its parent
+    has_elements_ = true;
+    return *this;
+  }
+
+  // Writes a comma if the innermost object or array already has an element
+  void comma() {
+    if (has_elements_) {
+      buffer_.push_back(',');
+    }
+    has_elements_ = true;
+  }
+
+  // Prepares writing a value
+  void separate() {
+    if (after_key_) {
+      after_key_ = false;
+      return;
+    }
+    if (!scopes_.empty()) {
+      ASSERT(scopes_.back() == kArray, "Members of an object need a key");
+      comma();
+    }
+  }
+
+  template <typename T>
+  void appendNumber(T value) {
+    char text[32];
+    if constexpr (std::is_floating_point_v<T>) {
+      if (!std::isfinite(value)) {
+        buffer_.append("null");
+        return;
+      }
+      const auto result = std::to_chars(text, text + sizeof(text), value);
+      const std::string_view view(text, result.ptr - text);
+      buffer_.append(view);
+      // Keep the value a floating point number when reading it back, as Json::dump does
+      if (view.find_first_of(".e") == std::string_view::npos) {
+        buffer_.append(".0");
+      }
+    } else {
+      const auto result = std::to_chars(text, text + sizeof(text), value);
+      buffer_.append(text, result.ptr - text);
+    }
+  }
+
+  void appendString(std::string_view text) {
+    static constexpr char kHex[] = "0123456789abcdef";
+    buffer_.push_back('"');
+    size_t begin = 0;
+    for (size_t i = 0; i < text.size(); i++) {
+      const unsigned char c = static_cast<unsigned char>(text[i]);
+      if (c >= 0x20 && c != '"' && c != '\\') {
+        continue;
+      }
+      buffer_.append(text.data() + begin, i - begin);
+      begin = i + 1;
+      switch (c) {
+        case '"': buffer_.append("\\\""); break;
+        case '\\': buffer_.append("\\\\"); break;
+        case '\b': buffer_.append("\\b"); break;
+        case '\f': buffer_.append("\\f"); break;
+        case '\n': buffer_.append("\\n"); break;
+        case '\r': buffer_.append("\\r"); break;
+        case '\t': buffer_.append("\\t"); break;
+        default: {
+          const char escaped[] = {'\\', 'u', '0', '0', kHex[c >> 4], kHex[c & 0xf]};
+          buffer_.append(escaped, sizeof(escaped));
+        }
+      }
+    }
+    buffer_.append(text.data() + begin, text.size() - begin);
+    buffer_.push_back('"');
+  }
+
+  std::string buffer_;
+  // Objects and arrays which are open, innermost last
+  std::vector<Scope> scopes_;
+  // True if the innermost object or array already has an element
+  bool has_elements_ = false;
+  // True if a key was written and its value was not
+  bool after_key_ = false;
+};
+
+}  // namespace serialization
+}  // namespace isaac
+}  // namespace nvidia
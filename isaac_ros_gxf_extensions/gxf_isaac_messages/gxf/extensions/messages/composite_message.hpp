@@ -97,6 +97,24 @@ gxf::Expected<Composite> ExtractComposite(
       current_schema, desired_schema);
 }
 
+// Same as above, but the copy plan is kept in `plan_cache`, which avoids recomputing the index map
+// for every message. Codelets extracting composites from every message should own a cache.
+template <typename Composite>
+gxf::Expected<Composite> ExtractComposite(
+    const CompositeMessageParts& message_parts, const CompositeSchemaServer& schema_server,
+    const composite::Schema& desired_schema, CompositeCopyPlanCache& plan_cache, int slice = 0) {
+  // Retrieve the schema of the composite message from the schema server.
+  const auto maybe_schema = schema_server.get(message_parts.composite_schema_uid->uid);
+  if (!maybe_schema) {
+    GXF_LOG_ERROR("Failed to get schema from schema server.");
+    return gxf::Unexpected(maybe_schema.error());
+  }
+  const composite::Schema& current_schema = maybe_schema.value();
+
+  return CompositeFromTensor<Composite>(message_parts.view.const_slice(slice),
+      current_schema, desired_schema, plan_cache);
+}
+
 // Convenience wrapper around function above. Allows to directly pass a gxf::Entity instead of a
 // CompositeMessageParts.
 template <typename Composite>
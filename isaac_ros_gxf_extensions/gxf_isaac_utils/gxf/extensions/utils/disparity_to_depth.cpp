@@ -21,6 +21,7 @@
 
 #include "extensions/messages/camera_message.hpp"
 #include "extensions/utils/disparity_to_depth.cu.hpp"
+#include "extensions/utils/disparity_to_depth_cpu.hpp"
 #include "gems/gxf_helpers/expected_macro_gxf.hpp"
 
 namespace nvidia {
@@ -38,6 +39,10 @@ gxf_result_t DisparityToDepth::registerInterface(gxf::Registrar* registrar) {
   result &= registrar->parameter(
       allocator_, "allocator", "Allocator",
       "Allocator to allocate output messages");
+  result &= registrar->parameter(
+      num_threads_, "num_threads", "Number of threads",
+      "Maximum number of threads used to convert disparities in host or system memory. "
+      "0 uses one thread per hardware thread.", 0);
 
   return gxf::ToResultCode(result);
 }
@@ -59,9 +64,12 @@ gxf_result_t DisparityToDepth::tick() {
   gxf::VideoBufferInfo disparity_info = disparity_message.frame->video_frame_info();
 
   // validate input message
-  if (disparity_message.frame->storage_type() != gxf::MemoryStorageType::kDevice) {
+  const gxf::MemoryStorageType storage_type = disparity_message.frame->storage_type();
+  if (storage_type != gxf::MemoryStorageType::kDevice &&
+      storage_type != gxf::MemoryStorageType::kHost &&
+      storage_type != gxf::MemoryStorageType::kSystem) {
     GXF_LOG_ERROR("Input disparity image must be stored in "
-                  "gxf::MemoryStorageType::kDevice");
+                  "gxf::MemoryStorageType::kDevice, kHost or kSystem");
     return GXF_INVALID_DATA_FORMAT;
   }
 
@@ -77,7 +85,7 @@ gxf_result_t DisparityToDepth::tick() {
         disparity_info.width,
         disparity_info.height,
         disparity_info.surface_layout,
-        gxf::MemoryStorageType::kDevice,
+        storage_type,
         allocator_,
         false));  // TODO(kpatzwaldt): change to true and adjust kernel accordingly
 
@@ -90,11 +98,19 @@ gxf_result_t DisparityToDepth::tick() {
                                                 translation.begin(),
                                                 0.0L));
 
-  // call CUDA kernel and wait for completion
-  disparity_to_depth_cuda(
-      reinterpret_cast<const float *>(disparity_message.frame->pointer()),
-      reinterpret_cast<float *>(depth_message.frame->pointer()),
-      baseline, focal_length, disparity_info.height, disparity_info.width);
+  if (storage_type == gxf::MemoryStorageType::kDevice) {
+    // call CUDA kernel and wait for completion
+    disparity_to_depth_cuda(
+        reinterpret_cast<const float *>(disparity_message.frame->pointer()),
+        reinterpret_cast<float *>(depth_message.frame->pointer()),
+        baseline, focal_length, disparity_info.height, disparity_info.width);
+  } else {
+    disparity_to_depth_cpu(
+        reinterpret_cast<const float *>(disparity_message.frame->pointer()),
+        disparity_info.color_planes[0].stride,
+        reinterpret_cast<float *>(depth_message.frame->pointer()),
+        baseline, focal_length, disparity_info.height, disparity_info.width, num_threads_);
+  }
 
   // forward other components as is
   *depth_message.intrinsics = *disparity_message.intrinsics;
@@ -27,7 +27,9 @@ namespace isaac {
 // Disparity to depth converter
 //
 // This codelet consumes a CameraMessage, and converts the disparity
-// in the VideoBuffer into a depth map
+// in the VideoBuffer into a depth map. Disparities in device memory are
+// converted with CUDA, disparities in host or system memory on the CPU.
+// The depth map is stored in the same kind of memory as the disparity.
 class DisparityToDepth : public gxf::Codelet {
  public:
   gxf_result_t registerInterface(gxf::Registrar* registrar) override;
@@ -40,6 +42,7 @@ class DisparityToDepth : public gxf::Codelet {
   gxf::Parameter<gxf::Handle<gxf::Receiver>> disparity_input_;
   gxf::Parameter<gxf::Handle<gxf::Transmitter>> depth_output_;
   gxf::Parameter<gxf::Handle<gxf::Allocator>> allocator_;
+  gxf::Parameter<int32_t> num_threads_;
 };
 
 }  // namespace isaac
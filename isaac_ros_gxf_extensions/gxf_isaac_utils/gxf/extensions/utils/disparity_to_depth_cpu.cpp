@@ -0,0 +1,108 @@
+// SPDX-FileCopyrightText: NVIDIA CORPORATION & AFFILIATES
+// Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "extensions/utils/disparity_to_depth_cpu.hpp"
+
+#include <cstdint>
+
+#include "gems/image/vectorized_utils.hpp"
+
+namespace nvidia {
+namespace isaac {
+
+namespace {
+
+// Same operations as disparity_to_depth_kernel, one pixel at a time
+void DisparityToDepthRowScalar(
+    const float * input, float * output, float baseline, float focal_length, int count) {
+  for (int x = 0; x < count; x++) {
+    if (input[x] > 0) {
+      output[x] = (baseline * focal_length) / input[x];
+    } else {
+      output[x] = 0;
+    }
+  }
+}
+
+#if defined(ISAAC_IMAGE_HAS_AVX2)
+__attribute__((target("avx2")))
+void DisparityToDepthRowAvx2(
+    const float * input, float * output, float baseline, float focal_length, int count) {
+  const __m256 numerator = _mm256_set1_ps(baseline * focal_length);
+  const __m256 zero = _mm256_setzero_ps();
+  int x = 0;
+  for (; x + 8 <= count; x += 8) {
+    const __m256 disparity = _mm256_loadu_ps(input + x);
+    // Ordered comparison, so that NaN disparities are invalid as in the scalar code
+    const __m256 valid = _mm256_cmp_ps(disparity, zero, _CMP_GT_OQ);
+    _mm256_storeu_ps(output + x, _mm256_and_ps(valid, _mm256_div_ps(numerator, disparity)));
+  }
+  DisparityToDepthRowScalar(input + x, output + x, baseline, focal_length, count - x);
+}
+#endif  // ISAAC_IMAGE_HAS_AVX2
+
+#if defined(ISAAC_IMAGE_HAS_NEON)
+void DisparityToDepthRowNeon(
+    const float * input, float * output, float baseline, float focal_length, int count) {
+  const float32x4_t numerator = vdupq_n_f32(baseline * focal_length);
+  const float32x4_t zero = vdupq_n_f32(0.0f);
+  int x = 0;
+  for (; x + 4 <= count; x += 4) {
+    const float32x4_t disparity = vld1q_f32(input + x);
+    const uint32x4_t valid = vcgtq_f32(disparity, zero);
+    const float32x4_t depth = vdivq_f32(numerator, disparity);
+    vst1q_f32(output + x, vreinterpretq_f32_u32(vandq_u32(valid, vreinterpretq_u32_f32(depth))));
+  }
+  DisparityToDepthRowScalar(input + x, output + x, baseline, focal_length, count - x);
+}
+#endif  // ISAAC_IMAGE_HAS_NEON
+
+}  // namespace
+
+void disparity_to_depth_cpu(
+    const float * input, size_t input_stride, float * output, float baseline,
+    float focal_length, int image_height, int image_width, int num_threads)
+{
+  CpuExecution execution;
+  execution.num_threads = num_threads;
+  const SimdBackend backend = vectorized_details::Resolve(execution.backend);
+  const int tasks = vectorized_details::CountTasks(image_height, image_width, execution);
+  vectorized_details::ParallelForRows(tasks, image_height, [&](int, int begin, int end) {
+    for (int y = begin; y < end; y++) {
+      const float * input_row = reinterpret_cast<const float *>(
+          reinterpret_cast<const uint8_t *>(input) + y * input_stride);
+      float * output_row = output + static_cast<size_t>(y) * image_width;
+#if defined(ISAAC_IMAGE_HAS_AVX2)
+      if (backend == SimdBackend::kAvx2) {
+        DisparityToDepthRowAvx2(input_row, output_row, baseline, focal_length, image_width);
+        continue;
+      }
+#endif
+#if defined(ISAAC_IMAGE_HAS_NEON)
+      if (backend == SimdBackend::kNeon) {
+        DisparityToDepthRowNeon(input_row, output_row, baseline, focal_length, image_width);
+        continue;
+      }
+#endif
+      DisparityToDepthRowScalar(input_row, output_row, baseline, focal_length, image_width);
+    }
+  });
+  (void)backend;
+}
+
+}  // namespace isaac
+}  // namespace nvidia
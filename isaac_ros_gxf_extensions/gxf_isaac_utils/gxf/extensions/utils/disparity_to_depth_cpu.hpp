@@ -0,0 +1,34 @@
+// SPDX-FileCopyrightText: NVIDIA CORPORATION & AFFILIATES
+// Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <cstddef>
+
+namespace nvidia {
+namespace isaac {
+
+// Host memory counterpart of disparity_to_depth_cuda. Produces the same depth values: pixels with
+// a positive disparity get `baseline * focal_length / disparity`, all others are set to 0.
+// Rows of the input are `input_stride` bytes apart, the output is dense. Rows are split between
+// up to `num_threads` threads (0 for one per hardware thread).
+void disparity_to_depth_cpu(
+    const float * input, size_t input_stride, float * output, float baseline,
+    float focal_length, int image_height, int image_width, int num_threads);
+
+}  // namespace isaac
+}  // namespace nvidia
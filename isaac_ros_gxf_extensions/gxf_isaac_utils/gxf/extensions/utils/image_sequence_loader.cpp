@@ -0,0 +1,480 @@
+// SPDX-FileCopyrightText: NVIDIA CORPORATION & AFFILIATES
+// Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+#include "extensions/utils/image_sequence_loader.hpp"
+
+#include <fcntl.h>
+#include <glob.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <utility>
+
+#include "gems/algorithm/string_utils.hpp"
+#include "gems/core/image/image.hpp"
+#include "gems/image/io.hpp"
+#include "gems/video_buffer/allocator.hpp"
+
+namespace nvidia {
+namespace isaac {
+
+namespace {
+
+// Extension of files which are memory mapped instead of decoded
+constexpr char kRawExtension[] = ".raw";
+
+// Time to wait before trying again when the allocator is exhausted
+constexpr std::chrono::milliseconds kAllocationRetryPeriod{1};
+
+// Returns the current time of the steady clock in nanoseconds
+int64_t Now() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Returns the directory part of a path, including the trailing separator
+std::string DirectoryOf(const std::string& path) {
+  const size_t separator = path.find_last_of('/');
+  return separator == std::string::npos ? std::string() : path.substr(0, separator + 1);
+}
+
+// Builds the buffer info of a frame without padding between rows
+template <gxf::VideoFormat C>
+gxf::VideoBufferInfo FrameInfo(uint32_t rows, uint32_t columns) {
+  NoPaddingColorPlanes<C> color_planes(columns);
+  return gxf::VideoBufferInfo{
+      columns, rows, C,
+      std::vector<gxf::ColorPlane>(color_planes.planes.begin(), color_planes.planes.end()),
+      gxf::SurfaceLayout::GXF_SURFACE_LAYOUT_PITCH_LINEAR};
+}
+
+}  // namespace
+
+gxf_result_t ImageSequenceLoader::registerInterface(gxf::Registrar* registrar) {
+  if (registrar == nullptr) {
+    return GXF_ARGUMENT_NULL;
+  }
+  gxf::Expected<void> result;
+  result &= registrar->parameter(
+      transmitter_, "transmitter", "Transmitter",
+      "Transmitter to publish the video buffers");
+  result &= registrar->parameter(
+      allocator_, "allocator", "Allocator",
+      "Allocator for decoded frames. A BlockMemoryPool avoids allocations while streaming.");
+  result &= registrar->parameter(
+      file_pattern_, "file_pattern", "File Pattern",
+      "Glob pattern matching the image files. Files are published in lexicographic order.",
+      gxf::Registrar::NoDefaultParameter(), GXF_PARAMETER_FLAGS_OPTIONAL);
+  result &= registrar->parameter(
+      index_file_, "index_file", "Index File",
+      "File listing one image file per line. Relative paths are relative to the index file.",
+      gxf::Registrar::NoDefaultParameter(), GXF_PARAMETER_FLAGS_OPTIONAL);
+  result &= registrar->parameter(
+      color_, "color", "Color",
+      "Whether images are loaded as RGB or as grayscale. False by default.", false);
+  result &= registrar->parameter(
+      raw_rows_, "raw_rows", "Raw Rows",
+      "Number of rows of the images in raw files",
+      gxf::Registrar::NoDefaultParameter(), GXF_PARAMETER_FLAGS_OPTIONAL);
+  result &= registrar->parameter(
+      raw_columns_, "raw_columns", "Raw Columns",
+      "Number of columns of the images in raw files",
+      gxf::Registrar::NoDefaultParameter(), GXF_PARAMETER_FLAGS_OPTIONAL);
+  result &= registrar->parameter(
+      num_threads_, "num_threads", "Number of Threads",
+      "Number of threads decoding frames in the background", 2UL);
+  result &= registrar->parameter(
+      prefetch_size_, "prefetch_size", "Prefetch Size",
+      "Maximum number of frames decoded ahead of the published one", 8UL);
+  result &= registrar->parameter(
+      loop_, "loop", "Loop",
+      "Whether to start over at the end of the sequence", false);
+  result &= registrar->parameter(
+      frame_rate_, "frame_rate", "Frame Rate",
+      "Maximum number of frames published per second. 0 publishes frames as fast as possible.",
+      0.0);
+  result &= registrar->parameter(
+      boolean_scheduling_term_, "boolean_scheduling_term", "Boolean Scheduling Term",
+      "Used to stop ticking at the end of the sequence",
+      gxf::Registrar::NoDefaultParameter(), GXF_PARAMETER_FLAGS_OPTIONAL);
+  result &= registrar->parameter(
+      frame_rate_metric_, "frame_rate_metric", "Frame Rate Metric",
+      "Records the achieved frame rate in frames per second, once per published frame",
+      gxf::Registrar::NoDefaultParameter(), GXF_PARAMETER_FLAGS_OPTIONAL);
+  result &= registrar->parameter(
+      decode_latency_metric_, "decode_latency_metric", "Decode Latency Metric",
+      "Records the time spent loading every published frame in milliseconds",
+      gxf::Registrar::NoDefaultParameter(), GXF_PARAMETER_FLAGS_OPTIONAL);
+  return gxf::ToResultCode(result);
+}
+
+gxf_result_t ImageSequenceLoader::initialize() {
+  if (num_threads_ == 0 || prefetch_size_ == 0) {
+    GXF_LOG_ERROR("num_threads and prefetch_size must be greater than 0");
+    return GXF_PARAMETER_OUT_OF_RANGE;
+  }
+  if (frame_rate_ < 0.0) {
+    GXF_LOG_ERROR("frame_rate must not be negative");
+    return GXF_PARAMETER_OUT_OF_RANGE;
+  }
+  auto result = listFiles();
+  if (!result) {
+    return gxf::ToResultCode(result);
+  }
+  end_ = loop_ ? std::numeric_limits<uint64_t>::max() : files_.size();
+  return GXF_SUCCESS;
+}
+
+gxf_result_t ImageSequenceLoader::deinitialize() {
+  files_.clear();
+  return GXF_SUCCESS;
+}
+
+gxf_result_t ImageSequenceLoader::start() {
+  frames_.assign(prefetch_size_, Frame{});
+  next_decode_ = 0;
+  next_publish_ = 0;
+  next_frame_time_ = 0;
+  first_publish_time_ = 0;
+  last_publish_time_ = 0;
+  total_decode_latency_ = 0;
+
+  auto scheduling_term = boolean_scheduling_term_.try_get();
+  if (scheduling_term) {
+    scheduling_term.value()->enable_tick();
+  }
+
+  running_ = true;
+  threads_.reserve(num_threads_);
+  for (size_t i = 0; i < num_threads_; i++) {
+    threads_.emplace_back([this] { decodeLoop(); });
+  }
+  return GXF_SUCCESS;
+}
+
+gxf_result_t ImageSequenceLoader::tick() {
+  if (next_publish_ >= end_) {
+    return GXF_SUCCESS;
+  }
+
+  // Take the next frame out of the queue, waiting for it to be decoded if necessary
+  Frame frame;
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    Frame& slot = frames_[next_publish_ % frames_.size()];
+    frame_ready_.wait(lock, [&] { return slot.ready; });
+    frame = std::move(slot);
+    slot = Frame{};
+    next_publish_++;
+  }
+  slot_available_.notify_one();
+
+  if (!frame.valid) {
+    GXF_LOG_ERROR("Failed to load %s", files_[(next_publish_ - 1) % files_.size()].c_str());
+    return GXF_FAILURE;
+  }
+
+  pace();
+  auto result = publish(frame);
+  if (!result) {
+    discard(frame);
+    return gxf::ToResultCode(result);
+  }
+
+  // Update metrics
+  const int64_t now = Now();
+  if (first_publish_time_ == 0) {
+    first_publish_time_ = now;
+  } else {
+    auto metric = frame_rate_metric_.try_get();
+    if (metric && now > last_publish_time_) {
+      metric.value()->record(1e9 / static_cast<double>(now - last_publish_time_));
+    }
+  }
+  last_publish_time_ = now;
+  total_decode_latency_ += frame.decode_latency;
+  auto metric = decode_latency_metric_.try_get();
+  if (metric) {
+    metric.value()->record(static_cast<double>(frame.decode_latency) / 1e6);
+  }
+
+  if (next_publish_ == end_) {
+    auto scheduling_term = boolean_scheduling_term_.try_get();
+    if (scheduling_term) {
+      scheduling_term.value()->disable_tick();
+    }
+  }
+  return GXF_SUCCESS;
+}
+
+gxf_result_t ImageSequenceLoader::stop() {
+  // Stop decoding threads and wait for exit
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    running_ = false;
+  }
+  slot_available_.notify_all();
+  for (auto& thread : threads_) {
+    thread.join();
+  }
+  threads_.clear();
+
+  // Release frames which were not published
+  for (auto& frame : frames_) {
+    discard(frame);
+  }
+  frames_.clear();
+
+  if (next_publish_ > 1 && last_publish_time_ > first_publish_time_) {
+    GXF_LOG_INFO("Published %lu frames at %.2f frames per second, mean decode latency %.3f ms",
+                 next_publish_,
+                 static_cast<double>(next_publish_ - 1) * 1e9 /
+                     static_cast<double>(last_publish_time_ - first_publish_time_),
+                 static_cast<double>(total_decode_latency_) / 1e6 /
+                     static_cast<double>(next_publish_));
+  }
+  return GXF_SUCCESS;
+}
+
+gxf::Expected<void> ImageSequenceLoader::listFiles() {
+  files_.clear();
+  auto file_pattern = file_pattern_.try_get();
+  auto index_file = index_file_.try_get();
+  if (file_pattern.has_value() == index_file.has_value()) {
+    GXF_LOG_ERROR("Exactly one of file_pattern and index_file must be set");
+    return gxf::Unexpected{GXF_ARGUMENT_INVALID};
+  }
+
+  if (file_pattern) {
+    glob_t matches;
+    const int result = glob(file_pattern.value().c_str(), 0, nullptr, &matches);
+    if (result == 0) {
+      files_.assign(matches.gl_pathv, matches.gl_pathv + matches.gl_pathc);
+    }
+    globfree(&matches);
+    if (result != 0 && result != GLOB_NOMATCH) {
+      GXF_LOG_ERROR("Failed to expand %s", file_pattern.value().c_str());
+      return gxf::Unexpected{GXF_FAILURE};
+    }
+  } else {
+    std::ifstream index(index_file.value());
+    if (!index) {
+      GXF_LOG_ERROR("Failed to open %s", index_file.value().c_str());
+      return gxf::Unexpected{GXF_FILE_NOT_FOUND};
+    }
+    const std::string directory = DirectoryOf(index_file.value());
+    std::string line;
+    while (std::getline(index, line)) {
+      line = TrimString(line);
+      if (line.empty() || StartsWith(line, "#")) {
+        continue;
+      }
+      files_.push_back(StartsWith(line, "/") ? line : directory + line);
+    }
+  }
+
+  if (files_.empty()) {
+    GXF_LOG_ERROR("No image files in the sequence");
+    return gxf::Unexpected{GXF_ARGUMENT_INVALID};
+  }
+  return gxf::Success;
+}
+
+void ImageSequenceLoader::decodeLoop() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    // Claim the next frame once its slot was published
+    slot_available_.wait(lock, [&] {
+      return !running_ || (next_decode_ < end_ && next_decode_ < next_publish_ + frames_.size());
+    });
+    if (!running_) {
+      return;
+    }
+    const uint64_t index = next_decode_++;
+    Frame& frame = frames_[index % frames_.size()];
+
+    // Decode without holding the lock. The slot is not accessed by others until it is ready.
+    lock.unlock();
+    const int64_t start_time = Now();
+    frame.valid = static_cast<bool>(decode(files_[index % files_.size()], frame));
+    frame.decode_latency = Now() - start_time;
+    lock.lock();
+
+    frame.ready = true;
+    frame_ready_.notify_all();
+  }
+}
+
+gxf::Expected<void> ImageSequenceLoader::decode(const std::string& filename, Frame& frame) {
+  if (EndsWith(ToLowerCase(filename), kRawExtension)) {
+    return mapRaw(filename, frame);
+  }
+  return decodeImage(filename, frame);
+}
+
+gxf::Expected<void> ImageSequenceLoader::decodeImage(const std::string& filename, Frame& frame) {
+  ::nvidia::isaac::Vector3i dimensions;
+  if (!::nvidia::isaac::LoadImageShape(filename, dimensions)) {
+    GXF_LOG_ERROR("Failed to load image shape of %s", filename.c_str());
+    return gxf::Unexpected{GXF_FAILURE};
+  }
+  const bool color = color_.get();
+  const uint32_t rows = dimensions[0];
+  const uint32_t columns = dimensions[1];
+  const uint64_t size = static_cast<uint64_t>(rows) * columns * (color ? 3 : 1);
+
+  // Wait for memory if the pool is exhausted, frames in use downstream will be returned
+  const gxf::Handle<gxf::Allocator> allocator = allocator_.get();
+  auto pointer = allocator->allocate(size, gxf::MemoryStorageType::kHost);
+  while (!pointer) {
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      if (!running_) {
+        return gxf::ForwardError(pointer);
+      }
+    }
+    std::this_thread::sleep_for(kAllocationRetryPeriod);
+    pointer = allocator->allocate(size, gxf::MemoryStorageType::kHost);
+  }
+
+  bool loaded;
+  if (color) {
+    auto view = CreateImageView<uint8_t, 3>(pointer.value(), rows, columns);
+    loaded = ::nvidia::isaac::LoadImage(filename, view);
+  } else {
+    auto view = CreateImageView<uint8_t, 1>(pointer.value(), rows, columns);
+    loaded = ::nvidia::isaac::LoadImage(filename, view);
+  }
+  if (!loaded) {
+    allocator->free(pointer.value());
+    return gxf::Unexpected{GXF_FAILURE};
+  }
+
+  frame.pointer = pointer.value();
+  frame.size = size;
+  frame.release = [allocator](void* data) {
+    return allocator->free(static_cast<byte*>(data));
+  };
+  frame.rows = rows;
+  frame.columns = columns;
+  frame.color = color;
+  return gxf::Success;
+}
+
+gxf::Expected<void> ImageSequenceLoader::mapRaw(const std::string& filename, Frame& frame) {
+  auto raw_rows = raw_rows_.try_get();
+  auto raw_columns = raw_columns_.try_get();
+  if (!raw_rows || !raw_columns || raw_rows.value() <= 0 || raw_columns.value() <= 0) {
+    GXF_LOG_ERROR("raw_rows and raw_columns must be set to load raw files");
+    return gxf::Unexpected{GXF_PARAMETER_NOT_INITIALIZED};
+  }
+  const bool color = color_.get();
+  const uint64_t size =
+      static_cast<uint64_t>(raw_rows.value()) * raw_columns.value() * (color ? 3 : 1);
+
+  const int fd = open(filename.c_str(), O_RDONLY);
+  if (fd < 0) {
+    GXF_LOG_ERROR("Failed to open %s: %s", filename.c_str(), strerror(errno));
+    return gxf::Unexpected{GXF_FILE_NOT_FOUND};
+  }
+  struct stat status;
+  if (fstat(fd, &status) != 0 || static_cast<uint64_t>(status.st_size) != size) {
+    GXF_LOG_ERROR("Size of %s does not match a %dx%d image", filename.c_str(),
+                  raw_rows.value(), raw_columns.value());
+    close(fd);
+    return gxf::Unexpected{GXF_FAILURE};
+  }
+  // Pages are private copy-on-write so that receivers can modify the frame, and are populated
+  // here so that reading the file happens on the decoding thread.
+  void* pointer = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_POPULATE, fd, 0);
+  close(fd);
+  if (pointer == MAP_FAILED) {
+    GXF_LOG_ERROR("Failed to map %s: %s", filename.c_str(), strerror(errno));
+    return gxf::Unexpected{GXF_FAILURE};
+  }
+
+  frame.pointer = pointer;
+  frame.size = size;
+  frame.release = [size](void* data) -> gxf::Expected<void> {
+    if (munmap(data, size) != 0) {
+      return gxf::Unexpected{GXF_FAILURE};
+    }
+    return gxf::Success;
+  };
+  frame.rows = raw_rows.value();
+  frame.columns = raw_columns.value();
+  frame.color = color;
+  return gxf::Success;
+}
+
+gxf::Expected<void> ImageSequenceLoader::publish(Frame& frame) {
+  auto entity = gxf::Entity::New(context());
+  if (!entity) {
+    return gxf::ForwardError(entity);
+  }
+  auto video_buffer = entity->add<gxf::VideoBuffer>();
+  if (!video_buffer) {
+    return gxf::ForwardError(video_buffer);
+  }
+  const gxf::VideoBufferInfo info =
+      frame.color ? FrameInfo<gxf::VideoFormat::GXF_VIDEO_FORMAT_RGB>(frame.rows, frame.columns)
+                  : FrameInfo<gxf::VideoFormat::GXF_VIDEO_FORMAT_GRAY>(frame.rows, frame.columns);
+  // The release function is copied, so that the frame can still be discarded if wrapping fails
+  auto result = video_buffer.value()->wrapMemory(info, frame.size, gxf::MemoryStorageType::kHost,
+                                                 frame.pointer, frame.release);
+  if (!result) {
+    return gxf::ForwardError(result);
+  }
+  // The memory is owned by the video buffer from now on
+  frame.pointer = nullptr;
+  frame.release = nullptr;
+  return transmitter_->publish(entity.value(), getExecutionTimestamp());
+}
+
+void ImageSequenceLoader::discard(Frame& frame) {
+  if (frame.pointer != nullptr && frame.release) {
+    frame.release(frame.pointer);
+  }
+  frame.pointer = nullptr;
+}
+
+void ImageSequenceLoader::pace() {
+  if (frame_rate_ <= 0.0) {
+    return;
+  }
+  // Frames are published on a fixed grid. If publishing fell behind by more than a period the
+  // grid is reset instead of publishing a burst of frames to catch up.
+  const int64_t period = static_cast<int64_t>(1e9 / frame_rate_);
+  const int64_t now = Now();
+  if (next_frame_time_ > now) {
+    std::this_thread::sleep_for(std::chrono::nanoseconds(next_frame_time_ - now));
+    next_frame_time_ += period;
+  } else if (now - next_frame_time_ < period) {
+    next_frame_time_ += period;
+  } else {
+    next_frame_time_ = now + period;
+  }
+}
+
+}  // namespace isaac
+}  // namespace nvidia
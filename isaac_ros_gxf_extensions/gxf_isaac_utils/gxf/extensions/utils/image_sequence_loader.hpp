@@ -0,0 +1,143 @@
+// SPDX-FileCopyrightText: NVIDIA CORPORATION & AFFILIATES
+// Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gxf/multimedia/video.hpp"
+#include "gxf/std/allocator.hpp"
+#include "gxf/std/codelet.hpp"
+#include "gxf/std/metric.hpp"
+#include "gxf/std/scheduling_terms.hpp"
+#include "gxf/std/transmitter.hpp"
+
+namespace nvidia {
+namespace isaac {
+
+// Publishes a sequence of image files as video buffers, one frame per tick.
+//
+// The sequence is given either as a glob pattern or as an index file listing one image per line.
+// Supports PNG and JPEG files, which are decoded into memory from `allocator`, and raw files with
+// a ".raw" extension holding `raw_rows` x `raw_columns` pixels without header, which are memory
+// mapped and published without a copy.
+//
+// Frames are decoded ahead of time by a pool of background threads into a bounded prefetch queue,
+// so that the tick only has to wait for decoding if the queue ran empty. When `allocator` is a
+// BlockMemoryPool it should have at least `prefetch_size` blocks plus the number of frames in use
+// downstream; decoding threads wait for blocks to be returned when the pool is exhausted.
+//
+// Frames are published in order and at most at `frame_rate` frames per second. When the end of
+// the sequence is reached it starts over if `loop` is set, otherwise ticking is disabled through
+// the optional boolean scheduling term. The achieved frame rate and the decode latency of every
+// frame can be recorded in metrics.
+class ImageSequenceLoader : public gxf::Codelet {
+ public:
+  gxf_result_t registerInterface(gxf::Registrar* registrar) override;
+  gxf_result_t initialize() override;
+  gxf_result_t deinitialize() override;
+
+  gxf_result_t start() override;
+  gxf_result_t tick() override;
+  gxf_result_t stop() override;
+
+ private:
+  // A decoded frame in the prefetch queue
+  struct Frame {
+    // True once a decoding thread finished with the frame
+    bool ready = false;
+    // Pixel data, released with `release` unless published
+    void* pointer = nullptr;
+    uint64_t size = 0;
+    gxf::MemoryBuffer::release_function_t release;
+    uint32_t rows = 0;
+    uint32_t columns = 0;
+    bool color = false;
+    // Time spent loading the frame in nanoseconds
+    int64_t decode_latency = 0;
+    // False if the frame could not be loaded
+    bool valid = false;
+  };
+
+  // Reads the list of files from the glob pattern or the index file
+  gxf::Expected<void> listFiles();
+  // Loop run by the decoding threads
+  void decodeLoop();
+  // Loads an image file into a frame
+  gxf::Expected<void> decode(const std::string& filename, Frame& frame);
+  // Loads a PNG or JPEG file into memory from the allocator
+  gxf::Expected<void> decodeImage(const std::string& filename, Frame& frame);
+  // Memory maps a raw file
+  gxf::Expected<void> mapRaw(const std::string& filename, Frame& frame);
+  // Publishes a frame as a video buffer, handing its memory over to the message
+  gxf::Expected<void> publish(Frame& frame);
+  // Releases the memory of a frame which was not published
+  void discard(Frame& frame);
+  // Blocks until the next frame can be published without exceeding the frame rate
+  void pace();
+
+  gxf::Parameter<gxf::Handle<gxf::Transmitter>> transmitter_;
+  gxf::Parameter<gxf::Handle<gxf::Allocator>> allocator_;
+  gxf::Parameter<std::string> file_pattern_;
+  gxf::Parameter<std::string> index_file_;
+  gxf::Parameter<bool> color_;
+  gxf::Parameter<int32_t> raw_rows_;
+  gxf::Parameter<int32_t> raw_columns_;
+  gxf::Parameter<size_t> num_threads_;
+  gxf::Parameter<size_t> prefetch_size_;
+  gxf::Parameter<bool> loop_;
+  gxf::Parameter<double> frame_rate_;
+  gxf::Parameter<gxf::Handle<gxf::BooleanSchedulingTerm>> boolean_scheduling_term_;
+  gxf::Parameter<gxf::Handle<gxf::Metric>> frame_rate_metric_;
+  gxf::Parameter<gxf::Handle<gxf::Metric>> decode_latency_metric_;
+
+  // Files of the sequence, in order
+  std::vector<std::string> files_;
+  // Index in the sequence after the last frame to publish
+  uint64_t end_ = 0;
+
+  // Ring of frames indexed by their position in the sequence modulo the prefetch size
+  std::vector<Frame> frames_;
+  // Protects the frames and the counters below
+  std::mutex mutex_;
+  // Signaled when a frame slot becomes available for decoding
+  std::condition_variable slot_available_;
+  // Signaled when a frame finished decoding
+  std::condition_variable frame_ready_;
+  // Index in the sequence of the next frame to decode
+  uint64_t next_decode_ = 0;
+  // Index in the sequence of the next frame to publish
+  uint64_t next_publish_ = 0;
+  // False when the decoding threads have to exit
+  bool running_ = false;
+  std::vector<std::thread> threads_;
+
+  // Time in nanoseconds (steady clock) before which the next frame must not be published
+  int64_t next_frame_time_ = 0;
+  // Time in nanoseconds (steady clock) at which the first and the last frame were published
+  int64_t first_publish_time_ = 0;
+  int64_t last_publish_time_ = 0;
+  // Sum of the decode latencies of the published frames, in nanoseconds
+  int64_t total_decode_latency_ = 0;
+};
+
+}  // namespace isaac
+}  // namespace nvidia
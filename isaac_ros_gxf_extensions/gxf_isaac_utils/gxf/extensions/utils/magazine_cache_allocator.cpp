@@ -0,0 +1,98 @@
+// SPDX-FileCopyrightText: NVIDIA CORPORATION & AFFILIATES
+// Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+#include "extensions/utils/magazine_cache_allocator.hpp"
+
+namespace nvidia {
+namespace isaac {
+
+gxf_result_t MagazineCacheAllocator::registerInterface(gxf::Registrar* registrar) {
+  if (registrar == nullptr) {
+    return GXF_ARGUMENT_NULL;
+  }
+  gxf::Expected<void> result;
+  result &= registrar->parameter(
+      pool_, "pool", "Pool",
+      "Block memory pool the blocks are taken from");
+  result &= registrar->parameter(
+      magazine_size_, "magazine_size", "Magazine Size",
+      "Number of blocks in a magazine",
+      gxf::BlockMemoryPoolCache::kDefaultMagazineSize);
+  result &= registrar->parameter(
+      depot_size_, "depot_size", "Depot Size",
+      "Number of magazines shared between the caches",
+      gxf::BlockMemoryPoolCache::kDefaultDepotSize);
+  result &= registrar->parameter(
+      number_caches_, "number_caches", "Number of Caches",
+      "Number of caches the calling threads are distributed over. 0 means one per hardware thread.",
+      0UL);
+  return gxf::ToResultCode(result);
+}
+
+gxf_result_t MagazineCacheAllocator::initialize() {
+  if (magazine_size_ == 0) {
+    GXF_LOG_ERROR("magazine_size must be greater than 0");
+    return GXF_PARAMETER_OUT_OF_RANGE;
+  }
+  const gxf::Handle<gxf::BlockMemoryPool> pool = pool_;
+  return gxf::ToResultCode(cache_.initialize(
+      pool.get(), pool->storage_type(), magazine_size_, depot_size_, number_caches_));
+}
+
+gxf_result_t MagazineCacheAllocator::deinitialize() {
+  return gxf::ToResultCode(cache_.deinitialize());
+}
+
+gxf_result_t MagazineCacheAllocator::is_available_abi(uint64_t size) {
+  if (size > cache_.block_size()) {
+    return GXF_FAILURE;
+  }
+  return cache_.available_blocks() > 0 ? GXF_SUCCESS : GXF_FAILURE;
+}
+
+gxf_result_t MagazineCacheAllocator::allocate_abi(uint64_t size, int32_t type, void** pointer) {
+  if (pointer == nullptr) {
+    return GXF_ARGUMENT_NULL;
+  }
+  const gxf::Handle<gxf::BlockMemoryPool> pool = pool_;
+  if (type != static_cast<int32_t>(pool->storage_type())) {
+    GXF_LOG_ERROR("Requested storage type %d does not match the storage type of the pool %d",
+                  type, static_cast<int32_t>(pool->storage_type()));
+    return GXF_ARGUMENT_INVALID;
+  }
+  if (size > cache_.block_size()) {
+    GXF_LOG_ERROR("Requested %lu bytes but the blocks of the pool have %lu bytes",
+                  size, cache_.block_size());
+    return GXF_ARGUMENT_INVALID;
+  }
+  auto maybe_block = cache_.allocate();
+  if (!maybe_block) {
+    return gxf::ToResultCode(maybe_block);
+  }
+  *pointer = maybe_block.value();
+  return GXF_SUCCESS;
+}
+
+gxf_result_t MagazineCacheAllocator::free_abi(void* pointer) {
+  return gxf::ToResultCode(cache_.free(static_cast<byte*>(pointer)));
+}
+
+uint64_t MagazineCacheAllocator::block_size_abi() const {
+  return cache_.block_size();
+}
+
+}  // namespace isaac
+}  // namespace nvidia
@@ -0,0 +1,52 @@
+// SPDX-FileCopyrightText: NVIDIA CORPORATION & AFFILIATES
+// Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include <cstdint>
+
+#include "gxf/std/allocator.hpp"
+#include "gxf/std/block_memory_pool.hpp"
+#include "gxf/std/gems/magazine_cache/magazine_cache.hpp"
+
+namespace nvidia {
+namespace isaac {
+
+// Allocator serving the blocks of a BlockMemoryPool through per-thread magazine caches, so that
+// components allocating and freeing blocks at a steady rate do not contend on the lock of the pool.
+// All the allocations from the pool have to go through this allocator.
+class MagazineCacheAllocator : public gxf::Allocator {
+ public:
+  gxf_result_t registerInterface(gxf::Registrar* registrar) override;
+  gxf_result_t initialize() override;
+  gxf_result_t deinitialize() override;
+
+  gxf_result_t is_available_abi(uint64_t size) override;
+  gxf_result_t allocate_abi(uint64_t size, int32_t type, void** pointer) override;
+  gxf_result_t free_abi(void* pointer) override;
+  uint64_t block_size_abi() const override;
+
+ private:
+  gxf::Parameter<gxf::Handle<gxf::BlockMemoryPool>> pool_;
+  gxf::Parameter<size_t> magazine_size_;
+  gxf::Parameter<size_t> depot_size_;
+  gxf::Parameter<size_t> number_caches_;
+
+  gxf::BlockMemoryPoolCache cache_;
+};
+
+}  // namespace isaac
+}  // namespace nvidia
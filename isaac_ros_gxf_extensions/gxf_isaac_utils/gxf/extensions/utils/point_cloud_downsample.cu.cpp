@@ -0,0 +1,341 @@
+// SPDX-FileCopyrightText: NVIDIA CORPORATION & AFFILIATES
+// Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "point_cloud_downsample.cu.hpp"
+
+#include <thrust/binary_search.h>
+#include <thrust/copy.h>
+#include <thrust/device_vector.h>
+#include <thrust/iterator/counting_iterator.h>
+#include <thrust/iterator/transform_iterator.h>
+#include <thrust/iterator/zip_iterator.h>
+#include <thrust/reduce.h>
+#include <thrust/remove.h>
+#include <thrust/sequence.h>
+#include <thrust/sort.h>
+#include <thrust/system_error.h>
+#include <thrust/transform.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <new>
+
+#include "cuda.h"
+
+namespace nvidia {
+namespace isaac {
+
+namespace {
+
+namespace downsample = point_cloud_downsample;
+
+constexpr int kBlockSize = 256;
+
+// Selects the points passing the crop and the random selection
+struct SelectPoint
+{
+  const float * points;
+  int channels;
+  PointCloudDownsampleParams params;
+  bool random;
+  uint64_t threshold;
+
+  __host__ __device__ bool operator()(uint32_t index) const
+  {
+    const float * point = points + static_cast<size_t>(index) * channels;
+    if (!downsample::InsideCrop(params, point[0], point[1], point[2])) {
+      return false;
+    }
+    return !random || downsample::KeepRandom(index, params.seed, threshold);
+  }
+};
+
+// Keeps every `stride`-th element
+struct IsStrideMultiple
+{
+  uint32_t stride;
+
+  __host__ __device__ bool operator()(uint32_t position) const
+  {
+    return position % stride == 0;
+  }
+};
+
+// Index of the i-th point of a stride without crop
+struct StrideIndex
+{
+  uint32_t stride;
+
+  __host__ __device__ uint32_t operator()(uint32_t position) const
+  {
+    return position * stride;
+  }
+};
+
+// Voxel key of a point, kInvalidVoxelKey if it does not pass the crop
+struct ComputeVoxelKey
+{
+  const float * points;
+  int channels;
+  PointCloudDownsampleParams params;
+  float inverse_voxel_size;
+
+  __host__ __device__ uint64_t operator()(uint32_t index) const
+  {
+    const float * point = points + static_cast<size_t>(index) * channels;
+    if (!downsample::InsideCrop(params, point[0], point[1], point[2])) {
+      return downsample::kInvalidVoxelKey;
+    }
+    return downsample::VoxelKey(point[0], point[1], point[2], inverse_voxel_size);
+  }
+};
+
+// Accumulator holding a single point of a voxel
+struct PointAccumulator
+{
+  const float * points;
+  int channels;
+  float voxel_size;
+
+  __host__ __device__ downsample::VoxelAccumulator operator()(
+    const thrust::tuple<uint64_t, uint32_t> & key_and_index) const
+  {
+    float origin_x, origin_y, origin_z;
+    downsample::VoxelOrigin(thrust::get<0>(key_and_index), voxel_size,
+      origin_x, origin_y, origin_z);
+    downsample::VoxelAccumulator accumulator;
+    downsample::Accumulate(points + static_cast<size_t>(thrust::get<1>(key_and_index)) * channels,
+      channels, origin_x, origin_y, origin_z, accumulator);
+    return accumulator;
+  }
+};
+
+struct MergeAccumulators
+{
+  __host__ __device__ downsample::VoxelAccumulator operator()(
+    const downsample::VoxelAccumulator & a, const downsample::VoxelAccumulator & b) const
+  {
+    return downsample::Merge(a, b);
+  }
+};
+
+// Voxels with too few points
+struct HasTooFewPoints
+{
+  uint32_t min_points;
+
+  __host__ __device__ bool operator()(
+    const thrust::tuple<uint64_t, downsample::VoxelAccumulator> & voxel) const
+  {
+    return thrust::get<1>(voxel).count < min_points;
+  }
+};
+
+__global__ void gather_points_kernel(
+  const float * points, const uint32_t * indices, int channels, size_t count, float * output)
+{
+  const size_t i = static_cast<size_t>(blockIdx.x) * blockDim.x + threadIdx.x;
+  if (i < count * channels) {
+    const size_t point = i / channels;
+    output[i] = points[static_cast<size_t>(indices[point]) * channels + (i - point * channels)];
+  }
+}
+
+__global__ void write_centroids_kernel(
+  const uint64_t * keys, const downsample::VoxelAccumulator * accumulators, float voxel_size,
+  int channels, size_t count, float * output)
+{
+  const size_t i = static_cast<size_t>(blockIdx.x) * blockDim.x + threadIdx.x;
+  if (i < count) {
+    downsample::WriteCentroid(keys[i], voxel_size, accumulators[i], channels,
+      output + i * channels);
+  }
+}
+
+unsigned int ceil_div(size_t numerator, size_t denominator)
+{
+  return static_cast<unsigned int>((numerator + denominator - 1) / denominator);
+}
+
+}  // namespace
+
+struct PointCloudDownsampleCuda::Impl
+{
+  const float * points = nullptr;
+  size_t count = 0;
+  int channels = 3;
+  PointCloudDownsampleParams params;
+
+  // True if all points are selected
+  bool all_points = false;
+  // True if the output is made of voxels
+  bool voxels = false;
+  size_t output_count = 0;
+
+  // Indices of the selected points, or of the points sorted by voxel key
+  thrust::device_vector<uint32_t> indices;
+  thrust::device_vector<uint32_t> strided_indices;
+  // Voxel key of every point
+  thrust::device_vector<uint64_t> keys;
+  // Keys and sums of the selected voxels
+  thrust::device_vector<uint64_t> voxel_keys;
+  thrust::device_vector<downsample::VoxelAccumulator> voxel_sums;
+
+  void selectPoints();
+  void selectVoxels();
+};
+
+void PointCloudDownsampleCuda::Impl::selectPoints()
+{
+  const bool crop = params.crop_range || params.crop_box;
+  const uint64_t threshold = downsample::RandomThreshold(params.keep_ratio);
+  const bool random = params.mode == PointCloudDownsampleMode::kRandom &&
+    threshold < (uint64_t(1) << 32);
+  const uint32_t stride = params.mode == PointCloudDownsampleMode::kStride ?
+    static_cast<uint32_t>(std::max(1, params.stride)) : 1;
+  const thrust::counting_iterator<uint32_t> first(0);
+
+  if (!crop && !random) {
+    if (stride == 1) {
+      all_points = true;
+      output_count = count;
+      return;
+    }
+    output_count = (count + stride - 1) / stride;
+    indices.resize(output_count);
+    thrust::transform(first, first + output_count, indices.begin(), StrideIndex{stride});
+    return;
+  }
+
+  // Stream compaction keeps the selected points in order
+  indices.resize(count);
+  const auto selected_end = thrust::copy_if(
+    first, first + count, indices.begin(),
+    SelectPoint{points, channels, params, random, threshold});
+  output_count = selected_end - indices.begin();
+
+  // The stride applies to the points which passed the crop
+  if (stride > 1) {
+    strided_indices.resize((output_count + stride - 1) / stride);
+    thrust::copy_if(
+      indices.begin(), indices.begin() + output_count, first, strided_indices.begin(),
+      IsStrideMultiple{stride});
+    indices.swap(strided_indices);
+    output_count = (output_count + stride - 1) / stride;
+  }
+}
+
+void PointCloudDownsampleCuda::Impl::selectVoxels()
+{
+  voxels = true;
+  const thrust::counting_iterator<uint32_t> first(0);
+  keys.resize(count);
+  thrust::transform(
+    first, first + count, keys.begin(),
+    ComputeVoxelKey{points, channels, params, 1.0f / params.voxel_size});
+
+  // Sort the points by voxel. Points without voxel have the largest key and end up last.
+  indices.resize(count);
+  thrust::sequence(indices.begin(), indices.end());
+  thrust::sort_by_key(keys.begin(), keys.end(), indices.begin());
+  const size_t valid_count =
+    thrust::lower_bound(keys.begin(), keys.end(), downsample::kInvalidVoxelKey) - keys.begin();
+
+  // Sum the points of every voxel
+  voxel_keys.resize(valid_count);
+  voxel_sums.resize(valid_count);
+  const auto accumulators = thrust::make_transform_iterator(
+    thrust::make_zip_iterator(thrust::make_tuple(keys.begin(), indices.begin())),
+    PointAccumulator{points, channels, params.voxel_size});
+  const auto reduced_end = thrust::reduce_by_key(
+    keys.begin(), keys.begin() + valid_count, accumulators, voxel_keys.begin(),
+    voxel_sums.begin(), thrust::equal_to<uint64_t>(), MergeAccumulators());
+  output_count = reduced_end.first - voxel_keys.begin();
+
+  if (params.min_points_per_voxel > 1) {
+    const auto voxels_begin =
+      thrust::make_zip_iterator(thrust::make_tuple(voxel_keys.begin(), voxel_sums.begin()));
+    const auto voxels_end = thrust::remove_if(
+      voxels_begin, voxels_begin + output_count,
+      HasTooFewPoints{static_cast<uint32_t>(params.min_points_per_voxel)});
+    output_count = voxels_end - voxels_begin;
+  }
+}
+
+PointCloudDownsampleCuda::PointCloudDownsampleCuda()
+: impl_(std::make_unique<Impl>()) {}
+
+PointCloudDownsampleCuda::~PointCloudDownsampleCuda() = default;
+
+cudaError_t PointCloudDownsampleCuda::select(
+  const float * points, size_t count, int channels,
+  const PointCloudDownsampleParams & params, size_t & output_count)
+{
+  impl_->points = points;
+  impl_->count = count;
+  impl_->channels = channels;
+  impl_->params = params;
+  impl_->all_points = false;
+  impl_->voxels = false;
+  impl_->output_count = 0;
+  try {
+    if (count > 0) {
+      if (params.mode == PointCloudDownsampleMode::kVoxelGrid) {
+        impl_->selectVoxels();
+      } else {
+        impl_->selectPoints();
+      }
+    }
+  } catch (const thrust::system_error & error) {
+    return static_cast<cudaError_t>(error.code().value());
+  } catch (const std::bad_alloc &) {
+    // Thrust reports failed device allocations with an exception derived from std::bad_alloc
+    return cudaErrorMemoryAllocation;
+  }
+  output_count = impl_->output_count;
+  return cudaSuccess;
+}
+
+cudaError_t PointCloudDownsampleCuda::write(float * output)
+{
+  const size_t count = impl_->output_count;
+  if (count == 0) {
+    return cudaSuccess;
+  }
+  const int channels = impl_->channels;
+  if (impl_->all_points) {
+    return cudaMemcpy(
+      output, impl_->points, count * channels * sizeof(float), cudaMemcpyDeviceToDevice);
+  }
+  if (impl_->voxels) {
+    write_centroids_kernel << < ceil_div(count, kBlockSize), kBlockSize >> > (
+      thrust::raw_pointer_cast(impl_->voxel_keys.data()),
+      thrust::raw_pointer_cast(impl_->voxel_sums.data()),
+      impl_->params.voxel_size, channels, count, output);
+  } else {
+    gather_points_kernel << < ceil_div(count * channels, kBlockSize), kBlockSize >> > (
+      impl_->points, thrust::raw_pointer_cast(impl_->indices.data()), channels, count, output);
+  }
+  const cudaError_t error = cudaGetLastError();
+  if (error != cudaSuccess) {
+    return error;
+  }
+  return cudaStreamSynchronize(0);
+}
+
+}  // namespace isaac
+}  // namespace nvidia
@@ -0,0 +1,52 @@
+// SPDX-FileCopyrightText: NVIDIA CORPORATION & AFFILIATES
+// Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+
+#include "cuda_runtime.h"
+#include "extensions/utils/point_cloud_downsample_types.hpp"
+
+namespace nvidia {
+namespace isaac {
+
+// Downsamples point clouds stored in device memory. The voxel grid is computed by sorting the
+// points by voxel key, so voxels are ordered by key. Device memory is kept between clouds.
+class PointCloudDownsampleCuda {
+ public:
+  PointCloudDownsampleCuda();
+  ~PointCloudDownsampleCuda();
+
+  // Selects the points of a cloud of `count` points of `channels` floats, and sets
+  // `output_count` to the number of points of the downsampled cloud. The points must stay valid
+  // until `write` is called.
+  cudaError_t select(
+    const float * points, size_t count, int channels,
+    const PointCloudDownsampleParams & params, size_t & output_count);
+
+  // Writes the downsampled cloud selected by the last call to `select` and waits for completion
+  cudaError_t write(float * output);
+
+ private:
+  struct Impl;
+  std::unique_ptr<Impl> impl_;
+};
+
+}  // namespace isaac
+}  // namespace nvidia
@@ -0,0 +1,628 @@
+// SPDX-FileCopyrightText: NVIDIA CORPORATION & AFFILIATES
+// Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "extensions/utils/point_cloud_downsample_cpu.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#include "gems/image/vectorized_utils.hpp"
+
+namespace nvidia {
+namespace isaac {
+
+namespace {
+
+using point_cloud_downsample::kInvalidVoxelKey;
+
+// Clouds are only split between threads in parts of at least this number of points
+constexpr int64_t kMinPointsPerThread = 1 << 15;
+// Initial number of slots of the voxel hash tables
+constexpr size_t kMinTableSize = 1 << 10;
+// Number of points of which the voxels are prefetched together
+constexpr size_t kBatchSize = 16;
+
+// Number of parts in which `count` points are split
+int CountTasks(size_t count, int num_threads) {
+  CpuExecution execution;
+  execution.num_threads = num_threads;
+  execution.min_pixels_per_thread = kMinPointsPerThread;
+  return vectorized_details::CountTasks(static_cast<int>(count), 1, execution);
+}
+
+// Mixes the bits of a voxel key (murmur3 64-bit finalizer)
+uint64_t HashKey(uint64_t key) {
+  key ^= key >> 33;
+  key *= 0xff51afd7ed558ccdull;
+  key ^= key >> 33;
+  key *= 0xc4ceb9fe1a85ec53ull;
+  key ^= key >> 33;
+  return key;
+}
+
+// Shard of a voxel key hash when voxels are split in `shards` shards
+int ShardOf(uint64_t hash, int shards) {
+  return static_cast<int>(((hash >> 32) * static_cast<uint64_t>(shards)) >> 32);
+}
+
+// Appends to `output` the indices of the points in [begin, end[ which pass the crop and, if
+// `random` is set, the random selection. Returns the number of indices written.
+size_t SelectScalar(const float* points, int channels, size_t begin, size_t end,
+                    const PointCloudDownsampleParams& params, bool random, uint64_t threshold,
+                    uint32_t* output) {
+  size_t count = 0;
+  for (size_t i = begin; i < end; i++) {
+    const float* point = points + i * channels;
+    if (!point_cloud_downsample::InsideCrop(params, point[0], point[1], point[2])) {
+      continue;
+    }
+    if (random &&
+        !point_cloud_downsample::KeepRandom(static_cast<uint32_t>(i), params.seed, threshold)) {
+      continue;
+    }
+    output[count++] = static_cast<uint32_t>(i);
+  }
+  return count;
+}
+
+// Computes the voxel keys of the points in [begin, end[
+void VoxelKeysScalar(const float* points, int channels, size_t begin, size_t end,
+                     const PointCloudDownsampleParams& params, uint64_t* keys) {
+  const float inverse_voxel_size = 1.0f / params.voxel_size;
+  for (size_t i = begin; i < end; i++) {
+    const float* point = points + i * channels;
+    keys[i] = point_cloud_downsample::InsideCrop(params, point[0], point[1], point[2])
+                  ? point_cloud_downsample::VoxelKey(point[0], point[1], point[2],
+                                                     inverse_voxel_size)
+                  : kInvalidVoxelKey;
+  }
+}
+
+#if defined(ISAAC_IMAGE_HAS_AVX2)
+// Crop of 8 points with the same operations in the same order as InsideCrop
+__attribute__((target("avx2")))
+inline __m256 InsideCropAvx2(const PointCloudDownsampleParams& params, __m256 x, __m256 y,
+                             __m256 z) {
+  __m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+  if (params.crop_range) {
+    const __m256 squared_range = _mm256_add_ps(
+        _mm256_add_ps(_mm256_mul_ps(x, x), _mm256_mul_ps(y, y)), _mm256_mul_ps(z, z));
+    const __m256 min = _mm256_set1_ps(params.min_range * params.min_range);
+    const __m256 max = _mm256_set1_ps(params.max_range * params.max_range);
+    inside = _mm256_and_ps(inside, _mm256_cmp_ps(squared_range, min, _CMP_GE_OQ));
+    inside = _mm256_and_ps(inside, _mm256_cmp_ps(squared_range, max, _CMP_LE_OQ));
+  }
+  if (params.crop_box) {
+    const __m256 values[3] = {x, y, z};
+    for (int axis = 0; axis < 3; axis++) {
+      inside = _mm256_and_ps(inside, _mm256_cmp_ps(values[axis],
+                                                   _mm256_set1_ps(params.box_min[axis]),
+                                                   _CMP_GE_OQ));
+      inside = _mm256_and_ps(inside, _mm256_cmp_ps(values[axis],
+                                                   _mm256_set1_ps(params.box_max[axis]),
+                                                   _CMP_LE_OQ));
+    }
+  }
+  return inside;
+}
+
+// HashIndex of 8 indices
+__attribute__((target("avx2")))
+inline __m256i HashIndexAvx2(__m256i index, uint32_t seed) {
+  const __m256i mixed_seed = _mm256_set1_epi32(static_cast<int>(seed * 0x9e3779b9u));
+  __m256i hash = _mm256_xor_si256(index, mixed_seed);
+  hash = _mm256_xor_si256(hash, _mm256_srli_epi32(hash, 16));
+  hash = _mm256_mullo_epi32(hash, _mm256_set1_epi32(static_cast<int>(0x85ebca6bu)));
+  hash = _mm256_xor_si256(hash, _mm256_srli_epi32(hash, 13));
+  hash = _mm256_mullo_epi32(hash, _mm256_set1_epi32(static_cast<int>(0xc2b2ae35u)));
+  return _mm256_xor_si256(hash, _mm256_srli_epi32(hash, 16));
+}
+
+// Permutations moving the lanes selected by a 8-bit mask to the front, as 8 lane indices
+struct LeftPackTable {
+  uint64_t permutations[256];
+  LeftPackTable() {
+    for (int mask = 0; mask < 256; mask++) {
+      uint64_t permutation = 0;
+      int count = 0;
+      for (int lane = 0; lane < 8; lane++) {
+        if (mask & (1 << lane)) {
+          permutation |= static_cast<uint64_t>(lane) << (8 * count++);
+        }
+      }
+      permutations[mask] = permutation;
+    }
+  }
+};
+
+// Writes the indices of the points selected by an 8-bit mask at `output`, which must have room for
+// 8 indices. Returns the number of indices written.
+__attribute__((target("avx2")))
+inline size_t LeftPackAvx2(__m256i indices, uint32_t mask, uint32_t* output) {
+  static const LeftPackTable table;
+  const __m256i permutation = _mm256_cvtepu8_epi32(
+      _mm_cvtsi64_si128(static_cast<int64_t>(table.permutations[mask])));
+  _mm256_storeu_si256(reinterpret_cast<__m256i*>(output),
+                      _mm256_permutevar8x32_epi32(indices, permutation));
+  return __builtin_popcount(mask);
+}
+
+__attribute__((target("avx2")))
+size_t SelectAvx2(const float* points, int channels, size_t begin, size_t end,
+                  const PointCloudDownsampleParams& params, bool random, uint64_t threshold,
+                  uint32_t* output) {
+  const __m256i lanes = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+  const __m256i offsets = _mm256_mullo_epi32(lanes, _mm256_set1_epi32(channels));
+  // Unsigned comparison of the hashes with the threshold, which is below 2^32 here
+  const __m256i sign = _mm256_set1_epi32(static_cast<int>(0x80000000u));
+  const __m256i biased_threshold =
+      _mm256_xor_si256(_mm256_set1_epi32(static_cast<int>(static_cast<uint32_t>(threshold))),
+                       sign);
+  size_t count = 0;
+  size_t i = begin;
+  for (; i + 8 <= end; i += 8) {
+    const float* base = points + i * channels;
+    const __m256 x = _mm256_i32gather_ps(base, offsets, 4);
+    const __m256 y = _mm256_i32gather_ps(base + 1, offsets, 4);
+    const __m256 z = _mm256_i32gather_ps(base + 2, offsets, 4);
+    uint32_t mask = _mm256_movemask_ps(InsideCropAvx2(params, x, y, z));
+    const __m256i index = _mm256_add_epi32(_mm256_set1_epi32(static_cast<int>(i)), lanes);
+    if (random && mask != 0) {
+      const __m256i hash = _mm256_xor_si256(HashIndexAvx2(index, params.seed), sign);
+      mask &= _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(biased_threshold, hash)));
+    }
+    // The output has room for the 8 indices of the block, since i + 8 <= end
+    count += LeftPackAvx2(index, mask, output + count);
+  }
+  return count + SelectScalar(points, channels, i, end, params, random, threshold,
+                              output + count);
+}
+
+// Combines 4 voxel indices per axis into keys, with kInvalidVoxelKey for invalid points
+__attribute__((target("avx2")))
+inline __m256i VoxelKeysAvx2(__m128i x, __m128i y, __m128i z, __m128i valid) {
+  const __m256i key = _mm256_or_si256(
+      _mm256_or_si256(
+          _mm256_slli_epi64(_mm256_cvtepu32_epi64(x), 2 * point_cloud_downsample::kVoxelKeyBits),
+          _mm256_slli_epi64(_mm256_cvtepu32_epi64(y), point_cloud_downsample::kVoxelKeyBits)),
+      _mm256_cvtepu32_epi64(z));
+  return _mm256_or_si256(key, _mm256_andnot_si256(_mm256_cvtepi32_epi64(valid),
+                                                  _mm256_set1_epi32(-1)));
+}
+
+__attribute__((target("avx2")))
+void VoxelKeysAvx2(const float* points, int channels, size_t begin, size_t end,
+                   const PointCloudDownsampleParams& params, uint64_t* keys) {
+  const __m256i offsets = _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7),
+                                             _mm256_set1_epi32(channels));
+  const __m256 inverse_voxel_size = _mm256_set1_ps(1.0f / params.voxel_size);
+  const __m256 min_index = _mm256_set1_ps(-static_cast<float>(
+      point_cloud_downsample::kVoxelIndexOffset));
+  const __m256 max_index = _mm256_set1_ps(static_cast<float>(
+      point_cloud_downsample::kVoxelIndexOffset));
+  const __m256i index_offset = _mm256_set1_epi32(point_cloud_downsample::kVoxelIndexOffset);
+  size_t i = begin;
+  for (; i + 8 <= end; i += 8) {
+    const float* base = points + i * channels;
+    const __m256 x = _mm256_i32gather_ps(base, offsets, 4);
+    const __m256 y = _mm256_i32gather_ps(base + 1, offsets, 4);
+    const __m256 z = _mm256_i32gather_ps(base + 2, offsets, 4);
+    __m256 valid = InsideCropAvx2(params, x, y, z);
+    __m256i indices[3];
+    const __m256 values[3] = {x, y, z};
+    for (int axis = 0; axis < 3; axis++) {
+      const __m256 scaled = _mm256_floor_ps(_mm256_mul_ps(values[axis], inverse_voxel_size));
+      valid = _mm256_and_ps(valid, _mm256_cmp_ps(scaled, min_index, _CMP_GE_OQ));
+      valid = _mm256_and_ps(valid, _mm256_cmp_ps(scaled, max_index, _CMP_LT_OQ));
+      indices[axis] = _mm256_add_epi32(_mm256_cvttps_epi32(scaled), index_offset);
+    }
+    const __m256i valid_lanes = _mm256_castps_si256(valid);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(keys + i), VoxelKeysAvx2(
+        _mm256_castsi256_si128(indices[0]), _mm256_castsi256_si128(indices[1]),
+        _mm256_castsi256_si128(indices[2]), _mm256_castsi256_si128(valid_lanes)));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(keys + i + 4), VoxelKeysAvx2(
+        _mm256_extracti128_si256(indices[0], 1), _mm256_extracti128_si256(indices[1], 1),
+        _mm256_extracti128_si256(indices[2], 1), _mm256_extracti128_si256(valid_lanes, 1)));
+  }
+  VoxelKeysScalar(points, channels, i, end, params, keys);
+}
+#endif  // ISAAC_IMAGE_HAS_AVX2
+
+#if defined(ISAAC_IMAGE_HAS_NEON)
+// Loads the coordinates of 4 points of 3 or 4 channels
+inline void LoadPointsNeon(const float* base, int channels, float32x4_t& x, float32x4_t& y,
+                           float32x4_t& z) {
+  if (channels == 4) {
+    const float32x4x4_t values = vld4q_f32(base);
+    x = values.val[0];
+    y = values.val[1];
+    z = values.val[2];
+  } else {
+    const float32x4x3_t values = vld3q_f32(base);
+    x = values.val[0];
+    y = values.val[1];
+    z = values.val[2];
+  }
+}
+
+// Crop of 4 points with the same operations in the same order as InsideCrop
+inline uint32x4_t InsideCropNeon(const PointCloudDownsampleParams& params, float32x4_t x,
+                                 float32x4_t y, float32x4_t z) {
+  uint32x4_t inside = vdupq_n_u32(0xffffffffu);
+  if (params.crop_range) {
+    const float32x4_t squared_range =
+        vaddq_f32(vaddq_f32(vmulq_f32(x, x), vmulq_f32(y, y)), vmulq_f32(z, z));
+    inside = vandq_u32(inside, vcgeq_f32(squared_range,
+                                         vdupq_n_f32(params.min_range * params.min_range)));
+    inside = vandq_u32(inside, vcleq_f32(squared_range,
+                                         vdupq_n_f32(params.max_range * params.max_range)));
+  }
+  if (params.crop_box) {
+    const float32x4_t values[3] = {x, y, z};
+    for (int axis = 0; axis < 3; axis++) {
+      inside = vandq_u32(inside, vcgeq_f32(values[axis], vdupq_n_f32(params.box_min[axis])));
+      inside = vandq_u32(inside, vcleq_f32(values[axis], vdupq_n_f32(params.box_max[axis])));
+    }
+  }
+  return inside;
+}
+
+// Returns one bit per lane of a comparison result
+inline uint32_t MoveMaskNeon(uint32x4_t mask) {
+  const uint32_t bits[4] = {1, 2, 4, 8};
+  return vaddvq_u32(vandq_u32(mask, vld1q_u32(bits)));
+}
+
+size_t SelectNeon(const float* points, int channels, size_t begin, size_t end,
+                  const PointCloudDownsampleParams& params, bool random, uint64_t threshold,
+                  uint32_t* output) {
+  if (channels != 3 && channels != 4) {
+    return SelectScalar(points, channels, begin, end, params, random, threshold, output);
+  }
+  const uint32_t lane_values[4] = {0, 1, 2, 3};
+  const uint32x4_t lanes = vld1q_u32(lane_values);
+  const uint32x4_t hash_seed = vdupq_n_u32(params.seed * 0x9e3779b9u);
+  const uint32x4_t hash_threshold = vdupq_n_u32(static_cast<uint32_t>(threshold));
+  size_t count = 0;
+  size_t i = begin;
+  for (; i + 4 <= end; i += 4) {
+    float32x4_t x, y, z;
+    LoadPointsNeon(points + i * channels, channels, x, y, z);
+    uint32_t mask = MoveMaskNeon(InsideCropNeon(params, x, y, z));
+    if (random && mask != 0) {
+      uint32x4_t hash = veorq_u32(vaddq_u32(vdupq_n_u32(static_cast<uint32_t>(i)), lanes),
+                                  hash_seed);
+      hash = veorq_u32(hash, vshrq_n_u32(hash, 16));
+      hash = vmulq_u32(hash, vdupq_n_u32(0x85ebca6bu));
+      hash = veorq_u32(hash, vshrq_n_u32(hash, 13));
+      hash = vmulq_u32(hash, vdupq_n_u32(0xc2b2ae35u));
+      hash = veorq_u32(hash, vshrq_n_u32(hash, 16));
+      mask &= MoveMaskNeon(vcltq_u32(hash, hash_threshold));
+    }
+    while (mask != 0) {
+      output[count++] = static_cast<uint32_t>(i) + __builtin_ctz(mask);
+      mask &= mask - 1;
+    }
+  }
+  return count + SelectScalar(points, channels, i, end, params, random, threshold,
+                              output + count);
+}
+
+void VoxelKeysNeon(const float* points, int channels, size_t begin, size_t end,
+                   const PointCloudDownsampleParams& params, uint64_t* keys) {
+  if (channels != 3 && channels != 4) {
+    VoxelKeysScalar(points, channels, begin, end, params, keys);
+    return;
+  }
+  const float32x4_t inverse_voxel_size = vdupq_n_f32(1.0f / params.voxel_size);
+  const float32x4_t min_index =
+      vdupq_n_f32(-static_cast<float>(point_cloud_downsample::kVoxelIndexOffset));
+  const float32x4_t max_index =
+      vdupq_n_f32(static_cast<float>(point_cloud_downsample::kVoxelIndexOffset));
+  const int32x4_t index_offset = vdupq_n_s32(point_cloud_downsample::kVoxelIndexOffset);
+  size_t i = begin;
+  for (; i + 4 <= end; i += 4) {
+    float32x4_t values[3];
+    LoadPointsNeon(points + i * channels, channels, values[0], values[1], values[2]);
+    uint32x4_t valid = InsideCropNeon(params, values[0], values[1], values[2]);
+    uint32_t indices[3][4];
+    for (int axis = 0; axis < 3; axis++) {
+      const float32x4_t scaled = vrndmq_f32(vmulq_f32(values[axis], inverse_voxel_size));
+      valid = vandq_u32(valid, vcgeq_f32(scaled, min_index));
+      valid = vandq_u32(valid, vcltq_f32(scaled, max_index));
+      vst1q_u32(indices[axis], vreinterpretq_u32_s32(
+          vaddq_s32(vcvtq_s32_f32(scaled), index_offset)));
+    }
+    const uint32_t mask = MoveMaskNeon(valid);
+    for (int lane = 0; lane < 4; lane++) {
+      keys[i + lane] = (mask & (1u << lane)) == 0
+          ? kInvalidVoxelKey
+          : (static_cast<uint64_t>(indices[0][lane]) <<
+             (2 * point_cloud_downsample::kVoxelKeyBits)) |
+            (static_cast<uint64_t>(indices[1][lane]) << point_cloud_downsample::kVoxelKeyBits) |
+            static_cast<uint64_t>(indices[2][lane]);
+    }
+  }
+  VoxelKeysScalar(points, channels, i, end, params, keys);
+}
+#endif  // ISAAC_IMAGE_HAS_NEON
+
+size_t Select(SimdBackend backend, const float* points, int channels, size_t begin, size_t end,
+              const PointCloudDownsampleParams& params, bool random, uint64_t threshold,
+              uint32_t* output) {
+#if defined(ISAAC_IMAGE_HAS_AVX2)
+  if (backend == SimdBackend::kAvx2) {
+    return SelectAvx2(points, channels, begin, end, params, random, threshold, output);
+  }
+#endif
+#if defined(ISAAC_IMAGE_HAS_NEON)
+  if (backend == SimdBackend::kNeon) {
+    return SelectNeon(points, channels, begin, end, params, random, threshold, output);
+  }
+#endif
+  (void)backend;
+  return SelectScalar(points, channels, begin, end, params, random, threshold, output);
+}
+
+void VoxelKeys(SimdBackend backend, const float* points, int channels, size_t begin, size_t end,
+               const PointCloudDownsampleParams& params, uint64_t* keys) {
+#if defined(ISAAC_IMAGE_HAS_AVX2)
+  if (backend == SimdBackend::kAvx2) {
+    VoxelKeysAvx2(points, channels, begin, end, params, keys);
+    return;
+  }
+#endif
+#if defined(ISAAC_IMAGE_HAS_NEON)
+  if (backend == SimdBackend::kNeon) {
+    VoxelKeysNeon(points, channels, begin, end, params, keys);
+    return;
+  }
+#endif
+  (void)backend;
+  VoxelKeysScalar(points, channels, begin, end, params, keys);
+}
+
+}  // namespace
+
+size_t PointCloudDownsampleCpu::select(const float* points, size_t count, int channels,
+                                       const PointCloudDownsampleParams& params,
+                                       int num_threads) {
+  points_ = points;
+  count_ = count;
+  channels_ = channels;
+  params_ = params;
+  all_points_ = false;
+  indices_.clear();
+  voxels_.clear();
+  const int tasks = CountTasks(count, num_threads);
+  if (params.mode == PointCloudDownsampleMode::kVoxelGrid) {
+    return selectVoxels(tasks);
+  }
+  return selectPoints(tasks);
+}
+
+size_t PointCloudDownsampleCpu::selectPoints(int tasks) {
+  const bool crop = params_.crop_range || params_.crop_box;
+  const uint64_t threshold = point_cloud_downsample::RandomThreshold(params_.keep_ratio);
+  const bool random = params_.mode == PointCloudDownsampleMode::kRandom &&
+                      threshold < (uint64_t(1) << 32);
+  const size_t stride = params_.mode == PointCloudDownsampleMode::kStride
+                            ? static_cast<size_t>(std::max(1, params_.stride))
+                            : 1;
+
+  if (!crop && !random) {
+    if (stride == 1) {
+      all_points_ = true;
+      return count_;
+    }
+    indices_.resize((count_ + stride - 1) / stride);
+    for (size_t i = 0; i < indices_.size(); i++) {
+      indices_[i] = static_cast<uint32_t>(i * stride);
+    }
+    return indices_.size();
+  }
+
+  // Every thread selects points of its part of the cloud, then the parts are concatenated
+  const SimdBackend backend = vectorized_details::Resolve(DetectSimdBackend());
+  if (task_indices_.size() < static_cast<size_t>(tasks)) {
+    task_indices_.resize(tasks);
+  }
+  vectorized_details::ParallelForRows(tasks, static_cast<int>(count_),
+                                      [&](int task, int begin, int end) {
+    auto& indices = task_indices_[task];
+    indices.resize(end - begin);
+    indices.resize(Select(backend, points_, channels_, begin, end, params_, random, threshold,
+                          indices.data()));
+  });
+  size_t selected = 0;
+  for (int task = 0; task < tasks; task++) {
+    selected += task_indices_[task].size();
+  }
+  indices_.resize(selected);
+  auto target = indices_.begin();
+  for (int task = 0; task < tasks; task++) {
+    target = std::copy(task_indices_[task].begin(), task_indices_[task].end(), target);
+  }
+
+  // The stride applies to the points which passed the crop
+  if (stride > 1) {
+    size_t kept = 0;
+    for (size_t i = 0; i < indices_.size(); i += stride) {
+      indices_[kept++] = indices_[i];
+    }
+    indices_.resize(kept);
+  }
+  return indices_.size();
+}
+
+size_t PointCloudDownsampleCpu::selectVoxels(int tasks) {
+  const SimdBackend backend = vectorized_details::Resolve(DetectSimdBackend());
+  keys_.resize(count_);
+  hashes_.resize(count_);
+
+  // Voxels are split between threads by the hash of their key, so that every thread sums the
+  // points of its voxels without synchronization. Every thread first counts the points of its
+  // part of the cloud in every shard.
+  const size_t num_shards = static_cast<size_t>(tasks);
+  task_shard_offsets_.assign(num_shards * num_shards, 0);
+  vectorized_details::ParallelForRows(tasks, static_cast<int>(count_),
+                                      [&](int task, int begin, int end) {
+    VoxelKeys(backend, points_, channels_, begin, end, params_, keys_.data());
+    size_t* counts = task_shard_offsets_.data() + task * num_shards;
+    for (int i = begin; i < end; i++) {
+      if (keys_[i] == kInvalidVoxelKey) {
+        continue;
+      }
+      hashes_[i] = HashKey(keys_[i]);
+      counts[ShardOf(hashes_[i], tasks)]++;
+    }
+  });
+
+  // Points are grouped by shard, then by thread, so that every shard lists its points in order
+  shard_begins_.resize(num_shards + 1);
+  size_t offset = 0;
+  for (size_t shard = 0; shard < num_shards; shard++) {
+    shard_begins_[shard] = offset;
+    for (size_t task = 0; task < num_shards; task++) {
+      const size_t count = task_shard_offsets_[task * num_shards + shard];
+      task_shard_offsets_[task * num_shards + shard] = offset;
+      offset += count;
+    }
+  }
+  shard_begins_[num_shards] = offset;
+  shard_points_.resize(offset);
+  vectorized_details::ParallelForRows(tasks, static_cast<int>(count_),
+                                      [&](int task, int begin, int end) {
+    size_t* offsets = task_shard_offsets_.data() + task * num_shards;
+    for (int i = begin; i < end; i++) {
+      if (keys_[i] != kInvalidVoxelKey) {
+        shard_points_[offsets[ShardOf(hashes_[i], tasks)]++] = static_cast<uint32_t>(i);
+      }
+    }
+  });
+
+  if (shards_.size() < num_shards) {
+    shards_.resize(num_shards);
+  }
+  vectorized_details::ParallelForRows(tasks, tasks, [&](int task, int, int) {
+    accumulateShard(shards_[task], shard_begins_[task], shard_begins_[task + 1]);
+  });
+
+  const uint32_t min_points = static_cast<uint32_t>(std::max(1, params_.min_points_per_voxel));
+  for (int task = 0; task < tasks; task++) {
+    for (const uint32_t slot : shards_[task].order) {
+      const Voxel& voxel = shards_[task].table[slot];
+      if (voxel.accumulator.count >= min_points) {
+        voxels_.push_back(&voxel);
+      }
+    }
+  }
+  // Every shard lists its voxels by first point already, so this only interleaves the shards
+  if (tasks > 1) {
+    std::sort(voxels_.begin(), voxels_.end(), [](const Voxel* a, const Voxel* b) {
+      return a->first_point < b->first_point;
+    });
+  }
+  return voxels_.size();
+}
+
+void PointCloudDownsampleCpu::accumulateShard(Shard& shard, size_t begin, size_t end) const {
+  // Start with a table large enough for the voxels of the previous cloud
+  size_t table_size = kMinTableSize;
+  while (table_size < 2 * shard.order.size()) {
+    table_size *= 2;
+  }
+  shard.order.clear();
+  shard.table.assign(table_size, Voxel{kInvalidVoxelKey, 0, {}});
+  size_t mask = table_size - 1;
+
+  // Returns the slot of a key, or the empty slot where it has to be inserted
+  const auto find_slot = [&](uint64_t key, uint64_t hash) {
+    size_t slot = hash & mask;
+    while (shard.table[slot].key != key && shard.table[slot].key != kInvalidVoxelKey) {
+      slot = (slot + 1) & mask;
+    }
+    return slot;
+  };
+  // Doubles the size of the table
+  const auto grow = [&]() {
+    std::vector<Voxel> table(2 * shard.table.size(), Voxel{kInvalidVoxelKey, 0, {}});
+    std::swap(table, shard.table);
+    mask = shard.table.size() - 1;
+    for (uint32_t& slot : shard.order) {
+      const Voxel& voxel = table[slot];
+      slot = static_cast<uint32_t>(find_slot(voxel.key, HashKey(voxel.key)));
+      shard.table[slot] = voxel;
+    }
+  };
+
+  // Points are processed in batches: the slots of all points of a batch are prefetched before the
+  // points are summed, which hides part of the latency of tables which do not fit in cache
+  for (size_t batch = begin; batch < end; batch += kBatchSize) {
+    const size_t batch_end = std::min(end, batch + kBatchSize);
+    for (size_t k = batch; k < batch_end; k++) {
+      __builtin_prefetch(&shard.table[hashes_[shard_points_[k]] & mask]);
+    }
+    for (size_t k = batch; k < batch_end; k++) {
+      const uint32_t i = shard_points_[k];
+      const uint64_t key = keys_[i];
+      size_t slot = find_slot(key, hashes_[i]);
+      if (shard.table[slot].key == kInvalidVoxelKey) {
+        // Keep the table at most half full
+        if (2 * (shard.order.size() + 1) > shard.table.size()) {
+          grow();
+          slot = find_slot(key, hashes_[i]);
+        }
+        shard.table[slot].key = key;
+        shard.table[slot].first_point = i;
+        shard.order.push_back(static_cast<uint32_t>(slot));
+      }
+      float origin_x, origin_y, origin_z;
+      point_cloud_downsample::VoxelOrigin(key, params_.voxel_size, origin_x, origin_y, origin_z);
+      point_cloud_downsample::Accumulate(points_ + i * channels_, channels_, origin_x, origin_y,
+                                         origin_z, shard.table[slot].accumulator);
+    }
+  }
+}
+
+void PointCloudDownsampleCpu::write(float* output, int num_threads) const {
+  const size_t channels = channels_;
+  if (all_points_) {
+    std::memcpy(output, points_, count_ * channels * sizeof(float));
+    return;
+  }
+  const size_t count = voxels_.empty() ? indices_.size() : voxels_.size();
+  const int tasks = CountTasks(count, num_threads);
+  vectorized_details::ParallelForRows(tasks, static_cast<int>(count),
+                                      [&](int, int begin, int end) {
+    if (voxels_.empty()) {
+      for (int i = begin; i < end; i++) {
+        std::memcpy(output + i * channels, points_ + indices_[i] * channels,
+                    channels * sizeof(float));
+      }
+    } else {
+      for (int i = begin; i < end; i++) {
+        const Voxel& voxel = *voxels_[i];
+        point_cloud_downsample::WriteCentroid(voxel.key, params_.voxel_size, voxel.accumulator,
+                                              channels_, output + i * channels);
+      }
+    }
+  });
+}
+
+}  // namespace isaac
+}  // namespace nvidia
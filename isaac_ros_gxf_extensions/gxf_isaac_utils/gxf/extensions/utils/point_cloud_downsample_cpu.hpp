@@ -0,0 +1,95 @@
+// SPDX-FileCopyrightText: NVIDIA CORPORATION & AFFILIATES
+// Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "extensions/utils/point_cloud_downsample_types.hpp"
+
+namespace nvidia {
+namespace isaac {
+
+// Host memory counterpart of PointCloudDownsampleCuda. Selects the same points for the crop, the
+// stride and the random modes. Voxel grid centroids are the same up to float rounding, but are
+// ordered by the first point of every voxel instead of by voxel key.
+//
+// Points are `channels` floats (3, or 4 with color) stored one after the other. Points are split
+// between up to `num_threads` threads (0 for one per hardware thread) and use AVX2 (selected at
+// runtime) or NEON kernels. Memory is kept between clouds, so that downsampling clouds of similar
+// sizes does not allocate.
+class PointCloudDownsampleCpu {
+ public:
+  // Selects the points of a cloud and returns the number of points of the downsampled cloud. The
+  // points must stay valid until `write` is called.
+  size_t select(const float* points, size_t count, int channels,
+                const PointCloudDownsampleParams& params, int num_threads);
+
+  // Writes the downsampled cloud selected by the last call to `select`
+  void write(float* output, int num_threads) const;
+
+ private:
+  // A voxel of the voxel grid
+  struct Voxel {
+    // kInvalidVoxelKey for empty slots of the hash tables
+    uint64_t key;
+    // Index of the first point of the voxel, used to order the voxels
+    uint32_t first_point;
+    point_cloud_downsample::VoxelAccumulator accumulator;
+  };
+
+  // Voxels of the keys which are assigned to one thread. The voxels are stored in an open
+  // addressing hash table, and `order` lists their slots in the order they were created.
+  struct Shard {
+    std::vector<Voxel> table;
+    std::vector<uint32_t> order;
+  };
+
+  size_t selectPoints(int tasks);
+  size_t selectVoxels(int tasks);
+  // Sums the points of the shard, listed in `shard_points_[begin, end[`
+  void accumulateShard(Shard& shard, size_t begin, size_t end) const;
+
+  const float* points_ = nullptr;
+  size_t count_ = 0;
+  int channels_ = 3;
+  PointCloudDownsampleParams params_;
+
+  // True if all points are selected
+  bool all_points_ = false;
+  // Indices of the selected points
+  std::vector<uint32_t> indices_;
+  // Indices selected by every thread
+  std::vector<std::vector<uint32_t>> task_indices_;
+  // Voxel key of every point, kInvalidVoxelKey for points which do not pass the crop
+  std::vector<uint64_t> keys_;
+  // Hash of the voxel key of every point which passes the crop
+  std::vector<uint64_t> hashes_;
+  // Number of points of every thread in every shard, then the offsets where they are written
+  std::vector<size_t> task_shard_offsets_;
+  // Indices of the points which pass the crop grouped by shard, in order within every shard. The
+  // points of shard `s` are in [shard_begins_[s], shard_begins_[s + 1][.
+  std::vector<uint32_t> shard_points_;
+  std::vector<size_t> shard_begins_;
+  std::vector<Shard> shards_;
+  // Selected voxels, ordered by their first point
+  std::vector<const Voxel*> voxels_;
+};
+
+}  // namespace isaac
+}  // namespace nvidia
@@ -0,0 +1,224 @@
+// SPDX-FileCopyrightText: NVIDIA CORPORATION & AFFILIATES
+// Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+// Functions shared by the CPU and the CUDA implementations, so that both select the same points
+#if defined(__CUDACC__)
+#define POINT_CLOUD_DOWNSAMPLE_FUNCTION __host__ __device__ inline
+#else
+#define POINT_CLOUD_DOWNSAMPLE_FUNCTION inline
+#endif
+
+namespace nvidia {
+namespace isaac {
+
+// How the points which pass the crop are reduced
+enum class PointCloudDownsampleMode : int32_t {
+  // All points are kept
+  kNone,
+  // Every `stride`-th point is kept
+  kStride,
+  // Every point is kept with probability `keep_ratio`
+  kRandom,
+  // Points are replaced by the centroid of the points in their voxel
+  kVoxelGrid,
+};
+
+// Parameters of the point cloud downsampling
+struct PointCloudDownsampleParams {
+  PointCloudDownsampleMode mode = PointCloudDownsampleMode::kNone;
+  // Used with kStride
+  int32_t stride = 1;
+  // Used with kRandom. Points are selected by hashing their index with the seed, so a cloud is
+  // always downsampled the same way for a given seed.
+  float keep_ratio = 1.0f;
+  uint32_t seed = 0;
+  // Used with kVoxelGrid. Voxels with less than `min_points_per_voxel` points are dropped.
+  float voxel_size = 0.05f;
+  int32_t min_points_per_voxel = 1;
+  // Points with a distance to the origin outside of [min_range, max_range] are dropped
+  bool crop_range = false;
+  float min_range = 0.0f;
+  float max_range = 0.0f;
+  // Points outside of the axis aligned box [box_min, box_max] are dropped
+  bool crop_box = false;
+  float box_min[3] = {0.0f, 0.0f, 0.0f};
+  float box_max[3] = {0.0f, 0.0f, 0.0f};
+};
+
+namespace point_cloud_downsample {
+
+// Voxel indices are stored on 21 bits per axis in 64-bit keys. Points further than 2^20 voxels
+// from the origin, or with a coordinate which is not finite, do not belong to any voxel.
+constexpr int kVoxelKeyBits = 21;
+constexpr int32_t kVoxelIndexOffset = 1 << (kVoxelKeyBits - 1);
+constexpr uint64_t kVoxelKeyMask = (uint64_t(1) << kVoxelKeyBits) - 1;
+// Marks points without a voxel
+constexpr uint64_t kInvalidVoxelKey = ~uint64_t(0);
+
+// Returns true if the point passes the crop. NaN coordinates never pass an enabled crop.
+POINT_CLOUD_DOWNSAMPLE_FUNCTION bool InsideCrop(const PointCloudDownsampleParams& params,
+                                                float x, float y, float z) {
+  if (params.crop_range) {
+    const float squared_range = x * x + y * y + z * z;
+    if (!(squared_range >= params.min_range * params.min_range &&
+          squared_range <= params.max_range * params.max_range)) {
+      return false;
+    }
+  }
+  if (params.crop_box) {
+    if (!(x >= params.box_min[0] && x <= params.box_max[0] &&
+          y >= params.box_min[1] && y <= params.box_max[1] &&
+          z >= params.box_min[2] && z <= params.box_max[2])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Mixes the bits of the point index and of the seed (murmur3 finalizer)
+POINT_CLOUD_DOWNSAMPLE_FUNCTION uint32_t HashIndex(uint32_t index, uint32_t seed) {
+  uint32_t hash = index ^ (seed * 0x9e3779b9u);
+  hash ^= hash >> 16;
+  hash *= 0x85ebca6bu;
+  hash ^= hash >> 13;
+  hash *= 0xc2b2ae35u;
+  hash ^= hash >> 16;
+  return hash;
+}
+
+// Hashes are compared to this threshold to keep a fraction `ratio` of the points
+POINT_CLOUD_DOWNSAMPLE_FUNCTION uint64_t RandomThreshold(float ratio) {
+  if (!(ratio > 0.0f)) {
+    return 0;
+  }
+  if (ratio >= 1.0f) {
+    return uint64_t(1) << 32;
+  }
+  return static_cast<uint64_t>(static_cast<double>(ratio) * 4294967296.0);
+}
+
+// Returns true if the point with the given index is kept by kRandom
+POINT_CLOUD_DOWNSAMPLE_FUNCTION bool KeepRandom(uint32_t index, uint32_t seed, uint64_t threshold) {
+  return HashIndex(index, seed) < threshold;
+}
+
+// Index of the voxel of a coordinate, or false if it is out of bounds or not finite
+POINT_CLOUD_DOWNSAMPLE_FUNCTION bool VoxelIndex(float value, float inverse_voxel_size,
+                                                int32_t& index) {
+  const float scaled = floorf(value * inverse_voxel_size);
+  if (!(scaled >= -static_cast<float>(kVoxelIndexOffset) &&
+        scaled < static_cast<float>(kVoxelIndexOffset))) {
+    return false;
+  }
+  index = static_cast<int32_t>(scaled);
+  return true;
+}
+
+// Returns the key of the voxel containing the point, or kInvalidVoxelKey
+POINT_CLOUD_DOWNSAMPLE_FUNCTION uint64_t VoxelKey(float x, float y, float z,
+                                                  float inverse_voxel_size) {
+  int32_t ix, iy, iz;
+  if (!VoxelIndex(x, inverse_voxel_size, ix) || !VoxelIndex(y, inverse_voxel_size, iy) ||
+      !VoxelIndex(z, inverse_voxel_size, iz)) {
+    return kInvalidVoxelKey;
+  }
+  return (static_cast<uint64_t>(ix + kVoxelIndexOffset) << (2 * kVoxelKeyBits)) |
+         (static_cast<uint64_t>(iy + kVoxelIndexOffset) << kVoxelKeyBits) |
+         static_cast<uint64_t>(iz + kVoxelIndexOffset);
+}
+
+// Returns the corner with the smallest coordinates of a voxel
+POINT_CLOUD_DOWNSAMPLE_FUNCTION void VoxelOrigin(uint64_t key, float voxel_size, float& x,
+                                                 float& y, float& z) {
+  x = static_cast<float>(static_cast<int32_t>((key >> (2 * kVoxelKeyBits)) & kVoxelKeyMask) -
+                         kVoxelIndexOffset) * voxel_size;
+  y = static_cast<float>(static_cast<int32_t>((key >> kVoxelKeyBits) & kVoxelKeyMask) -
+                         kVoxelIndexOffset) * voxel_size;
+  z = static_cast<float>(static_cast<int32_t>(key & kVoxelKeyMask) - kVoxelIndexOffset) *
+      voxel_size;
+}
+
+// Sums the points of a voxel. Positions are summed relative to the voxel origin to keep the
+// precision of float sums far away from the origin. The four bytes of the color are summed
+// separately, which averages them whatever their order.
+struct VoxelAccumulator {
+  float x = 0.0f;
+  float y = 0.0f;
+  float z = 0.0f;
+  uint32_t color[4] = {0, 0, 0, 0};
+  uint32_t count = 0;
+};
+
+// Adds a point of `channels` floats (3, or 4 with color) to an accumulator
+POINT_CLOUD_DOWNSAMPLE_FUNCTION void Accumulate(const float* point, int channels, float origin_x,
+                                                float origin_y, float origin_z,
+                                                VoxelAccumulator& accumulator) {
+  accumulator.x += point[0] - origin_x;
+  accumulator.y += point[1] - origin_y;
+  accumulator.z += point[2] - origin_z;
+  if (channels > 3) {
+    uint8_t bytes[4];
+    memcpy(bytes, &point[3], sizeof(bytes));
+    for (int i = 0; i < 4; i++) {
+      accumulator.color[i] += bytes[i];
+    }
+  }
+  accumulator.count++;
+}
+
+// Merges two accumulators of the same voxel
+POINT_CLOUD_DOWNSAMPLE_FUNCTION VoxelAccumulator Merge(const VoxelAccumulator& a,
+                                                       const VoxelAccumulator& b) {
+  VoxelAccumulator sum;
+  sum.x = a.x + b.x;
+  sum.y = a.y + b.y;
+  sum.z = a.z + b.z;
+  for (int i = 0; i < 4; i++) {
+    sum.color[i] = a.color[i] + b.color[i];
+  }
+  sum.count = a.count + b.count;
+  return sum;
+}
+
+// Writes the centroid of a voxel as a point of `channels` floats
+POINT_CLOUD_DOWNSAMPLE_FUNCTION void WriteCentroid(uint64_t key, float voxel_size,
+                                                   const VoxelAccumulator& accumulator,
+                                                   int channels, float* point) {
+  float origin_x, origin_y, origin_z;
+  VoxelOrigin(key, voxel_size, origin_x, origin_y, origin_z);
+  const float inverse_count = 1.0f / static_cast<float>(accumulator.count);
+  point[0] = origin_x + accumulator.x * inverse_count;
+  point[1] = origin_y + accumulator.y * inverse_count;
+  point[2] = origin_z + accumulator.z * inverse_count;
+  if (channels > 3) {
+    uint8_t bytes[4];
+    for (int i = 0; i < 4; i++) {
+      bytes[i] = static_cast<uint8_t>(accumulator.color[i] / accumulator.count);
+    }
+    memcpy(&point[3], bytes, sizeof(bytes));
+  }
+}
+
+}  // namespace point_cloud_downsample
+
+}  // namespace isaac
+}  // namespace nvidia
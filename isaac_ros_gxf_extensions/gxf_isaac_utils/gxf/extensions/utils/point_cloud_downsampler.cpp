@@ -0,0 +1,291 @@
+// SPDX-FileCopyrightText: NVIDIA CORPORATION & AFFILIATES
+// Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+#include "extensions/utils/point_cloud_downsampler.hpp"
+
+#include <chrono>
+#include <limits>
+#include <new>
+
+#include "extensions/utils/point_cloud_downsample.cu.hpp"
+#include "gems/gxf_helpers/expected_macro_gxf.hpp"
+#include "messages/point_cloud_message.hpp"
+
+namespace nvidia {
+namespace isaac {
+
+namespace {
+
+// Returns the current time of the steady clock in nanoseconds
+int64_t Now() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Parses the `mode` parameter
+gxf::Expected<PointCloudDownsampleMode> ParseMode(const std::string& mode) {
+  if (mode == "none") {
+    return PointCloudDownsampleMode::kNone;
+  }
+  if (mode == "stride") {
+    return PointCloudDownsampleMode::kStride;
+  }
+  if (mode == "random") {
+    return PointCloudDownsampleMode::kRandom;
+  }
+  if (mode == "voxel_grid") {
+    return PointCloudDownsampleMode::kVoxelGrid;
+  }
+  GXF_LOG_ERROR("Unknown downsampling mode '%s'. Expected none, stride, random or voxel_grid.",
+                mode.c_str());
+  return gxf::Unexpected{GXF_PARAMETER_OUT_OF_RANGE};
+}
+
+}  // namespace
+
+PointCloudDownsampler::PointCloudDownsampler() {}
+
+PointCloudDownsampler::~PointCloudDownsampler() {}
+
+gxf_result_t PointCloudDownsampler::registerInterface(gxf::Registrar* registrar) {
+  gxf::Expected<void> result;
+
+  result &= registrar->parameter(
+      input_, "input", "Input",
+      "Incoming PointCloudMessage");
+  result &= registrar->parameter(
+      output_, "output", "Output",
+      "Downsampled point clouds as PointCloudMessage");
+  result &= registrar->parameter(
+      allocator_, "allocator", "Allocator",
+      "Allocator to allocate output messages");
+  result &= registrar->parameter(
+      mode_, "mode", "Mode",
+      "How the points which pass the crop are reduced: none, stride, random or voxel_grid",
+      std::string("voxel_grid"));
+  result &= registrar->parameter(
+      stride_, "stride", "Stride",
+      "Every stride-th point passing the crop is kept in stride mode", 1);
+  result &= registrar->parameter(
+      keep_ratio_, "keep_ratio", "Keep Ratio",
+      "Fraction of the points passing the crop kept in random mode", 1.0);
+  result &= registrar->parameter(
+      seed_, "seed", "Seed",
+      "Seed of the random mode. Clouds are always downsampled the same way for a given seed.",
+      int64_t{0});
+  result &= registrar->parameter(
+      voxel_size_, "voxel_size", "Voxel Size",
+      "Edge length of the voxels in meters in voxel_grid mode", 0.05);
+  result &= registrar->parameter(
+      min_points_per_voxel_, "min_points_per_voxel", "Minimum Points per Voxel",
+      "Voxels with fewer points are dropped in voxel_grid mode", 1);
+  result &= registrar->parameter(
+      min_range_, "min_range", "Minimum Range",
+      "Points closer to the origin of the cloud are dropped",
+      gxf::Registrar::NoDefaultParameter(), GXF_PARAMETER_FLAGS_OPTIONAL);
+  result &= registrar->parameter(
+      max_range_, "max_range", "Maximum Range",
+      "Points further away from the origin of the cloud are dropped",
+      gxf::Registrar::NoDefaultParameter(), GXF_PARAMETER_FLAGS_OPTIONAL);
+  result &= registrar->parameter(
+      box_min_, "box_min", "Box Minimum",
+      "Minimum x, y and z of the box crop. Points outside of the box are dropped.",
+      gxf::Registrar::NoDefaultParameter(), GXF_PARAMETER_FLAGS_OPTIONAL);
+  result &= registrar->parameter(
+      box_max_, "box_max", "Box Maximum",
+      "Maximum x, y and z of the box crop. Points outside of the box are dropped.",
+      gxf::Registrar::NoDefaultParameter(), GXF_PARAMETER_FLAGS_OPTIONAL);
+  result &= registrar->parameter(
+      num_threads_, "num_threads", "Number of threads",
+      "Maximum number of threads used to downsample clouds in host or system memory. "
+      "0 uses one thread per hardware thread.", 0);
+  result &= registrar->parameter(
+      points_in_metric_, "points_in_metric", "Points In Metric",
+      "Records the number of points of every incoming cloud",
+      gxf::Registrar::NoDefaultParameter(), GXF_PARAMETER_FLAGS_OPTIONAL);
+  result &= registrar->parameter(
+      points_out_metric_, "points_out_metric", "Points Out Metric",
+      "Records the number of points of every downsampled cloud",
+      gxf::Registrar::NoDefaultParameter(), GXF_PARAMETER_FLAGS_OPTIONAL);
+  result &= registrar->parameter(
+      latency_metric_, "latency_metric", "Latency Metric",
+      "Records the time spent downsampling every cloud in milliseconds",
+      gxf::Registrar::NoDefaultParameter(), GXF_PARAMETER_FLAGS_OPTIONAL);
+
+  return gxf::ToResultCode(result);
+}
+
+gxf_result_t PointCloudDownsampler::start() {
+  params_ = PointCloudDownsampleParams{};
+  params_.mode = UNWRAP_OR_RETURN(ParseMode(mode_));
+  if (params_.mode == PointCloudDownsampleMode::kStride && stride_ < 1) {
+    GXF_LOG_ERROR("stride must be at least 1");
+    return GXF_PARAMETER_OUT_OF_RANGE;
+  }
+  if (params_.mode == PointCloudDownsampleMode::kRandom &&
+      !(keep_ratio_ >= 0.0 && keep_ratio_ <= 1.0)) {
+    GXF_LOG_ERROR("keep_ratio must be in [0, 1]");
+    return GXF_PARAMETER_OUT_OF_RANGE;
+  }
+  if (params_.mode == PointCloudDownsampleMode::kVoxelGrid && !(voxel_size_ > 0.0)) {
+    GXF_LOG_ERROR("voxel_size must be greater than 0");
+    return GXF_PARAMETER_OUT_OF_RANGE;
+  }
+  params_.stride = stride_;
+  params_.keep_ratio = static_cast<float>(keep_ratio_);
+  params_.seed = static_cast<uint32_t>(seed_);
+  params_.voxel_size = static_cast<float>(voxel_size_);
+  params_.min_points_per_voxel = min_points_per_voxel_;
+
+  // The range crop is enabled as soon as one of the bounds is set
+  const auto min_range = min_range_.try_get();
+  const auto max_range = max_range_.try_get();
+  if (min_range || max_range) {
+    params_.crop_range = true;
+    params_.min_range = min_range ? static_cast<float>(min_range.value()) : 0.0f;
+    params_.max_range = max_range ? static_cast<float>(max_range.value()) :
+                                    std::numeric_limits<float>::max();
+    if (!(params_.min_range >= 0.0f && params_.min_range <= params_.max_range)) {
+      GXF_LOG_ERROR("min_range and max_range must satisfy 0 <= min_range <= max_range");
+      return GXF_PARAMETER_OUT_OF_RANGE;
+    }
+  }
+
+  const auto box_min = box_min_.try_get();
+  const auto box_max = box_max_.try_get();
+  if (static_cast<bool>(box_min) != static_cast<bool>(box_max)) {
+    GXF_LOG_ERROR("box_min and box_max must be set together");
+    return GXF_PARAMETER_OUT_OF_RANGE;
+  }
+  if (box_min) {
+    if (box_min.value().size() != 3 || box_max.value().size() != 3) {
+      GXF_LOG_ERROR("box_min and box_max must have 3 elements");
+      return GXF_PARAMETER_OUT_OF_RANGE;
+    }
+    params_.crop_box = true;
+    for (int i = 0; i < 3; i++) {
+      params_.box_min[i] = static_cast<float>(box_min.value()[i]);
+      params_.box_max[i] = static_cast<float>(box_max.value()[i]);
+    }
+  }
+
+  return GXF_SUCCESS;
+}
+
+gxf_result_t PointCloudDownsampler::stop() {
+  cuda_.reset();
+  cpu_ = PointCloudDownsampleCpu{};
+  return GXF_SUCCESS;
+}
+
+gxf_result_t PointCloudDownsampler::tick() {
+  gxf::Entity message = UNWRAP_OR_RETURN(input_->receive());
+
+  isaac_ros::messages::PointCloudMessageParts input =
+    UNWRAP_OR_RETURN(isaac_ros::messages::GetPointCloudMessage(message));
+
+  // validate input message
+  const gxf::MemoryStorageType storage_type = input.points->storage_type();
+  if (storage_type != gxf::MemoryStorageType::kDevice &&
+      storage_type != gxf::MemoryStorageType::kHost &&
+      storage_type != gxf::MemoryStorageType::kSystem) {
+    GXF_LOG_ERROR("Input points must be stored in "
+                  "gxf::MemoryStorageType::kDevice, kHost or kSystem");
+    return GXF_INVALID_DATA_FORMAT;
+  }
+  const gxf::Shape shape = input.points->shape();
+  if (input.points->element_type() != gxf::PrimitiveType::kFloat32 || shape.rank() != 2 ||
+      (shape.dimension(1) != 3 && shape.dimension(1) != 4)) {
+    GXF_LOG_ERROR("Input points must be a float tensor of shape [N, 3] or [N, 4]");
+    return GXF_INVALID_DATA_FORMAT;
+  }
+  const size_t count = shape.dimension(0);
+  const int channels = shape.dimension(1);
+  if (count > std::numeric_limits<uint32_t>::max()) {
+    GXF_LOG_ERROR("Input clouds are limited to 2^32 - 1 points");
+    return GXF_INVALID_DATA_FORMAT;
+  }
+  const float* points = UNWRAP_OR_RETURN(input.points->data<float>());
+
+  const int64_t start_time = Now();
+  const bool device = storage_type == gxf::MemoryStorageType::kDevice;
+  size_t output_count = 0;
+  if (device) {
+    // The CUDA backend is only created once a cloud in device memory is received
+    if (!cuda_) {
+      cuda_ = std::make_unique<PointCloudDownsampleCuda>();
+    }
+    const cudaError_t error = cuda_->select(points, count, channels, params_, output_count);
+    if (error != cudaSuccess) {
+      GXF_LOG_ERROR("Failed to downsample point cloud: %s", cudaGetErrorString(error));
+      return GXF_FAILURE;
+    }
+  } else {
+    try {
+      output_count = cpu_.select(points, count, channels, params_, num_threads_);
+    } catch (const std::bad_alloc&) {
+      GXF_LOG_ERROR("Failed to allocate memory to downsample a cloud of %zu points", count);
+      return GXF_OUT_OF_MEMORY;
+    }
+  }
+
+  // The message is created without points, so that the points are only allocated once, in the
+  // same kind of memory as the input cloud
+  isaac_ros::messages::PointCloudMessageParts output =
+    UNWRAP_OR_RETURN(isaac_ros::messages::CreatePointCloudMessage(
+        context(), allocator_, 0, channels == 4));
+  RETURN_IF_ERROR(output.points->reshape<float>(
+      gxf::Shape{static_cast<int32_t>(output_count), channels}, storage_type, allocator_));
+  float* output_points = UNWRAP_OR_RETURN(output.points->data<float>());
+  if (device) {
+    const cudaError_t error = cuda_->write(output_points);
+    if (error != cudaSuccess) {
+      GXF_LOG_ERROR("Failed to write downsampled point cloud: %s", cudaGetErrorString(error));
+      return GXF_FAILURE;
+    }
+  } else {
+    cpu_.write(output_points, num_threads_);
+  }
+  const int64_t latency = Now() - start_time;
+
+  // forward other components as is
+  *output.info = *input.info;
+  *output.pose_frame_uid = *input.pose_frame_uid;
+  *output.timestamp = *input.timestamp;
+
+  RETURN_IF_ERROR(output_->publish(output.message));
+
+  // Update metrics
+  auto points_in_metric = points_in_metric_.try_get();
+  if (points_in_metric) {
+    points_in_metric.value()->record(static_cast<double>(count));
+  }
+  auto points_out_metric = points_out_metric_.try_get();
+  if (points_out_metric) {
+    points_out_metric.value()->record(static_cast<double>(output_count));
+  }
+  auto latency_metric = latency_metric_.try_get();
+  if (latency_metric) {
+    latency_metric.value()->record(static_cast<double>(latency) / 1e6);
+  }
+  GXF_LOG_DEBUG("Downsampled point cloud from %zu to %zu points in %.3f ms", count, output_count,
+                static_cast<double>(latency) / 1e6);
+
+  return GXF_SUCCESS;
+}
+
+}  // namespace isaac
+}  // namespace nvidia
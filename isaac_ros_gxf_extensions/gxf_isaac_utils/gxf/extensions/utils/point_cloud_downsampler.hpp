@@ -0,0 +1,83 @@
+// SPDX-FileCopyrightText: NVIDIA CORPORATION & AFFILIATES
+// Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "extensions/utils/point_cloud_downsample_cpu.hpp"
+#include "extensions/utils/point_cloud_downsample_types.hpp"
+#include "gxf/std/allocator.hpp"
+#include "gxf/std/codelet.hpp"
+#include "gxf/std/metric.hpp"
+#include "gxf/std/receiver.hpp"
+#include "gxf/std/transmitter.hpp"
+
+namespace nvidia {
+namespace isaac {
+
+class PointCloudDownsampleCuda;
+
+// Point cloud downsampler
+//
+// This codelet consumes a PointCloudMessage, drops the points outside of an optional range or box
+// crop, and reduces the remaining points with one of the following modes:
+//  - "none": all points are kept
+//  - "stride": every `stride`-th point is kept
+//  - "random": points are kept with probability `keep_ratio`, using a hash of their index
+//  - "voxel_grid": points are replaced by the centroid of the points in their voxel
+// Clouds in device memory are downsampled with CUDA, clouds in host or system memory on the CPU.
+// The downsampled cloud is stored in the same kind of memory as the input cloud, so clouds never
+// make a round trip through host memory.
+class PointCloudDownsampler : public gxf::Codelet {
+ public:
+  PointCloudDownsampler();
+  ~PointCloudDownsampler();
+
+  gxf_result_t registerInterface(gxf::Registrar* registrar) override;
+  gxf_result_t start() override;
+  gxf_result_t stop() override;
+
+  gxf_result_t tick() override;
+
+ private:
+  gxf::Parameter<gxf::Handle<gxf::Receiver>> input_;
+  gxf::Parameter<gxf::Handle<gxf::Transmitter>> output_;
+  gxf::Parameter<gxf::Handle<gxf::Allocator>> allocator_;
+  gxf::Parameter<std::string> mode_;
+  gxf::Parameter<int32_t> stride_;
+  gxf::Parameter<double> keep_ratio_;
+  gxf::Parameter<int64_t> seed_;
+  gxf::Parameter<double> voxel_size_;
+  gxf::Parameter<int32_t> min_points_per_voxel_;
+  gxf::Parameter<double> min_range_;
+  gxf::Parameter<double> max_range_;
+  gxf::Parameter<std::vector<double>> box_min_;
+  gxf::Parameter<std::vector<double>> box_max_;
+  gxf::Parameter<int32_t> num_threads_;
+  gxf::Parameter<gxf::Handle<gxf::Metric>> points_in_metric_;
+  gxf::Parameter<gxf::Handle<gxf::Metric>> points_out_metric_;
+  gxf::Parameter<gxf::Handle<gxf::Metric>> latency_metric_;
+
+  PointCloudDownsampleParams params_;
+  PointCloudDownsampleCpu cpu_;
+  std::unique_ptr<PointCloudDownsampleCuda> cuda_;
+};
+
+}  // namespace isaac
+}  // namespace nvidia
@@ -0,0 +1,185 @@
+// SPDX-FileCopyrightText: NVIDIA CORPORATION & AFFILIATES
+// Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+#include "extensions/utils/segregated_fit_arena_allocator.hpp"
+
+#include <limits>
+
+namespace nvidia {
+namespace isaac {
+
+namespace {
+
+// Converts a policy name to the strategy of the free lists
+gxf::Expected<gxf::SegregatedFitAllocatorBase::Policy> ParsePolicy(const std::string& policy) {
+  if (policy == "best_fit") {
+    return gxf::SegregatedFitAllocatorBase::Policy::kBestFit;
+  }
+  if (policy == "good_fit") {
+    return gxf::SegregatedFitAllocatorBase::Policy::kGoodFit;
+  }
+  GXF_LOG_ERROR("Unknown policy '%s', expected best_fit or good_fit", policy.c_str());
+  return gxf::Unexpected{GXF_PARAMETER_OUT_OF_RANGE};
+}
+
+}  // namespace
+
+gxf_result_t SegregatedFitArenaAllocator::registerInterface(gxf::Registrar* registrar) {
+  if (registrar == nullptr) {
+    return GXF_ARGUMENT_NULL;
+  }
+  gxf::Expected<void> result;
+  result &= registrar->parameter(
+      allocator_, "allocator", "Allocator",
+      "Allocator the arena is reserved from");
+  result &= registrar->parameter(
+      storage_type_, "storage_type", "Storage type",
+      "The memory storage type of the arena. Host=0, Device=1, System=2", 0);
+  result &= registrar->parameter(
+      arena_size_, "arena_size", "Arena Size",
+      "Number of bytes reserved for the arena");
+  result &= registrar->parameter(
+      chunk_size_, "chunk_size", "Chunk Size",
+      "Blocks are a multiple of this number of bytes and aligned on it inside the arena", 256UL);
+  result &= registrar->parameter(
+      policy_, "policy", "Policy",
+      "How a free block is picked: best_fit returns the smallest block large enough, good_fit "
+      "returns any block of the smallest size class which is large enough",
+      std::string("best_fit"));
+  return gxf::ToResultCode(result);
+}
+
+gxf_result_t SegregatedFitArenaAllocator::initialize() {
+  if (chunk_size_ == 0) {
+    GXF_LOG_ERROR("chunk_size must be greater than 0");
+    return GXF_PARAMETER_OUT_OF_RANGE;
+  }
+  const uint64_t number_chunks = arena_size_ / chunk_size_;
+  if (number_chunks == 0 ||
+      number_chunks > static_cast<uint64_t>(std::numeric_limits<int32_t>::max())) {
+    GXF_LOG_ERROR("arena_size %lu holds %lu chunks of %lu bytes, expected between 1 and %d",
+                  arena_size_.get(), number_chunks, chunk_size_.get(),
+                  std::numeric_limits<int32_t>::max());
+    return GXF_PARAMETER_OUT_OF_RANGE;
+  }
+  const auto policy = ParsePolicy(policy_);
+  if (!policy) {
+    return gxf::ToResultCode(policy);
+  }
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  number_chunks_ = static_cast<int32_t>(number_chunks);
+  const auto maybe_arena = allocator_.get()->allocate(
+      number_chunks * chunk_size_, static_cast<gxf::MemoryStorageType>(storage_type_.get()));
+  if (!maybe_arena) {
+    GXF_LOG_ERROR("Failed to reserve an arena of %lu bytes", number_chunks * chunk_size_);
+    return gxf::ToResultCode(maybe_arena);
+  }
+  arena_ = maybe_arena.value();
+  if (!free_lists_.allocate(number_chunks_, policy.value())) {
+    allocator_.get()->free(arena_);
+    arena_ = nullptr;
+    return GXF_OUT_OF_MEMORY;
+  }
+  return GXF_SUCCESS;
+}
+
+gxf_result_t SegregatedFitArenaAllocator::deinitialize() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (arena_ == nullptr) {
+    return GXF_SUCCESS;
+  }
+  const auto stats = free_lists_.stats();
+  if (stats.free_size != stats.total_size) {
+    GXF_LOG_WARNING("%ld bytes of the arena are still in use",
+                    static_cast<int64_t>(stats.total_size - stats.free_size) * chunk_size_);
+  }
+  const auto result = allocator_.get()->free(arena_);
+  arena_ = nullptr;
+  return gxf::ToResultCode(result);
+}
+
+gxf_result_t SegregatedFitArenaAllocator::is_available_abi(uint64_t size) {
+  const uint64_t chunks = numberChunks(size);
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (arena_ == nullptr || chunks > static_cast<uint64_t>(number_chunks_)) {
+    return GXF_FAILURE;
+  }
+  return static_cast<uint64_t>(free_lists_.stats().largest_free_block) >= chunks ? GXF_SUCCESS
+                                                                                : GXF_FAILURE;
+}
+
+gxf_result_t SegregatedFitArenaAllocator::allocate_abi(uint64_t size, int32_t type,
+                                                       void** pointer) {
+  if (pointer == nullptr) {
+    return GXF_ARGUMENT_NULL;
+  }
+  if (type != storage_type_) {
+    GXF_LOG_ERROR("Requested storage type %d does not match the storage type of the arena %d",
+                  type, storage_type_.get());
+    return GXF_ARGUMENT_INVALID;
+  }
+  const uint64_t chunks = numberChunks(size);
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (arena_ == nullptr) {
+    return GXF_FAILURE;
+  }
+  if (chunks > static_cast<uint64_t>(number_chunks_)) {
+    GXF_LOG_ERROR("Requested %lu bytes but the arena only has %lu bytes",
+                  size, number_chunks_ * chunk_size_);
+    return GXF_ARGUMENT_INVALID;
+  }
+  const auto maybe_index = free_lists_.acquire(static_cast<int32_t>(chunks));
+  if (!maybe_index) {
+    return GXF_OUT_OF_MEMORY;
+  }
+  *pointer = arena_ + maybe_index.value() * chunk_size_;
+  return GXF_SUCCESS;
+}
+
+gxf_result_t SegregatedFitArenaAllocator::free_abi(void* pointer) {
+  const byte* block = static_cast<const byte*>(pointer);
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (arena_ == nullptr || block < arena_ ||
+      block >= arena_ + static_cast<uint64_t>(number_chunks_) * chunk_size_ ||
+      (block - arena_) % chunk_size_ != 0) {
+    GXF_LOG_ERROR("Pointer %p was not allocated from this arena", pointer);
+    return GXF_ARGUMENT_INVALID;
+  }
+  const auto result = free_lists_.release(static_cast<int32_t>((block - arena_) / chunk_size_));
+  if (!result) {
+    GXF_LOG_ERROR("Pointer %p is not an allocated block of the arena", pointer);
+    return GXF_ARGUMENT_INVALID;
+  }
+  return GXF_SUCCESS;
+}
+
+uint64_t SegregatedFitArenaAllocator::block_size_abi() const {
+  return chunk_size_;
+}
+
+gxf::SegregatedFitAllocatorBase::Stats SegregatedFitArenaAllocator::stats() const {
+  std::unique_lock<std::mutex> lock(mutex_);
+  return free_lists_.stats();
+}
+
+uint64_t SegregatedFitArenaAllocator::numberChunks(uint64_t size) const {
+  const uint64_t chunks = size / chunk_size_ + (size % chunk_size_ != 0 ? 1 : 0);
+  return chunks == 0 ? 1 : chunks;
+}
+
+}  // namespace isaac
+}  // namespace nvidia
@@ -0,0 +1,66 @@
+// SPDX-FileCopyrightText: NVIDIA CORPORATION & AFFILIATES
+// Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+#include "gxf/std/allocator.hpp"
+#include "gxf/std/gems/suballocators/segregated_fit_allocator_base.hpp"
+
+namespace nvidia {
+namespace isaac {
+
+// Allocator carving blocks of any size out of a single arena reserved from another allocator.
+// Free blocks are kept in segregated lists by size class and merged with their free neighbors on
+// release, which keeps the arena from fragmenting when blocks of very different sizes are allocated
+// and freed for a long time. Sizes are rounded up to a multiple of `chunk_size` bytes.
+class SegregatedFitArenaAllocator : public gxf::Allocator {
+ public:
+  gxf_result_t registerInterface(gxf::Registrar* registrar) override;
+  gxf_result_t initialize() override;
+  gxf_result_t deinitialize() override;
+
+  gxf_result_t is_available_abi(uint64_t size) override;
+  gxf_result_t allocate_abi(uint64_t size, int32_t type, void** pointer) override;
+  gxf_result_t free_abi(void* pointer) override;
+  uint64_t block_size_abi() const override;
+
+  // Returns the fragmentation metrics of the arena. Sizes are in chunks of `chunk_size` bytes.
+  gxf::SegregatedFitAllocatorBase::Stats stats() const;
+
+ private:
+  // Returns the number of chunks needed for `size` bytes, at least one
+  uint64_t numberChunks(uint64_t size) const;
+
+  gxf::Parameter<gxf::Handle<gxf::Allocator>> allocator_;
+  gxf::Parameter<int32_t> storage_type_;
+  gxf::Parameter<uint64_t> arena_size_;
+  gxf::Parameter<uint64_t> chunk_size_;
+  gxf::Parameter<std::string> policy_;
+
+  // Protects the free lists
+  mutable std::mutex mutex_;
+  gxf::SegregatedFitAllocatorBase free_lists_;
+  // Memory managed by this allocator, obtained from `allocator_`
+  byte* arena_ = nullptr;
+  int32_t number_chunks_ = 0;
+};
+
+}  // namespace isaac
+}  // namespace nvidia
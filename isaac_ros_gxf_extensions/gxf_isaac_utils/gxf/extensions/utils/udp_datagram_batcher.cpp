@@ -0,0 +1,159 @@
+// SPDX-FileCopyrightText: NVIDIA CORPORATION & AFFILIATES
+// Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+#include "extensions/utils/udp_datagram_batcher.hpp"
+
+#include <poll.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <thread>
+
+namespace nvidia {
+namespace isaac {
+
+namespace {
+
+// Time waited for the socket to have room again before the first retry, doubled for every retry
+constexpr int64_t kRetryDelayUs = 100;
+
+// Returns the current time of the steady clock in nanoseconds
+int64_t Now() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+}  // namespace
+
+void UdpDatagramBatcher::initialize(int socket, const sockaddr* destination,
+                                    socklen_t destination_length, size_t batch_size,
+                                    uint64_t max_rate, size_t max_retries) {
+  socket_ = socket;
+  destination_length_ = 0;
+  if (destination != nullptr) {
+    destination_length_ = std::min<socklen_t>(destination_length, sizeof(destination_));
+    std::memcpy(&destination_, destination, destination_length_);
+  }
+  max_rate_ = max_rate;
+  max_retries_ = max_retries;
+  // Message headers are prepared once, only the buffers change between batches
+  messages_.assign(batch_size, mmsghdr{});
+  iovecs_.assign(batch_size, iovec{});
+  for (size_t i = 0; i < batch_size; i++) {
+    msghdr& header = messages_[i].msg_hdr;
+    header.msg_name = destination_length_ > 0 ? &destination_ : nullptr;
+    header.msg_namelen = destination_length_;
+    header.msg_iov = &iovecs_[i];
+    header.msg_iovlen = 1;
+  }
+  queued_ = 0;
+  queued_bytes_ = 0;
+  next_send_time_ = 0;
+  sent_ = 0;
+  dropped_ = 0;
+}
+
+gxf::Expected<void> UdpDatagramBatcher::queue(const uint8_t* data, size_t size) {
+  if (queued_ == messages_.size()) {
+    auto result = flush();
+    if (!result) {
+      return result;
+    }
+  }
+  iovecs_[queued_].iov_base = const_cast<uint8_t*>(data);
+  iovecs_[queued_].iov_len = size;
+  queued_++;
+  queued_bytes_ += size;
+  return gxf::Success;
+}
+
+gxf::Expected<void> UdpDatagramBatcher::flush() {
+  if (queued_ == 0) {
+    return gxf::Success;
+  }
+  pace(queued_bytes_);
+  gxf::Expected<void> result = gxf::Success;
+  size_t sent = 0;
+  size_t retry = 0;
+  while (sent < queued_) {
+    // sendmmsg may send fewer datagrams than requested, for example if the send buffer is full
+    const int datagrams = sendmmsg(socket_, &messages_[sent], queued_ - sent, 0);
+    if (datagrams >= 0) {
+      sent += datagrams;
+      retry = 0;
+      continue;
+    }
+    const int error = errno;
+    if (error == EINTR) {
+      continue;
+    }
+    if (error != EAGAIN && error != EWOULDBLOCK && error != ENOBUFS) {
+      GXF_LOG_ERROR("Failed to send to socket: %s", strerror(error));
+      result = gxf::Unexpected{GXF_FAILURE};
+      break;
+    }
+    if (retry < max_retries_) {
+      waitForRoom(error, retry);
+      retry++;
+      continue;
+    }
+    // The socket stays congested: drops the rest of the batch instead of failing
+    const uint64_t previous = dropped_;
+    dropped_ += queued_ - sent;
+    // Logs the first drop, then every time the total doubles, to not flood the log
+    if ((previous ^ dropped_) > previous) {
+      GXF_LOG_WARNING("%lu datagrams have been dropped: %s", dropped_, strerror(error));
+    }
+    break;
+  }
+  sent_ += sent;
+  queued_ = 0;
+  queued_bytes_ = 0;
+  return result;
+}
+
+void UdpDatagramBatcher::pace(size_t bytes) {
+  if (max_rate_ == 0) {
+    return;
+  }
+  // The batch is sent once the previous ones had time to drain at the maximum rate. Idle time is
+  // not accumulated, so a new burst is limited to one batch.
+  const int64_t now = Now();
+  if (next_send_time_ > now) {
+    std::this_thread::sleep_for(std::chrono::nanoseconds(next_send_time_ - now));
+  }
+  const int64_t duration = static_cast<int64_t>(bytes * 1'000'000'000ULL / max_rate_);
+  next_send_time_ = std::max(next_send_time_, now) + duration;
+}
+
+void UdpDatagramBatcher::waitForRoom(int error, size_t retry) {
+  const int64_t delay_us = kRetryDelayUs << std::min<size_t>(retry, 10);
+  if (error == ENOBUFS) {
+    // The interface queue is full, which poll does not report
+    std::this_thread::sleep_for(std::chrono::microseconds(delay_us));
+    return;
+  }
+  pollfd socket_fd;
+  socket_fd.fd = socket_;
+  socket_fd.events = POLLOUT;
+  socket_fd.revents = 0;
+  poll(&socket_fd, 1, static_cast<int>(std::max<int64_t>(delay_us / 1000, 1)));
+}
+
+}  // namespace isaac
+}  // namespace nvidia
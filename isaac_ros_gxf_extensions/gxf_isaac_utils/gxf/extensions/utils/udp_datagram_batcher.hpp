@@ -0,0 +1,86 @@
+// SPDX-FileCopyrightText: NVIDIA CORPORATION & AFFILIATES
+// Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include <sys/socket.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "gxf/core/expected.hpp"
+
+namespace nvidia {
+namespace isaac {
+
+// Sends datagrams to one UDP destination in batches with sendmmsg. The send rate can be limited to
+// avoid bursts overflowing switch buffers.
+//
+// When the socket has no room for a batch (EAGAIN, EWOULDBLOCK or ENOBUFS), sending is retried up
+// to `max_retries` times, then the rest of the batch is dropped and counted instead of failing.
+class UdpDatagramBatcher {
+ public:
+  UdpDatagramBatcher() = default;
+  UdpDatagramBatcher(const UdpDatagramBatcher&) = delete;
+  UdpDatagramBatcher& operator=(const UdpDatagramBatcher&) = delete;
+
+  // Prepares the message headers for batches of at most `batch_size` datagrams. `destination` can
+  // be null for connected sockets. `max_rate` is in bytes per second of UDP payload, 0 means
+  // unlimited.
+  void initialize(int socket, const sockaddr* destination, socklen_t destination_length,
+                  size_t batch_size, uint64_t max_rate, size_t max_retries);
+
+  // Queues a datagram, sending the current batch first if it is full. The data must stay valid
+  // until the next call to `flush`.
+  gxf::Expected<void> queue(const uint8_t* data, size_t size);
+
+  // Sends all the queued datagrams
+  gxf::Expected<void> flush();
+
+  // Number of datagrams sent since initialize
+  uint64_t sent() const { return sent_; }
+  // Number of datagrams dropped since initialize because the socket had no room for them
+  uint64_t dropped() const { return dropped_; }
+
+ private:
+  // Blocks until sending the given number of bytes respects the maximum rate
+  void pace(size_t bytes);
+  // Waits before retrying after the socket reported `error`
+  void waitForRoom(int error, size_t retry);
+
+  int socket_ = -1;
+  sockaddr_storage destination_{};
+  socklen_t destination_length_ = 0;
+  uint64_t max_rate_ = 0;
+  size_t max_retries_ = 0;
+
+  // Message headers and buffers passed to sendmmsg
+  std::vector<mmsghdr> messages_;
+  std::vector<iovec> iovecs_;
+  // Number of datagrams queued in messages_
+  size_t queued_ = 0;
+  // Number of bytes queued in messages_
+  size_t queued_bytes_ = 0;
+  // Time in nanoseconds (steady clock) before which the next batch must not be sent
+  int64_t next_send_time_ = 0;
+
+  uint64_t sent_ = 0;
+  uint64_t dropped_ = 0;
+};
+
+}  // namespace isaac
+}  // namespace nvidia
@@ -18,7 +18,11 @@
 
 #include <sys/eventfd.h>
 #include <sys/poll.h>
+#include <sys/socket.h>
 
+#include <cstring>
+#include <ctime>
+#include <memory>
 #include <utility>
 
 #include "common/span.hpp"
@@ -35,6 +39,12 @@ namespace {
 // with 20 bytes reserved for IP header and 8 bytes reserved for UDP header
 constexpr size_t kUdpMaxPacketSize = 65507;
 
+// Size of the control buffer of a packet, large enough for a SCM_TIMESTAMPNS message
+constexpr size_t kControlSize = CMSG_SPACE(sizeof(timespec));
+
+// Name of the tensor holding the kernel receive timestamps of the packets
+constexpr char kTimestampsTensorName[] = "timestamps";
+
 }
 
 gxf_result_t UdpReceiver::registerInterface(gxf::Registrar* registrar) {
@@ -69,6 +79,21 @@ gxf_result_t UdpReceiver::registerInterface(gxf::Registrar* registrar) {
       receive_buffer_size_, "receive_buffer_size", "Receive Buffer Size",
       "UDP receive buffer size in bytes (overrides value in /proc/sys/net/core/rmem_default)",
       gxf::Registrar::NoDefaultParameter(), GXF_PARAMETER_FLAGS_OPTIONAL);
+  result &= registrar->parameter(
+      batch_receive_, "batch_receive", "Batch Receive",
+      "Receive all the packets of a message with a single recvmmsg call into one buffer. Each "
+      "packet is still published as its own tensor, slicing that buffer.",
+      false);
+  result &= registrar->parameter(
+      kernel_timestamps_, "kernel_timestamps", "Kernel Timestamps",
+      "Publish the kernel receive timestamp (SO_TIMESTAMPNS) of each packet, in nanoseconds, in "
+      "an int64 tensor named 'timestamps'. Requires batch_receive.",
+      false);
+  result &= registrar->parameter(
+      ring_size_, "ring_size", "Ring Size",
+      "Number of message buffers allocated in start and recycled once downstream components "
+      "release them. Only used with batch_receive.",
+      4UL);
   return gxf::ToResultCode(result);
 }
 
@@ -82,6 +107,14 @@ gxf_result_t UdpReceiver::initialize() {
                   kUdpMaxPacketSize);
     return GXF_PARAMETER_OUT_OF_RANGE;
   }
+  if (kernel_timestamps_ && !batch_receive_) {
+    GXF_LOG_ERROR("kernel_timestamps requires batch_receive");
+    return GXF_PARAMETER_OUT_OF_RANGE;
+  }
+  if (batch_receive_ && ring_size_ == 0) {
+    GXF_LOG_ERROR("ring_size must be greater than 0");
+    return GXF_PARAMETER_OUT_OF_RANGE;
+  }
   return GXF_SUCCESS;
 }
 
@@ -119,6 +152,42 @@ gxf_result_t UdpReceiver::start() {
     }
   }
 
+  if (kernel_timestamps_) {
+    const int enable = 1;
+    result = setsockopt(socket_->getFileDescriptor(), SOL_SOCKET, SO_TIMESTAMPNS,
+                        &enable, sizeof(enable));
+    if (result != 0) {
+      GXF_LOG_ERROR("%s", strerror(errno));
+      return GXF_FAILURE;
+    }
+  }
+
+  if (batch_receive_) {
+    // Message headers are prepared once, only the buffer addresses change between ticks
+    messages_.assign(packet_accumulation_, mmsghdr{});
+    iovecs_.assign(packet_accumulation_, iovec{});
+    control_.assign(kernel_timestamps_ ? packet_accumulation_ * kControlSize : 0, 0);
+    for (size_t i = 0; i < packet_accumulation_; i++) {
+      messages_[i].msg_hdr.msg_iov = &iovecs_[i];
+      messages_[i].msg_hdr.msg_iovlen = 1;
+    }
+
+    // Message buffers are allocated once and recycled
+    ring_.clear();
+    next_slot_ = 0;
+    for (size_t i = 0; i < ring_size_; i++) {
+      auto slot = std::make_shared<RingSlot>();
+      auto maybe = slot->buffer.resize(allocator_, packet_accumulation_ * buffer_size_,
+                                       gxf::MemoryStorageType::kSystem);
+      if (!maybe) {
+        GXF_LOG_ERROR("Failed to allocate the receive buffers");
+        return gxf::ToResultCode(maybe);
+      }
+      ring_.push_back(std::move(slot));
+    }
+  }
+  truncated_packets_ = 0;
+
   // Create event file descriptor
   event_fd_ = eventfd(0, 0);
   if (event_fd_ < 0) {
@@ -140,34 +209,10 @@ gxf_result_t UdpReceiver::tick() {
   }
 
   // Accumulate packets and add them to message entity as tensors
-  for (size_t packet = 0; packet < packet_accumulation_; packet++) {
-    gxf::MemoryBuffer buffer;
-    gxf::Handle<gxf::Tensor> tensor;
-    auto result = entity->add<gxf::Tensor>()
-        .assign_to(tensor)
-        .and_then([&]() {
-          return buffer.resize(allocator_, buffer_size_, gxf::MemoryStorageType::kSystem);
-        })
-        .and_then([&]() -> gxf::Expected<int> {
-          Span<char> span(reinterpret_cast<char*>(buffer.pointer()), buffer.size());
-          // This call will block if there is no data available on the socket
-          const int received = socket_->readPacket(span.data(), span.size());
-          if (received < 0) {
-            GXF_LOG_ERROR("Failed to read from socket");
-            return gxf::Unexpected{GXF_FAILURE};
-          }
-          return received;
-        })
-        .map([&](int size) {
-          return tensor->wrapMemoryBuffer({size},
-                                          gxf::PrimitiveType::kUnsigned8,
-                                          PrimitiveTypeSize(gxf::PrimitiveType::kUnsigned8),
-                                          gxf::Unexpected{GXF_UNINITIALIZED_VALUE},
-                                          std::move(buffer));
-        });
-    if (!result) {
-      return gxf::ToResultCode(result);
-    }
+  auto result = batch_receive_ ? receivePacketBatch(entity.value())
+                               : receivePackets(entity.value());
+  if (!result) {
+    return gxf::ToResultCode(result);
   }
 
   // Put main thread in a waiting state until socket has data to read
@@ -204,9 +249,177 @@ gxf_result_t UdpReceiver::stop() {
   // Close UDP socket
   socket_->closeSocket();
 
+  // Slots still referenced by tensors are released with the last of them
+  ring_.clear();
+
   return GXF_SUCCESS;
 }
 
+gxf::Expected<void> UdpReceiver::receivePackets(gxf::Entity& entity) {
+  for (size_t packet = 0; packet < packet_accumulation_; packet++) {
+    gxf::MemoryBuffer buffer;
+    gxf::Handle<gxf::Tensor> tensor;
+    auto result = entity.add<gxf::Tensor>()
+        .assign_to(tensor)
+        .and_then([&]() {
+          return buffer.resize(allocator_, buffer_size_, gxf::MemoryStorageType::kSystem);
+        })
+        .and_then([&]() -> gxf::Expected<int> {
+          Span<char> span(reinterpret_cast<char*>(buffer.pointer()), buffer.size());
+          // This call will block if there is no data available on the socket. With MSG_TRUNC the
+          // size of the datagram is returned even if it did not fit in the buffer.
+          const ssize_t received = recv(socket_->getFileDescriptor(), span.data(), span.size(),
+                                        MSG_TRUNC);
+          if (received < 0) {
+            GXF_LOG_ERROR("Failed to read from socket: %s", strerror(errno));
+            return gxf::Unexpected{GXF_FAILURE};
+          }
+          if (static_cast<size_t>(received) > span.size()) {
+            reportTruncatedPackets(1);
+            return static_cast<int>(span.size());
+          }
+          return static_cast<int>(received);
+        })
+        .map([&](int size) {
+          return tensor->wrapMemoryBuffer({size},
+                                          gxf::PrimitiveType::kUnsigned8,
+                                          PrimitiveTypeSize(gxf::PrimitiveType::kUnsigned8),
+                                          gxf::Unexpected{GXF_UNINITIALIZED_VALUE},
+                                          std::move(buffer));
+        });
+    if (!result) {
+      return gxf::ForwardError(result);
+    }
+  }
+  return gxf::Success;
+}
+
+gxf::Expected<void> UdpReceiver::receivePacketBatch(gxf::Entity& entity) {
+  const size_t count = packet_accumulation_;
+
+  // All the packets of the message share one buffer. It can be reused once the last tensor slicing
+  // it is destroyed.
+  auto maybe_slot = acquireSlot();
+  if (!maybe_slot) {
+    return gxf::ForwardError(maybe_slot);
+  }
+  std::shared_ptr<RingSlot> slot = std::move(maybe_slot.value());
+  for (size_t i = 0; i < count; i++) {
+    iovecs_[i].iov_base = slot->buffer.pointer() + i * buffer_size_;
+    iovecs_[i].iov_len = buffer_size_;
+    msghdr& header = messages_[i].msg_hdr;
+    header.msg_control = kernel_timestamps_ ? &control_[i * kControlSize] : nullptr;
+    header.msg_controllen = kernel_timestamps_ ? kControlSize : 0;
+  }
+
+  // Blocks until the first packet is available, then reads all the packets already queued in the
+  // socket with one system call.
+  size_t received = 0;
+  while (received < count) {
+    const int packets = recvmmsg(socket_->getFileDescriptor(), &messages_[received],
+                                 count - received, MSG_WAITFORONE, nullptr);
+    if (packets < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      GXF_LOG_ERROR("Failed to read from socket: %s", strerror(errno));
+      return gxf::Unexpected{GXF_FAILURE};
+    }
+    received += packets;
+  }
+
+  size_t truncated = 0;
+  for (size_t i = 0; i < count; i++) {
+    if (messages_[i].msg_hdr.msg_flags & MSG_TRUNC) {
+      truncated++;
+    }
+  }
+  if (truncated > 0) {
+    reportTruncatedPackets(truncated);
+  }
+
+  gxf::Expected<void> result;
+  for (size_t i = 0; i < count; i++) {
+    auto tensor = entity.add<gxf::Tensor>();
+    if (!tensor) {
+      return gxf::ForwardError(tensor);
+    }
+    slot->references.fetch_add(1, std::memory_order_relaxed);
+    result = tensor.value()->wrapMemory(
+        {static_cast<int32_t>(messages_[i].msg_len)},
+        gxf::PrimitiveType::kUnsigned8, PrimitiveTypeSize(gxf::PrimitiveType::kUnsigned8),
+        gxf::Unexpected{GXF_UNINITIALIZED_VALUE}, gxf::MemoryStorageType::kSystem,
+        iovecs_[i].iov_base, [slot](void*) {
+          slot->references.fetch_sub(1, std::memory_order_release);
+          return gxf::Success;
+        });
+    if (!result) {
+      slot->references.fetch_sub(1, std::memory_order_relaxed);
+      return gxf::ForwardError(result);
+    }
+  }
+
+  if (!kernel_timestamps_) {
+    return gxf::Success;
+  }
+  gxf::Handle<gxf::Tensor> timestamps;
+  result = entity.add<gxf::Tensor>(kTimestampsTensorName)
+      .assign_to(timestamps)
+      .and_then([&]() {
+        return timestamps->reshape<int64_t>({static_cast<int32_t>(count)},
+                                            gxf::MemoryStorageType::kSystem, allocator_);
+      });
+  if (!result) {
+    return gxf::ForwardError(result);
+  }
+  int64_t* data = reinterpret_cast<int64_t*>(timestamps->pointer());
+  for (size_t i = 0; i < count; i++) {
+    // Packets without a timestamp report 0
+    data[i] = 0;
+    msghdr& header = messages_[i].msg_hdr;
+    for (cmsghdr* message = CMSG_FIRSTHDR(&header); message != nullptr;
+         message = CMSG_NXTHDR(&header, message)) {
+      if (message->cmsg_level == SOL_SOCKET && message->cmsg_type == SCM_TIMESTAMPNS) {
+        timespec time;
+        std::memcpy(&time, CMSG_DATA(message), sizeof(time));
+        data[i] = static_cast<int64_t>(time.tv_sec) * 1'000'000'000 + time.tv_nsec;
+      }
+    }
+  }
+  return gxf::Success;
+}
+
+gxf::Expected<std::shared_ptr<UdpReceiver::RingSlot>> UdpReceiver::acquireSlot() {
+  for (size_t i = 0; i < ring_.size(); i++) {
+    const size_t index = (next_slot_ + i) % ring_.size();
+    // Acquire pairs with the release of the last tensor, so that its readers are done with the
+    // buffer before it is overwritten
+    if (ring_[index]->references.load(std::memory_order_acquire) == 0) {
+      next_slot_ = index + 1;
+      return ring_[index];
+    }
+  }
+  // All the slots are still in use downstream: falls back to a buffer for this message only
+  GXF_LOG_DEBUG("All %zu receive buffers are in use, allocating a new one", ring_.size());
+  auto slot = std::make_shared<RingSlot>();
+  auto result = slot->buffer.resize(allocator_, packet_accumulation_ * buffer_size_,
+                                    gxf::MemoryStorageType::kSystem);
+  if (!result) {
+    return gxf::ForwardError(result);
+  }
+  return slot;
+}
+
+void UdpReceiver::reportTruncatedPackets(size_t count) {
+  const uint64_t previous = truncated_packets_;
+  truncated_packets_ += count;
+  // Logs the first truncation, then every time the total doubles, to not flood the log
+  if ((previous ^ truncated_packets_) > previous) {
+    GXF_LOG_WARNING("%lu packets larger than buffer_size (%zu bytes) have been truncated",
+                    truncated_packets_, buffer_size_.get());
+  }
+}
+
 void UdpReceiver::asyncSocketMonitor() {
   // Poll structure for state
   pollfd state_fds;
@@ -16,13 +16,18 @@
 // SPDX-License-Identifier: Apache-2.0
 #pragma once
 
+#include <sys/socket.h>
+
+#include <atomic>
 #include <memory>
 #include <string>
 #include <thread>
+#include <vector>
 
 #include "gems/coms/socket.hpp"
 #include "gxf/std/allocator.hpp"
 #include "gxf/std/codelet.hpp"
+#include "gxf/std/memory_buffer.hpp"
 #include "gxf/std/scheduling_terms.hpp"
 #include "gxf/std/transmitter.hpp"
 
@@ -43,6 +48,24 @@ class UdpReceiver : public gxf::Codelet {
  private:
   // Asynchronous thread that monitors when the socket has data available to read
   void asyncSocketMonitor();
+  // Reads packets one at a time and adds each of them to the entity as a tensor
+  gxf::Expected<void> receivePackets(gxf::Entity& entity);
+  // Reads all the packets of a message with recvmmsg into a single buffer and adds each of them to
+  // the entity as a tensor slicing that buffer
+  gxf::Expected<void> receivePacketBatch(gxf::Entity& entity);
+
+  // Buffer holding all the packets of a message in batch receive mode. It is reused for another
+  // message once all the tensors slicing it have been released.
+  struct RingSlot {
+    gxf::MemoryBuffer buffer;
+    // Number of tensors slicing the buffer which have not been released yet
+    std::atomic<size_t> references{0};
+  };
+  // Returns a ring slot which is not referenced by any tensor, or a new one if all the slots of the
+  // ring are still in use downstream
+  gxf::Expected<std::shared_ptr<RingSlot>> acquireSlot();
+  // Counts and reports packets which were larger than buffer_size and have been truncated
+  void reportTruncatedPackets(size_t count);
 
   gxf::Parameter<gxf::Handle<gxf::Transmitter>> tensor_;
   gxf::Parameter<gxf::Handle<gxf::Allocator>> allocator_;
@@ -52,6 +75,9 @@ class UdpReceiver : public gxf::Codelet {
   gxf::Parameter<size_t> packet_accumulation_;
   gxf::Parameter<size_t> buffer_size_;
   gxf::Parameter<size_t> receive_buffer_size_;
+  gxf::Parameter<bool> batch_receive_;
+  gxf::Parameter<bool> kernel_timestamps_;
+  gxf::Parameter<size_t> ring_size_;
 
   // UDP socket to receive data from
   std::unique_ptr<::nvidia::isaac::Socket> socket_;
@@ -59,6 +85,16 @@ class UdpReceiver : public gxf::Codelet {
   std::thread thread_;
   // Event file descriptor used to stop async thread
   int event_fd_;
+  // Message headers, packet buffers and control buffers used by recvmmsg, one per packet of a
+  // message. Allocated in start when batch_receive is enabled.
+  std::vector<mmsghdr> messages_;
+  std::vector<iovec> iovecs_;
+  std::vector<char> control_;
+  // Receive buffers allocated in start when batch_receive is enabled, used round robin
+  std::vector<std::shared_ptr<RingSlot>> ring_;
+  size_t next_slot_ = 0;
+  // Number of packets truncated because they were larger than buffer_size
+  uint64_t truncated_packets_ = 0;
 };
 
 }  // namespace isaac
@@ -0,0 +1,262 @@
+// SPDX-FileCopyrightText: NVIDIA CORPORATION & AFFILIATES
+// Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+#include "extensions/utils/udp_sender.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+#include "gxf/std/tensor.hpp"
+
+namespace nvidia {
+namespace isaac {
+
+namespace {
+
+// Maximum size of a UDP packet
+// Assumes a 2 byte size field (65535 bytes maximum)
+// with 20 bytes reserved for IP header and 8 bytes reserved for UDP header
+constexpr size_t kUdpMaxPacketSize = 65507;
+
+// Largest datagram which fits an Ethernet frame with a 1500 bytes MTU
+constexpr size_t kEthernetDatagramSize = 1472;
+
+// Name of the tensor holding kernel receive timestamps published by UdpReceiver
+constexpr char kTimestampsTensorName[] = "timestamps";
+
+}  // namespace
+
+gxf_result_t UdpSender::registerInterface(gxf::Registrar* registrar) {
+  if (registrar == nullptr) {
+    return GXF_ARGUMENT_NULL;
+  }
+  gxf::Expected<void> result;
+  result &= registrar->parameter(
+      tensor_, "tensor", "Tensor",
+      "Tensor input");
+  result &= registrar->parameter(
+      address_, "address", "Address",
+      "Destination IP address");
+  result &= registrar->parameter(
+      port_, "port", "Port",
+      "Destination port number");
+  result &= registrar->parameter(
+      max_datagram_size_, "max_datagram_size", "Maximum Datagram Size",
+      "Tensors larger than this are split in several datagrams. The default fits a 1500 bytes MTU.",
+      kEthernetDatagramSize);
+  result &= registrar->parameter(
+      batch_size_, "batch_size", "Batch Size",
+      "Maximum number of datagrams sent with a single sendmmsg call",
+      64UL);
+  result &= registrar->parameter(
+      max_rate_, "max_rate", "Maximum Rate",
+      "Maximum send rate in bytes per second (UDP payload). 0 means unlimited.",
+      0UL);
+  result &= registrar->parameter(
+      send_buffer_size_, "send_buffer_size", "Send Buffer Size",
+      "UDP send buffer size in bytes (overrides value in /proc/sys/net/core/wmem_default)",
+      gxf::Registrar::NoDefaultParameter(), GXF_PARAMETER_FLAGS_OPTIONAL);
+  result &= registrar->parameter(
+      max_retries_, "max_retries", "Maximum Retries",
+      "Number of times sending is retried when the socket has no room (EAGAIN or ENOBUFS) before "
+      "the rest of the batch is dropped",
+      3UL);
+  result &= registrar->parameter(
+      pacing_queue_size_, "pacing_queue_size", "Pacing Queue Size",
+      "Maximum number of messages waiting to be sent when max_rate is set. Messages received "
+      "while the queue is full are dropped.",
+      4UL);
+  return gxf::ToResultCode(result);
+}
+
+gxf_result_t UdpSender::initialize() {
+  if (max_datagram_size_ == 0 || max_datagram_size_ > kUdpMaxPacketSize) {
+    GXF_LOG_ERROR("max_datagram_size must be greater than 0 and less than or equal to %zu",
+                  kUdpMaxPacketSize);
+    return GXF_PARAMETER_OUT_OF_RANGE;
+  }
+  if (batch_size_ == 0) {
+    GXF_LOG_ERROR("batch_size must be greater than 0");
+    return GXF_PARAMETER_OUT_OF_RANGE;
+  }
+  if (max_rate_ > 0 && pacing_queue_size_ == 0) {
+    GXF_LOG_ERROR("pacing_queue_size must be greater than 0");
+    return GXF_PARAMETER_OUT_OF_RANGE;
+  }
+  return GXF_SUCCESS;
+}
+
+gxf_result_t UdpSender::start() {
+  // Create UDP socket
+  socket_.reset(::nvidia::isaac::Socket::CreateTxUDPSocket(address_, port_));
+  int result = socket_->startSocket();
+  if (result < 0) {
+    GXF_LOG_ERROR("Failed to start socket");
+    return GXF_FAILURE;
+  }
+
+  auto send_buffer_size = send_buffer_size_.try_get();
+  if (send_buffer_size) {
+    int opt = static_cast<int>(send_buffer_size.value());
+    result = setsockopt(socket_->getFileDescriptor(), SOL_SOCKET, SO_SNDBUF, &opt, sizeof(opt));
+    if (result != 0) {
+      GXF_LOG_ERROR("%s", strerror(errno));
+      return GXF_FAILURE;
+    }
+  }
+
+  batcher_.initialize(socket_->getFileDescriptor(),
+                      reinterpret_cast<const sockaddr*>(&socket_->getRemoteAddress()),
+                      sizeof(sockaddr_in), batch_size_, max_rate_, max_retries_);
+  dropped_messages_ = 0;
+
+  if (max_rate_ > 0) {
+    pacing_stop_ = false;
+    pacing_failed_ = false;
+    pacing_thread_ = std::thread([this] { pacingLoop(); });
+  }
+
+  return GXF_SUCCESS;
+}
+
+gxf_result_t UdpSender::tick() {
+  auto entity = tensor_->receive();
+  if (!entity) {
+    return gxf::ToResultCode(entity);
+  }
+  auto result = checkTensors(entity.value());
+  if (!result) {
+    return gxf::ToResultCode(result);
+  }
+
+  if (max_rate_ == 0) {
+    return gxf::ToResultCode(sendTensors(entity.value()));
+  }
+
+  if (pacing_failed_) {
+    GXF_LOG_ERROR("Failed to send a previous message");
+    return GXF_FAILURE;
+  }
+  {
+    std::unique_lock<std::mutex> lock(pacing_mutex_);
+    if (pacing_queue_.size() >= pacing_queue_size_) {
+      const uint64_t previous = dropped_messages_;
+      dropped_messages_++;
+      // Logs the first drop, then every time the total doubles, to not flood the log
+      if ((previous ^ dropped_messages_) > previous) {
+        GXF_LOG_WARNING("%lu messages have been dropped because they arrive faster than "
+                        "max_rate allows", dropped_messages_);
+      }
+      return GXF_SUCCESS;
+    }
+    pacing_queue_.push_back(std::move(entity.value()));
+  }
+  pacing_condition_.notify_one();
+  return GXF_SUCCESS;
+}
+
+gxf_result_t UdpSender::stop() {
+  // Stop the pacing thread, messages which have not been sent yet are discarded
+  if (pacing_thread_.joinable()) {
+    {
+      std::unique_lock<std::mutex> lock(pacing_mutex_);
+      pacing_stop_ = true;
+    }
+    pacing_condition_.notify_one();
+    pacing_thread_.join();
+    pacing_queue_.clear();
+  }
+
+  // Close UDP socket
+  socket_->closeSocket();
+  return GXF_SUCCESS;
+}
+
+gxf::Expected<void> UdpSender::checkTensors(const gxf::Entity& entity) {
+  auto tensors = entity.findAll<gxf::Tensor>();
+  if (!tensors) {
+    return gxf::ForwardError(tensors);
+  }
+  for (const auto& maybe_tensor : tensors.value()) {
+    if (!maybe_tensor) {
+      continue;
+    }
+    const gxf::Handle<gxf::Tensor>& tensor = maybe_tensor.value();
+    if (std::strcmp(tensor.name(), kTimestampsTensorName) == 0) {
+      continue;
+    }
+    if (tensor->storage_type() == gxf::MemoryStorageType::kDevice) {
+      GXF_LOG_ERROR("UdpSender only supports tensors in host or system memory");
+      return gxf::Unexpected{GXF_FAILURE};
+    }
+    auto contiguous = tensor->isContiguous();
+    if (!contiguous || !contiguous.value()) {
+      GXF_LOG_ERROR("UdpSender only supports contiguous tensors");
+      return gxf::Unexpected{GXF_FAILURE};
+    }
+  }
+  return gxf::Success;
+}
+
+gxf::Expected<void> UdpSender::sendTensors(const gxf::Entity& entity) {
+  auto tensors = entity.findAll<gxf::Tensor>();
+  if (!tensors) {
+    return gxf::ForwardError(tensors);
+  }
+  for (const auto& maybe_tensor : tensors.value()) {
+    if (!maybe_tensor) {
+      continue;
+    }
+    const gxf::Handle<gxf::Tensor>& tensor = maybe_tensor.value();
+    if (std::strcmp(tensor.name(), kTimestampsTensorName) == 0) {
+      continue;
+    }
+    // Split the tensor in datagrams
+    const uint8_t* data = tensor->pointer();
+    const size_t size = tensor->element_count() * tensor->bytes_per_element();
+    for (size_t offset = 0; offset < size; offset += max_datagram_size_) {
+      const size_t length = std::min<size_t>(max_datagram_size_, size - offset);
+      auto result = batcher_.queue(data + offset, length);
+      if (!result) {
+        return result;
+      }
+    }
+  }
+  // Datagrams point to the tensors of the message and must be sent before it is released
+  return batcher_.flush();
+}
+
+void UdpSender::pacingLoop() {
+  while (true) {
+    gxf::Entity entity;
+    {
+      std::unique_lock<std::mutex> lock(pacing_mutex_);
+      pacing_condition_.wait(lock, [this] { return pacing_stop_ || !pacing_queue_.empty(); });
+      if (pacing_stop_) {
+        return;
+      }
+      entity = std::move(pacing_queue_.front());
+      pacing_queue_.pop_front();
+    }
+    if (!sendTensors(entity)) {
+      pacing_failed_ = true;
+    }
+  }
+}
+
+}  // namespace isaac
+}  // namespace nvidia
@@ -0,0 +1,86 @@
+// SPDX-FileCopyrightText: NVIDIA CORPORATION & AFFILIATES
+// Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "extensions/utils/udp_datagram_batcher.hpp"
+#include "gems/coms/socket.hpp"
+#include "gxf/std/codelet.hpp"
+#include "gxf/std/receiver.hpp"
+
+namespace nvidia {
+namespace isaac {
+
+// Network interface codelet that receives tensors and sends their content over a UDP socket.
+// Each tensor is split in datagrams of at most `max_datagram_size` bytes which are sent in batches
+// with sendmmsg. The send rate can be limited to avoid bursts overflowing switch buffers, in which
+// case messages are sent by a pacing thread so that the scheduler thread never sleeps.
+// Tensors named "timestamps", as published by UdpReceiver, are not sent.
+class UdpSender : public gxf::Codelet {
+ public:
+  gxf_result_t registerInterface(gxf::Registrar* registrar) override;
+  gxf_result_t initialize() override;
+  gxf_result_t deinitialize() override { return GXF_SUCCESS; }
+
+  gxf_result_t start() override;
+  gxf_result_t tick() override;
+  gxf_result_t stop() override;
+
+ private:
+  // Checks that all the tensors of a message can be sent
+  gxf::Expected<void> checkTensors(const gxf::Entity& entity);
+  // Sends all the tensors of a message
+  gxf::Expected<void> sendTensors(const gxf::Entity& entity);
+  // Sends the messages queued by tick at the maximum rate
+  void pacingLoop();
+
+  gxf::Parameter<gxf::Handle<gxf::Receiver>> tensor_;
+  gxf::Parameter<std::string> address_;
+  gxf::Parameter<uint16_t> port_;
+  gxf::Parameter<size_t> max_datagram_size_;
+  gxf::Parameter<size_t> batch_size_;
+  gxf::Parameter<uint64_t> max_rate_;
+  gxf::Parameter<size_t> send_buffer_size_;
+  gxf::Parameter<size_t> max_retries_;
+  gxf::Parameter<size_t> pacing_queue_size_;
+
+  // UDP socket to send data to
+  std::unique_ptr<::nvidia::isaac::Socket> socket_;
+  // Only used by the scheduler thread without max_rate, and by the pacing thread with it
+  UdpDatagramBatcher batcher_;
+
+  // Pacing thread and the messages waiting to be sent by it
+  std::thread pacing_thread_;
+  std::mutex pacing_mutex_;
+  std::condition_variable pacing_condition_;
+  std::deque<gxf::Entity> pacing_queue_;
+  bool pacing_stop_ = false;
+  // Set by the pacing thread when sending failed, reported by the next tick
+  std::atomic<bool> pacing_failed_{false};
+  // Number of messages dropped because the pacing queue was full
+  uint64_t dropped_messages_ = 0;
+};
+
+}  // namespace isaac
+}  // namespace nvidia
@@ -16,7 +16,12 @@
 // SPDX-License-Identifier: Apache-2.0
 #include "extensions/utils/disparity_to_depth.hpp"
 #include "extensions/utils/image_loader.hpp"
+#include "extensions/utils/image_sequence_loader.hpp"
+#include "extensions/utils/magazine_cache_allocator.hpp"
+#include "extensions/utils/point_cloud_downsampler.hpp"
+#include "extensions/utils/segregated_fit_arena_allocator.hpp"
 #include "extensions/utils/udp_receiver.hpp"
+#include "extensions/utils/udp_sender.hpp"
 #include "gxf/std/extension_factory_helper.hpp"
 
 GXF_EXT_FACTORY_BEGIN()
@@ -37,4 +42,24 @@ GXF_EXT_FACTORY_ADD(0xcb7d1d801f5daf96, 0x985e15059bd5a332,
                     nvidia::isaac::UdpReceiver, nvidia::gxf::Codelet,
                     "Receives packets from a UDP socket and publishes them as tensors");
 
+GXF_EXT_FACTORY_ADD(0xe8c449784aa24418, 0x9790b92ddbe35146,
+                    nvidia::isaac::UdpSender, nvidia::gxf::Codelet,
+                    "Sends tensors as datagrams over a UDP socket");
+
+GXF_EXT_FACTORY_ADD(0xc8ea04b1e799445e, 0xadb11b522cb4b4cd,
+                    nvidia::isaac::ImageSequenceLoader, nvidia::gxf::Codelet,
+                    "Publishes a sequence of image files as video buffers");
+
+GXF_EXT_FACTORY_ADD(0x4f6a2b1ce0d311ef, 0x9a7c3b58d2e1f604,
+                    nvidia::isaac::PointCloudDownsampler, nvidia::gxf::Codelet,
+                    "Crops and downsamples point clouds");
+
+GXF_EXT_FACTORY_ADD(0x9d3e5f1a4c2b11ef, 0xb8e60f7c1a2d9e35,
+                    nvidia::isaac::MagazineCacheAllocator, nvidia::gxf::Allocator,
+                    "Serves the blocks of a block memory pool through per-thread magazine caches");
+
+GXF_EXT_FACTORY_ADD(0xb680f9c435774e49, 0x9f4c61d94f69938d,
+                    nvidia::isaac::SegregatedFitArenaAllocator, nvidia::gxf::Allocator,
+                    "Allocates blocks of any size from an arena with segregated free lists");
+
 GXF_EXT_FACTORY_END()
@@ -0,0 +1,119 @@
+// SPDX-FileCopyrightText: NVIDIA CORPORATION & AFFILIATES
+// Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "gems/composite/composite_view.hpp"
+#include "gems/composite/schema_tensor_archive.hpp"
+#include "gems/core/tensor/tensor.hpp"
+
+namespace nvidia {
+namespace isaac {
+
+namespace {
+
+constexpr int32_t kDimension = 64;
+using State = CompositeContainerArray<double, kDimension>;
+
+// Reads a state element by element, as done by TensorArchiveDecoder
+State Gather(const CpuTensor1d& tensor, const std::vector<int32_t>& indices) {
+  State state;
+  for (int32_t i = 0; i < kDimension; i++) {
+    state[i] = tensor(indices[i]);
+  }
+  return state;
+}
+
+CpuTensor1d RandomTensor(int32_t size, std::mt19937& rng) {
+  CpuTensor1d tensor(size);
+  std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+  for (int32_t i = 0; i < size; i++) {
+    tensor(i) = distribution(rng);
+  }
+  return tensor;
+}
+
+// Indices which select `kDimension` elements from a larger tensor, as blocks of `block_size`
+// consecutive elements in shuffled order
+std::vector<int32_t> BlockIndices(int32_t block_size, std::mt19937& rng) {
+  const int32_t num_blocks = kDimension / block_size;
+  std::vector<int32_t> blocks(2 * num_blocks);
+  std::iota(blocks.begin(), blocks.end(), 0);
+  std::shuffle(blocks.begin(), blocks.end(), rng);
+  std::vector<int32_t> indices;
+  for (int32_t b = 0; b < num_blocks; b++) {
+    for (int32_t i = 0; i < block_size; i++) {
+      indices.push_back(blocks[b] * block_size + i);
+    }
+  }
+  return indices;
+}
+
+}  // namespace
+
+TEST(CompositeCopyPlan, Runs) {
+  const auto identity = CompositeCopyPlan::Create({0, 1, 2, 3, 4, 5, 6, 7});
+  ASSERT_EQ(identity.num_runs(), 1);
+  EXPECT_EQ(identity.runs()[0].target, 0);
+  EXPECT_EQ(identity.runs()[0].source, 0);
+  EXPECT_EQ(identity.runs()[0].length, 8);
+
+  const auto swapped = CompositeCopyPlan::Create({4, 5, 6, 7, 0, 1, 2, 3});
+  ASSERT_EQ(swapped.num_runs(), 2);
+  EXPECT_EQ(swapped.runs()[1].target, 4);
+  EXPECT_EQ(swapped.runs()[1].source, 0);
+  EXPECT_EQ(swapped.runs()[1].length, 4);
+
+  // Runs shorter than kMinAverageRunLength on average are not used
+  EXPECT_EQ(CompositeCopyPlan::Create({1, 0, 3, 2, 5, 4, 7, 6}).num_runs(), 0);
+
+  // Too many runs
+  std::vector<int32_t> many(4 * (CompositeCopyPlan::kMaxRuns + 1));
+  for (size_t i = 0; i < many.size(); i++) {
+    many[i] = static_cast<int32_t>(many.size() - 4 * (i / 4 + 1) + i % 4);
+  }
+  EXPECT_EQ(CompositeCopyPlan::Create(many).num_runs(), 0);
+
+  EXPECT_EQ(CompositeCopyPlan::Create({}).num_runs(), 0);
+}
+
+TEST(CompositeCopyPlan, MatchesGather) {
+  std::mt19937 rng(7);
+  const CpuTensor1d tensor = RandomTensor(2 * kDimension, rng);
+  for (int32_t block_size : {1, 2, 4, 8, 16, 32, 64}) {
+    for (int trial = 0; trial < 20; trial++) {
+      const std::vector<int32_t> indices = BlockIndices(block_size, rng);
+      const auto plan = CompositeCopyPlan::Create(indices);
+      EXPECT_EQ(plan.num_runs() == 0, block_size < CompositeCopyPlan::kMinAverageRunLength)
+          << block_size;
+
+      State state;
+      FromSchemaTensor(tensor.const_view(), plan, state);
+      const State expected = Gather(tensor, indices);
+      for (int32_t i = 0; i < kDimension; i++) {
+        ASSERT_EQ(state[i], expected[i]) << "block size " << block_size << ", element " << i;
+      }
+    }
+  }
+}
+
+}  // namespace isaac
+}  // namespace nvidia
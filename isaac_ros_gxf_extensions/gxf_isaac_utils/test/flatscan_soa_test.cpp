@@ -0,0 +1,187 @@
+// SPDX-FileCopyrightText: NVIDIA CORPORATION & AFFILIATES
+// Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "gems/flatscan/flatscan_soa.hpp"
+
+namespace nvidia {
+namespace isaac {
+
+namespace {
+
+constexpr float kNan = std::numeric_limits<float>::quiet_NaN();
+constexpr float kInfinity = std::numeric_limits<float>::infinity();
+
+// A scan with random ranges, including NaN and infinite ones. The number of beams is not a
+// multiple of the SIMD width so that the remainder loops are tested as well.
+FlatscanSoa RandomScan(size_t count, std::mt19937& rng) {
+  std::uniform_real_distribution<float> range(-1.0f, 30.0f);
+  std::uniform_int_distribution<int> special(0, 15);
+  FlatscanSoa scan;
+  scan.resize(count);
+  for (size_t i = 0; i < count; i++) {
+    scan.angles[i] = -3.0f + 6.0f * static_cast<float>(i) / static_cast<float>(count);
+    switch (special(rng)) {
+      case 0:
+        scan.ranges[i] = kNan;
+        break;
+      case 1:
+        scan.ranges[i] = kInfinity;
+        break;
+      default:
+        scan.ranges[i] = range(rng);
+    }
+  }
+  return scan;
+}
+
+bool SameRanges(const std::vector<float>& a, const std::vector<float>& b) {
+  return a.size() == b.size() && std::memcmp(a.data(), b.data(), a.size() * sizeof(float)) == 0;
+}
+
+}  // namespace
+
+TEST(FlatscanSoa, PackUnpackRoundTrip) {
+  FlatscanSoa scan;
+  scan.resize(3);
+  scan.angles = {-1.5f, 0.0f, 0.25f};
+  scan.ranges = {2.0f, kInfinity, 0.5f};
+
+  std::vector<double> beams(scan.size() * FlatscanIndices::kSize, -1.0);
+  PackFlatscanBeams(scan.angles.data(), scan.ranges.data(), scan.size(), beams.data());
+  for (size_t i = 0; i < scan.size(); i++) {
+    const double* beam = beams.data() + i * FlatscanIndices::kSize;
+    EXPECT_EQ(beam[FlatscanIndices::kAngle], scan.angles[i]);
+    EXPECT_EQ(beam[FlatscanIndices::kRangeStart], 0.0);
+    EXPECT_EQ(beam[FlatscanIndices::kRangeEnd], scan.ranges[i]);
+    EXPECT_EQ(beam[FlatscanIndices::kVisibilityRange], scan.ranges[i]);
+    EXPECT_EQ(beam[FlatscanIndices::kRelativeTime], 0.0);
+  }
+
+  FlatscanSoa unpacked;
+  UnpackFlatscanBeams(beams.data(), scan.size(), unpacked);
+  EXPECT_EQ(unpacked.angles, scan.angles);
+  EXPECT_EQ(unpacked.ranges, scan.ranges);
+  EXPECT_TRUE(unpacked.intensities.empty());
+}
+
+TEST(FlatscanSoa, ClampRanges) {
+  FlatscanSoa scan;
+  scan.resize(5);
+  scan.ranges = {-1.0f, 0.5f, 40.0f, kInfinity, kNan};
+  ClampRanges(scan, 0.1f, 20.0f, SimdBackend::kScalar);
+  EXPECT_EQ(scan.ranges[0], 0.1f);
+  EXPECT_EQ(scan.ranges[1], 0.5f);
+  EXPECT_EQ(scan.ranges[2], 20.0f);
+  EXPECT_EQ(scan.ranges[3], 20.0f);
+  EXPECT_TRUE(std::isnan(scan.ranges[4]));
+}
+
+TEST(FlatscanSoa, MaskInvalidBeams) {
+  FlatscanSoa scan;
+  scan.resize(5);
+  scan.ranges = {-1.0f, 0.5f, 40.0f, kInfinity, kNan};
+  std::vector<uint8_t> valid;
+  EXPECT_EQ(MaskInvalidBeams(scan, 0.1f, 20.0f, 0.0f, &valid, SimdBackend::kScalar), 1);
+  EXPECT_EQ(scan.ranges, (std::vector<float>{0.0f, 0.5f, 0.0f, 0.0f, 0.0f}));
+  EXPECT_EQ(valid, (std::vector<uint8_t>{0, 1, 0, 0, 0}));
+}
+
+TEST(FlatscanSoa, SimdMatchesScalar) {
+  std::mt19937 rng(0);
+  for (size_t count : {0, 1, 7, 8, 9, 1027}) {
+    const FlatscanSoa scan = RandomScan(count, rng);
+
+    FlatscanSoa expected = scan;
+    FlatscanSoa actual = scan;
+    ClampRanges(expected, 0.2f, 25.0f, SimdBackend::kScalar);
+    ClampRanges(actual, 0.2f, 25.0f);
+    EXPECT_TRUE(SameRanges(expected.ranges, actual.ranges)) << count;
+
+    expected = scan;
+    actual = scan;
+    std::vector<uint8_t> expected_valid;
+    std::vector<uint8_t> actual_valid;
+    EXPECT_EQ(MaskInvalidBeams(expected, 0.2f, 25.0f, kInfinity, &expected_valid,
+                               SimdBackend::kScalar),
+              MaskInvalidBeams(actual, 0.2f, 25.0f, kInfinity, &actual_valid)) << count;
+    EXPECT_TRUE(SameRanges(expected.ranges, actual.ranges)) << count;
+    EXPECT_EQ(expected_valid, actual_valid) << count;
+
+    FlatscanBeamDirections directions;
+    directions.update(expected.angles);
+    std::vector<float> expected_x, expected_y, actual_x, actual_y;
+    PolarToCartesian(expected, directions, expected_x, expected_y, SimdBackend::kScalar);
+    PolarToCartesian(expected, directions, actual_x, actual_y);
+    EXPECT_TRUE(SameRanges(expected_x, actual_x)) << count;
+    EXPECT_TRUE(SameRanges(expected_y, actual_y)) << count;
+  }
+}
+
+TEST(FlatscanSoa, DecimateBeams) {
+  FlatscanSoa scan;
+  scan.resize(8, true);
+  scan.angles = {0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f};
+  scan.ranges = {5.0f, 2.0f, 3.0f, kNan, kNan, 4.0f, kNan, kNan};
+  scan.intensities = {10.0f, 11.0f, 12.0f, 13.0f, 14.0f, 15.0f, 16.0f, 17.0f};
+
+  FlatscanSoa decimated;
+  DecimateBeams(scan, 3, decimated);
+  ASSERT_EQ(decimated.size(), 3u);
+  // The closest beam of every group is kept, NaN only if the whole group is NaN
+  EXPECT_EQ(decimated.angles, (std::vector<float>{1.0f, 5.0f, 7.0f}));
+  EXPECT_EQ(decimated.ranges[0], 2.0f);
+  EXPECT_EQ(decimated.ranges[1], 4.0f);
+  EXPECT_TRUE(std::isnan(decimated.ranges[2]));
+  EXPECT_EQ(decimated.intensities, (std::vector<float>{11.0f, 15.0f, 17.0f}));
+
+  DecimateBeams(scan, 1, decimated);
+  EXPECT_EQ(decimated.angles, scan.angles);
+  EXPECT_TRUE(SameRanges(decimated.ranges, scan.ranges));
+}
+
+TEST(FlatscanSoa, BeamDirectionsAreCached) {
+  FlatscanSoa scan;
+  scan.resize(2);
+  scan.angles = {0.0f, 0.5f};
+  scan.ranges = {2.0f, 4.0f};
+
+  FlatscanBeamDirections directions;
+  EXPECT_TRUE(directions.update(scan.angles));
+  EXPECT_FALSE(directions.update(scan.angles));
+
+  std::vector<float> x, y;
+  PolarToCartesian(scan, directions, x, y);
+  EXPECT_FLOAT_EQ(x[0], 2.0f);
+  EXPECT_FLOAT_EQ(y[0], 0.0f);
+  EXPECT_FLOAT_EQ(x[1], 4.0f * std::cos(0.5f));
+  EXPECT_FLOAT_EQ(y[1], 4.0f * std::sin(0.5f));
+
+  scan.angles[1] = 1.0f;
+  EXPECT_TRUE(directions.update(scan.angles));
+  PolarToCartesian(scan, directions, x, y);
+  EXPECT_FLOAT_EQ(x[1], 4.0f * std::cos(1.0f));
+}
+
+}  // namespace isaac
+}  // namespace nvidia
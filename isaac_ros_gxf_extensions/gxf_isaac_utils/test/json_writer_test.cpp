@@ -0,0 +1,160 @@
+// SPDX-FileCopyrightText: NVIDIA CORPORATION & AFFILIATES
+// Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "gems/serialization/json.hpp"
+#include "gems/serialization/json_writer.hpp"
+
+namespace nvidia {
+namespace isaac {
+namespace serialization {
+
+namespace {
+
+// Returns a random string with quotes, backslashes, control and multi-byte characters
+std::string RandomString(std::mt19937& rng) {
+  static const std::vector<std::string> kPieces = {
+      "a", "Z", "0", " ", "\"", "\\", "/", "\n", "\t", "\r", "\b", "\f", std::string(1, '\0'),
+      "\x01", "\x1f", "\x7f", "\xc3\xa9", "\xe2\x82\xac", "\xf0\x9f\x98\x80", "key"};
+  std::string text;
+  const int length = rng() % 12;
+  for (int i = 0; i < length; i++) {
+    text += kPieces[rng() % kPieces.size()];
+  }
+  return text;
+}
+
+// Returns a random number of one of the three kinds of numbers of Json
+Json RandomNumber(std::mt19937& rng) {
+  switch (rng() % 6) {
+    case 0:
+      return static_cast<int64_t>(rng()) - static_cast<int64_t>(rng()) * 4096;
+    case 1:
+      return std::numeric_limits<int64_t>::min() + static_cast<int64_t>(rng() % 3);
+    case 2:
+      return std::numeric_limits<uint64_t>::max() - rng() % 3;
+    case 3:
+      return std::ldexp(std::uniform_real_distribution<double>(-1.0, 1.0)(rng),
+                        static_cast<int>(rng() % 2000) - 1000);
+    case 4:
+      return static_cast<double>(static_cast<int>(rng() % 2001) - 1000);
+    default:
+      return std::uniform_real_distribution<double>(-1e6, 1e6)(rng);
+  }
+}
+
+// Returns a random Json document
+Json RandomJson(std::mt19937& rng, int depth) {
+  switch (depth > 0 ? rng() % 7 : 2 + rng() % 5) {
+    case 0: {
+      Json object = Json::object();
+      const int count = rng() % 5;
+      for (int i = 0; i < count; i++) {
+        object[RandomString(rng)] = RandomJson(rng, depth - 1);
+      }
+      return object;
+    }
+    case 1: {
+      Json array = Json::array();
+      const int count = rng() % 5;
+      for (int i = 0; i < count; i++) {
+        array.push_back(RandomJson(rng, depth - 1));
+      }
+      return array;
+    }
+    case 2:
+      return RandomString(rng);
+    case 3:
+      return rng() % 2 == 0;
+    case 4:
+      return nullptr;
+    default:
+      return RandomNumber(rng);
+  }
+}
+
+}  // namespace
+
+TEST(JsonWriter, RoundTripsJson) {
+  std::mt19937 rng(1);
+  JsonWriter writer;
+  for (int i = 0; i < 2000; i++) {
+    const Json json = RandomJson(rng, 4);
+    writer.clear();
+    writer.value(json);
+    ASSERT_TRUE(writer.complete());
+    // The text can differ from Json::dump in the formatting of floating point numbers only
+    EXPECT_EQ(Json::parse(writer.str()), json) << writer.str();
+  }
+}
+
+TEST(JsonWriter, RoundTripsNumbers) {
+  std::mt19937 rng(2);
+  std::vector<float> floats;
+  std::vector<double> doubles;
+  std::vector<int32_t> integers;
+  for (int i = 0; i < 1000; i++) {
+    const double value = std::ldexp(std::uniform_real_distribution<double>(-1.0, 1.0)(rng),
+                                    static_cast<int>(rng() % 200) - 100);
+    floats.push_back(static_cast<float>(value));
+    doubles.push_back(value);
+    integers.push_back(static_cast<int32_t>(rng()));
+  }
+  floats.push_back(std::numeric_limits<float>::quiet_NaN());
+  doubles.push_back(std::numeric_limits<double>::infinity());
+  floats.push_back(3.0f);
+
+  JsonWriter writer;
+  writer.beginObject()
+      .key("floats").value(floats)
+      .key("doubles").value(doubles)
+      .key("integers").array(integers.data(), integers.size())
+      .key("points").array(floats.data(), floats.size() / 3, 3)
+      .endObject();
+  ASSERT_TRUE(writer.complete());
+  const Json json = Json::parse(writer.str());
+
+  ASSERT_EQ(json["floats"].size(), floats.size());
+  for (size_t i = 0; i + 1 < floats.size(); i++) {
+    if (std::isnan(floats[i])) {
+      EXPECT_TRUE(json["floats"][i].is_null());
+    } else {
+      EXPECT_EQ(json["floats"][i].get<float>(), floats[i]);
+      EXPECT_TRUE(json["floats"][i].is_number_float());
+    }
+  }
+  EXPECT_TRUE(json["floats"].back().is_number_float());
+  for (size_t i = 0; i + 1 < doubles.size(); i++) {
+    EXPECT_EQ(json["doubles"][i].get<double>(), doubles[i]);
+  }
+  EXPECT_TRUE(json["doubles"].back().is_null());
+  for (size_t i = 0; i < integers.size(); i++) {
+    EXPECT_EQ(json["integers"][i].get<int32_t>(), integers[i]);
+  }
+  ASSERT_EQ(json["points"].size(), floats.size() / 3);
+  EXPECT_EQ(json["points"][1][2], json["floats"][5]);
+}
+
+}  // namespace serialization
+}  // namespace isaac
+}  // namespace nvidia
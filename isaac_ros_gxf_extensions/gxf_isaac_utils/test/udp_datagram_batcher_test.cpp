@@ -0,0 +1,149 @@
+// SPDX-FileCopyrightText: NVIDIA CORPORATION & AFFILIATES
+// Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+#include <gtest/gtest.h>
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstring>
+#include <vector>
+
+#include "extensions/utils/udp_datagram_batcher.hpp"
+
+namespace nvidia {
+namespace isaac {
+
+namespace {
+
+// UDP sockets on the loopback interface, the receiving one bound to an ephemeral port
+class Loopback : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    receiver_ = socket(AF_INET, SOCK_DGRAM, 0);
+    ASSERT_GE(receiver_, 0);
+    const int buffer_size = 8 << 20;
+    setsockopt(receiver_, SOL_SOCKET, SO_RCVBUF, &buffer_size, sizeof(buffer_size));
+    address_.sin_family = AF_INET;
+    address_.sin_port = 0;
+    address_.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    ASSERT_EQ(bind(receiver_, reinterpret_cast<sockaddr*>(&address_), sizeof(address_)), 0);
+    socklen_t length = sizeof(address_);
+    ASSERT_EQ(getsockname(receiver_, reinterpret_cast<sockaddr*>(&address_), &length), 0);
+    sender_ = socket(AF_INET, SOCK_DGRAM, 0);
+    ASSERT_GE(sender_, 0);
+  }
+
+  void TearDown() override {
+    close(receiver_);
+    close(sender_);
+  }
+
+  void initialize(UdpDatagramBatcher& batcher, size_t batch_size, uint64_t max_rate) {
+    batcher.initialize(sender_, reinterpret_cast<const sockaddr*>(&address_), sizeof(address_),
+                       batch_size, max_rate, 3);
+  }
+
+  // Receives one datagram, returns its size or -1 after a timeout
+  ssize_t receive(std::vector<uint8_t>& buffer) {
+    pollfd fd{receiver_, POLLIN, 0};
+    if (poll(&fd, 1, 1000) <= 0) { return -1; }
+    return recv(receiver_, buffer.data(), buffer.size(), 0);
+  }
+
+  int receiver_ = -1;
+  int sender_ = -1;
+  sockaddr_in address_{};
+};
+
+}  // namespace
+
+TEST_F(Loopback, SendsAllDatagramsInOrder) {
+  constexpr size_t kDatagrams = 200;
+  constexpr size_t kDatagramSize = 1000;
+  std::vector<uint8_t> data(kDatagrams * kDatagramSize);
+  for (size_t i = 0; i < data.size(); i++) { data[i] = static_cast<uint8_t>(i * 7 + i / 251); }
+
+  UdpDatagramBatcher batcher;
+  initialize(batcher, 16, 0);
+  for (size_t i = 0; i < kDatagrams; i++) {
+    ASSERT_TRUE(batcher.queue(data.data() + i * kDatagramSize, kDatagramSize));
+  }
+  ASSERT_TRUE(batcher.flush());
+  EXPECT_EQ(batcher.sent(), kDatagrams);
+  EXPECT_EQ(batcher.dropped(), 0u);
+
+  std::vector<uint8_t> buffer(2 * kDatagramSize);
+  for (size_t i = 0; i < kDatagrams; i++) {
+    ASSERT_EQ(receive(buffer), static_cast<ssize_t>(kDatagramSize));
+    EXPECT_EQ(std::memcmp(buffer.data(), data.data() + i * kDatagramSize, kDatagramSize), 0);
+  }
+}
+
+TEST_F(Loopback, LimitsRate) {
+  constexpr size_t kBatches = 20;
+  constexpr size_t kBatchSize = 10;
+  constexpr size_t kDatagramSize = 1000;
+  constexpr uint64_t kRate = 2'000'000;
+  std::vector<uint8_t> data(kDatagramSize);
+
+  UdpDatagramBatcher batcher;
+  initialize(batcher, kBatchSize, kRate);
+  const auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < kBatches; i++) {
+    for (size_t j = 0; j < kBatchSize; j++) {
+      ASSERT_TRUE(batcher.queue(data.data(), kDatagramSize));
+    }
+    ASSERT_TRUE(batcher.flush());
+  }
+  const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start)
+      .count();
+  // The first batch is sent right away
+  const double expected = static_cast<double>((kBatches - 1) * kBatchSize * kDatagramSize) / kRate;
+  EXPECT_GE(seconds, expected * 0.99);
+  EXPECT_EQ(batcher.sent(), kBatches * kBatchSize);
+}
+
+TEST(UdpDatagramBatcher, DropsWhenSocketIsFull) {
+  // The peer of a non-blocking datagram socket pair never reads, so its queue fills up and sending
+  // fails with EAGAIN
+  int sockets[2];
+  ASSERT_EQ(socketpair(AF_UNIX, SOCK_DGRAM | SOCK_NONBLOCK, 0, sockets), 0);
+  const int buffer_size = 4096;
+  setsockopt(sockets[0], SOL_SOCKET, SO_SNDBUF, &buffer_size, sizeof(buffer_size));
+  setsockopt(sockets[1], SOL_SOCKET, SO_RCVBUF, &buffer_size, sizeof(buffer_size));
+
+  constexpr size_t kDatagrams = 1000;
+  std::vector<uint8_t> data(512);
+  UdpDatagramBatcher batcher;
+  batcher.initialize(sockets[0], nullptr, 0, 64, 0, 2);
+  for (size_t i = 0; i < kDatagrams; i++) {
+    ASSERT_TRUE(batcher.queue(data.data(), data.size()));
+  }
+  ASSERT_TRUE(batcher.flush());
+  EXPECT_GT(batcher.dropped(), 0u);
+  EXPECT_EQ(batcher.sent() + batcher.dropped(), kDatagrams);
+
+  close(sockets[0]);
+  close(sockets[1]);
+}
+
+}  // namespace isaac
+}  // namespace nvidia
@@ -0,0 +1,147 @@
+// SPDX-FileCopyrightText: NVIDIA CORPORATION & AFFILIATES
+// Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "gems/core/math/utils.hpp"
+#include "gems/image/utils.hpp"
+#include "gems/image/vectorized_utils.hpp"
+
+namespace nvidia {
+namespace isaac {
+
+namespace {
+
+template <typename K, int N>
+Image<K, N> RandomImage(int rows, int cols, std::mt19937& rng) {
+  Image<K, N> image(rows, cols);
+  std::uniform_real_distribution<double> distribution(0.0, 255.0);
+  for (int64_t i = 0; i < image.num_elements(); i++) {
+    image.element_wise_begin()[i] = static_cast<K>(distribution(rng));
+  }
+  return image;
+}
+
+template <typename K, int N>
+bool SameImages(const Image<K, N>& a, const Image<K, N>& b) {
+  return a.rows() == b.rows() && a.cols() == b.cols() &&
+         std::memcmp(a.element_wise_begin(), b.element_wise_begin(),
+                     a.num_elements() * sizeof(K)) == 0;
+}
+
+// Execution settings which split even small images in bands
+std::vector<CpuExecution> Executions() {
+  std::vector<CpuExecution> executions;
+  for (SimdBackend backend : {SimdBackend::kScalar, DetectSimdBackend()}) {
+    for (int num_threads : {1, 3, 8}) {
+      CpuExecution execution;
+      execution.backend = backend;
+      execution.num_threads = num_threads;
+      execution.min_pixels_per_thread = 1;
+      executions.push_back(execution);
+    }
+  }
+  return executions;
+}
+
+}  // namespace
+
+TEST(VectorizedUtils, ReduceMatchesScalar) {
+  std::mt19937 rng(1);
+  for (int iteration = 0; iteration < 20; iteration++) {
+    const int rows = 2 + rng() % 300;
+    const int cols = 2 + rng() % 300;
+    const auto gray = RandomImage<uint8_t, 1>(rows, cols, rng);
+    const auto color = RandomImage<uint8_t, 3>(rows, cols, rng);
+    const auto depth = RandomImage<float, 1>(rows, cols, rng);
+    for (const CpuExecution& execution : Executions()) {
+      EXPECT_TRUE(SameImages(vectorized::Reduce<2>(gray, execution), Reduce<2>(gray)));
+      EXPECT_TRUE(SameImages(vectorized::Reduce(gray, 3, execution), Reduce(gray, 3)));
+      EXPECT_TRUE(SameImages(vectorized::Reduce<2>(color, execution), Reduce<2>(color)));
+      EXPECT_TRUE(SameImages(vectorized::Reduce<2>(depth, execution), Reduce<2>(depth)));
+    }
+  }
+}
+
+TEST(VectorizedUtils, ConvertMatchesScalar) {
+  std::mt19937 rng(2);
+  const auto convert = [](uint8_t value) { return static_cast<float>(value) * 0.5f + 1.0f; };
+  for (int iteration = 0; iteration < 20; iteration++) {
+    const auto image = RandomImage<uint8_t, 1>(1 + rng() % 300, 1 + rng() % 300, rng);
+    const auto expected = Convert<Image1f>(image, convert);
+    for (const CpuExecution& execution : Executions()) {
+      EXPECT_TRUE(SameImages(vectorized::Convert<Image1f>(image, convert, execution), expected));
+    }
+  }
+}
+
+TEST(VectorizedUtils, NormalizeMatchesScalar) {
+  std::mt19937 rng(3);
+  for (int iteration = 0; iteration < 20; iteration++) {
+    const int rows = 1 + rng() % 300;
+    const int cols = 1 + rng() % 300;
+    const auto image = RandomImage<float, 1>(rows, cols, rng);
+    Image1ub expected;
+    Normalize(image, expected);
+    Image1ub expected_range(rows, cols);
+    Normalize(image, 50.0f, 200.0f, expected_range);
+    for (const CpuExecution& execution : Executions()) {
+      Image1ub output;
+      vectorized::Normalize(image, output, execution);
+      EXPECT_TRUE(SameImages(output, expected));
+      Image1ub output_range(rows, cols);
+      vectorized::Normalize(image, 50.0f, 200.0f, output_range, execution);
+      EXPECT_TRUE(SameImages(output_range, expected_range));
+    }
+  }
+}
+
+TEST(VectorizedUtils, ConcurrentCalls) {
+  // Several threads share the worker pool, including a call from inside a band
+  std::mt19937 rng(4);
+  const auto image = RandomImage<float, 1>(480, 640, rng);
+  Image1ub expected;
+  Normalize(image, expected);
+  CpuExecution execution;
+  execution.num_threads = 4;
+  execution.min_pixels_per_thread = 1;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; t++) {
+    threads.emplace_back([&] {
+      for (int i = 0; i < 20; i++) {
+        Image1ub output;
+        vectorized::Normalize(image, output, execution);
+        EXPECT_TRUE(SameImages(output, expected));
+      }
+    });
+  }
+  vectorized_details::ParallelForRows(4, 4, [&](int, int, int) {
+    Image1ub output;
+    vectorized::Normalize(image, output, execution);
+    EXPECT_TRUE(SameImages(output, expected));
+  });
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
+}  // namespace isaac
+}  // namespace nvidia
@@ -0,0 +1,77 @@
+// SPDX-FileCopyrightText: NVIDIA CORPORATION & AFFILIATES
+// Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef ISAAC_ROS_NITROS_TOPIC_TOOLS__ISAAC_ROS_NITROS_POINT_CLOUD_DOWNSAMPLE_NODE_HPP_
+#define ISAAC_ROS_NITROS_TOPIC_TOOLS__ISAAC_ROS_NITROS_POINT_CLOUD_DOWNSAMPLE_NODE_HPP_
+
+#include <string>
+#include <vector>
+
+#include "isaac_ros_nitros/nitros_node.hpp"
+#include "rclcpp/rclcpp.hpp"
+
+namespace nvidia
+{
+namespace isaac_ros
+{
+namespace nitros
+{
+/**
+ * @brief NitrosPointCloudDownsampleNode class implements a node that crops and
+ *        downsamples point clouds without copying them to the host.
+ *        Points outside of an optional range or box crop are dropped, and the
+ *        remaining points are reduced with one of the following modes:
+ *        - none: all points are kept
+ *        - stride: every stride-th point is kept
+ *        - random: points are kept with probability keep_ratio
+ *        - voxel_grid: points are replaced by the centroid of their voxel
+ *        Clouds in device memory are downsampled with CUDA, clouds in host memory
+ *        with multithreaded SIMD kernels. The number of points in and out and the
+ *        latency of every cloud are logged at debug level.
+ */
+class NitrosPointCloudDownsampleNode : public NitrosNode
+{
+public:
+  /**
+   * @brief Constructor for NitrosPointCloudDownsampleNode class.
+   * @param options The node options.
+   */
+  explicit NitrosPointCloudDownsampleNode(const rclcpp::NodeOptions & options);
+
+  void postLoadGraphCallback() override;
+
+private:
+  std::string mode_;
+  int stride_;
+  double keep_ratio_;
+  int64_t seed_;
+  double voxel_size_;
+  int min_points_per_voxel_;
+  // Disabled when not greater than 0
+  double min_range_;
+  double max_range_;
+  // Disabled when empty
+  std::vector<double> box_min_;
+  std::vector<double> box_max_;
+  int num_threads_;
+};
+
+}  // namespace nitros
+}  // namespace isaac_ros
+}  // namespace nvidia
+
+#endif  // ISAAC_ROS_NITROS_TOPIC_TOOLS__ISAAC_ROS_NITROS_POINT_CLOUD_DOWNSAMPLE_NODE_HPP_
@@ -0,0 +1,139 @@
+// SPDX-FileCopyrightText: NVIDIA CORPORATION & AFFILIATES
+// Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "isaac_ros_nitros_topic_tools/isaac_ros_nitros_point_cloud_downsample_node.hpp"
+
+#include <stdexcept>
+
+#include "isaac_ros_nitros_point_cloud_type/nitros_point_cloud.hpp"
+
+namespace nvidia
+{
+namespace isaac_ros
+{
+namespace nitros
+{
+
+namespace
+{
+constexpr char PACKAGE_NAME[] = "isaac_ros_nitros_topic_tools";
+constexpr char APP_YAML_FILENAME[] = "config/nitros_point_cloud_downsample_node.yaml";
+
+constexpr char INPUT_COMPONENT_KEY[] = "downsampler/input";
+constexpr char OUTPUT_COMPONENT_KEY[] = "sink/sink";
+constexpr char POINT_CLOUD_FORMAT[] = "nitros_point_cloud";
+constexpr char INPUT_TOPIC_NAME[] = "point_cloud";
+constexpr char OUTPUT_TOPIC_NAME[] = "point_cloud_downsampled";
+
+constexpr char DOWNSAMPLER_ENTITY[] = "downsampler";
+constexpr char DOWNSAMPLER_TYPE[] = "nvidia::isaac::PointCloudDownsampler";
+}  // namespace
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+const nitros::NitrosPublisherSubscriberConfigMap CONFIG_MAP = {
+  {INPUT_COMPONENT_KEY,
+    {
+      .type = nitros::NitrosPublisherSubscriberType::NEGOTIATED,
+      .qos = rclcpp::QoS(10),
+      .compatible_data_format = POINT_CLOUD_FORMAT,
+      .topic_name = INPUT_TOPIC_NAME,
+    }
+  },
+  {OUTPUT_COMPONENT_KEY,
+    {
+      .type = nitros::NitrosPublisherSubscriberType::NEGOTIATED,
+      .qos = rclcpp::QoS(10),
+      .compatible_data_format = POINT_CLOUD_FORMAT,
+      .topic_name = OUTPUT_TOPIC_NAME,
+      .frame_id_source_key = INPUT_COMPONENT_KEY,
+    }
+  }
+};
+#pragma GCC diagnostic pop
+
+NitrosPointCloudDownsampleNode::NitrosPointCloudDownsampleNode(
+  const rclcpp::NodeOptions & options)
+: NitrosNode(
+    options,
+    // Application graph filename
+    APP_YAML_FILENAME,
+    // I/O configuration map
+    CONFIG_MAP,
+    // Extension specs
+    {},
+    // Optimizer's rule filenames
+    {},
+    // Extension so file list
+    {
+      {"gxf_isaac_utils", "gxf/lib/libgxf_isaac_utils.so"}
+    },
+    // Package name
+    PACKAGE_NAME),
+  mode_(declare_parameter<std::string>("mode", "voxel_grid")),
+  stride_(declare_parameter<int>("stride", 1)),
+  keep_ratio_(declare_parameter<double>("keep_ratio", 1.0)),
+  seed_(declare_parameter<int64_t>("seed", 0)),
+  voxel_size_(declare_parameter<double>("voxel_size", 0.05)),
+  min_points_per_voxel_(declare_parameter<int>("min_points_per_voxel", 1)),
+  min_range_(declare_parameter<double>("min_range", 0.0)),
+  max_range_(declare_parameter<double>("max_range", 0.0)),
+  box_min_(declare_parameter<std::vector<double>>("box_min", std::vector<double>{})),
+  box_max_(declare_parameter<std::vector<double>>("box_max", std::vector<double>{})),
+  num_threads_(declare_parameter<int>("num_threads", 0))
+{
+  if (box_min_.size() != box_max_.size() || (!box_min_.empty() && box_min_.size() != 3)) {
+    RCLCPP_ERROR(get_logger(), "box_min and box_max must both be empty or have 3 elements");
+    throw std::invalid_argument("Invalid box_min or box_max");
+  }
+
+  registerSupportedType<nvidia::isaac_ros::nitros::NitrosPointCloud>();
+
+  startNitrosNode();
+}
+
+void NitrosPointCloudDownsampleNode::postLoadGraphCallback()
+{
+  auto & context = getNitrosContext();
+  context.setParameterStr(DOWNSAMPLER_ENTITY, DOWNSAMPLER_TYPE, "mode", mode_);
+  context.setParameterInt32(DOWNSAMPLER_ENTITY, DOWNSAMPLER_TYPE, "stride", stride_);
+  context.setParameterFloat64(DOWNSAMPLER_ENTITY, DOWNSAMPLER_TYPE, "keep_ratio", keep_ratio_);
+  context.setParameterInt64(DOWNSAMPLER_ENTITY, DOWNSAMPLER_TYPE, "seed", seed_);
+  context.setParameterFloat64(DOWNSAMPLER_ENTITY, DOWNSAMPLER_TYPE, "voxel_size", voxel_size_);
+  context.setParameterInt32(
+    DOWNSAMPLER_ENTITY, DOWNSAMPLER_TYPE, "min_points_per_voxel", min_points_per_voxel_);
+  context.setParameterInt32(DOWNSAMPLER_ENTITY, DOWNSAMPLER_TYPE, "num_threads", num_threads_);
+  if (min_range_ > 0.0) {
+    context.setParameterFloat64(DOWNSAMPLER_ENTITY, DOWNSAMPLER_TYPE, "min_range", min_range_);
+  }
+  if (max_range_ > 0.0) {
+    context.setParameterFloat64(DOWNSAMPLER_ENTITY, DOWNSAMPLER_TYPE, "max_range", max_range_);
+  }
+  if (!box_min_.empty()) {
+    context.setParameter1DFloat64Vector(
+      DOWNSAMPLER_ENTITY, DOWNSAMPLER_TYPE, "box_min", box_min_);
+    context.setParameter1DFloat64Vector(
+      DOWNSAMPLER_ENTITY, DOWNSAMPLER_TYPE, "box_max", box_max_);
+  }
+}
+
+}  // namespace nitros
+}  // namespace isaac_ros
+}  // namespace nvidia
+
+#include "rclcpp_components/register_node_macro.hpp"
+RCLCPP_COMPONENTS_REGISTER_NODE(nvidia::isaac_ros::nitros::NitrosPointCloudDownsampleNode)
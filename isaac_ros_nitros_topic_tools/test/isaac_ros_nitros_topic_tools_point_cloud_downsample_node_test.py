@@ -0,0 +1,124 @@
+# SPDX-FileCopyrightText: NVIDIA CORPORATION & AFFILIATES
+# Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+# SPDX-License-Identifier: Apache-2.0
+import struct
+import time
+
+from isaac_ros_test import IsaacROSBaseTest
+
+from launch_ros.actions import ComposableNodeContainer
+from launch_ros.descriptions import ComposableNode
+
+import pytest
+import rclpy
+from sensor_msgs.msg import PointCloud2, PointField
+
+
+POINT_COUNT = 1001
+STRIDE = 4
+MAX_RANGE = 500.0
+RECEIVE_WAIT_TIME = 10
+
+
+@pytest.mark.rostest
+def generate_test_description():
+    """Generate launch description with all ROS 2 nodes for testing."""
+    downsample_node = ComposableNode(
+        package='isaac_ros_nitros_topic_tools',
+        plugin='nvidia::isaac_ros::nitros::NitrosPointCloudDownsampleNode',
+        name='nitros_point_cloud_downsample_node',
+        namespace=NitrosPointCloudDownsampleNodeTest.generate_namespace(),
+        parameters=[{
+                    'mode': 'stride',
+                    'stride': STRIDE,
+                    'max_range': MAX_RANGE,
+                    }]
+    )
+
+    container = ComposableNodeContainer(
+        name='test_container',
+        namespace='isaac_ros_nitros_container',
+        package='rclcpp_components',
+        executable='component_container_mt',
+        composable_node_descriptions=[downsample_node],
+        output='screen',
+        arguments=['--ros-args', '--log-level', 'info'],
+    )
+
+    return NitrosPointCloudDownsampleNodeTest.generate_test_description([container])
+
+
+class NitrosPointCloudDownsampleNodeTest(IsaacROSBaseTest):
+    """Test NitrosPointCloudDownsampleNode in stride mode with a range crop."""
+
+    def create_point_cloud(self):
+        # Points are on the x axis, one meter apart, so the range crop drops the points
+        # after x = MAX_RANGE
+        point_cloud = PointCloud2()
+        point_cloud.header.frame_id = 'lidar'
+        point_cloud.height = 1
+        point_cloud.width = POINT_COUNT
+        point_cloud.fields = [
+            PointField(name='x', offset=0, datatype=PointField.FLOAT32, count=1),
+            PointField(name='y', offset=4, datatype=PointField.FLOAT32, count=1),
+            PointField(name='z', offset=8, datatype=PointField.FLOAT32, count=1),
+        ]
+        point_cloud.is_bigendian = False
+        point_cloud.point_step = 12
+        point_cloud.row_step = 12 * POINT_COUNT
+        point_cloud.is_dense = True
+        point_cloud.data = b''.join(
+            struct.pack('<fff', float(i), 0.0, 0.0) for i in range(POINT_COUNT))
+        return point_cloud
+
+    def test_downsample_node(self) -> None:
+        """
+        Test case for the point cloud downsample node.
+
+        This test case publishes a point cloud and checks that the output only contains every
+        STRIDE-th point among the points passing the range crop.
+        """
+        self.generate_namespace_lookup(['point_cloud', 'point_cloud_downsampled'])
+
+        received_messages = {}
+        subs = self.create_logging_subscribers(
+            [('point_cloud_downsampled', PointCloud2)], received_messages)
+        point_cloud_pub = self.node.create_publisher(
+            PointCloud2, self.namespaces['point_cloud'], self.DEFAULT_QOS)
+        try:
+            point_cloud = self.create_point_cloud()
+            end_time = time.time() + RECEIVE_WAIT_TIME
+            while time.time() < end_time:
+                point_cloud.header.stamp = self.node.get_clock().now().to_msg()
+                point_cloud_pub.publish(point_cloud)
+                rclpy.spin_once(self.node, timeout_sec=0.1)
+                if 'point_cloud_downsampled' in received_messages:
+                    break
+
+            self.assertIn('point_cloud_downsampled', received_messages,
+                          'Did not receive output messages')
+            output = received_messages['point_cloud_downsampled']
+            kept_count = int(MAX_RANGE) + 1
+            expected_count = (kept_count + STRIDE - 1) // STRIDE
+            self.assertEqual(output.width * output.height, expected_count,
+                             'Did not receive the correct number of points')
+            xs = [struct.unpack_from('<f', output.data, i * output.point_step)[0]
+                  for i in range(expected_count)]
+            self.assertEqual(xs, [float(i * STRIDE) for i in range(expected_count)],
+                             'Did not receive the expected points')
+        finally:
+            self.node.destroy_subscription(subs)
+            self.node.destroy_publisher(point_cloud_pub)
@@ -0,0 +1,99 @@
+// SPDX-FileCopyrightText: NVIDIA CORPORATION & AFFILIATES
+// Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef ISAAC_ROS_NITROS_CAMERA_INFO_TYPE__NITROS_CAMERA_INFO_LATCHED_HPP_
+#define ISAAC_ROS_NITROS_CAMERA_INFO_TYPE__NITROS_CAMERA_INFO_LATCHED_HPP_
+/*
+ * Type adaptation for:
+ *   Nitros type: NitrosCameraInfoLatched
+ *   ROS type:    sensor_msgs::msg::CameraInfo
+ *
+ * Same message as NitrosCameraInfo, with the calibration latched for GXF graphs which keep the
+ * last camera models they received. Every message gets a "calibration_id" component identifying
+ * its calibration, and the camera models and poses are only added to keyframes: the first message
+ * of every frame ID, messages whose calibration changed and every 30th message. Every conversion
+ * of a keyframe message gets the models, so that all the subscriptions receiving it are updated,
+ * and a subscription started later gets the models within 30 messages. Messages without models
+ * are converted back to ROS from the calibrations converted by this process.
+ */
+
+#include <string>
+
+#include "isaac_ros_nitros/types/nitros_format_agent.hpp"
+#include "isaac_ros_nitros/types/nitros_type_base.hpp"
+
+#include "rclcpp/type_adapter.hpp"
+#include "sensor_msgs/msg/camera_info.hpp"
+
+
+namespace nvidia
+{
+namespace isaac_ros
+{
+namespace nitros
+{
+
+// Type forward declaration
+struct NitrosCameraInfoLatched;
+
+// Formats
+struct nitros_camera_info_latched_t
+{
+  using MsgT = NitrosCameraInfoLatched;
+  static const inline std::string supported_type_name = "nitros_camera_info_latched";
+};
+
+// NITROS data type registration factory
+NITROS_TYPE_FACTORY_BEGIN(NitrosCameraInfoLatched)
+// Supported data formats
+NITROS_FORMAT_FACTORY_BEGIN()
+NITROS_FORMAT_ADD(nitros_camera_info_latched_t)
+NITROS_FORMAT_FACTORY_END()
+// Required extensions
+NITROS_TYPE_EXTENSION_FACTORY_BEGIN()
+NITROS_TYPE_EXTENSION_ADD("isaac_ros_gxf", "gxf/lib/multimedia/libgxf_multimedia.so")
+NITROS_TYPE_EXTENSION_FACTORY_END()
+NITROS_TYPE_FACTORY_END()
+
+}  // namespace nitros
+}  // namespace isaac_ros
+}  // namespace nvidia
+
+
+template<>
+struct rclcpp::TypeAdapter<
+  nvidia::isaac_ros::nitros::NitrosCameraInfoLatched,
+  sensor_msgs::msg::CameraInfo>
+{
+  using is_specialized = std::true_type;
+  using custom_type = nvidia::isaac_ros::nitros::NitrosCameraInfoLatched;
+  using ros_message_type = sensor_msgs::msg::CameraInfo;
+
+  static void convert_to_ros_message(
+    const custom_type & source,
+    ros_message_type & destination);
+
+  static void convert_to_custom(
+    const ros_message_type & source,
+    custom_type & destination);
+};
+
+RCLCPP_USING_CUSTOM_TYPE_AS_ROS_MESSAGE_TYPE(
+  nvidia::isaac_ros::nitros::NitrosCameraInfoLatched,
+  sensor_msgs::msg::CameraInfo);
+
+#endif  // ISAAC_ROS_NITROS_CAMERA_INFO_TYPE__NITROS_CAMERA_INFO_LATCHED_HPP_
@@ -15,6 +15,11 @@
 //
 // SPDX-License-Identifier: Apache-2.0
 
+#include <algorithm>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -30,6 +35,7 @@
 #pragma GCC diagnostic pop
 
 #include "isaac_ros_nitros_camera_info_type/nitros_camera_info.hpp"
+#include "isaac_ros_nitros_camera_info_type/nitros_camera_info_latched.hpp"
 #include "isaac_ros_nitros/types/type_adapter_nitros_context.hpp"
 
 #include "rclcpp/rclcpp.hpp"
@@ -39,6 +45,7 @@ constexpr char RAW_CAMERA_MODEL_GXF_NAME[] = "intrinsics";
 constexpr char RECT_CAMERA_MODEL_GXF_NAME[] = "target_camera";
 constexpr char EXTRINSICS_GXF_NAME[] = "extrinsics";
 constexpr char TARGET_EXTRINSICS_DELTA_GXF_NAME[] = "target_extrinsics_delta";
+constexpr char CALIBRATION_ID_GXF_NAME[] = "calibration_id";
 
 namespace
 {
@@ -56,58 +63,513 @@ const std::unordered_map<DistortionType, std::string> g_gxf_to_ros_distortion_mo
     {DistortionType::Perspective, "pinhole"},
     {DistortionType::Brown, "plumb_bob"}
   });
-}  // namespace
 
+// Maximum number of calibrations kept in the cache
+constexpr size_t kMaxCachedCalibrations = 64;
+// Maximum number of frame IDs whose last calibration and latched state are kept
+constexpr size_t kMaxCachedFrames = 64;
 
-void rclcpp::TypeAdapter<
-  nvidia::isaac_ros::nitros::NitrosCameraInfo,
-  sensor_msgs::msg::CameraInfo>::convert_to_ros_message(
-  const custom_type & source, ros_message_type & destination)
+// Every kLatchedKeyframeInterval-th message of a frame ID gets the camera models in the latched
+// transport
+constexpr size_t kLatchedKeyframeInterval = 30;
+
+// GXF components converted from the calibration of a camera info message
+struct CameraInfoComponents
 {
-  nvidia::isaac_ros::nitros::nvtxRangePushWrapper(
-    "NitrosCameraInfo::convert_to_ros_message",
-    nvidia::isaac_ros::nitros::CLR_PURPLE);
+  nvidia::gxf::CameraModel raw_camera_model{};
+  nvidia::gxf::CameraModel rect_camera_model{};
+  nvidia::gxf::Pose3D extrinsics{};
+  nvidia::gxf::Pose3D target_extrinsics_delta{};
+};
+
+// A converted calibration and the message it was converted from
+struct CachedCalibration
+{
+  // Identifies the calibration in the messages of the latched transport. IDs are unique in the
+  // process, unlike hashes.
+  uint64_t id;
+  // Hash of the fields used by the conversion
+  uint64_t hash;
+  sensor_msgs::msg::CameraInfo camera_info;
+  CameraInfoComponents components;
+};
+
+// Calibration of the last message of a frame ID
+struct LastCalibration
+{
+  std::shared_ptr<const CachedCalibration> calibration;
+  // Value of CalibrationCache::use_count when the frame ID was last converted
+  uint64_t last_use;
+};
 
-  RCLCPP_DEBUG(
-    rclcpp::get_logger("NitrosCameraInfo"),
-    "[convert_to_ros_message] Conversion started for handle=%ld", source.handle);
+// Calibration last sent for a frame ID in the latched transport
+struct LatchState
+{
+  // Kept alive for receivers of the messages which only have its ID, even once it was evicted
+  // from the cache
+  std::shared_ptr<const CachedCalibration> calibration;
+  // Timestamps of the last converted message and of the last keyframe
+  uint64_t last_timestamp;
+  uint64_t keyframe_timestamp;
+  // Number of messages converted since the last keyframe
+  size_t messages_since_keyframe;
+  // Value of CalibrationCache::use_count when the frame ID was last converted
+  uint64_t last_use;
+};
+
+// Converted calibrations, and the calibration last sent for every frame ID in the latched
+// transport. The cache is never destroyed, so that conversions running at exit are safe.
+struct CalibrationCache
+{
+  std::mutex mutex;
+  // Calibrations by hash. Different calibrations with the same hash are kept side by side.
+  std::unordered_map<uint64_t, std::vector<std::shared_ptr<const CachedCalibration>>> by_hash;
+  // Calibrations by ID
+  std::unordered_map<uint64_t, std::shared_ptr<const CachedCalibration>> by_id;
+  // IDs of the calibrations in the order they were added, oldest first
+  std::deque<uint64_t> order;
+  // ID of the next converted calibration
+  uint64_t next_id = 1;
+  // Calibration of the last message of every frame ID, compared first to skip hashing
+  std::unordered_map<std::string, LastCalibration> last_calibrations;
+  std::unordered_map<std::string, LatchState> latch_states;
+  // Number of conversions, which orders the uses of the frame IDs
+  uint64_t use_count = 0;
+};
+
+CalibrationCache & GetCalibrationCache()
+{
+  static CalibrationCache * cache = new CalibrationCache();
+  return *cache;
+}
 
-  auto context = nvidia::isaac_ros::nitros::GetTypeAdapterNitrosContext().getContext();
-  auto msg_entity = nvidia::gxf::Entity::Shared(context, source.handle);
+uint64_t HashBytes(uint64_t hash, const void * data, size_t size)
+{
+  // Mixes 8 bytes at a time, IDs are only used to find calibrations which are then compared
+  constexpr uint64_t kMultiplier = 0x9e3779b97f4a7c15ull;
+  const uint8_t * bytes = static_cast<const uint8_t *>(data);
+  size_t i = 0;
+  for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t)) {
+    uint64_t word;
+    std::memcpy(&word, bytes + i, sizeof(word));
+    hash = (hash ^ word) * kMultiplier;
+    hash ^= hash >> 32;
+  }
+  for (; i < size; i++) {
+    hash = (hash ^ bytes[i]) * kMultiplier;
+    hash ^= hash >> 32;
+  }
+  return hash;
+}
 
-  auto raw_gxf_camera_model = msg_entity->get<nvidia::gxf::CameraModel>(RAW_CAMERA_MODEL_GXF_NAME);
-  if (!raw_gxf_camera_model) {
+// Returns the ID of the calibration of a camera info message, a hash of the fields used by the
+// conversion
+uint64_t HashCalibration(const sensor_msgs::msg::CameraInfo & camera_info)
+{
+  uint64_t hash = 14695981039346656037ull;
+  const uint64_t distortion_model_size = camera_info.distortion_model.size();
+  const uint64_t d_size = camera_info.d.size();
+  hash = HashBytes(hash, &camera_info.width, sizeof(camera_info.width));
+  hash = HashBytes(hash, &camera_info.height, sizeof(camera_info.height));
+  hash = HashBytes(hash, &distortion_model_size, sizeof(distortion_model_size));
+  hash = HashBytes(hash, camera_info.distortion_model.data(), distortion_model_size);
+  hash = HashBytes(hash, &d_size, sizeof(d_size));
+  hash = HashBytes(hash, camera_info.d.data(), d_size * sizeof(double));
+  hash = HashBytes(hash, camera_info.k.data(), camera_info.k.size() * sizeof(double));
+  hash = HashBytes(hash, camera_info.r.data(), camera_info.r.size() * sizeof(double));
+  hash = HashBytes(hash, camera_info.p.data(), camera_info.p.size() * sizeof(double));
+  return hash;
+}
+
+// Returns true if the fields used by the conversion are byte-identical
+bool SameCalibration(const sensor_msgs::msg::CameraInfo & a, const sensor_msgs::msg::CameraInfo & b)
+{
+  return a.width == b.width && a.height == b.height &&
+         a.distortion_model == b.distortion_model && a.d.size() == b.d.size() &&
+         (a.d.empty() || std::memcmp(a.d.data(), b.d.data(), a.d.size() * sizeof(double)) == 0) &&
+         std::memcmp(a.k.data(), b.k.data(), a.k.size() * sizeof(double)) == 0 &&
+         std::memcmp(a.r.data(), b.r.data(), a.r.size() * sizeof(double)) == 0 &&
+         std::memcmp(a.p.data(), b.p.data(), a.p.size() * sizeof(double)) == 0;
+}
+
+// Converts the calibration of a camera info message into GXF components
+CameraInfoComponents ConvertCalibration(const sensor_msgs::msg::CameraInfo & source)
+{
+  CameraInfoComponents components;
+  nvidia::gxf::CameraModel & raw_camera_model = components.raw_camera_model;
+
+  raw_camera_model.dimensions = {source.width, source.height};
+  raw_camera_model.focal_length = {
+    static_cast<float>(source.k[0]), static_cast<float>(source.k[4])};
+  raw_camera_model.principal_point = {
+    static_cast<float>(source.k[2]), static_cast<float>(source.k[5])};
+
+  const auto distortion = g_ros_to_gxf_distortion_model.find(source.distortion_model);
+  if (distortion == std::end(g_ros_to_gxf_distortion_model)) {
+    std::stringstream error_msg;
+    error_msg <<
+      "[convert_to_custom] Unsupported distortion model from ROS [" <<
+      source.distortion_model.c_str() << "].";
+    RCLCPP_ERROR(
+      rclcpp::get_logger("NitrosCameraInfo"), error_msg.str().c_str());
+    throw std::runtime_error(error_msg.str().c_str());
+  } else {
+    raw_camera_model.distortion_type = distortion->second;
+  }
+
+  if (source.d.size() > nvidia::gxf::CameraModel::kMaxDistortionCoefficients) {
     std::stringstream error_msg;
     error_msg <<
-      "[convert_to_ros_message] Failed to get the Raw CameraModel object: " <<
-      GxfResultStr(raw_gxf_camera_model.error());
+      "[convert_to_custom] More number of coefficients for distortion model found [ # of coeff: " <<
+      source.d.size() << " > " << nvidia::gxf::CameraModel::kMaxDistortionCoefficients << "].";
     RCLCPP_ERROR(
       rclcpp::get_logger("NitrosCameraInfo"), error_msg.str().c_str());
     throw std::runtime_error(error_msg.str().c_str());
   }
-  auto rect_gxf_camera_model =
-    msg_entity->get<nvidia::gxf::CameraModel>(RECT_CAMERA_MODEL_GXF_NAME);
-  // Fallback to raw intrinsics incase rect camera model is not available
-  if (!rect_gxf_camera_model) {
-    RCLCPP_WARN_ONCE(
-      rclcpp::get_logger(
-        "NitrosCameraInfo"),
-      "[convert_to_ros_message] Failed to get the Rectified CameraModel object: "
-      "Falling back to raw camera model");
-    rect_gxf_camera_model = raw_gxf_camera_model;
+
+  if (raw_camera_model.distortion_type == DistortionType::Polynomial) {
+    // prevents distortion parameters array access if its empty
+    // simulators may send empty distortion parameter array since images are already rectified
+    if (!source.d.empty()) {
+      // distortion parameters in GXF: k1, k2, k3, k4, k5, k6, p1, p2
+      // distortion parameters in ROS message: k1, k2, p1, p2, k3 ...
+      raw_camera_model.distortion_coefficients[0] = source.d[0];
+      raw_camera_model.distortion_coefficients[1] = source.d[1];
+
+      for (uint16_t index = 2; index < source.d.size() - 2; index++) {
+        raw_camera_model.distortion_coefficients[index] = source.d[index + 2];
+      }
+      raw_camera_model.distortion_coefficients[6] = source.d[2];
+      raw_camera_model.distortion_coefficients[7] = source.d[3];
+    }
+  } else if (raw_camera_model.distortion_type == DistortionType::Brown) {
+    // prevents distortion parameters array access if its empty
+    // simulators may send empty distortion parameter array since images are already rectified
+    if (!source.d.empty()) {
+      // distortion parameters in GXF: k1, k2, k3, k4, k5, k6, p1, p2
+      // distortion parameters in ROS message: k1, k2, p1, p2, k3 ...
+      raw_camera_model.distortion_coefficients[0] = source.d[0];
+      raw_camera_model.distortion_coefficients[1] = source.d[1];
+      raw_camera_model.distortion_coefficients[2] = source.d[4];
+      for (uint16_t index = 3;
+        index < nvidia::gxf::CameraModel::kMaxDistortionCoefficients - 2;
+        index++)
+      {
+        raw_camera_model.distortion_coefficients[index] = 0;
+      }
+      raw_camera_model.distortion_coefficients[6] = source.d[2];
+      raw_camera_model.distortion_coefficients[7] = source.d[3];
+    }
+  } else {
+    std::copy(
+      std::begin(source.d), std::end(source.d),
+      std::begin(raw_camera_model.distortion_coefficients));
+  }
+
+  // rectified image camera model
+  nvidia::gxf::CameraModel & rect_camera_model = components.rect_camera_model;
+  rect_camera_model.dimensions = {source.width, source.height};
+  rect_camera_model.focal_length = {
+    static_cast<float>(source.p[0]), static_cast<float>(source.p[5])};
+  rect_camera_model.principal_point = {
+    static_cast<float>(source.p[2]), static_cast<float>(source.p[6])};
+  rect_camera_model.distortion_type = DistortionType::Perspective;
+  memset(
+    rect_camera_model.distortion_coefficients, 0,
+    rect_camera_model.kMaxDistortionCoefficients * sizeof(float));
+
+  // populate rectification rotation matrix into the TARGET_EXTRINSICS_DELTA_GXF_NAME
+  std::copy(
+    std::begin(source.r), std::end(source.r),
+    std::begin(components.target_extrinsics_delta.rotation));
+
+  // Based on the comments for the camera info msg type, p[0] == 0 means the topic
+  // contains no calibration data, ie, its an uncalibrated camera
+  if (source.p[0] == 0.0f) {
+    RCLCPP_WARN(
+      rclcpp::get_logger("NitrosCameraInfo"),
+      "[convert_to_custom] Received an uncalibrated camera info msg.");
+    components.extrinsics.translation = {
+      0,
+      0,
+      0};
+  } else {
+    // populate extrinsics translation the EXTRINSICS_GXF_NAME
+    components.extrinsics.translation = {
+      static_cast<float>(source.p[3]) / static_cast<float>(source.p[0]),
+      static_cast<float>(source.p[7]),
+      static_cast<float>(source.p[11])};
+  }
+  return components;
+}
+
+// Evicts the least recently used frame ID of a map once it has more than kMaxCachedFrames
+// entries. The map values have a last_use field.
+template<typename Map>
+void EvictLeastRecentlyUsedFrame(Map & frames)
+{
+  if (frames.size() <= kMaxCachedFrames) {
+    return;
+  }
+  auto oldest = frames.begin();
+  for (auto it = frames.begin(); it != frames.end(); ++it) {
+    if (it->second.last_use < oldest->second.last_use) {
+      oldest = it;
+    }
+  }
+  frames.erase(oldest);
+}
+
+// Records the calibration of the last message of a frame ID. The cache mutex must be held.
+void SetLastCalibration(
+  CalibrationCache & cache, const std::string & frame_id,
+  const std::shared_ptr<const CachedCalibration> & calibration)
+{
+  cache.last_calibrations[frame_id] = LastCalibration{calibration, ++cache.use_count};
+  EvictLeastRecentlyUsedFrame(cache.last_calibrations);
+}
+
+// Returns the cached calibration which is the same as the one of a message with the given hash,
+// nullptr if there is none. The cache mutex must be held.
+std::shared_ptr<const CachedCalibration> FindSameCalibration(
+  const CalibrationCache & cache, uint64_t hash, const sensor_msgs::msg::CameraInfo & source)
+{
+  const auto cached = cache.by_hash.find(hash);
+  if (cached == cache.by_hash.end()) {
+    return nullptr;
+  }
+  for (const auto & calibration : cached->second) {
+    if (SameCalibration(calibration->camera_info, source)) {
+      return calibration;
+    }
+  }
+  return nullptr;
+}
+
+// Returns the converted calibration of a camera info message, converting it only if it is not
+// in the cache yet
+std::shared_ptr<const CachedCalibration> GetCachedCalibration(
+  const sensor_msgs::msg::CameraInfo & source)
+{
+  auto & cache = GetCalibrationCache();
+  {
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    const auto last = cache.last_calibrations.find(source.header.frame_id);
+    if (last != cache.last_calibrations.end() &&
+      SameCalibration(last->second.calibration->camera_info, source))
+    {
+      last->second.last_use = ++cache.use_count;
+      return last->second.calibration;
+    }
+  }
+
+  const uint64_t hash = HashCalibration(source);
+  {
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    auto cached = FindSameCalibration(cache, hash, source);
+    if (cached) {
+      SetLastCalibration(cache, source.header.frame_id, cached);
+      return cached;
+    }
+  }
+
+  auto calibration = std::make_shared<CachedCalibration>();
+  calibration->hash = hash;
+  calibration->camera_info = source;
+  calibration->components = ConvertCalibration(source);
+
+  std::lock_guard<std::mutex> lock(cache.mutex);
+  // Another thread may have converted the same calibration in the meantime
+  auto cached = FindSameCalibration(cache, hash, source);
+  if (cached) {
+    SetLastCalibration(cache, source.header.frame_id, cached);
+    return cached;
+  }
+  calibration->id = cache.next_id++;
+  cache.by_hash[hash].push_back(calibration);
+  cache.by_id[calibration->id] = calibration;
+  cache.order.push_back(calibration->id);
+  while (cache.by_id.size() > kMaxCachedCalibrations) {
+    const auto evicted = cache.by_id.find(cache.order.front());
+    auto & same_hash = cache.by_hash[evicted->second->hash];
+    same_hash.erase(std::find(same_hash.begin(), same_hash.end(), evicted->second));
+    if (same_hash.empty()) {
+      cache.by_hash.erase(evicted->second->hash);
+    }
+    cache.by_id.erase(evicted);
+    cache.order.pop_front();
+  }
+  SetLastCalibration(cache, source.header.frame_id, calibration);
+  return calibration;
+}
+
+// Returns the cached calibration of the given ID, nullptr if it is not cached
+std::shared_ptr<const CachedCalibration> FindCachedCalibration(uint64_t id)
+{
+  auto & cache = GetCalibrationCache();
+  std::lock_guard<std::mutex> lock(cache.mutex);
+  const auto cached = cache.by_id.find(id);
+  if (cached != cache.by_id.end()) {
+    return cached->second;
+  }
+  // Latched calibrations stay in use after they are evicted
+  for (const auto & latch_state : cache.latch_states) {
+    if (latch_state.second.calibration->id == id) {
+      return latch_state.second.calibration;
+    }
+  }
+  return nullptr;
+}
+
+// Records a message of a frame ID converted with the latched transport. Returns true if the
+// message is a keyframe, which gets the camera models. The type adapter does not know which
+// subscription a conversion is for, so messages are told apart by timestamp: every conversion of
+// the keyframe message is a keyframe, so that all the subscriptions receiving it get the models,
+// and keyframes are repeated periodically for subscriptions started later.
+bool LatchCalibration(
+  const std::string & frame_id, const std::shared_ptr<const CachedCalibration> & calibration,
+  uint64_t timestamp)
+{
+  auto & cache = GetCalibrationCache();
+  std::lock_guard<std::mutex> lock(cache.mutex);
+  const auto inserted = cache.latch_states.emplace(frame_id, LatchState{});
+  LatchState & state = inserted.first->second;
+  const uint64_t use = ++cache.use_count;
+  if (inserted.second) {
+    // A frame ID which was never latched, or whose state was evicted, starts with a keyframe
+    state = LatchState{calibration, timestamp, timestamp, 0, use};
+    EvictLeastRecentlyUsedFrame(cache.latch_states);
+    return true;
+  }
+  if (timestamp != state.last_timestamp) {
+    state.messages_since_keyframe++;
+  }
+  state.last_timestamp = timestamp;
+  state.last_use = use;
+  if (state.calibration->id != calibration->id ||
+    state.messages_since_keyframe >= kLatchedKeyframeInterval)
+  {
+    state = LatchState{calibration, timestamp, timestamp, 0, use};
+    return true;
+  }
+  return timestamp == state.keyframe_timestamp;
+}
+
+// Adds a component holding the given value to the message
+template<typename T>
+void AddComponent(nvidia::gxf::Entity & message, const char * name, const T & value)
+{
+  auto component = message.add<T>(name);
+  if (!component) {
+    std::stringstream error_msg;
+    error_msg <<
+      "[convert_to_custom] Failed to add " << name << " to message: " <<
+      GxfResultStr(component.error());
+    RCLCPP_ERROR(
+      rclcpp::get_logger("NitrosCameraInfo"), error_msg.str().c_str());
+    throw std::runtime_error(error_msg.str().c_str());
+  }
+  *component.value() = value;
+}
+
+// Converts a NitrosCameraInfo or NitrosCameraInfoLatched message entity into a CameraInfo.
+// Messages without camera models are resolved from their "calibration_id" component.
+void ConvertToRosMessage(
+  const nvidia::isaac_ros::nitros::NitrosTypeBase & source,
+  sensor_msgs::msg::CameraInfo & destination)
+{
+  auto context = nvidia::isaac_ros::nitros::GetTypeAdapterNitrosContext().getContext();
+  auto msg_entity = nvidia::gxf::Entity::Shared(context, source.handle);
+
+  const nvidia::gxf::CameraModel * raw_camera_model = nullptr;
+  const nvidia::gxf::CameraModel * rect_camera_model = nullptr;
+  const nvidia::gxf::Pose3D * extrinsics = nullptr;
+  const nvidia::gxf::Pose3D * target_extrinsics_delta = nullptr;
+
+  auto raw_gxf_camera_model = msg_entity->get<nvidia::gxf::CameraModel>(RAW_CAMERA_MODEL_GXF_NAME);
+  auto calibration_id = msg_entity->get<uint64_t>(CALIBRATION_ID_GXF_NAME);
+  std::shared_ptr<const CachedCalibration> latched_calibration;
+  if (!raw_gxf_camera_model && calibration_id) {
+    // Latched calibration sent with a previous message
+    latched_calibration = FindCachedCalibration(*calibration_id.value());
+    if (!latched_calibration) {
+      std::stringstream error_msg;
+      error_msg <<
+        "[convert_to_ros_message] Calibration " << *calibration_id.value() <<
+        " of a latched camera info message is not cached";
+      RCLCPP_ERROR(
+        rclcpp::get_logger("NitrosCameraInfo"), error_msg.str().c_str());
+      throw std::runtime_error(error_msg.str().c_str());
+    }
+    raw_camera_model = &latched_calibration->components.raw_camera_model;
+    rect_camera_model = &latched_calibration->components.rect_camera_model;
+    extrinsics = &latched_calibration->components.extrinsics;
+    target_extrinsics_delta = &latched_calibration->components.target_extrinsics_delta;
+  } else {
+    if (!raw_gxf_camera_model) {
+      std::stringstream error_msg;
+      error_msg <<
+        "[convert_to_ros_message] Failed to get the Raw CameraModel object: " <<
+        GxfResultStr(raw_gxf_camera_model.error());
+      RCLCPP_ERROR(
+        rclcpp::get_logger("NitrosCameraInfo"), error_msg.str().c_str());
+      throw std::runtime_error(error_msg.str().c_str());
+    }
+    raw_camera_model = raw_gxf_camera_model.value().get();
+
+    auto rect_gxf_camera_model =
+      msg_entity->get<nvidia::gxf::CameraModel>(RECT_CAMERA_MODEL_GXF_NAME);
+    // Fallback to raw intrinsics incase rect camera model is not available
+    if (!rect_gxf_camera_model) {
+      RCLCPP_WARN_ONCE(
+        rclcpp::get_logger(
+          "NitrosCameraInfo"),
+        "[convert_to_ros_message] Failed to get the Rectified CameraModel object: "
+        "Falling back to raw camera model");
+      rect_gxf_camera_model = raw_gxf_camera_model;
+    }
+    rect_camera_model = rect_gxf_camera_model.value().get();
+
+    auto extrinsics_gxf_pose_3d = msg_entity->get<nvidia::gxf::Pose3D>(EXTRINSICS_GXF_NAME);
+    if (!extrinsics_gxf_pose_3d) {
+      std::stringstream error_msg;
+      error_msg <<
+        "[convert_to_ros_message] Failed to get the extrinsics Pose3D object: " <<
+        GxfResultStr(extrinsics_gxf_pose_3d.error());
+      RCLCPP_ERROR(
+        rclcpp::get_logger("NitrosCameraInfo"), error_msg.str().c_str());
+      throw std::runtime_error(error_msg.str().c_str());
+    }
+    extrinsics = extrinsics_gxf_pose_3d.value().get();
+
+    auto target_extrinsics_delta_gxf_pose_3d = msg_entity->get<nvidia::gxf::Pose3D>(
+      TARGET_EXTRINSICS_DELTA_GXF_NAME);
+    // Fallback to extrinsics Pose3D object
+    if (!target_extrinsics_delta_gxf_pose_3d) {
+      std::stringstream warn_msg;
+      warn_msg <<
+        "[convert_to_ros_message] Failed to get the target extrinsics delta Pose3D object: " <<
+        GxfResultStr(target_extrinsics_delta_gxf_pose_3d.error()) <<
+        "Falling back to extrinsics Pose3D object";
+      RCLCPP_WARN_ONCE(
+        rclcpp::get_logger("NitrosCameraInfo"), warn_msg.str().c_str());
+
+      target_extrinsics_delta_gxf_pose_3d = extrinsics_gxf_pose_3d;
+    }
+    target_extrinsics_delta = target_extrinsics_delta_gxf_pose_3d.value().get();
   }
 
   // Setting camera info from gxf camera model
-  destination.height = raw_gxf_camera_model.value()->dimensions.y;
-  destination.width = raw_gxf_camera_model.value()->dimensions.x;
+  destination.height = raw_camera_model->dimensions.y;
+  destination.width = raw_camera_model->dimensions.x;
 
   const auto distortion = g_gxf_to_ros_distortion_model.find(
-    raw_gxf_camera_model.value()->distortion_type);
+    raw_camera_model->distortion_type);
   if (distortion == std::end(g_gxf_to_ros_distortion_model)) {
     std::stringstream error_msg;
     error_msg <<
       "[convert_to_ros_message] Unsupported distortion model from gxf [" <<
-      static_cast<int>(raw_gxf_camera_model.value()->distortion_type) << "].";
+      static_cast<int>(raw_camera_model->distortion_type) << "].";
     RCLCPP_ERROR(
       rclcpp::get_logger("NitrosCameraInfo"), error_msg.str().c_str());
     throw std::runtime_error(error_msg.str().c_str());
@@ -117,94 +579,68 @@ void rclcpp::TypeAdapter<
 
   // Resize d buffer to the right size
   destination.d.resize(
-    sizeof(raw_gxf_camera_model.value()->distortion_coefficients) /
+    sizeof(raw_camera_model->distortion_coefficients) /
     sizeof(float));
 
-  if (raw_gxf_camera_model.value()->distortion_type == DistortionType::Polynomial) {
-    destination.d[0] = raw_gxf_camera_model.value()->distortion_coefficients[0];
-    destination.d[1] = raw_gxf_camera_model.value()->distortion_coefficients[1];
-    destination.d[2] = raw_gxf_camera_model.value()->distortion_coefficients[6];
-    destination.d[3] = raw_gxf_camera_model.value()->distortion_coefficients[7];
-    destination.d[4] = raw_gxf_camera_model.value()->distortion_coefficients[2];
-    destination.d[5] = raw_gxf_camera_model.value()->distortion_coefficients[3];
-    destination.d[6] = raw_gxf_camera_model.value()->distortion_coefficients[4];
-    destination.d[7] = raw_gxf_camera_model.value()->distortion_coefficients[5];
-  } else if (raw_gxf_camera_model.value()->distortion_type == DistortionType::Brown) {
-    destination.d[0] = raw_gxf_camera_model.value()->distortion_coefficients[0];
-    destination.d[1] = raw_gxf_camera_model.value()->distortion_coefficients[1];
-    destination.d[2] = raw_gxf_camera_model.value()->distortion_coefficients[6];
-    destination.d[3] = raw_gxf_camera_model.value()->distortion_coefficients[7];
-    destination.d[4] = raw_gxf_camera_model.value()->distortion_coefficients[2];
+  if (raw_camera_model->distortion_type == DistortionType::Polynomial) {
+    destination.d[0] = raw_camera_model->distortion_coefficients[0];
+    destination.d[1] = raw_camera_model->distortion_coefficients[1];
+    destination.d[2] = raw_camera_model->distortion_coefficients[6];
+    destination.d[3] = raw_camera_model->distortion_coefficients[7];
+    destination.d[4] = raw_camera_model->distortion_coefficients[2];
+    destination.d[5] = raw_camera_model->distortion_coefficients[3];
+    destination.d[6] = raw_camera_model->distortion_coefficients[4];
+    destination.d[7] = raw_camera_model->distortion_coefficients[5];
+  } else if (raw_camera_model->distortion_type == DistortionType::Brown) {
+    destination.d[0] = raw_camera_model->distortion_coefficients[0];
+    destination.d[1] = raw_camera_model->distortion_coefficients[1];
+    destination.d[2] = raw_camera_model->distortion_coefficients[6];
+    destination.d[3] = raw_camera_model->distortion_coefficients[7];
+    destination.d[4] = raw_camera_model->distortion_coefficients[2];
     destination.d[5] = 0;
     destination.d[6] = 0;
     destination.d[7] = 0;
   } else {
     std::copy(
-      std::begin(raw_gxf_camera_model.value()->distortion_coefficients),
-      std::end(raw_gxf_camera_model.value()->distortion_coefficients), std::begin(destination.d));
+      std::begin(raw_camera_model->distortion_coefficients),
+      std::end(raw_camera_model->distortion_coefficients), std::begin(destination.d));
   }
 
-  destination.k[0] = raw_gxf_camera_model.value()->focal_length.x;
+  destination.k[0] = raw_camera_model->focal_length.x;
   destination.k[1] = 0;
-  destination.k[2] = raw_gxf_camera_model.value()->principal_point.x;
+  destination.k[2] = raw_camera_model->principal_point.x;
   destination.k[3] = 0;
-  destination.k[4] = raw_gxf_camera_model.value()->focal_length.y;
-  destination.k[5] = raw_gxf_camera_model.value()->principal_point.y;
+  destination.k[4] = raw_camera_model->focal_length.y;
+  destination.k[5] = raw_camera_model->principal_point.y;
   destination.k[6] = 0;
   destination.k[7] = 0;
   destination.k[8] = 1;
 
   // Setting extrinsic info from gxf pose 3D
-  auto extrinsics_gxf_pose_3d = msg_entity->get<nvidia::gxf::Pose3D>(EXTRINSICS_GXF_NAME);
-  if (!extrinsics_gxf_pose_3d) {
-    std::stringstream error_msg;
-    error_msg <<
-      "[convert_to_ros_message] Failed to get the extrinsics Pose3D object: " <<
-      GxfResultStr(extrinsics_gxf_pose_3d.error());
-    RCLCPP_ERROR(
-      rclcpp::get_logger("NitrosCameraInfo"), error_msg.str().c_str());
-    throw std::runtime_error(error_msg.str().c_str());
-  }
-  auto target_extrinsics_delta_gxf_pose_3d = msg_entity->get<nvidia::gxf::Pose3D>(
-    TARGET_EXTRINSICS_DELTA_GXF_NAME);
-
-  // Fallback to extrinsics Pose3D object
-  if (!target_extrinsics_delta_gxf_pose_3d) {
-    std::stringstream warn_msg;
-    warn_msg <<
-      "[convert_to_ros_message] Failed to get the target extrinsics delta Pose3D object: " <<
-      GxfResultStr(target_extrinsics_delta_gxf_pose_3d.error()) <<
-      "Falling back to extrinsics Pose3D object";
-    RCLCPP_WARN_ONCE(
-      rclcpp::get_logger("NitrosCameraInfo"), warn_msg.str().c_str());
-
-    target_extrinsics_delta_gxf_pose_3d = extrinsics_gxf_pose_3d;
-  }
-
   std::copy(
-    std::begin(target_extrinsics_delta_gxf_pose_3d.value()->rotation),
-    std::end(target_extrinsics_delta_gxf_pose_3d.value()->rotation),
+    std::begin(target_extrinsics_delta->rotation),
+    std::end(target_extrinsics_delta->rotation),
     std::begin(destination.r));
 
   // The left 3*3 portion of the P-matrix specifies the intrinsic of rectified image
   // The right 1*3 vector specifies the tranlsation vector
-  destination.p[0] = rect_gxf_camera_model.value()->focal_length.x;
+  destination.p[0] = rect_camera_model->focal_length.x;
   destination.p[1] = 0;
-  destination.p[2] = rect_gxf_camera_model.value()->principal_point.x;
-  destination.p[3] = extrinsics_gxf_pose_3d.value()->translation[0] * destination.p[0];
+  destination.p[2] = rect_camera_model->principal_point.x;
+  destination.p[3] = extrinsics->translation[0] * destination.p[0];
   destination.p[4] = 0;
-  destination.p[5] = rect_gxf_camera_model.value()->focal_length.y;
-  destination.p[6] = rect_gxf_camera_model.value()->principal_point.y;
-  destination.p[7] = extrinsics_gxf_pose_3d.value()->translation[1];
+  destination.p[5] = rect_camera_model->focal_length.y;
+  destination.p[6] = rect_camera_model->principal_point.y;
+  destination.p[7] = extrinsics->translation[1];
   destination.p[8] = 0;
   destination.p[9] = 0;
   destination.p[10] = 1;
-  destination.p[11] = extrinsics_gxf_pose_3d.value()->translation[2];
+  destination.p[11] = extrinsics->translation[2];
 
   destination.binning_x = 1;    // No subsampling
   destination.binning_y = 1;    // No subsampling
-  destination.roi.height = raw_gxf_camera_model.value()->dimensions.y;    // Full resolution
-  destination.roi.width = raw_gxf_camera_model.value()->dimensions.x;    // Full resolution
+  destination.roi.height = raw_camera_model->dimensions.y;    // Full resolution
+  destination.roi.width = raw_camera_model->dimensions.x;    // Full resolution
 
   // Populate timestamp information back into ROS header
   auto input_timestamp = msg_entity->get<nvidia::gxf::Timestamp>("timestamp");
@@ -220,27 +656,26 @@ void rclcpp::TypeAdapter<
 
   // Set frame ID
   destination.header.frame_id = source.frame_id;
-
-  RCLCPP_DEBUG(
-    rclcpp::get_logger("NitrosCameraInfo"),
-    "[convert_to_ros_message] Conversion completed");
-
-  nvidia::isaac_ros::nitros::nvtxRangePopWrapper();
 }
 
-void rclcpp::TypeAdapter<
-  nvidia::isaac_ros::nitros::NitrosCameraInfo,
-  sensor_msgs::msg::CameraInfo>::convert_to_custom(
-  const ros_message_type & source,
-  custom_type & destination)
+// Converts a CameraInfo into a new message entity. The calibration is only converted if it
+// differs from the calibrations converted before. If latched is set, the camera models are only
+// added to keyframes, and every message gets the ID of its calibration.
+void ConvertToCustom(
+  const sensor_msgs::msg::CameraInfo & source,
+  nvidia::isaac_ros::nitros::NitrosTypeBase & destination,
+  bool latched)
 {
-  nvidia::isaac_ros::nitros::nvtxRangePushWrapper(
-    "NitrosCameraInfo::convert_to_custom",
-    nvidia::isaac_ros::nitros::CLR_PURPLE);
+  const std::shared_ptr<const CachedCalibration> calibration = GetCachedCalibration(source);
+  const CameraInfoComponents * components = &calibration->components;
 
-  RCLCPP_DEBUG(
-    rclcpp::get_logger("NitrosCameraInfo"),
-    "[convert_to_custom] Conversion started");
+  // Timestamp of the message, which also tells apart the messages of the latched transport
+  uint64_t input_timestamp =
+    source.header.stamp.sec * static_cast<uint64_t>(1e9) +
+    source.header.stamp.nanosec;
+
+  const bool add_components =
+    !latched || LatchCalibration(source.header.frame_id, calibration, input_timestamp);
 
   auto context = nvidia::isaac_ros::nitros::GetTypeAdapterNitrosContext().getContext();
 
@@ -255,124 +690,24 @@ void rclcpp::TypeAdapter<
     throw std::runtime_error(error_msg.str().c_str());
   }
 
-  auto raw_gxf_camera_model = message->add<nvidia::gxf::CameraModel>(RAW_CAMERA_MODEL_GXF_NAME);
-
-  raw_gxf_camera_model.value()->dimensions = {source.width, source.height};
-  raw_gxf_camera_model.value()->focal_length = {
-    static_cast<float>(source.k[0]), static_cast<float>(source.k[4])};
-  raw_gxf_camera_model.value()->principal_point = {
-    static_cast<float>(source.k[2]), static_cast<float>(source.k[5])};
-
-  const auto distortion = g_ros_to_gxf_distortion_model.find(source.distortion_model);
-  if (distortion == std::end(g_ros_to_gxf_distortion_model)) {
-    std::stringstream error_msg;
-    error_msg <<
-      "[convert_to_custom] Unsupported distortion model from ROS [" <<
-      source.distortion_model.c_str() << "].";
-    RCLCPP_ERROR(
-      rclcpp::get_logger("NitrosCameraInfo"), error_msg.str().c_str());
-    throw std::runtime_error(error_msg.str().c_str());
-  } else {
-    raw_gxf_camera_model.value()->distortion_type = distortion->second;
+  if (add_components) {
+    AddComponent(message.value(), RAW_CAMERA_MODEL_GXF_NAME, components->raw_camera_model);
+    AddComponent(message.value(), RECT_CAMERA_MODEL_GXF_NAME, components->rect_camera_model);
+    // this pose3D entity is used to passthrough the translation between the two cameras
+    // this translation data is not used by the tensorops rectification library
+    // Note: The rotation of this EXTRINSICS_GXF_NAME pose3D entity is set identity
+    // since the information cannot be calculated from a single camera info msg
+    AddComponent(message.value(), EXTRINSICS_GXF_NAME, components->extrinsics);
+    // this pose3D entity is used to send the rectification matrix
+    // Note: translation of this TARGET_EXTRINSICS_DELTA_GXF_NAME pose3D entity is always zero
+    AddComponent(
+      message.value(), TARGET_EXTRINSICS_DELTA_GXF_NAME, components->target_extrinsics_delta);
   }
-
-  if (source.d.size() > nvidia::gxf::CameraModel::kMaxDistortionCoefficients) {
-    std::stringstream error_msg;
-    error_msg <<
-      "[convert_to_custom] More number of coefficients for distortion model found [ # of coeff: " <<
-      source.d.size() << " > " << nvidia::gxf::CameraModel::kMaxDistortionCoefficients << "].";
-    RCLCPP_ERROR(
-      rclcpp::get_logger("NitrosCameraInfo"), error_msg.str().c_str());
-    throw std::runtime_error(error_msg.str().c_str());
-  }
-
-  if (raw_gxf_camera_model.value()->distortion_type == DistortionType::Polynomial) {
-    // prevents distortion parameters array access if its empty
-    // simulators may send empty distortion parameter array since images are already rectified
-    if (!source.d.empty()) {
-      // distortion parameters in GXF: k1, k2, k3, k4, k5, k6, p1, p2
-      // distortion parameters in ROS message: k1, k2, p1, p2, k3 ...
-      raw_gxf_camera_model.value()->distortion_coefficients[0] = source.d[0];
-      raw_gxf_camera_model.value()->distortion_coefficients[1] = source.d[1];
-
-      for (uint16_t index = 2; index < source.d.size() - 2; index++) {
-        raw_gxf_camera_model.value()->distortion_coefficients[index] = source.d[index + 2];
-      }
-      raw_gxf_camera_model.value()->distortion_coefficients[6] = source.d[2];
-      raw_gxf_camera_model.value()->distortion_coefficients[7] = source.d[3];
-    }
-  } else if (raw_gxf_camera_model.value()->distortion_type == DistortionType::Brown) {
-    // prevents distortion parameters array access if its empty
-    // simulators may send empty distortion parameter array since images are already rectified
-    if (!source.d.empty()) {
-      // distortion parameters in GXF: k1, k2, k3, k4, k5, k6, p1, p2
-      // distortion parameters in ROS message: k1, k2, p1, p2, k3 ...
-      raw_gxf_camera_model.value()->distortion_coefficients[0] = source.d[0];
-      raw_gxf_camera_model.value()->distortion_coefficients[1] = source.d[1];
-      raw_gxf_camera_model.value()->distortion_coefficients[2] = source.d[4];
-      for (uint16_t index = 3;
-        index < nvidia::gxf::CameraModel::kMaxDistortionCoefficients - 2;
-        index++)
-      {
-        raw_gxf_camera_model.value()->distortion_coefficients[index] = 0;
-      }
-      raw_gxf_camera_model.value()->distortion_coefficients[6] = source.d[2];
-      raw_gxf_camera_model.value()->distortion_coefficients[7] = source.d[3];
-    }
-  } else {
-    std::copy(
-      std::begin(source.d), std::end(source.d),
-      std::begin(raw_gxf_camera_model.value()->distortion_coefficients));
-  }
-
-  // add rectified image camera model
-  auto rect_gxf_camera_model = message->add<nvidia::gxf::CameraModel>(RECT_CAMERA_MODEL_GXF_NAME);
-  rect_gxf_camera_model.value()->dimensions = {source.width, source.height};
-  rect_gxf_camera_model.value()->focal_length = {
-    static_cast<float>(source.p[0]), static_cast<float>(source.p[5])};
-  rect_gxf_camera_model.value()->principal_point = {
-    static_cast<float>(source.p[2]), static_cast<float>(source.p[6])};
-  rect_gxf_camera_model.value()->distortion_type = DistortionType::Perspective;
-  memset(
-    rect_gxf_camera_model.value()->distortion_coefficients, 0,
-    rect_gxf_camera_model.value()->kMaxDistortionCoefficients * sizeof(float));
-  // this pose3D entity is used to passthrough the translation between the two cameras
-  // this translation data is not used by the tensorops rectification library
-  // Note: The rotation of this EXTRINSICS_GXF_NAME pose3D entity is set identity
-  // since the information cannot be calculated from a single camera info msg
-  auto extrinsics_gxf_pose_3d = message->add<nvidia::gxf::Pose3D>(EXTRINSICS_GXF_NAME);
-  // this pose3D entity is used to send the rectification matrix
-  // Note: translation of this TARGET_EXTRINSICS_DELTA_GXF_NAME pose3D entity is always zero
-  auto target_extrinsics_delta_gxf_pose_3d = message->add<nvidia::gxf::Pose3D>(
-    TARGET_EXTRINSICS_DELTA_GXF_NAME);
-
-  // populate rectification rotation matrix into the TARGET_EXTRINSICS_DELTA_GXF_NAME
-  std::copy(
-    std::begin(source.r), std::end(source.r),
-    std::begin(target_extrinsics_delta_gxf_pose_3d.value()->rotation));
-
-  // Based on the comments for the camera info msg type, p[0] == 0 means the topic
-  // contains no calibration data, ie, its an uncalibrated camera
-  if (source.p[0] == 0.0f) {
-    RCLCPP_WARN(
-      rclcpp::get_logger("NitrosCameraInfo"),
-      "[convert_to_custom] Received an uncalibrated camera info msg.");
-    extrinsics_gxf_pose_3d.value()->translation = {
-      0,
-      0,
-      0};
-  } else {
-    // populate extrinsics translation the EXTRINSICS_GXF_NAME
-    extrinsics_gxf_pose_3d.value()->translation = {
-      static_cast<float>(source.p[3]) / static_cast<float>(source.p[0]),
-      static_cast<float>(source.p[7]),
-      static_cast<float>(source.p[11])};
+  if (latched) {
+    AddComponent(message.value(), CALIBRATION_ID_GXF_NAME, calibration->id);
   }
 
   // Add timestamp to the message
-  uint64_t input_timestamp =
-    source.header.stamp.sec * static_cast<uint64_t>(1e9) +
-    source.header.stamp.nanosec;
   auto output_timestamp = message->add<nvidia::gxf::Timestamp>("timestamp");
   if (!output_timestamp) {
     std::stringstream error_msg;
@@ -390,9 +725,96 @@ void rclcpp::TypeAdapter<
   // Set Entity Id
   destination.handle = message->eid();
   GxfEntityRefCountInc(context, message->eid());
+}
+
+}  // namespace
+
+void rclcpp::TypeAdapter<
+  nvidia::isaac_ros::nitros::NitrosCameraInfo,
+  sensor_msgs::msg::CameraInfo>::convert_to_ros_message(
+  const custom_type & source, ros_message_type & destination)
+{
+  nvidia::isaac_ros::nitros::nvtxRangePushWrapper(
+    "NitrosCameraInfo::convert_to_ros_message",
+    nvidia::isaac_ros::nitros::CLR_PURPLE);
 
   RCLCPP_DEBUG(
     rclcpp::get_logger("NitrosCameraInfo"),
+    "[convert_to_ros_message] Conversion started for handle=%ld", source.handle);
+
+  ConvertToRosMessage(source, destination);
+
+  RCLCPP_DEBUG(
+    rclcpp::get_logger("NitrosCameraInfo"),
+    "[convert_to_ros_message] Conversion completed");
+
+  nvidia::isaac_ros::nitros::nvtxRangePopWrapper();
+}
+
+void rclcpp::TypeAdapter<
+  nvidia::isaac_ros::nitros::NitrosCameraInfo,
+  sensor_msgs::msg::CameraInfo>::convert_to_custom(
+  const ros_message_type & source,
+  custom_type & destination)
+{
+  nvidia::isaac_ros::nitros::nvtxRangePushWrapper(
+    "NitrosCameraInfo::convert_to_custom",
+    nvidia::isaac_ros::nitros::CLR_PURPLE);
+
+  RCLCPP_DEBUG(
+    rclcpp::get_logger("NitrosCameraInfo"),
+    "[convert_to_custom] Conversion started");
+
+  ConvertToCustom(source, destination, false);
+
+  RCLCPP_DEBUG(
+    rclcpp::get_logger("NitrosCameraInfo"),
+    "[convert_to_custom] Conversion completed");
+
+  nvidia::isaac_ros::nitros::nvtxRangePopWrapper();
+}
+
+
+void rclcpp::TypeAdapter<
+  nvidia::isaac_ros::nitros::NitrosCameraInfoLatched,
+  sensor_msgs::msg::CameraInfo>::convert_to_ros_message(
+  const custom_type & source, ros_message_type & destination)
+{
+  nvidia::isaac_ros::nitros::nvtxRangePushWrapper(
+    "NitrosCameraInfoLatched::convert_to_ros_message",
+    nvidia::isaac_ros::nitros::CLR_PURPLE);
+
+  RCLCPP_DEBUG(
+    rclcpp::get_logger("NitrosCameraInfoLatched"),
+    "[convert_to_ros_message] Conversion started for handle=%ld", source.handle);
+
+  ConvertToRosMessage(source, destination);
+
+  RCLCPP_DEBUG(
+    rclcpp::get_logger("NitrosCameraInfoLatched"),
+    "[convert_to_ros_message] Conversion completed");
+
+  nvidia::isaac_ros::nitros::nvtxRangePopWrapper();
+}
+
+void rclcpp::TypeAdapter<
+  nvidia::isaac_ros::nitros::NitrosCameraInfoLatched,
+  sensor_msgs::msg::CameraInfo>::convert_to_custom(
+  const ros_message_type & source,
+  custom_type & destination)
+{
+  nvidia::isaac_ros::nitros::nvtxRangePushWrapper(
+    "NitrosCameraInfoLatched::convert_to_custom",
+    nvidia::isaac_ros::nitros::CLR_PURPLE);
+
+  RCLCPP_DEBUG(
+    rclcpp::get_logger("NitrosCameraInfoLatched"),
+    "[convert_to_custom] Conversion started");
+
+  ConvertToCustom(source, destination, true);
+
+  RCLCPP_DEBUG(
+    rclcpp::get_logger("NitrosCameraInfoLatched"),
     "[convert_to_custom] Conversion completed");
 
   nvidia::isaac_ros::nitros::nvtxRangePopWrapper();
@@ -0,0 +1,145 @@
+# SPDX-FileCopyrightText: NVIDIA CORPORATION & AFFILIATES
+# Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+# SPDX-License-Identifier: Apache-2.0
+
+"""Proof-of-Life test for the NitrosCameraInfoLatched type adapter."""
+
+import copy
+import os
+import pathlib
+import time
+
+from isaac_ros_test import IsaacROSBaseTest, JSONConversion
+
+from launch_ros.actions import ComposableNodeContainer
+from launch_ros.descriptions import ComposableNode
+
+import pytest
+import rclpy
+from sensor_msgs.msg import CameraInfo
+
+# Every KEYFRAME_INTERVAL-th message of a frame ID gets the camera models
+KEYFRAME_INTERVAL = 30
+
+
+@pytest.mark.rostest
+def generate_test_description():
+    """Generate launch description with all ROS 2 nodes for testing."""
+    test_ns = IsaacROSNitrosCameraInfoLatchedTest.generate_namespace()
+    container = ComposableNodeContainer(
+        name='test_container',
+        namespace='isaac_ros_nitros_container',
+        package='rclcpp_components',
+        executable='component_container_mt',
+        composable_node_descriptions=[
+            ComposableNode(
+                package='isaac_ros_nitros_camera_info_type',
+                plugin='nvidia::isaac_ros::nitros::NitrosCameraInfoForwardNode',
+                name='NitrosCameraInfoForwardNode',
+                namespace=test_ns,
+                parameters=[{
+                    'compatible_format': 'nitros_camera_info_latched'
+                }],
+                remappings=[
+                    (test_ns+'/topic_forward_input', test_ns+'/input'),
+                    (test_ns+'/topic_forward_output', test_ns+'/output'),
+                ]
+            ),
+        ],
+        output='both',
+        arguments=['--ros-args', '--log-level', 'info'],
+    )
+
+    return IsaacROSNitrosCameraInfoLatchedTest.generate_test_description(
+        [container],
+        node_startup_delay=2.5
+    )
+
+
+class IsaacROSNitrosCameraInfoLatchedTest(IsaacROSBaseTest):
+    """Validate NitrosCameraInfoLatched type adapter."""
+
+    filepath = pathlib.Path(os.path.dirname(__file__))
+
+    @IsaacROSBaseTest.for_each_test_case(subfolder='nitros_camera_info')
+    def test_nitros_camera_info_latched_type_conversions(self, test_folder) -> None:
+        """Expect every message to keep its calibration, with or without latched models."""
+        self.generate_namespace_lookup(['input', 'output'])
+        received_camera_infos = []
+
+        received_camera_info_sub = self.node.create_subscription(
+            CameraInfo, self.namespaces['output'],
+            lambda msg: received_camera_infos.append(msg), self.DEFAULT_QOS)
+
+        camera_info_pub = self.node.create_publisher(
+            CameraInfo, self.namespaces['input'], self.DEFAULT_QOS)
+
+        def round_trip(camera_info: CameraInfo, description: str) -> None:
+            """Publish a camera info and expect the same calibration back."""
+            camera_info.header.stamp = self.node.get_clock().now().to_msg()
+
+            # Wait at most TIMEOUT seconds for subscriber to respond
+            TIMEOUT = 2
+            end_time = time.time() + TIMEOUT
+
+            received_camera_info = None
+            while received_camera_info is None and time.time() < end_time:
+                camera_info_pub.publish(camera_info)
+                rclpy.spin_once(self.node, timeout_sec=0.1)
+                for msg in received_camera_infos:
+                    if msg.header.stamp == camera_info.header.stamp:
+                        received_camera_info = msg
+                received_camera_infos.clear()
+
+            self.assertIsNotNone(
+                received_camera_info, f"Didn't receive the {description} on the output topic!")
+            self.assertEqual(camera_info.height, received_camera_info.height,
+                             f'Height of the {description} does not match')
+            self.assertEqual(camera_info.width, received_camera_info.width,
+                             f'Width of the {description} does not match')
+            self.assertEqual(camera_info.distortion_model, received_camera_info.distortion_model,
+                             f'Distortion model of the {description} does not match')
+            for i in range(min(len(camera_info.d), len(received_camera_info.d))):
+                self.assertEqual(
+                    round(camera_info.d[i], 2), round(received_camera_info.d[i], 2),
+                    f'{i+1}th D value of the {description} does not match')
+            for name in ('k', 'r', 'p'):
+                expected = getattr(camera_info, name)
+                received = getattr(received_camera_info, name)
+                for i in range(len(expected)):
+                    self.assertEqual(
+                        round(expected[i], 2), round(received[i], 2),
+                        f'{i+1}th {name.upper()} value of the {description} does not match')
+
+        try:
+            camera_info = JSONConversion.load_camera_info_from_json(
+                test_folder / 'camera_info.json')
+
+            # Only the first message and every KEYFRAME_INTERVAL-th one carry the camera models
+            for index in range(KEYFRAME_INTERVAL + 2):
+                round_trip(copy.deepcopy(camera_info), f'camera info {index + 1}')
+
+            # A new calibration is sent with the first message carrying it
+            changed_camera_info = copy.deepcopy(camera_info)
+            changed_camera_info.k[0] += 10.0
+            changed_camera_info.k[4] += 10.0
+            round_trip(changed_camera_info, 'camera info with a new calibration')
+            round_trip(copy.deepcopy(changed_camera_info), 'camera info after the new calibration')
+
+            print('The received camera infos are verified successfully')
+        finally:
+            self.node.destroy_subscription(received_camera_info_sub)
+            self.node.destroy_publisher(camera_info_pub)
@@ -16,6 +16,7 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include "isaac_ros_nitros_camera_info_type/nitros_camera_info.hpp"
+#include "isaac_ros_nitros_camera_info_type/nitros_camera_info_latched.hpp"
 #include "isaac_ros_nitros/nitros_node.hpp"
 
 #include "rclcpp_components/register_node_macro.hpp"
@@ -79,6 +80,7 @@ public:
     }
 
     registerSupportedType<nvidia::isaac_ros::nitros::NitrosCameraInfo>();
+    registerSupportedType<nvidia::isaac_ros::nitros::NitrosCameraInfoLatched>();
 
     startNitrosNode();
   }
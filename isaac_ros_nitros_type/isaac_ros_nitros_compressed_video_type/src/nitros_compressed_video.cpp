@@ -16,7 +16,10 @@
 // SPDX-License-Identifier: Apache-2.0
 #include <cuda_runtime.h>
 
+#include <memory>
 #include <sstream>
+#include <utility>
+#include <vector>
 
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wunused-parameter"
@@ -35,9 +38,87 @@
 
 namespace
 {
-constexpr char kEntityName[] = "memory_pool";
-constexpr char kComponentName[] = "unbounded_allocator";
-constexpr char kComponentTypeName[] = "nvidia::gxf::UnboundedAllocator";
+constexpr char kTensorName[] = "compressed_video";
+
+// Creates a message entity whose tensor wraps `size` bytes at `data` in host memory. `owner` keeps
+// the bytes alive until the tensor releases them.
+void CreateCompressedVideoEntity(
+  const foxglove_msgs::msg::CompressedVideo & source, const uint8_t * data, size_t size,
+  std::shared_ptr<const void> owner,
+  nvidia::isaac_ros::nitros::NitrosCompressedVideo & destination)
+{
+  auto context = nvidia::isaac_ros::nitros::GetTypeAdapterNitrosContext().getContext();
+
+  auto message = nvidia::gxf::Entity::New(context);
+  if (!message) {
+    std::stringstream error_msg;
+    error_msg <<
+      "[convert_to_custom] Error initializing new message entity: " <<
+      GxfResultStr(message.error());
+    RCLCPP_ERROR(
+      rclcpp::get_logger("NitrosCompressedVideo"), error_msg.str().c_str());
+    throw std::runtime_error(error_msg.str().c_str());
+  }
+
+  auto gxf_tensor = message->add<nvidia::gxf::Tensor>(kTensorName);
+  if (!gxf_tensor) {
+    std::stringstream error_msg;
+    error_msg <<
+      "[convert_to_custom] Failed to add a tensor component to message: " <<
+      GxfResultStr(gxf_tensor.error());
+    RCLCPP_ERROR(
+      rclcpp::get_logger("NitrosCompressedVideo"), error_msg.str().c_str());
+    throw std::runtime_error(error_msg.str().c_str());
+  }
+
+  // The payload is only read on the CPU by encoders, decoders and recorders, so pageable memory
+  // is wrapped as is instead of being copied into pinned memory
+  auto gxf_tensor_result = gxf_tensor.value()->wrapMemory(
+    nvidia::gxf::Shape{static_cast<int>(size)},
+    nvidia::gxf::PrimitiveType::kUnsigned8,
+    nvidia::gxf::PrimitiveTypeSize(nvidia::gxf::PrimitiveType::kUnsigned8),
+    nvidia::gxf::Unexpected{GXF_UNINITIALIZED_VALUE},
+    nvidia::gxf::MemoryStorageType::kHost, const_cast<uint8_t *>(data),
+    [owner = std::move(owner)](void *) mutable {
+      owner.reset();
+      return nvidia::gxf::Success;
+    });
+  if (!gxf_tensor_result) {
+    std::stringstream error_msg;
+    error_msg <<
+      "[convert_to_custom] Error Creating tensors: " <<
+      GxfResultStr(gxf_tensor_result.error());
+    RCLCPP_ERROR(
+      rclcpp::get_logger("NitrosCompressedVideo"), error_msg.str().c_str());
+    throw std::runtime_error(error_msg.str().c_str());
+  }
+
+  // Add timestamp to the message
+  uint64_t input_timestamp =
+    source.timestamp.sec * static_cast<uint64_t>(1e9) +
+    source.timestamp.nanosec;
+  auto output_timestamp = message->add<nvidia::gxf::Timestamp>("timestamp");
+  if (!output_timestamp) {
+    std::stringstream error_msg;
+    error_msg << "[convert_to_custom] Failed to add a timestamp component to message: " <<
+      GxfResultStr(output_timestamp.error());
+    RCLCPP_ERROR(
+      rclcpp::get_logger("NitrosCompressedVideo"), error_msg.str().c_str());
+    throw std::runtime_error(error_msg.str().c_str());
+  }
+  output_timestamp.value()->acqtime = input_timestamp;
+
+  // Set frame ID
+  destination.frame_id = source.frame_id;
+
+  // Set Entity Id
+  destination.handle = message->eid();
+  GxfEntityRefCountInc(context, message->eid());
+
+  RCLCPP_DEBUG(
+    rclcpp::get_logger("NitrosCompressedVideo"),
+    "[convert_to_custom] Conversion completed (resulting handle=%ld)", message->eid());
+}
 }  // namespace
 
 
@@ -71,24 +152,28 @@ void rclcpp::TypeAdapter<
   auto gxf_tensor = maybe_gxf_tensor.value();
 
   destination.format = "h264";
-  destination.data.resize(gxf_tensor->size());
 
   // compressed results are reside on CPU
-  const cudaError_t cuda_error = cudaMemcpy(
-    destination.data.data(),
-    gxf_tensor->data<uint8_t>().value(), gxf_tensor->size(),
-    cudaMemcpyHostToHost);
-
-  if (cuda_error != cudaSuccess) {
-    std::stringstream error_msg;
-    error_msg <<
-      "[convert_to_ros_message] cudaMemcpy failed for conversion from "
-      "NitrosCompressedVideo to foxglove_msgs::msg::CompressedVideo: " <<
-      cudaGetErrorName(cuda_error) <<
-      " (" << cudaGetErrorString(cuda_error) << ")";
-    RCLCPP_ERROR(
-      rclcpp::get_logger("NitrosCompressedVideo"), error_msg.str().c_str());
-    throw std::runtime_error(error_msg.str().c_str());
+  if (gxf_tensor->storage_type() == nvidia::gxf::MemoryStorageType::kDevice) {
+    destination.data.resize(gxf_tensor->size());
+    const cudaError_t cuda_error = cudaMemcpy(
+      destination.data.data(), gxf_tensor->pointer(), gxf_tensor->size(),
+      cudaMemcpyDeviceToHost);
+    if (cuda_error != cudaSuccess) {
+      std::stringstream error_msg;
+      error_msg <<
+        "[convert_to_ros_message] cudaMemcpy failed for conversion from "
+        "NitrosCompressedVideo to foxglove_msgs::msg::CompressedVideo: " <<
+        cudaGetErrorName(cuda_error) <<
+        " (" << cudaGetErrorString(cuda_error) << ")";
+      RCLCPP_ERROR(
+        rclcpp::get_logger("NitrosCompressedVideo"), error_msg.str().c_str());
+      throw std::runtime_error(error_msg.str().c_str());
+    }
+  } else {
+    // A single pass over the payload, without zero filling the vector first
+    const uint8_t * data = gxf_tensor->pointer();
+    destination.data.assign(data, data + gxf_tensor->size());
   }
 
   // Populate timestamp information back into ROS header
@@ -127,95 +212,13 @@ void rclcpp::TypeAdapter<
     rclcpp::get_logger("NitrosCompressedVideo"),
     "[convert_to_custom] Conversion started");
 
-  auto context = nvidia::isaac_ros::nitros::GetTypeAdapterNitrosContext().getContext();
-
-  auto message = nvidia::gxf::Entity::New(context);
-  if (!message) {
-    std::stringstream error_msg;
-    error_msg <<
-      "[convert_to_custom] Error initializing new message entity: " <<
-      GxfResultStr(message.error());
-    RCLCPP_ERROR(
-      rclcpp::get_logger("NitrosCompressedVideo"), error_msg.str().c_str());
-    throw std::runtime_error(error_msg.str().c_str());
-  }
-
-  auto gxf_tensor = message->add<nvidia::gxf::Tensor>("compressed_video");
-
-  // Get pointer to allocator component
-  gxf_uid_t cid;
-  nvidia::isaac_ros::nitros::GetTypeAdapterNitrosContext().getCid(
-    kEntityName, kComponentName, kComponentTypeName, cid);
-
-  auto maybe_allocator_handle =
-    nvidia::gxf::Handle<nvidia::gxf::Allocator>::Create(context, cid);
-  if (!maybe_allocator_handle) {
-    std::stringstream error_msg;
-    error_msg <<
-      "[convert_to_custom] Failed to get allocator's handle: " <<
-      GxfResultStr(maybe_allocator_handle.error());
-    RCLCPP_ERROR(
-      rclcpp::get_logger("NitrosCompressedVideo"), error_msg.str().c_str());
-    throw std::runtime_error(error_msg.str().c_str());
-  }
-  auto allocator_handle = maybe_allocator_handle.value();
-
-  // Allocate memory of gxf tensor.
-  auto gxf_tensor_result = gxf_tensor.value()->reshape<uint8_t>(
-    nvidia::gxf::Shape{static_cast<int>(source.data.size())}, nvidia::gxf::MemoryStorageType::kHost,
-    allocator_handle);
-  if (!gxf_tensor_result) {
-    std::stringstream error_msg;
-    error_msg <<
-      "[convert_to_custom] Error Creating tensors: " <<
-      GxfResultStr(gxf_tensor_result.error());
-    RCLCPP_ERROR(
-      rclcpp::get_logger("NitrosCompressedVideo"), error_msg.str().c_str());
-    throw std::runtime_error(error_msg.str().c_str());
-  }
-
-  // Copy data from compressed video msg to gxf tensor.
-  const cudaError_t cuda_error = cudaMemcpy(
-    gxf_tensor.value()->data<uint8_t>().value(),
-    source.data.data(), source.data.size(), cudaMemcpyHostToHost);
-
-  if (cuda_error != cudaSuccess) {
-    std::stringstream error_msg;
-    error_msg <<
-      "[convert_to_custom] cudaMemcpy failed for copying data from "
-      "foxglove_msgs::msg::CompressedVideo to NitrosCompressedVideo: " <<
-      cudaGetErrorName(cuda_error) <<
-      " (" << cudaGetErrorString(cuda_error) << ")";
-    RCLCPP_ERROR(
-      rclcpp::get_logger("NitrosCompressedVideo"), error_msg.str().c_str());
-    throw std::runtime_error(error_msg.str().c_str());
-  }
-
-  // Add timestamp to the message
-  uint64_t input_timestamp =
-    source.timestamp.sec * static_cast<uint64_t>(1e9) +
-    source.timestamp.nanosec;
-  auto output_timestamp = message->add<nvidia::gxf::Timestamp>("timestamp");
-  if (!output_timestamp) {
-    std::stringstream error_msg;
-    error_msg << "[convert_to_custom] Failed to add a timestamp component to message: " <<
-      GxfResultStr(output_timestamp.error());
-    RCLCPP_ERROR(
-      rclcpp::get_logger("NitrosCompressedVideo"), error_msg.str().c_str());
-    throw std::runtime_error(error_msg.str().c_str());
-  }
-  output_timestamp.value()->acqtime = input_timestamp;
-
-  // Set frame ID
-  destination.frame_id = source.frame_id;
-
-  // Set Entity Id
-  destination.handle = message->eid();
-  GxfEntityRefCountInc(context, message->eid());
-
-  RCLCPP_DEBUG(
-    rclcpp::get_logger("NitrosCompressedVideo"),
-    "[convert_to_custom] Conversion completed (resulting handle=%ld)", message->eid());
+  // The ROS message is only borrowed for the conversion, so its payload is copied into a buffer
+  // which is owned by the tensor
+  auto payload = std::make_shared<const std::vector<uint8_t>>(
+    source.data.begin(), source.data.end());
+  const uint8_t * data = payload->data();
+  const size_t size = payload->size();
+  CreateCompressedVideoEntity(source, data, size, std::move(payload), destination);
 
   nvidia::isaac_ros::nitros::nvtxRangePopWrapper();
 }
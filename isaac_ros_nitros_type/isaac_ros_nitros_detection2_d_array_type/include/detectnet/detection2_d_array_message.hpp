@@ -20,8 +20,10 @@
 #include <vector>
 
 #include "gxf/core/entity.hpp"
+#include "gxf/std/tensor.hpp"
 #include "gxf/std/timestamp.hpp"
 #include "detection2_d.hpp"
+#include "detection2_d_soa.hpp"
 
 namespace nvidia
 {
@@ -47,6 +49,43 @@ gxf::Expected<Detection2DParts> CreateDetection2DList(gxf_context_t context);
 // access to the components.
 gxf::Expected<Detection2DParts> GetDetection2DList(gxf::Entity message);
 
+// Columnar layout of the same message, with one host tensor per field instead of a list of
+// `Detection2D`. The message entity consists of the following components:
+//   "bbox_centers": float32 tensor of shape (N, 2)
+//   "bbox_sizes":   float32 tensor of shape (N, 2)
+//   "class_ids":    int32 tensor of shape (N), indices into the class names
+//   "scores":       float32 tensor of shape (N)
+//   "class_names":  uint8 tensor holding the NUL-terminated class names
+//   "timestamp":    `Timestamp` component
+struct Detection2DColumnarParts
+{
+  gxf::Entity message;
+  gxf::Handle<gxf::Tensor> centers;
+  gxf::Handle<gxf::Tensor> sizes;
+  gxf::Handle<gxf::Tensor> class_ids;
+  gxf::Handle<gxf::Tensor> scores;
+  gxf::Handle<gxf::Tensor> class_names;
+  gxf::Handle<gxf::Timestamp> timestamp;
+  size_t count;
+};
+
+// This function creates a new entity holding a copy of the given detections in the columnar
+// layout. All tensors are slices of a single host allocation.
+gxf::Expected<Detection2DColumnarParts> CreateDetection2DColumnar(
+  gxf_context_t context, const Detection2DSoa & detections);
+
+// This function parses an entity in the columnar layout and checks that the tensors are
+// consistent with each other.
+gxf::Expected<Detection2DColumnarParts> GetDetection2DColumnar(gxf::Entity message);
+
+// Returns true if the entity is in the columnar layout
+bool IsDetection2DColumnar(gxf::Entity message);
+
+// This function copies the detections of an entity in the columnar layout. The tensors must be
+// stored in host or system memory.
+gxf::Expected<void> ReadDetection2DColumnar(
+  const Detection2DColumnarParts & parts, Detection2DSoa & detections);
+
 }  // namespace isaac_ros
 }  // namespace nvidia
 
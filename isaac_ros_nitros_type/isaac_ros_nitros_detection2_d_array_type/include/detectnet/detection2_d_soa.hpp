@@ -0,0 +1,192 @@
+// SPDX-FileCopyrightText: NVIDIA CORPORATION & AFFILIATES
+// Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef DETECTNET__DETECTION2_D_SOA_HPP_
+#define DETECTNET__DETECTION2_D_SOA_HPP_
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <string>
+#include <vector>
+
+namespace nvidia
+{
+namespace isaac_ros
+{
+
+// Detections stored as structure of arrays, with one contiguous array per field, in the layout
+// of the tensors of columnar detection messages. Every detection has a single hypothesis.
+struct Detection2DSoa
+{
+  // Number of floats per detection in `centers` and `sizes`
+  static constexpr size_t kBoxDims = 2;
+
+  // x and y (in pixels) of the bounding box center of every detection
+  std::vector<float> centers;
+  // Width and height (in pixels) of the bounding box of every detection
+  std::vector<float> sizes;
+  // Class of every detection, as an index into `class_names`
+  std::vector<int32_t> class_ids;
+  // Confidence value of every detection
+  std::vector<float> scores;
+  // Unique IDs of the object classes
+  std::vector<std::string> class_names;
+
+  size_t size() const {return scores.size();}
+  bool empty() const {return scores.empty();}
+
+  // Sets the number of detections. The memory of the arrays is kept when it shrinks.
+  void resize(size_t count)
+  {
+    centers.resize(count * kBoxDims);
+    sizes.resize(count * kBoxDims);
+    class_ids.resize(count);
+    scores.resize(count);
+  }
+};
+
+// Removes the detections whose score is lower than `min_score` or NaN, keeping the order of the
+// other detections. Returns the number of remaining detections.
+inline size_t ThresholdScores(Detection2DSoa & detections, float min_score)
+{
+  constexpr size_t kBoxDims = Detection2DSoa::kBoxDims;
+  const size_t count = detections.size();
+  size_t kept = 0;
+  for (size_t i = 0; i < count; i++) {
+    if (!(detections.scores[i] >= min_score)) {
+      continue;
+    }
+    if (kept != i) {
+      for (size_t d = 0; d < kBoxDims; d++) {
+        detections.centers[kept * kBoxDims + d] = detections.centers[i * kBoxDims + d];
+        detections.sizes[kept * kBoxDims + d] = detections.sizes[i * kBoxDims + d];
+      }
+      detections.class_ids[kept] = detections.class_ids[i];
+      detections.scores[kept] = detections.scores[i];
+    }
+    kept++;
+  }
+  detections.resize(kept);
+  return kept;
+}
+
+// Keeps the detections at the given indices, in that order
+inline void SelectDetections(Detection2DSoa & detections, const std::vector<uint32_t> & indices)
+{
+  constexpr size_t kBoxDims = Detection2DSoa::kBoxDims;
+  Detection2DSoa selected;
+  selected.resize(indices.size());
+  for (size_t i = 0; i < indices.size(); i++) {
+    const size_t index = indices[i];
+    for (size_t d = 0; d < kBoxDims; d++) {
+      selected.centers[i * kBoxDims + d] = detections.centers[index * kBoxDims + d];
+      selected.sizes[i * kBoxDims + d] = detections.sizes[index * kBoxDims + d];
+    }
+    selected.class_ids[i] = detections.class_ids[index];
+    selected.scores[i] = detections.scores[index];
+  }
+  detections.centers.swap(selected.centers);
+  detections.sizes.swap(selected.sizes);
+  detections.class_ids.swap(selected.class_ids);
+  detections.scores.swap(selected.scores);
+}
+
+// Greedy non-maximum suppression. A detection is suppressed if its intersection over union with
+// a kept detection of higher score is larger than `iou_threshold`. With `class_wise`, detections
+// only suppress detections of the same class. Returns the indices of the kept detections by
+// decreasing score, at most `max_detections` of them (0 for no limit).
+inline std::vector<uint32_t> NonMaximumSuppression(
+  const Detection2DSoa & detections, float iou_threshold, bool class_wise,
+  size_t max_detections = 0)
+{
+  constexpr size_t kBoxDims = Detection2DSoa::kBoxDims;
+  const size_t count = detections.size();
+
+  // NaN scores are sorted last
+  std::vector<float> scores(count);
+  for (size_t i = 0; i < count; i++) {
+    scores[i] = std::isnan(detections.scores[i]) ?
+      -std::numeric_limits<float>::infinity() : detections.scores[i];
+  }
+
+  // Sort by class, then by decreasing score, so that every class is a contiguous group
+  std::vector<uint32_t> order(count);
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(
+    order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+      if (class_wise && detections.class_ids[a] != detections.class_ids[b]) {
+        return detections.class_ids[a] < detections.class_ids[b];
+      }
+      return scores[a] > scores[b];
+    });
+
+  // Corners and areas in sorted order, so that the inner loop reads contiguous memory
+  std::vector<float> x1(count), y1(count), x2(count), y2(count), areas(count);
+  for (size_t k = 0; k < count; k++) {
+    const size_t i = order[k];
+    const float half_width = 0.5f * detections.sizes[i * kBoxDims];
+    const float half_height = 0.5f * detections.sizes[i * kBoxDims + 1];
+    x1[k] = detections.centers[i * kBoxDims] - half_width;
+    x2[k] = detections.centers[i * kBoxDims] + half_width;
+    y1[k] = detections.centers[i * kBoxDims + 1] - half_height;
+    y2[k] = detections.centers[i * kBoxDims + 1] + half_height;
+    areas[k] = (x2[k] - x1[k]) * (y2[k] - y1[k]);
+  }
+
+  // End of the group of every sorted detection
+  std::vector<size_t> group_ends(count);
+  for (size_t k = count; k-- > 0; ) {
+    const bool last_of_group = k + 1 == count ||
+      (class_wise && detections.class_ids[order[k]] != detections.class_ids[order[k + 1]]);
+    group_ends[k] = last_of_group ? k + 1 : group_ends[k + 1];
+  }
+
+  std::vector<uint8_t> suppressed(count, 0);
+  std::vector<uint32_t> kept;
+  for (size_t k = 0; k < count; k++) {
+    if (suppressed[k]) {
+      continue;
+    }
+    kept.push_back(order[k]);
+    for (size_t m = k + 1; m < group_ends[k]; m++) {
+      const float width = std::max(0.0f, std::min(x2[k], x2[m]) - std::max(x1[k], x1[m]));
+      const float height = std::max(0.0f, std::min(y2[k], y2[m]) - std::max(y1[k], y1[m]));
+      const float intersection = width * height;
+      // Compared without division, so that the loop vectorizes. Boxes with NaN coordinates
+      // never suppress nor get suppressed.
+      const float union_area = areas[k] + areas[m] - intersection;
+      suppressed[m] |= intersection > iou_threshold * union_area;
+    }
+  }
+
+  if (class_wise) {
+    std::stable_sort(
+      kept.begin(), kept.end(), [&](uint32_t a, uint32_t b) {return scores[a] > scores[b];});
+  }
+  if (max_detections > 0 && kept.size() > max_detections) {
+    kept.resize(max_detections);
+  }
+  return kept;
+}
+
+}  // namespace isaac_ros
+}  // namespace nvidia
+
+#endif  // DETECTNET__DETECTION2_D_SOA_HPP_
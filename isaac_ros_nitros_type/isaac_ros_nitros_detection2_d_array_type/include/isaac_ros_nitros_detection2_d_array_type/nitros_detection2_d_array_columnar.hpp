@@ -0,0 +1,104 @@
+// SPDX-FileCopyrightText: NVIDIA CORPORATION & AFFILIATES
+// Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef ISAAC_ROS_NITROS_DETECTION2_D_ARRAY_TYPE__NITROS_DETECTION2_D_ARRAY_COLUMNAR_HPP_
+#define ISAAC_ROS_NITROS_DETECTION2_D_ARRAY_TYPE__NITROS_DETECTION2_D_ARRAY_COLUMNAR_HPP_
+/*
+ * Type adaptation for:
+ *   Nitros type: NitrosDetection2DArrayColumnar
+ *   ROS type:    vision_msgs::msg::Detection2DArray
+ *
+ * Same message as NitrosDetection2DArray, with the detections stored as one host tensor per
+ * field (bbox centers, bbox sizes, class IDs and scores) and a list of class names, see
+ * Detection2DColumnarParts, instead of a std::vector<Detection2D> component. All the tensors are
+ * slices of a single allocation. The detection codelets consume NitrosDetection2DArray, this
+ * format is for consumers of columnar tensors.
+ *
+ * The round trip through the columnar layout is lossy: every detection keeps only its highest
+ * scoring hypothesis, a detection without hypothesis comes back with a single hypothesis of
+ * empty class ID and score 0, and values are stored in single precision. Both
+ * NitrosDetection2DArray and NitrosDetection2DArrayColumnar accept either layout when converting
+ * back to ROS.
+ */
+
+#include <string>
+
+#include "isaac_ros_nitros/types/nitros_format_agent.hpp"
+#include "isaac_ros_nitros/types/nitros_type_base.hpp"
+
+#include "rclcpp/type_adapter.hpp"
+#include "vision_msgs/msg/detection2_d_array.hpp"
+
+
+namespace nvidia
+{
+namespace isaac_ros
+{
+namespace nitros
+{
+
+// Type forward declaration
+struct NitrosDetection2DArrayColumnar;
+
+// Formats
+struct nitros_detection2_d_array_columnar_t
+{
+  using MsgT = NitrosDetection2DArrayColumnar;
+  static const inline std::string supported_type_name = "nitros_detection2_d_array_columnar";
+};
+
+// NITROS data type registration factory
+NITROS_TYPE_FACTORY_BEGIN(NitrosDetection2DArrayColumnar)
+// Supported data formats
+NITROS_FORMAT_FACTORY_BEGIN()
+NITROS_FORMAT_ADD(nitros_detection2_d_array_columnar_t)
+NITROS_FORMAT_FACTORY_END()
+// Required extensions
+NITROS_TYPE_EXTENSION_FACTORY_BEGIN()
+NITROS_TYPE_EXTENSION_ADD("isaac_ros_gxf", "gxf/lib/std/libgxf_std.so")
+NITROS_TYPE_EXTENSION_ADD("isaac_ros_gxf", "gxf/lib/serialization/libgxf_serialization.so")
+NITROS_TYPE_EXTENSION_FACTORY_END()
+NITROS_TYPE_FACTORY_END()
+
+}  // namespace nitros
+}  // namespace isaac_ros
+}  // namespace nvidia
+
+
+template<>
+struct rclcpp::TypeAdapter<
+  nvidia::isaac_ros::nitros::NitrosDetection2DArrayColumnar,
+  vision_msgs::msg::Detection2DArray>
+{
+  using is_specialized = std::true_type;
+  using custom_type = nvidia::isaac_ros::nitros::NitrosDetection2DArrayColumnar;
+  using ros_message_type = vision_msgs::msg::Detection2DArray;
+
+  static void convert_to_ros_message(
+    const custom_type & source,
+    ros_message_type & destination);
+
+  static void convert_to_custom(
+    const ros_message_type & source,
+    custom_type & destination);
+};
+
+RCLCPP_USING_CUSTOM_TYPE_AS_ROS_MESSAGE_TYPE(
+  nvidia::isaac_ros::nitros::NitrosDetection2DArrayColumnar,
+  vision_msgs::msg::Detection2DArray);
+
+#endif  // ISAAC_ROS_NITROS_DETECTION2_D_ARRAY_TYPE__NITROS_DETECTION2_D_ARRAY_COLUMNAR_HPP_
@@ -17,6 +17,9 @@
 
 #include "detection2_d_array_message.hpp"
 
+#include <algorithm>
+#include <cstring>
+#include <memory>
 #include <utility>
 
 namespace nvidia
@@ -28,8 +31,53 @@ namespace
 {
 constexpr char const * kDetection2DArrayIdentifier = "detection2_d_array";
 constexpr char const * kTimestampIdentifier = "timestamp";
+constexpr char const * kCentersIdentifier = "bbox_centers";
+constexpr char const * kSizesIdentifier = "bbox_sizes";
+constexpr char const * kClassIdsIdentifier = "class_ids";
+constexpr char const * kScoresIdentifier = "scores";
+constexpr char const * kClassNamesIdentifier = "class_names";
+
+constexpr int32_t kBoxDims = static_cast<int32_t>(Detection2DSoa::kBoxDims);
+
+// Wraps a slice of a shared host buffer into a tensor. The buffer is released with the last
+// tensor referencing it.
+gxf::Expected<void> WrapSlice(
+  gxf::Handle<gxf::Tensor> tensor, const gxf::Shape & shape, gxf::PrimitiveType element_type,
+  const std::shared_ptr<uint8_t[]> & buffer, size_t offset)
+{
+  return tensor->wrapMemory(
+    shape, element_type, gxf::PrimitiveTypeSize(element_type),
+    gxf::Unexpected{GXF_UNINITIALIZED_VALUE}, gxf::MemoryStorageType::kHost,
+    buffer.get() + offset,
+    [owner = buffer](void *) mutable {
+      owner.reset();
+      return gxf::Success;
+    });
 }
 
+// Checks that a tensor is a dense (rows) or (rows, columns) array of the given element type
+bool IsColumn(
+  const gxf::Tensor & tensor, gxf::PrimitiveType element_type, int32_t rows, int32_t columns)
+{
+  const uint64_t element_size = gxf::PrimitiveTypeSize(element_type);
+  if (tensor.element_type() != element_type || tensor.shape().dimension(0) != rows) {
+    return false;
+  }
+  if (columns == 0) {
+    return tensor.rank() == 1 && (rows <= 1 || tensor.stride(0) == element_size);
+  }
+  return tensor.rank() == 2 && tensor.shape().dimension(1) == columns &&
+         tensor.stride(1) == element_size &&
+         (rows <= 1 || tensor.stride(0) == columns * element_size);
+}
+
+bool IsHostTensor(const gxf::Tensor & tensor)
+{
+  return tensor.storage_type() == gxf::MemoryStorageType::kHost ||
+         tensor.storage_type() == gxf::MemoryStorageType::kSystem;
+}
+}  // namespace
+
 gxf::Expected<Detection2DParts> CreateDetection2DList(gxf_context_t context)
 {
   Detection2DParts parts;
@@ -61,5 +109,177 @@ gxf::Expected<Detection2DParts> GetDetection2DList(gxf::Entity message)
          .substitute(parts);
 }
 
+gxf::Expected<Detection2DColumnarParts> CreateDetection2DColumnar(
+  gxf_context_t context, const Detection2DSoa & detections)
+{
+  const size_t count = detections.size();
+  size_t class_names_size = 0;
+  for (const auto & class_name : detections.class_names) {
+    class_names_size += class_name.size() + 1;
+  }
+
+  // Float columns first, then int32 and byte columns, so that every column is aligned
+  const size_t centers_offset = 0;
+  const size_t sizes_offset = centers_offset + count * kBoxDims * sizeof(float);
+  const size_t scores_offset = sizes_offset + count * kBoxDims * sizeof(float);
+  const size_t class_ids_offset = scores_offset + count * sizeof(float);
+  const size_t class_names_offset = class_ids_offset + count * sizeof(int32_t);
+  // Empty messages still wrap a valid pointer
+  const size_t buffer_size = std::max<size_t>(class_names_offset + class_names_size, 1);
+  std::shared_ptr<uint8_t[]> buffer(new uint8_t[buffer_size]);
+
+  if (count > 0) {
+    std::memcpy(
+      buffer.get() + centers_offset, detections.centers.data(),
+      count * kBoxDims * sizeof(float));
+    std::memcpy(
+      buffer.get() + sizes_offset, detections.sizes.data(), count * kBoxDims * sizeof(float));
+    std::memcpy(buffer.get() + scores_offset, detections.scores.data(), count * sizeof(float));
+    std::memcpy(
+      buffer.get() + class_ids_offset, detections.class_ids.data(), count * sizeof(int32_t));
+  }
+  uint8_t * class_names = buffer.get() + class_names_offset;
+  for (const auto & class_name : detections.class_names) {
+    std::memcpy(class_names, class_name.c_str(), class_name.size() + 1);
+    class_names += class_name.size() + 1;
+  }
+
+  const int32_t rows = static_cast<int32_t>(count);
+  Detection2DColumnarParts parts;
+  parts.count = count;
+  return gxf::Entity::New(context)
+         .assign_to(parts.message)
+         .and_then([&]() {return parts.message.add<gxf::Tensor>(kCentersIdentifier);})
+         .assign_to(parts.centers)
+         .and_then([&]() {return parts.message.add<gxf::Tensor>(kSizesIdentifier);})
+         .assign_to(parts.sizes)
+         .and_then([&]() {return parts.message.add<gxf::Tensor>(kClassIdsIdentifier);})
+         .assign_to(parts.class_ids)
+         .and_then([&]() {return parts.message.add<gxf::Tensor>(kScoresIdentifier);})
+         .assign_to(parts.scores)
+         .and_then([&]() {return parts.message.add<gxf::Tensor>(kClassNamesIdentifier);})
+         .assign_to(parts.class_names)
+         .and_then([&]() {return parts.message.add<gxf::Timestamp>(kTimestampIdentifier);})
+         .assign_to(parts.timestamp)
+         .and_then(
+    [&]() {
+      return WrapSlice(
+        parts.centers, gxf::Shape{rows, kBoxDims}, gxf::PrimitiveType::kFloat32, buffer,
+        centers_offset);
+    })
+         .and_then(
+    [&]() {
+      return WrapSlice(
+        parts.sizes, gxf::Shape{rows, kBoxDims}, gxf::PrimitiveType::kFloat32, buffer,
+        sizes_offset);
+    })
+         .and_then(
+    [&]() {
+      return WrapSlice(
+        parts.scores, gxf::Shape{rows}, gxf::PrimitiveType::kFloat32, buffer, scores_offset);
+    })
+         .and_then(
+    [&]() {
+      return WrapSlice(
+        parts.class_ids, gxf::Shape{rows}, gxf::PrimitiveType::kInt32, buffer,
+        class_ids_offset);
+    })
+         .and_then(
+    [&]() {
+      return WrapSlice(
+        parts.class_names, gxf::Shape{static_cast<int32_t>(class_names_size)},
+        gxf::PrimitiveType::kUnsigned8, buffer, class_names_offset);
+    })
+         .substitute(parts);
+}
+
+gxf::Expected<Detection2DColumnarParts> GetDetection2DColumnar(gxf::Entity message)
+{
+  Detection2DColumnarParts parts;
+  parts.message = message;
+  auto result = parts.message.get<gxf::Tensor>(kCentersIdentifier)
+    .assign_to(parts.centers)
+    .and_then([&]() {return parts.message.get<gxf::Tensor>(kSizesIdentifier);})
+    .assign_to(parts.sizes)
+    .and_then([&]() {return parts.message.get<gxf::Tensor>(kClassIdsIdentifier);})
+    .assign_to(parts.class_ids)
+    .and_then([&]() {return parts.message.get<gxf::Tensor>(kScoresIdentifier);})
+    .assign_to(parts.scores)
+    .and_then([&]() {return parts.message.get<gxf::Tensor>(kClassNamesIdentifier);})
+    .assign_to(parts.class_names)
+    .log_error("Entity does not contain the tensors of columnar detections.")
+    .and_then([&]() {return parts.message.get<gxf::Timestamp>(kTimestampIdentifier);})
+    .log_error("Entity does not contain component Timestamp %s.", kTimestampIdentifier)
+    .assign_to(parts.timestamp);
+  if (!result) {
+    return gxf::ForwardError(result);
+  }
+
+  const int32_t rows = parts.scores->shape().dimension(0);
+  if (!IsColumn(*parts.scores, gxf::PrimitiveType::kFloat32, rows, 0) ||
+    !IsColumn(*parts.class_ids, gxf::PrimitiveType::kInt32, rows, 0) ||
+    !IsColumn(*parts.centers, gxf::PrimitiveType::kFloat32, rows, kBoxDims) ||
+    !IsColumn(*parts.sizes, gxf::PrimitiveType::kFloat32, rows, kBoxDims) ||
+    !IsColumn(
+      *parts.class_names, gxf::PrimitiveType::kUnsigned8,
+      parts.class_names->shape().dimension(0), 0))
+  {
+    GXF_LOG_ERROR("Tensors of columnar detections have inconsistent shapes or types.");
+    return gxf::Unexpected{GXF_INVALID_DATA_FORMAT};
+  }
+  parts.count = static_cast<size_t>(rows);
+  return parts;
+}
+
+bool IsDetection2DColumnar(gxf::Entity message)
+{
+  return message.get<gxf::Tensor>(kScoresIdentifier).has_value();
+}
+
+gxf::Expected<void> ReadDetection2DColumnar(
+  const Detection2DColumnarParts & parts, Detection2DSoa & detections)
+{
+  if (!IsHostTensor(*parts.centers) || !IsHostTensor(*parts.sizes) ||
+    !IsHostTensor(*parts.class_ids) || !IsHostTensor(*parts.scores) ||
+    !IsHostTensor(*parts.class_names))
+  {
+    GXF_LOG_ERROR("Columnar detections must be stored in host memory.");
+    return gxf::Unexpected{GXF_MEMORY_INVALID_STORAGE_MODE};
+  }
+
+  const size_t count = parts.count;
+  detections.resize(count);
+  if (count > 0) {
+    std::memcpy(
+      detections.centers.data(), parts.centers->pointer(), count * kBoxDims * sizeof(float));
+    std::memcpy(
+      detections.sizes.data(), parts.sizes->pointer(), count * kBoxDims * sizeof(float));
+    std::memcpy(detections.scores.data(), parts.scores->pointer(), count * sizeof(float));
+    std::memcpy(
+      detections.class_ids.data(), parts.class_ids->pointer(), count * sizeof(int32_t));
+  }
+
+  // Class names are NUL-terminated. A missing final terminator ends the last name.
+  detections.class_names.clear();
+  const char * class_names = reinterpret_cast<const char *>(parts.class_names->pointer());
+  const char * class_names_end = class_names + parts.class_names->shape().dimension(0);
+  while (class_names < class_names_end) {
+    const char * name_end = std::find(class_names, class_names_end, '\0');
+    detections.class_names.emplace_back(class_names, name_end);
+    class_names = name_end + 1;
+  }
+
+  for (size_t i = 0; i < count; i++) {
+    if (detections.class_ids[i] < 0 ||
+      static_cast<size_t>(detections.class_ids[i]) >= detections.class_names.size())
+    {
+      GXF_LOG_ERROR("Class ID %d of columnar detection %zu is out of range.",
+        detections.class_ids[i], i);
+      return gxf::Unexpected{GXF_ARGUMENT_OUT_OF_RANGE};
+    }
+  }
+  return gxf::Success;
+}
+
 }  // namespace isaac_ros
 }  // namespace nvidia
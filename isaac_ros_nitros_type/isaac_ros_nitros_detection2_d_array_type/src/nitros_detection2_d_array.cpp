@@ -24,95 +24,265 @@
 #pragma GCC diagnostic ignored "-Wmissing-field-initializers"
 #pragma GCC diagnostic ignored "-Wpedantic"
 #include "detectnet/detection2_d_array_message.hpp"
-#include "gxf/std/allocator.hpp"
 #pragma GCC diagnostic pop
 
 #include "isaac_ros_nitros_detection2_d_array_type/nitros_detection2_d_array.hpp"
+#include "isaac_ros_nitros_detection2_d_array_type/nitros_detection2_d_array_columnar.hpp"
 #include "isaac_ros_nitros/types/type_adapter_nitros_context.hpp"
 
-// This functions extracts data from a nvidia::isaac_ros::Detection2D object
-// and returns a vision_msgs::msg::Detection2D object
-vision_msgs::msg::Detection2D GetNewDetection2DMsg(
-  nvidia::isaac_ros::Detection2D detection2_d,
-  nvidia::gxf::Timestamp detection2_d_timestamp)
+namespace
+{
+
+// Columnar detections reused by the conversions of the calling thread, so that their arrays are
+// only allocated when the number of detections grows
+nvidia::isaac_ros::Detection2DSoa & ScratchDetections()
 {
-  vision_msgs::msg::Detection2D detection_msg;
-  detection_msg.header.stamp.sec = static_cast<int32_t>(
-    detection2_d_timestamp.acqtime / static_cast<uint64_t>(1e9));
-  detection_msg.header.stamp.nanosec = static_cast<uint32_t>(
-    detection2_d_timestamp.acqtime % static_cast<uint64_t>(1e9));
+  thread_local nvidia::isaac_ros::Detection2DSoa detections;
+  return detections;
+}
+
+[[noreturn]] void ThrowError(const std::string & error)
+{
+  RCLCPP_ERROR(rclcpp::get_logger("NitrosDetection2DArray"), error.c_str());
+  throw std::runtime_error(error.c_str());
+}
 
+// This functions extracts data from a nvidia::isaac_ros::Detection2D object
+// into a vision_msgs::msg::Detection2D object
+void SetDetection2DMsg(
+  const nvidia::isaac_ros::Detection2D & detection2_d,
+  const builtin_interfaces::msg::Time & stamp,
+  vision_msgs::msg::Detection2D & detection_msg)
+{
+  detection_msg.header.stamp = stamp;
   detection_msg.bbox.center.position.x = detection2_d.center_x;
   detection_msg.bbox.center.position.y = detection2_d.center_y;
   detection_msg.bbox.center.theta = 0;
   detection_msg.bbox.size_x = detection2_d.size_x;
   detection_msg.bbox.size_y = detection2_d.size_y;
-  std::vector<vision_msgs::msg::ObjectHypothesisWithPose> hypothesis_list;
-  vision_msgs::msg::ObjectHypothesisWithPose hypothesis;
+  detection_msg.results.resize(detection2_d.results.size());
   for (size_t i = 0; i < detection2_d.results.size(); i++) {
-    hypothesis.hypothesis.class_id = detection2_d.results[i].class_id;
-    hypothesis.hypothesis.score = detection2_d.results[i].score;
-    hypothesis_list.push_back(hypothesis);
+    detection_msg.results[i].hypothesis.class_id = detection2_d.results[i].class_id;
+    detection_msg.results[i].hypothesis.score = detection2_d.results[i].score;
   }
-  detection_msg.results = hypothesis_list;
-  return detection_msg;
 }
 
+// Converts columnar detections to ROS, one hypothesis per detection
+void SetDetection2DMsgs(
+  const nvidia::isaac_ros::Detection2DSoa & detections,
+  const builtin_interfaces::msg::Time & stamp,
+  std::vector<vision_msgs::msg::Detection2D> & detection_msgs)
+{
+  constexpr size_t kBoxDims = nvidia::isaac_ros::Detection2DSoa::kBoxDims;
+  const size_t count = detections.size();
+  detection_msgs.resize(count);
+  for (size_t i = 0; i < count; i++) {
+    vision_msgs::msg::Detection2D & detection_msg = detection_msgs[i];
+    detection_msg.header.stamp = stamp;
+    detection_msg.bbox.center.position.x = detections.centers[i * kBoxDims];
+    detection_msg.bbox.center.position.y = detections.centers[i * kBoxDims + 1];
+    detection_msg.bbox.center.theta = 0;
+    detection_msg.bbox.size_x = detections.sizes[i * kBoxDims];
+    detection_msg.bbox.size_y = detections.sizes[i * kBoxDims + 1];
+    detection_msg.results.resize(1);
+    detection_msg.results[0].hypothesis.class_id =
+      detections.class_names[detections.class_ids[i]];
+    detection_msg.results[0].hypothesis.score = detections.scores[i];
+  }
+}
 
-void rclcpp::TypeAdapter<
-  nvidia::isaac_ros::nitros::NitrosDetection2DArray,
-  vision_msgs::msg::Detection2DArray>::convert_to_ros_message(
-  const custom_type & source, ros_message_type & destination)
+// Converts ROS detections to columnar detections, keeping the highest scoring hypothesis of
+// every detection. Detections without hypothesis get an empty class ID and a score of 0.
+void GetColumnarDetections(
+  const std::vector<vision_msgs::msg::Detection2D> & detection_msgs,
+  nvidia::isaac_ros::Detection2DSoa & detections)
+{
+  constexpr size_t kBoxDims = nvidia::isaac_ros::Detection2DSoa::kBoxDims;
+  const size_t count = detection_msgs.size();
+  detections.resize(count);
+  detections.class_names.clear();
+  std::unordered_map<std::string, int32_t> class_indices;
+  for (size_t i = 0; i < count; i++) {
+    const vision_msgs::msg::Detection2D & detection_msg = detection_msgs[i];
+    detections.centers[i * kBoxDims] = detection_msg.bbox.center.position.x;
+    detections.centers[i * kBoxDims + 1] = detection_msg.bbox.center.position.y;
+    detections.sizes[i * kBoxDims] = detection_msg.bbox.size_x;
+    detections.sizes[i * kBoxDims + 1] = detection_msg.bbox.size_y;
+
+    static const std::string kNoClass;
+    const std::string * class_id = &kNoClass;
+    double score = 0.0;
+    for (size_t j = 0; j < detection_msg.results.size(); j++) {
+      const auto & hypothesis = detection_msg.results[j].hypothesis;
+      if (j == 0 || hypothesis.score > score) {
+        class_id = &hypothesis.class_id;
+        score = hypothesis.score;
+      }
+    }
+    detections.scores[i] = static_cast<float>(score);
+
+    const auto class_index = class_indices.emplace(
+      *class_id, static_cast<int32_t>(detections.class_names.size()));
+    if (class_index.second) {
+      detections.class_names.push_back(*class_id);
+    }
+    detections.class_ids[i] = class_index.first->second;
+  }
+}
+
+// Converts a NitrosDetection2DArray or NitrosDetection2DArrayColumnar message entity into a
+// Detection2DArray. Both layouts are accepted.
+void ConvertToRosMessage(
+  const nvidia::isaac_ros::nitros::NitrosTypeBase & source,
+  vision_msgs::msg::Detection2DArray & destination)
 {
-  nvidia::isaac_ros::nitros::nvtxRangePushWrapper(
-    "NitrosDetection2DArray::convert_to_ros_message",
-    nvidia::isaac_ros::nitros::CLR_PURPLE);
-  RCLCPP_DEBUG(
-    rclcpp::get_logger("NitrosDetection2DArray"),
-    "[convert_to_ros_message] Conversion started for handle=%ld", source.handle);
   auto context = nvidia::isaac_ros::nitros::GetTypeAdapterNitrosContext().getContext();
   auto msg_entity = nvidia::gxf::Entity::Shared(context, source.handle);
 
+  if (nvidia::isaac_ros::IsDetection2DColumnar(msg_entity.value())) {
+    auto columnar_parts_expected = nvidia::isaac_ros::GetDetection2DColumnar(msg_entity.value());
+    if (!columnar_parts_expected) {
+      std::stringstream error_msg;
+      error_msg <<
+        "[convert_to_ros_message] Failed to get columnar detections from message entity: " <<
+        GxfResultStr(columnar_parts_expected.error());
+      ThrowError(error_msg.str());
+    }
+    const auto & columnar_parts = columnar_parts_expected.value();
+
+    nvidia::isaac_ros::Detection2DSoa & detections = ScratchDetections();
+    auto read_result = nvidia::isaac_ros::ReadDetection2DColumnar(columnar_parts, detections);
+    if (!read_result) {
+      std::stringstream error_msg;
+      error_msg <<
+        "[convert_to_ros_message] Failed to read columnar detections: " <<
+        GxfResultStr(read_result.error());
+      ThrowError(error_msg.str());
+    }
+
+    const uint64_t acqtime = columnar_parts.timestamp->acqtime;
+    destination.header.stamp.sec = static_cast<int32_t>(acqtime / static_cast<uint64_t>(1e9));
+    destination.header.stamp.nanosec = static_cast<uint32_t>(
+      acqtime % static_cast<uint64_t>(1e9));
+    SetDetection2DMsgs(detections, destination.header.stamp, destination.detections);
+    return;
+  }
+
   // Extract gxf message data to a struct type defined in detection2_d_array_message.hpp
-  auto detection2_d_parts_expected = nvidia::isaac_ros::GetDetection2DList(
-    msg_entity.value());
+  auto detection2_d_parts_expected = nvidia::isaac_ros::GetDetection2DList(msg_entity.value());
   if (!detection2_d_parts_expected) {
     std::stringstream error_msg;
     error_msg <<
       "[convert_to_ros_message] Failed to get detection2_d_array data from message entity: " <<
       GxfResultStr(detection2_d_parts_expected.error());
-    RCLCPP_ERROR(
-      rclcpp::get_logger("NitrosDetection2DArray"), error_msg.str().c_str());
-    throw std::runtime_error(error_msg.str().c_str());
+    ThrowError(error_msg.str());
   }
   auto detection2_d_parts = detection2_d_parts_expected.value();
 
-  // Extract detection2_d array to a struct type defined in detection2_d.hpp
-  std::vector<nvidia::isaac_ros::Detection2D> detection2_d_array =
+  // Detection2D array, a struct type defined in detection2_d.hpp
+  const std::vector<nvidia::isaac_ros::Detection2D> & detection2_d_array =
     *(detection2_d_parts.detection2_d_array);
 
   // Set timestamp for ros message from gxf message
-  nvidia::gxf::Timestamp detection2_d_timestamp = *(detection2_d_parts.timestamp);
-  destination.header.stamp.sec = static_cast<int32_t>(
-    detection2_d_timestamp.acqtime / static_cast<uint64_t>(1e9));
+  const uint64_t acqtime = detection2_d_parts.timestamp->acqtime;
+  destination.header.stamp.sec = static_cast<int32_t>(acqtime / static_cast<uint64_t>(1e9));
   destination.header.stamp.nanosec = static_cast<uint32_t>(
-    detection2_d_timestamp.acqtime % static_cast<uint64_t>(1e9));
+    acqtime % static_cast<uint64_t>(1e9));
 
-  // Extract number of detections
-  size_t num_bboxes = detection2_d_array.size();
-  // resize output array to the number of tags detected before populating
+  // Populate the detections of the ros message in place
+  const size_t num_bboxes = detection2_d_array.size();
   destination.detections.resize(num_bboxes);
-
-  // Finally populate the ros message with detections
-  std::vector<vision_msgs::msg::Detection2D> detections_list;
   for (size_t i = 0; i < num_bboxes; i++) {
-    vision_msgs::msg::Detection2D msg_detection = GetNewDetection2DMsg(
-      detection2_d_array[i],
-      detection2_d_timestamp);
+    SetDetection2DMsg(
+      detection2_d_array[i], destination.header.stamp, destination.detections[i]);
+  }
+}
 
-    detections_list.push_back(msg_detection);
+// Converts a Detection2DArray into a new message entity, with a std::vector<Detection2D>
+// component, or with the columnar layout if columnar is set
+void ConvertToCustom(
+  const vision_msgs::msg::Detection2DArray & source,
+  nvidia::isaac_ros::nitros::NitrosTypeBase & destination,
+  bool columnar)
+{
+  auto context = nvidia::isaac_ros::nitros::GetTypeAdapterNitrosContext().getContext();
+
+  // Extract timestamp from ros message and convert to gxf timestamp format
+  uint64_t input_timestamp =
+    source.header.stamp.sec * static_cast<uint64_t>(1e9) +
+    source.header.stamp.nanosec;
+
+  nvidia::gxf::Entity message;
+  if (columnar) {
+    nvidia::isaac_ros::Detection2DSoa & detections = ScratchDetections();
+    GetColumnarDetections(source.detections, detections);
+
+    auto columnar_parts = nvidia::isaac_ros::CreateDetection2DColumnar(context, detections);
+    if (!columnar_parts) {
+      std::stringstream error_msg;
+      error_msg <<
+        "[convert_to_custom] Failed to create the columnar detection2_d message: " <<
+        GxfResultStr(columnar_parts.error());
+      ThrowError(error_msg.str());
+    }
+    columnar_parts->timestamp->acqtime = input_timestamp;
+    message = columnar_parts->message;
+  } else {
+    // Populate the gxf message with detections and the timestamp
+    const size_t num_bboxes = source.detections.size();
+    auto create_detection2_d_list_message_result =
+      nvidia::isaac_ros::CreateDetection2DList(context)
+      .map(
+      [&](nvidia::isaac_ros::Detection2DParts message_parts) -> nvidia::gxf::Expected<void> {
+        std::vector<nvidia::isaac_ros::Detection2D> & detection_info_vector =
+        *message_parts.detection2_d_array;
+        detection_info_vector.resize(num_bboxes);
+        for (size_t i = 0; i < num_bboxes; i++) {
+          const vision_msgs::msg::Detection2D & detection2_d = source.detections[i];
+          nvidia::isaac_ros::Detection2D & detection = detection_info_vector[i];
+          detection.center_x = detection2_d.bbox.center.position.x;
+          detection.center_y = detection2_d.bbox.center.position.y;
+          detection.size_x = detection2_d.bbox.size_x;
+          detection.size_y = detection2_d.bbox.size_y;
+          detection.results.resize(detection2_d.results.size());
+          for (size_t j = 0; j < detection2_d.results.size(); j++) {
+            detection.results[j].class_id = detection2_d.results[j].hypothesis.class_id;
+            detection.results[j].score = detection2_d.results[j].hypothesis.score;
+          }
+        }
+        message_parts.timestamp->acqtime = input_timestamp;
+        message = message_parts.message;
+        return nvidia::gxf::Success;
+      });
+    if (!create_detection2_d_list_message_result) {
+      std::stringstream error_msg;
+      error_msg <<
+        "[convert_to_custom] Failed to create the detection2_d list message: " <<
+        GxfResultStr(create_detection2_d_list_message_result.error());
+      ThrowError(error_msg.str());
+    }
   }
-  destination.detections = detections_list;
+
+  // Set Entity Id
+  destination.handle = message.eid();
+  GxfEntityRefCountInc(context, message.eid());
+}
+
+}  // namespace
+
+void rclcpp::TypeAdapter<
+  nvidia::isaac_ros::nitros::NitrosDetection2DArray,
+  vision_msgs::msg::Detection2DArray>::convert_to_ros_message(
+  const custom_type & source, ros_message_type & destination)
+{
+  nvidia::isaac_ros::nitros::nvtxRangePushWrapper(
+    "NitrosDetection2DArray::convert_to_ros_message",
+    nvidia::isaac_ros::nitros::CLR_PURPLE);
+  RCLCPP_DEBUG(
+    rclcpp::get_logger("NitrosDetection2DArray"),
+    "[convert_to_ros_message] Conversion started for handle=%ld", source.handle);
+
+  ConvertToRosMessage(source, destination);
 
   RCLCPP_DEBUG(
     rclcpp::get_logger("NitrosDetection2DArray"),
@@ -131,91 +301,43 @@ void rclcpp::TypeAdapter<
     "NitrosDetection2DArray::convert_to_custom",
     nvidia::isaac_ros::nitros::CLR_PURPLE);
 
-  auto context = nvidia::isaac_ros::nitros::GetTypeAdapterNitrosContext().getContext();
+  ConvertToCustom(source, destination, false);
 
-  // Get pointer to allocator component
-  const std::string kEntityName = "memory_pool";
-  const std::string kComponentName = "unbounded_allocator";
-  const std::string kComponentTypeName = "nvidia::gxf::UnboundedAllocator";
+  nvidia::isaac_ros::nitros::nvtxRangePopWrapper();
+}
 
-  gxf_uid_t cid;
-  nvidia::isaac_ros::nitros::GetTypeAdapterNitrosContext().getCid(
-    kEntityName, kComponentName, kComponentTypeName, cid);
+void rclcpp::TypeAdapter<
+  nvidia::isaac_ros::nitros::NitrosDetection2DArrayColumnar,
+  vision_msgs::msg::Detection2DArray>::convert_to_ros_message(
+  const custom_type & source, ros_message_type & destination)
+{
+  nvidia::isaac_ros::nitros::nvtxRangePushWrapper(
+    "NitrosDetection2DArrayColumnar::convert_to_ros_message",
+    nvidia::isaac_ros::nitros::CLR_PURPLE);
+  RCLCPP_DEBUG(
+    rclcpp::get_logger("NitrosDetection2DArrayColumnar"),
+    "[convert_to_ros_message] Conversion started for handle=%ld", source.handle);
 
-  auto maybe_allocator_handle =
-    nvidia::gxf::Handle<nvidia::gxf::Allocator>::Create(context, cid);
-  if (!maybe_allocator_handle) {
-    std::stringstream error_msg;
-    error_msg <<
-      "[convert_to_custom] Failed to get allocator's handle: " <<
-      GxfResultStr(maybe_allocator_handle.error());
-    RCLCPP_ERROR(
-      rclcpp::get_logger("NitrosDetection2DArray"), error_msg.str().c_str());
-    throw std::runtime_error(error_msg.str().c_str());
-  }
-  auto allocator_handle = maybe_allocator_handle.value();
+  ConvertToRosMessage(source, destination);
 
-  auto message = nvidia::gxf::Entity::New(context);
-  if (!message) {
-    std::stringstream error_msg;
-    error_msg <<
-      "[convert_to_custom] Error initializing new message entity: " <<
-      GxfResultStr(message.error());
-    RCLCPP_ERROR(
-      rclcpp::get_logger("NitrosDetection2DArray"), error_msg.str().c_str());
-    throw std::runtime_error(error_msg.str().c_str());
-  }
+  RCLCPP_DEBUG(
+    rclcpp::get_logger("NitrosDetection2DArrayColumnar"),
+    "[convert_to_ros_message] Conversion completed");
 
-  // Extract timestamp from ros message and convert to gxf timestamp format
-  uint64_t input_timestamp =
-    source.header.stamp.sec * static_cast<uint64_t>(1e9) +
-    source.header.stamp.nanosec;
+  nvidia::isaac_ros::nitros::nvtxRangePopWrapper();
+}
 
-  // count number of tags first to know how many times to run the below for loop
-  size_t num_bboxes = source.detections.size();
-  // Extract detections from the ros message into std::vector<nvidia::isaac_ros::Detection2D>
-  std::vector<nvidia::isaac_ros::Detection2D> detection_info_vector;
-  for (size_t i = 0; i < num_bboxes; i++) {
-    nvidia::isaac_ros::Detection2D temp_detection_message;
-    vision_msgs::msg::Detection2D detection2_d = source.detections[i];
-    temp_detection_message.center_x = detection2_d.bbox.center.position.x;
-    temp_detection_message.center_y = detection2_d.bbox.center.position.y;
-    temp_detection_message.size_x = detection2_d.bbox.size_x;
-    temp_detection_message.size_y = detection2_d.bbox.size_y;
-    for (size_t j = 0; j < detection2_d.results.size(); j++) {
-      nvidia::isaac_ros::Hypothesis result;
-      result.class_id = detection2_d.results[j].hypothesis.class_id;
-      result.score = detection2_d.results[j].hypothesis.score;
-      temp_detection_message.results.push_back(result);
-    }
-    detection_info_vector.push_back(temp_detection_message);
-  }
+void rclcpp::TypeAdapter<
+  nvidia::isaac_ros::nitros::NitrosDetection2DArrayColumnar,
+  vision_msgs::msg::Detection2DArray>::convert_to_custom(
+  const ros_message_type & source,
+  custom_type & destination)
+{
+  nvidia::isaac_ros::nitros::nvtxRangePushWrapper(
+    "NitrosDetection2DArrayColumnar::convert_to_custom",
+    nvidia::isaac_ros::nitros::CLR_PURPLE);
 
-  // Finally populate the gxf message with detections and the timestamp
-  auto create_detection2_d_list_message_result =
-    nvidia::isaac_ros::CreateDetection2DList(context)
-    .map(
-    [&](nvidia::isaac_ros::Detection2DParts message_parts) -> nvidia::gxf::Expected<void> {
-      nvidia::gxf::Expected<void> result;
-      for (uint32_t i = 0; i < num_bboxes; i++) {
-        (message_parts.detection2_d_array)->push_back(detection_info_vector[i]);
-      }
-      message_parts.timestamp->acqtime = input_timestamp;
-      message = message_parts.message;
-      return result;
-    });
-  if (!create_detection2_d_list_message_result) {
-    std::stringstream error_msg;
-    error_msg <<
-      "[convert_to_custom] Failed to create the detection2_d list message: " <<
-      GxfResultStr(create_detection2_d_list_message_result.error());
-    RCLCPP_ERROR(
-      rclcpp::get_logger("NitrosDetection2DArray"), error_msg.str().c_str());
-    throw std::runtime_error(error_msg.str().c_str());
-  }
+  ConvertToCustom(source, destination, true);
 
-  // Set Entity Id
-  destination.handle = message->eid();
-  GxfEntityRefCountInc(context, message->eid());
   nvidia::isaac_ros::nitros::nvtxRangePopWrapper();
 }
@@ -0,0 +1,222 @@
+// SPDX-FileCopyrightText: NVIDIA CORPORATION & AFFILIATES
+// Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "detectnet/detection2_d_soa.hpp"
+
+namespace nvidia
+{
+namespace isaac_ros
+{
+
+namespace
+{
+
+// A detection of the test cases: bounding box center and size, class index and score
+struct TestDetection
+{
+  float x;
+  float y;
+  float width;
+  float height;
+  int32_t class_id;
+  float score;
+};
+
+Detection2DSoa MakeDetections(const std::vector<TestDetection> & test_detections)
+{
+  Detection2DSoa detections;
+  detections.resize(test_detections.size());
+  for (size_t i = 0; i < test_detections.size(); i++) {
+    const TestDetection & detection = test_detections[i];
+    detections.centers[i * 2] = detection.x;
+    detections.centers[i * 2 + 1] = detection.y;
+    detections.sizes[i * 2] = detection.width;
+    detections.sizes[i * 2 + 1] = detection.height;
+    detections.class_ids[i] = detection.class_id;
+    detections.scores[i] = detection.score;
+  }
+  return detections;
+}
+
+float IntersectionOverUnion(const Detection2DSoa & detections, size_t a, size_t b)
+{
+  // Overlap of the two boxes along the x (d = 0) or y (d = 1) axis
+  const auto overlap = [&](size_t d) {
+      const float min_a = detections.centers[a * 2 + d] - 0.5f * detections.sizes[a * 2 + d];
+      const float max_a = detections.centers[a * 2 + d] + 0.5f * detections.sizes[a * 2 + d];
+      const float min_b = detections.centers[b * 2 + d] - 0.5f * detections.sizes[b * 2 + d];
+      const float max_b = detections.centers[b * 2 + d] + 0.5f * detections.sizes[b * 2 + d];
+      return std::max(0.0f, std::min(max_a, max_b) - std::max(min_a, min_b));
+    };
+  const float intersection = overlap(0) * overlap(1);
+  const float area_a = detections.sizes[a * 2] * detections.sizes[a * 2 + 1];
+  const float area_b = detections.sizes[b * 2] * detections.sizes[b * 2 + 1];
+  return intersection / (area_a + area_b - intersection);
+}
+
+// Textbook greedy NMS: repeatedly keeps the best remaining detection and drops the ones it
+// overlaps, with a division per pair
+std::vector<uint32_t> ReferenceNonMaximumSuppression(
+  const Detection2DSoa & detections, float iou_threshold, bool class_wise)
+{
+  std::vector<uint32_t> order(detections.size());
+  for (uint32_t i = 0; i < order.size(); i++) {
+    order[i] = i;
+  }
+  std::stable_sort(
+    order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+      return detections.scores[a] > detections.scores[b];
+    });
+  std::vector<uint32_t> kept;
+  for (const uint32_t candidate : order) {
+    bool suppressed = false;
+    for (const uint32_t selected : kept) {
+      if ((!class_wise || detections.class_ids[selected] == detections.class_ids[candidate]) &&
+        IntersectionOverUnion(detections, selected, candidate) > iou_threshold)
+      {
+        suppressed = true;
+        break;
+      }
+    }
+    if (!suppressed) {
+      kept.push_back(candidate);
+    }
+  }
+  return kept;
+}
+
+}  // namespace
+
+TEST(Detection2DSoaTest, ThresholdScoresKeepsOrderAndFields)
+{
+  const float nan = std::numeric_limits<float>::quiet_NaN();
+  Detection2DSoa detections = MakeDetections(
+  {
+    {1, 2, 3, 4, 0, 0.9f},
+    {5, 6, 7, 8, 1, 0.1f},
+    {9, 10, 11, 12, 2, nan},
+    {13, 14, 15, 16, 3, 0.5f},
+    {17, 18, 19, 20, 4, 0.49f},
+  });
+
+  EXPECT_EQ(ThresholdScores(detections, 0.5f), 2u);
+  ASSERT_EQ(detections.size(), 2u);
+  EXPECT_EQ(detections.centers, (std::vector<float>{1, 2, 13, 14}));
+  EXPECT_EQ(detections.sizes, (std::vector<float>{3, 4, 15, 16}));
+  EXPECT_EQ(detections.class_ids, (std::vector<int32_t>{0, 3}));
+  EXPECT_EQ(detections.scores, (std::vector<float>{0.9f, 0.5f}));
+
+  EXPECT_EQ(ThresholdScores(detections, 1.0f), 0u);
+  EXPECT_TRUE(detections.empty());
+  EXPECT_TRUE(detections.centers.empty());
+}
+
+TEST(Detection2DSoaTest, SelectDetectionsReorders)
+{
+  Detection2DSoa detections = MakeDetections(
+  {
+    {1, 2, 3, 4, 0, 0.1f},
+    {5, 6, 7, 8, 1, 0.2f},
+    {9, 10, 11, 12, 2, 0.3f},
+  });
+
+  SelectDetections(detections, {2, 0});
+  ASSERT_EQ(detections.size(), 2u);
+  EXPECT_EQ(detections.centers, (std::vector<float>{9, 10, 1, 2}));
+  EXPECT_EQ(detections.sizes, (std::vector<float>{11, 12, 3, 4}));
+  EXPECT_EQ(detections.class_ids, (std::vector<int32_t>{2, 0}));
+  EXPECT_EQ(detections.scores, (std::vector<float>{0.3f, 0.1f}));
+}
+
+TEST(Detection2DSoaTest, NonMaximumSuppressionOverlaps)
+{
+  const Detection2DSoa detections = MakeDetections(
+  {
+    // Overlaps the next box with an IoU of 0.6
+    {10, 10, 10, 10, 0, 0.8f},
+    {12.5f, 10, 10, 10, 0, 0.9f},
+    // Same box as the first one, in another class
+    {10, 10, 10, 10, 1, 0.7f},
+    // Overlaps the second box with an IoU of 1/3
+    {17.5f, 10, 10, 10, 0, 0.6f},
+    // Disjoint
+    {100, 100, 5, 5, 0, 0.1f},
+  });
+
+  EXPECT_EQ(NonMaximumSuppression(detections, 0.5f, true), (std::vector<uint32_t>{1, 2, 3, 4}));
+  EXPECT_EQ(NonMaximumSuppression(detections, 0.5f, false), (std::vector<uint32_t>{1, 3, 4}));
+  EXPECT_EQ(NonMaximumSuppression(detections, 0.3f, true), (std::vector<uint32_t>{1, 2, 4}));
+  EXPECT_EQ(
+    NonMaximumSuppression(detections, 0.7f, true), (std::vector<uint32_t>{1, 0, 2, 3, 4}));
+
+  // The limit applies to the detections kept by decreasing score
+  EXPECT_EQ(NonMaximumSuppression(detections, 0.5f, true, 2), (std::vector<uint32_t>{1, 2}));
+
+  EXPECT_TRUE(NonMaximumSuppression(Detection2DSoa{}, 0.5f, true).empty());
+}
+
+TEST(Detection2DSoaTest, NonMaximumSuppressionNan)
+{
+  const float nan = std::numeric_limits<float>::quiet_NaN();
+  const Detection2DSoa detections = MakeDetections(
+  {
+    // NaN scores are sorted last, so this box is suppressed by the next one
+    {10, 10, 10, 10, 0, nan},
+    {10, 10, 10, 10, 0, 0.5f},
+    // Boxes with NaN coordinates never suppress nor get suppressed
+    {nan, 10, 10, 10, 0, 0.9f},
+    {10, nan, 10, 10, 0, 0.1f},
+  });
+
+  EXPECT_EQ(NonMaximumSuppression(detections, 0.5f, true), (std::vector<uint32_t>{2, 1, 3}));
+}
+
+TEST(Detection2DSoaTest, NonMaximumSuppressionMatchesReference)
+{
+  std::mt19937 rng(0);
+  std::uniform_real_distribution<float> position(0.0f, 200.0f);
+  std::uniform_real_distribution<float> size(5.0f, 60.0f);
+  std::uniform_real_distribution<float> score(0.0f, 1.0f);
+  std::uniform_int_distribution<int32_t> class_id(0, 4);
+  for (const size_t count : {1, 2, 10, 100, 1000}) {
+    std::vector<TestDetection> test_detections(count);
+    for (TestDetection & detection : test_detections) {
+      detection = {position(rng), position(rng), size(rng), size(rng), class_id(rng), score(rng)};
+    }
+    const Detection2DSoa detections = MakeDetections(test_detections);
+    for (const bool class_wise : {false, true}) {
+      for (const float iou_threshold : {0.1f, 0.5f, 0.9f}) {
+        const std::vector<uint32_t> expected =
+          ReferenceNonMaximumSuppression(detections, iou_threshold, class_wise);
+        EXPECT_EQ(NonMaximumSuppression(detections, iou_threshold, class_wise), expected) <<
+          count << " detections, class_wise=" << class_wise << ", iou_threshold=" <<
+          iou_threshold;
+      }
+    }
+  }
+}
+
+}  // namespace isaac_ros
+}  // namespace nvidia
@@ -0,0 +1,142 @@
+# SPDX-FileCopyrightText: NVIDIA CORPORATION & AFFILIATES
+# Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+# SPDX-License-Identifier: Apache-2.0
+
+"""Proof-of-Life test for the NitrosDetection2DArrayColumnar type adapter."""
+
+import time
+
+from isaac_ros_test import IsaacROSBaseTest
+
+from launch_ros.actions import ComposableNodeContainer
+from launch_ros.descriptions import ComposableNode
+
+import pytest
+import rclpy
+from vision_msgs.msg import Detection2D, Detection2DArray, ObjectHypothesisWithPose
+
+# Detections of the test message: bounding box (center x, center y, width, height) and
+# hypotheses (class ID, score). Values are exact in single precision.
+TEST_DETECTIONS = [
+    ((4.0, 5.0, 6.0, 7.0), [('0', 0.25), ('1', 0.5)]),
+    ((100.5, 20.25, 30.0, 40.0), [('person', 0.75)]),
+    ((-3.0, 0.0, 1.0, 2.0), []),
+    ((8.0, 9.0, 10.0, 11.0), [('1', 0.125), ('person', 0.0625), ('2', 0.03125)]),
+    ((12.0, 13.0, 14.0, 15.0), [('1', 1.0)]),
+]
+
+
+@pytest.mark.rostest
+def generate_test_description():
+    """Generate launch description with all ROS 2 nodes for testing."""
+    test_ns = IsaacROSNitrosDetection2DArrayColumnarTest.generate_namespace()
+    container = ComposableNodeContainer(
+        name='test_container',
+        namespace='isaac_ros_nitros_container',
+        package='rclcpp_components',
+        executable='component_container_mt',
+        composable_node_descriptions=[
+            ComposableNode(
+                package='isaac_ros_nitros_detection2_d_array_type',
+                plugin='nvidia::isaac_ros::nitros::NitrosDetection2DArrayForwardNode',
+                name='NitrosDetection2DArrayForwardNode',
+                namespace=test_ns,
+                parameters=[{
+                    'compatible_format': 'nitros_detection2_d_array_columnar'
+                }],
+                remappings=[
+                    (test_ns+'/topic_forward_input', test_ns+'/input'),
+                    (test_ns+'/topic_forward_output', test_ns+'/output'),
+                ]
+            ),
+        ],
+        output='both',
+        arguments=['--ros-args', '--log-level', 'info'],
+    )
+
+    return IsaacROSNitrosDetection2DArrayColumnarTest.generate_test_description(
+        [container],
+        node_startup_delay=2.5
+    )
+
+
+class IsaacROSNitrosDetection2DArrayColumnarTest(IsaacROSBaseTest):
+    """Validate NitrosDetection2DArrayColumnar type adapter."""
+
+    def test_nitros_detection2_d_array_columnar_type_conversions(self) -> None:
+        """Expect every detection back with its bounding box and best hypothesis only."""
+        self.generate_namespace_lookup(['input', 'output'])
+        received_arrays = []
+
+        received_array_sub = self.node.create_subscription(
+            Detection2DArray, self.namespaces['output'],
+            lambda msg: received_arrays.append(msg), self.DEFAULT_QOS)
+
+        detection2_d_array_pub = self.node.create_publisher(
+            Detection2DArray, self.namespaces['input'], self.DEFAULT_QOS)
+
+        try:
+            detection2_d_array = Detection2DArray()
+            detection2_d_array.header.frame_id = 'tf_camera'
+            for (x, y, width, height), hypotheses in TEST_DETECTIONS:
+                detection2_d = Detection2D()
+                detection2_d.bbox.center.position.x = x
+                detection2_d.bbox.center.position.y = y
+                detection2_d.bbox.size_x = width
+                detection2_d.bbox.size_y = height
+                for class_id, score in hypotheses:
+                    result = ObjectHypothesisWithPose()
+                    result.hypothesis.class_id = class_id
+                    result.hypothesis.score = score
+                    detection2_d.results.append(result)
+                detection2_d_array.detections.append(detection2_d)
+            detection2_d_array.header.stamp = self.node.get_clock().now().to_msg()
+
+            # Wait at most TIMEOUT seconds for subscriber to respond
+            TIMEOUT = 10
+            end_time = time.time() + TIMEOUT
+
+            received_array = None
+            while received_array is None and time.time() < end_time:
+                detection2_d_array_pub.publish(detection2_d_array)
+                rclpy.spin_once(self.node, timeout_sec=0.1)
+                for msg in received_arrays:
+                    if msg.header.stamp == detection2_d_array.header.stamp:
+                        received_array = msg
+
+            self.assertIsNotNone(received_array, "Didn't receive output on the output topic!")
+            self.assertEqual(len(TEST_DETECTIONS), len(received_array.detections))
+            for index, ((x, y, width, height), hypotheses) in enumerate(TEST_DETECTIONS):
+                received_detection2_d = received_array.detections[index]
+                self.assertEqual(x, received_detection2_d.bbox.center.position.x)
+                self.assertEqual(y, received_detection2_d.bbox.center.position.y)
+                self.assertEqual(width, received_detection2_d.bbox.size_x)
+                self.assertEqual(height, received_detection2_d.bbox.size_y)
+
+                # The columnar layout keeps the best hypothesis, or an empty class with score 0
+                best_class_id, best_score = max(
+                    hypotheses, key=lambda hypothesis: hypothesis[1], default=('', 0.0))
+                self.assertEqual(1, len(received_detection2_d.results),
+                                 f'Detection {index} does not have a single hypothesis')
+                received_hypothesis = received_detection2_d.results[0].hypothesis
+                self.assertEqual(best_class_id, received_hypothesis.class_id,
+                                 f'Class ID of detection {index} does not match')
+                self.assertEqual(best_score, received_hypothesis.score,
+                                 f'Score of detection {index} does not match')
+            print('The received columnar detection 2D array has been verified successfully')
+        finally:
+            self.node.destroy_subscription(received_array_sub)
+            self.node.destroy_publisher(detection2_d_array_pub)
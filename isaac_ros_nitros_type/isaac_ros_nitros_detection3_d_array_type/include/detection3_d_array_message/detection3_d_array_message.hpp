@@ -20,6 +20,7 @@
 #include <string>
 #include <vector>
 
+#include "detection3_d_array_message/detection3_d_soa.hpp"
 #include "gems/core/math/pose3.hpp"
 #include "gxf/core/entity.hpp"
 #include "gxf/core/expected.hpp"
@@ -51,6 +52,40 @@ gxf::Expected<Detection3DListMessageParts> CreateDetection3DListMessage(
   gxf_context_t context, size_t detections);
 gxf::Expected<Detection3DListMessageParts> GetDetection3DListMessage(gxf::Entity entity);
 
+// Columnar layout of the same message, with one host tensor per field instead of three
+// components per detection:
+//   "bbox_centers": float32 tensor of shape (N, 3)
+//   "orientations": float32 tensor of shape (N, 4), quaternions in x, y, z, w order
+//   "bbox_sizes":   float32 tensor of shape (N, 3)
+//   "class_ids":    int32 tensor of shape (N), indices into the class names
+//   "scores":       float32 tensor of shape (N)
+//   "class_names":  uint8 tensor holding the NUL-terminated class names
+//   "timestamp":    `Timestamp` component
+struct Detection3DColumnarParts
+{
+  gxf::Entity entity;
+  gxf::Handle<gxf::Tensor> centers;
+  gxf::Handle<gxf::Tensor> orientations;
+  gxf::Handle<gxf::Tensor> sizes;
+  gxf::Handle<gxf::Tensor> class_ids;
+  gxf::Handle<gxf::Tensor> scores;
+  gxf::Handle<gxf::Tensor> class_names;
+  gxf::Handle<gxf::Timestamp> timestamp;
+  size_t count;
+};
+
+// Creates an entity holding a copy of the detections in the columnar layout. All tensors are
+// slices of a single host allocation.
+gxf::Expected<Detection3DColumnarParts> CreateDetection3DColumnarMessage(
+  gxf_context_t context, const Detection3DSoa & detections);
+// Parses an entity in the columnar layout and checks the consistency of its tensors
+gxf::Expected<Detection3DColumnarParts> GetDetection3DColumnarMessage(gxf::Entity entity);
+// Returns true if the entity is in the columnar layout
+bool IsDetection3DColumnarMessage(gxf::Entity entity);
+// Copies the detections of an entity in the columnar layout, stored in host or system memory
+gxf::Expected<void> ReadDetection3DColumnarMessage(
+  const Detection3DColumnarParts & parts, Detection3DSoa & detections);
+
 }  // namespace isaac
 }  // namespace nvidia
 
@@ -0,0 +1,221 @@
+// SPDX-FileCopyrightText: NVIDIA CORPORATION & AFFILIATES
+// Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef DETECTION3_D_ARRAY_MESSAGE__DETECTION3_D_SOA_HPP_
+#define DETECTION3_D_ARRAY_MESSAGE__DETECTION3_D_SOA_HPP_
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <string>
+#include <vector>
+
+namespace nvidia
+{
+namespace isaac
+{
+
+// 3D detections stored as structure of arrays, with one contiguous array per field, in the
+// layout of the tensors of columnar detection messages. Every detection has a single hypothesis.
+struct Detection3DSoa
+{
+  // x, y and z of the bounding box center of every detection
+  std::vector<float> centers;
+  // Orientation of the bounding box of every detection, as a quaternion in x, y, z, w order
+  std::vector<float> orientations;
+  // Size of the bounding box of every detection along its x, y and z axes
+  std::vector<float> sizes;
+  // Class of every detection, as an index into `class_names`
+  std::vector<int32_t> class_ids;
+  // Confidence value of every detection
+  std::vector<float> scores;
+  // Unique IDs of the object classes
+  std::vector<std::string> class_names;
+
+  size_t size() const {return scores.size();}
+  bool empty() const {return scores.empty();}
+
+  // Sets the number of detections. The memory of the arrays is kept when it shrinks.
+  void resize(size_t count)
+  {
+    centers.resize(count * 3);
+    orientations.resize(count * 4);
+    sizes.resize(count * 3);
+    class_ids.resize(count);
+    scores.resize(count);
+  }
+};
+
+// Removes the detections whose score is lower than `min_score` or NaN, keeping the order of the
+// other detections. Returns the number of remaining detections.
+inline size_t ThresholdScores(Detection3DSoa & detections, float min_score)
+{
+  const size_t count = detections.size();
+  size_t kept = 0;
+  for (size_t i = 0; i < count; i++) {
+    if (!(detections.scores[i] >= min_score)) {
+      continue;
+    }
+    if (kept != i) {
+      for (size_t d = 0; d < 3; d++) {
+        detections.centers[kept * 3 + d] = detections.centers[i * 3 + d];
+        detections.sizes[kept * 3 + d] = detections.sizes[i * 3 + d];
+      }
+      for (size_t d = 0; d < 4; d++) {
+        detections.orientations[kept * 4 + d] = detections.orientations[i * 4 + d];
+      }
+      detections.class_ids[kept] = detections.class_ids[i];
+      detections.scores[kept] = detections.scores[i];
+    }
+    kept++;
+  }
+  detections.resize(kept);
+  return kept;
+}
+
+// Keeps the detections at the given indices, in that order
+inline void SelectDetections(Detection3DSoa & detections, const std::vector<uint32_t> & indices)
+{
+  Detection3DSoa selected;
+  selected.resize(indices.size());
+  for (size_t i = 0; i < indices.size(); i++) {
+    const size_t index = indices[i];
+    for (size_t d = 0; d < 3; d++) {
+      selected.centers[i * 3 + d] = detections.centers[index * 3 + d];
+      selected.sizes[i * 3 + d] = detections.sizes[index * 3 + d];
+    }
+    for (size_t d = 0; d < 4; d++) {
+      selected.orientations[i * 4 + d] = detections.orientations[index * 4 + d];
+    }
+    selected.class_ids[i] = detections.class_ids[index];
+    selected.scores[i] = detections.scores[index];
+  }
+  detections.centers.swap(selected.centers);
+  detections.orientations.swap(selected.orientations);
+  detections.sizes.swap(selected.sizes);
+  detections.class_ids.swap(selected.class_ids);
+  detections.scores.swap(selected.scores);
+}
+
+// Greedy non-maximum suppression. A detection is suppressed if its intersection over union with
+// a kept detection of higher score is larger than `iou_threshold`. With `class_wise`, detections
+// only suppress detections of the same class. Returns the indices of the kept detections by
+// decreasing score, at most `max_detections` of them (0 for no limit).
+//
+// Boxes are compared through their axis-aligned bounding boxes, which is exact for boxes which
+// are not rotated, or rotated by multiples of 90 degrees, and an approximation otherwise.
+inline std::vector<uint32_t> NonMaximumSuppression(
+  const Detection3DSoa & detections, float iou_threshold, bool class_wise,
+  size_t max_detections = 0)
+{
+  const size_t count = detections.size();
+
+  // NaN scores are sorted last
+  std::vector<float> scores(count);
+  for (size_t i = 0; i < count; i++) {
+    scores[i] = std::isnan(detections.scores[i]) ?
+      -std::numeric_limits<float>::infinity() : detections.scores[i];
+  }
+
+  // Sort by class, then by decreasing score, so that every class is a contiguous group
+  std::vector<uint32_t> order(count);
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(
+    order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+      if (class_wise && detections.class_ids[a] != detections.class_ids[b]) {
+        return detections.class_ids[a] < detections.class_ids[b];
+      }
+      return scores[a] > scores[b];
+    });
+
+  // Corners of the axis-aligned bounding boxes and their volumes in sorted order, so that the
+  // inner loop reads contiguous memory
+  std::vector<float> lower[3], upper[3];
+  for (size_t d = 0; d < 3; d++) {
+    lower[d].resize(count);
+    upper[d].resize(count);
+  }
+  std::vector<float> volumes(count);
+  for (size_t k = 0; k < count; k++) {
+    const size_t i = order[k];
+    const float * q = &detections.orientations[i * 4];
+    const float * size = &detections.sizes[i * 3];
+    // Rotation matrix of the normalized quaternion
+    const float norm = q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3];
+    const float s = norm > 0.0f ? 2.0f / norm : 0.0f;
+    const float x = q[0], y = q[1], z = q[2], w = q[3];
+    const float rotation[3][3] = {
+      {1.0f - s * (y * y + z * z), s * (x * y - z * w), s * (x * z + y * w)},
+      {s * (x * y + z * w), 1.0f - s * (x * x + z * z), s * (y * z - x * w)},
+      {s * (x * z - y * w), s * (y * z + x * w), 1.0f - s * (x * x + y * y)},
+    };
+    float volume = 1.0f;
+    for (size_t d = 0; d < 3; d++) {
+      const float half_extent = 0.5f *
+        (std::abs(rotation[d][0]) * size[0] + std::abs(rotation[d][1]) * size[1] +
+        std::abs(rotation[d][2]) * size[2]);
+      lower[d][k] = detections.centers[i * 3 + d] - half_extent;
+      upper[d][k] = detections.centers[i * 3 + d] + half_extent;
+      volume *= upper[d][k] - lower[d][k];
+    }
+    volumes[k] = volume;
+  }
+
+  // End of the group of every sorted detection
+  std::vector<size_t> group_ends(count);
+  for (size_t k = count; k-- > 0; ) {
+    const bool last_of_group = k + 1 == count ||
+      (class_wise && detections.class_ids[order[k]] != detections.class_ids[order[k + 1]]);
+    group_ends[k] = last_of_group ? k + 1 : group_ends[k + 1];
+  }
+
+  std::vector<uint8_t> suppressed(count, 0);
+  std::vector<uint32_t> kept;
+  for (size_t k = 0; k < count; k++) {
+    if (suppressed[k]) {
+      continue;
+    }
+    kept.push_back(order[k]);
+    for (size_t m = k + 1; m < group_ends[k]; m++) {
+      float intersection = 1.0f;
+      for (size_t d = 0; d < 3; d++) {
+        intersection *= std::max(
+          0.0f, std::min(upper[d][k], upper[d][m]) - std::max(lower[d][k], lower[d][m]));
+      }
+      // Compared without division. Boxes with NaN coordinates never suppress nor get
+      // suppressed.
+      const float union_volume = volumes[k] + volumes[m] - intersection;
+      suppressed[m] |= intersection > iou_threshold * union_volume;
+    }
+  }
+
+  if (class_wise) {
+    std::stable_sort(
+      kept.begin(), kept.end(), [&](uint32_t a, uint32_t b) {return scores[a] > scores[b];});
+  }
+  if (max_detections > 0 && kept.size() > max_detections) {
+    kept.resize(max_detections);
+  }
+  return kept;
+}
+
+}  // namespace isaac
+}  // namespace nvidia
+
+#endif  // DETECTION3_D_ARRAY_MESSAGE__DETECTION3_D_SOA_HPP_
@@ -17,6 +17,10 @@
 
 #include "detection3_d_array_message/detection3_d_array_message.hpp"
 
+#include <algorithm>
+#include <cstring>
+#include <memory>
+
 namespace nvidia
 {
 namespace isaac
@@ -30,6 +34,52 @@ constexpr char kBBoxSizeName[] = "bbox_size";
 constexpr char kObjectHypothesisName[] = "object_hypothesis";
 constexpr char kTimestampName[] = "timestamp";
 
+// Tensors of the columnar layout
+constexpr char kCentersName[] = "bbox_centers";
+constexpr char kOrientationsName[] = "orientations";
+constexpr char kSizesName[] = "bbox_sizes";
+constexpr char kClassIdsName[] = "class_ids";
+constexpr char kScoresName[] = "scores";
+constexpr char kClassNamesName[] = "class_names";
+
+// Wraps a slice of a shared host buffer into a tensor. The buffer is released with the last
+// tensor referencing it.
+gxf::Expected<void> WrapSlice(
+  gxf::Handle<gxf::Tensor> tensor, const gxf::Shape & shape, gxf::PrimitiveType element_type,
+  const std::shared_ptr<uint8_t[]> & buffer, size_t offset)
+{
+  return tensor->wrapMemory(
+    shape, element_type, gxf::PrimitiveTypeSize(element_type),
+    gxf::Unexpected{GXF_UNINITIALIZED_VALUE}, gxf::MemoryStorageType::kHost,
+    buffer.get() + offset,
+    [owner = buffer](void *) mutable {
+      owner.reset();
+      return gxf::Success;
+    });
+}
+
+// Checks that a tensor is a dense (rows) or (rows, columns) array of the given element type
+bool IsColumn(
+  const gxf::Tensor & tensor, gxf::PrimitiveType element_type, int32_t rows, int32_t columns)
+{
+  const uint64_t element_size = gxf::PrimitiveTypeSize(element_type);
+  if (tensor.element_type() != element_type || tensor.shape().dimension(0) != rows) {
+    return false;
+  }
+  if (columns == 0) {
+    return tensor.rank() == 1 && (rows <= 1 || tensor.stride(0) == element_size);
+  }
+  return tensor.rank() == 2 && tensor.shape().dimension(1) == columns &&
+         tensor.stride(1) == element_size &&
+         (rows <= 1 || tensor.stride(0) == columns * element_size);
+}
+
+bool IsHostTensor(const gxf::Tensor & tensor)
+{
+  return tensor.storage_type() == gxf::MemoryStorageType::kHost ||
+         tensor.storage_type() == gxf::MemoryStorageType::kSystem;
+}
+
 }  // namespace
 
 gxf::Expected<Detection3DListMessageParts> CreateDetection3DListMessage(
@@ -75,5 +125,175 @@ gxf::Expected<Detection3DListMessageParts> GetDetection3DListMessage(gxf::Entity
   return parts;
 }
 
+gxf::Expected<Detection3DColumnarParts> CreateDetection3DColumnarMessage(
+  gxf_context_t context, const Detection3DSoa & detections)
+{
+  const size_t count = detections.size();
+  size_t class_names_size = 0;
+  for (const auto & class_name : detections.class_names) {
+    class_names_size += class_name.size() + 1;
+  }
+
+  // Float columns first, then int32 and byte columns, so that every column is aligned
+  const size_t centers_offset = 0;
+  const size_t orientations_offset = centers_offset + count * 3 * sizeof(float);
+  const size_t sizes_offset = orientations_offset + count * 4 * sizeof(float);
+  const size_t scores_offset = sizes_offset + count * 3 * sizeof(float);
+  const size_t class_ids_offset = scores_offset + count * sizeof(float);
+  const size_t class_names_offset = class_ids_offset + count * sizeof(int32_t);
+  // Empty messages still wrap a valid pointer
+  const size_t buffer_size = std::max<size_t>(class_names_offset + class_names_size, 1);
+  std::shared_ptr<uint8_t[]> buffer(new uint8_t[buffer_size]);
+
+  if (count > 0) {
+    std::memcpy(
+      buffer.get() + centers_offset, detections.centers.data(), count * 3 * sizeof(float));
+    std::memcpy(
+      buffer.get() + orientations_offset, detections.orientations.data(),
+      count * 4 * sizeof(float));
+    std::memcpy(buffer.get() + sizes_offset, detections.sizes.data(), count * 3 * sizeof(float));
+    std::memcpy(buffer.get() + scores_offset, detections.scores.data(), count * sizeof(float));
+    std::memcpy(
+      buffer.get() + class_ids_offset, detections.class_ids.data(), count * sizeof(int32_t));
+  }
+  uint8_t * class_names = buffer.get() + class_names_offset;
+  for (const auto & class_name : detections.class_names) {
+    std::memcpy(class_names, class_name.c_str(), class_name.size() + 1);
+    class_names += class_name.size() + 1;
+  }
+
+  const int32_t rows = static_cast<int32_t>(count);
+  Detection3DColumnarParts parts;
+  parts.count = count;
+  return gxf::Entity::New(context)
+         .assign_to(parts.entity)
+         .and_then([&]() {return parts.entity.add<gxf::Tensor>(kCentersName);})
+         .assign_to(parts.centers)
+         .and_then([&]() {return parts.entity.add<gxf::Tensor>(kOrientationsName);})
+         .assign_to(parts.orientations)
+         .and_then([&]() {return parts.entity.add<gxf::Tensor>(kSizesName);})
+         .assign_to(parts.sizes)
+         .and_then([&]() {return parts.entity.add<gxf::Tensor>(kClassIdsName);})
+         .assign_to(parts.class_ids)
+         .and_then([&]() {return parts.entity.add<gxf::Tensor>(kScoresName);})
+         .assign_to(parts.scores)
+         .and_then([&]() {return parts.entity.add<gxf::Tensor>(kClassNamesName);})
+         .assign_to(parts.class_names)
+         .and_then([&]() {return parts.entity.add<gxf::Timestamp>(kTimestampName);})
+         .assign_to(parts.timestamp)
+         .and_then(
+    [&]() {
+      return WrapSlice(
+        parts.centers, gxf::Shape{rows, 3}, gxf::PrimitiveType::kFloat32, buffer,
+        centers_offset) &
+      WrapSlice(
+        parts.orientations, gxf::Shape{rows, 4}, gxf::PrimitiveType::kFloat32, buffer,
+        orientations_offset) &
+      WrapSlice(
+        parts.sizes, gxf::Shape{rows, 3}, gxf::PrimitiveType::kFloat32, buffer,
+        sizes_offset) &
+      WrapSlice(
+        parts.scores, gxf::Shape{rows}, gxf::PrimitiveType::kFloat32, buffer, scores_offset) &
+      WrapSlice(
+        parts.class_ids, gxf::Shape{rows}, gxf::PrimitiveType::kInt32, buffer,
+        class_ids_offset) &
+      WrapSlice(
+        parts.class_names, gxf::Shape{static_cast<int32_t>(class_names_size)},
+        gxf::PrimitiveType::kUnsigned8, buffer, class_names_offset);
+    })
+         .substitute(parts);
+}
+
+gxf::Expected<Detection3DColumnarParts> GetDetection3DColumnarMessage(gxf::Entity entity)
+{
+  Detection3DColumnarParts parts;
+  parts.entity = entity;
+  auto result = parts.entity.get<gxf::Tensor>(kCentersName)
+    .assign_to(parts.centers)
+    .and_then([&]() {return parts.entity.get<gxf::Tensor>(kOrientationsName);})
+    .assign_to(parts.orientations)
+    .and_then([&]() {return parts.entity.get<gxf::Tensor>(kSizesName);})
+    .assign_to(parts.sizes)
+    .and_then([&]() {return parts.entity.get<gxf::Tensor>(kClassIdsName);})
+    .assign_to(parts.class_ids)
+    .and_then([&]() {return parts.entity.get<gxf::Tensor>(kScoresName);})
+    .assign_to(parts.scores)
+    .and_then([&]() {return parts.entity.get<gxf::Tensor>(kClassNamesName);})
+    .assign_to(parts.class_names)
+    .log_error("Entity does not contain the tensors of columnar detections.")
+    .and_then([&]() {return parts.entity.get<gxf::Timestamp>(kTimestampName);})
+    .log_error("Entity does not contain component Timestamp %s.", kTimestampName)
+    .assign_to(parts.timestamp);
+  if (!result) {
+    return gxf::ForwardError(result);
+  }
+
+  const int32_t rows = parts.scores->shape().dimension(0);
+  if (!IsColumn(*parts.scores, gxf::PrimitiveType::kFloat32, rows, 0) ||
+    !IsColumn(*parts.class_ids, gxf::PrimitiveType::kInt32, rows, 0) ||
+    !IsColumn(*parts.centers, gxf::PrimitiveType::kFloat32, rows, 3) ||
+    !IsColumn(*parts.orientations, gxf::PrimitiveType::kFloat32, rows, 4) ||
+    !IsColumn(*parts.sizes, gxf::PrimitiveType::kFloat32, rows, 3) ||
+    !IsColumn(
+      *parts.class_names, gxf::PrimitiveType::kUnsigned8,
+      parts.class_names->shape().dimension(0), 0))
+  {
+    GXF_LOG_ERROR("Tensors of columnar detections have inconsistent shapes or types.");
+    return gxf::Unexpected{GXF_INVALID_DATA_FORMAT};
+  }
+  parts.count = static_cast<size_t>(rows);
+  return parts;
+}
+
+bool IsDetection3DColumnarMessage(gxf::Entity entity)
+{
+  return entity.get<gxf::Tensor>(kScoresName).has_value();
+}
+
+gxf::Expected<void> ReadDetection3DColumnarMessage(
+  const Detection3DColumnarParts & parts, Detection3DSoa & detections)
+{
+  if (!IsHostTensor(*parts.centers) || !IsHostTensor(*parts.orientations) ||
+    !IsHostTensor(*parts.sizes) || !IsHostTensor(*parts.class_ids) ||
+    !IsHostTensor(*parts.scores) || !IsHostTensor(*parts.class_names))
+  {
+    GXF_LOG_ERROR("Columnar detections must be stored in host memory.");
+    return gxf::Unexpected{GXF_MEMORY_INVALID_STORAGE_MODE};
+  }
+
+  const size_t count = parts.count;
+  detections.resize(count);
+  if (count > 0) {
+    std::memcpy(detections.centers.data(), parts.centers->pointer(), count * 3 * sizeof(float));
+    std::memcpy(
+      detections.orientations.data(), parts.orientations->pointer(), count * 4 * sizeof(float));
+    std::memcpy(detections.sizes.data(), parts.sizes->pointer(), count * 3 * sizeof(float));
+    std::memcpy(detections.scores.data(), parts.scores->pointer(), count * sizeof(float));
+    std::memcpy(
+      detections.class_ids.data(), parts.class_ids->pointer(), count * sizeof(int32_t));
+  }
+
+  // Class names are NUL-terminated. A missing final terminator ends the last name.
+  detections.class_names.clear();
+  const char * class_names = reinterpret_cast<const char *>(parts.class_names->pointer());
+  const char * class_names_end = class_names + parts.class_names->shape().dimension(0);
+  while (class_names < class_names_end) {
+    const char * name_end = std::find(class_names, class_names_end, '\0');
+    detections.class_names.emplace_back(class_names, name_end);
+    class_names = name_end + 1;
+  }
+
+  for (size_t i = 0; i < count; i++) {
+    if (detections.class_ids[i] < 0 ||
+      static_cast<size_t>(detections.class_ids[i]) >= detections.class_names.size())
+    {
+      GXF_LOG_ERROR("Class ID %d of columnar detection %zu is out of range.",
+        detections.class_ids[i], i);
+      return gxf::Unexpected{GXF_ARGUMENT_OUT_OF_RANGE};
+    }
+  }
+  return gxf::Success;
+}
+
 }  // namespace isaac
 }  // namespace nvidia
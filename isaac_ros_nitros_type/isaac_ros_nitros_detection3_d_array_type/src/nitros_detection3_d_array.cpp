@@ -15,6 +15,7 @@
 //
 // SPDX-License-Identifier: Apache-2.0
 
+#include <algorithm>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -32,7 +33,9 @@
 #pragma GCC diagnostic pop
 
 #include "isaac_ros_nitros_detection3_d_array_type/nitros_detection3_d_array.hpp"
+#include "isaac_ros_nitros_detection3_d_array_type/nitros_detection3_d_array_columnar.hpp"
 #include "isaac_ros_nitros/types/type_adapter_nitros_context.hpp"
+#include "std_msgs/msg/header.hpp"
 
 constexpr char kEntityName[] = "memory_pool";
 constexpr char kComponentName[] = "unbounded_allocator";
@@ -41,6 +44,14 @@ constexpr char kComponentTypeName[] = "nvidia::gxf::UnboundedAllocator";
 namespace
 {
 
+// Columnar detections reused by the conversions of the calling thread, so that their arrays are
+// only allocated when the number of detections grows
+::nvidia::isaac::Detection3DSoa & ScratchDetections()
+{
+  thread_local ::nvidia::isaac::Detection3DSoa detections;
+  return detections;
+}
+
 ::nvidia::isaac::Pose3d DetectionToPose3d(const float translation[3], const float rotation_wxyz[4])
 {
   return ::nvidia::isaac::Pose3d{
@@ -50,25 +61,122 @@ namespace
     ::nvidia::isaac::Vector3d(translation[0], translation[1], translation[2])
   };
 }
-}  // namespace
 
-void rclcpp::TypeAdapter<
-  nvidia::isaac_ros::nitros::NitrosDetection3DArray,
-  vision_msgs::msg::Detection3DArray>::convert_to_ros_message(
-  const custom_type & source, ros_message_type & destination)
+// Converts columnar detections to ROS, one hypothesis per detection
+void SetDetection3DMsgs(
+  const ::nvidia::isaac::Detection3DSoa & detections,
+  const std_msgs::msg::Header & header,
+  std::vector<vision_msgs::msg::Detection3D> & detection_msgs)
+{
+  const size_t count = detections.size();
+  detection_msgs.resize(count);
+  for (size_t i = 0; i < count; i++) {
+    vision_msgs::msg::Detection3D & detection = detection_msgs[i];
+    detection.header = header;
+    auto & center = detection.bbox.center;
+    center.position.x = detections.centers[i * 3];
+    center.position.y = detections.centers[i * 3 + 1];
+    center.position.z = detections.centers[i * 3 + 2];
+    center.orientation.x = detections.orientations[i * 4];
+    center.orientation.y = detections.orientations[i * 4 + 1];
+    center.orientation.z = detections.orientations[i * 4 + 2];
+    center.orientation.w = detections.orientations[i * 4 + 3];
+    detection.bbox.size.x = detections.sizes[i * 3];
+    detection.bbox.size.y = detections.sizes[i * 3 + 1];
+    detection.bbox.size.z = detections.sizes[i * 3 + 2];
+
+    // Results are never empty, as required by vision_msgs_rviz_plugins
+    detection.results.resize(1);
+    detection.results[0].hypothesis.class_id = detections.class_names[detections.class_ids[i]];
+    detection.results[0].hypothesis.score = detections.scores[i];
+    detection.results[0].pose.pose = center;
+  }
+}
+
+// Converts ROS detections to columnar detections, keeping the highest scoring hypothesis of
+// every detection. Detections without hypothesis get an empty class ID and a score of 0.
+void GetColumnarDetections(
+  const std::vector<vision_msgs::msg::Detection3D> & detection_msgs,
+  ::nvidia::isaac::Detection3DSoa & detections)
+{
+  const size_t count = detection_msgs.size();
+  detections.resize(count);
+  detections.class_names.clear();
+  std::unordered_map<std::string, int32_t> class_indices;
+  for (size_t i = 0; i < count; i++) {
+    const vision_msgs::msg::Detection3D & detection = detection_msgs[i];
+    const auto & center = detection.bbox.center;
+    detections.centers[i * 3] = center.position.x;
+    detections.centers[i * 3 + 1] = center.position.y;
+    detections.centers[i * 3 + 2] = center.position.z;
+    detections.orientations[i * 4] = center.orientation.x;
+    detections.orientations[i * 4 + 1] = center.orientation.y;
+    detections.orientations[i * 4 + 2] = center.orientation.z;
+    detections.orientations[i * 4 + 3] = center.orientation.w;
+    detections.sizes[i * 3] = detection.bbox.size.x;
+    detections.sizes[i * 3 + 1] = detection.bbox.size.y;
+    detections.sizes[i * 3 + 2] = detection.bbox.size.z;
+
+    static const std::string kNoClass;
+    const std::string * class_id = &kNoClass;
+    double score = 0.0;
+    for (size_t j = 0; j < detection.results.size(); j++) {
+      const auto & hypothesis = detection.results[j].hypothesis;
+      if (j == 0 || hypothesis.score > score) {
+        class_id = &hypothesis.class_id;
+        score = hypothesis.score;
+      }
+    }
+    detections.scores[i] = static_cast<float>(score);
+
+    const auto class_index = class_indices.emplace(
+      *class_id, static_cast<int32_t>(detections.class_names.size()));
+    if (class_index.second) {
+      detections.class_names.push_back(*class_id);
+    }
+    detections.class_ids[i] = class_index.first->second;
+  }
+}
+
+// Converts a NitrosDetection3DArray or NitrosDetection3DArrayColumnar message entity into a
+// Detection3DArray. Both layouts are accepted.
+void ConvertToRosMessage(
+  const nvidia::isaac_ros::nitros::NitrosTypeBase & source,
+  vision_msgs::msg::Detection3DArray & destination)
 {
-  nvidia::isaac_ros::nitros::nvtxRangePushWrapper(
-    "NitrosDetection3DArray::convert_to_ros_message",
-    nvidia::isaac_ros::nitros::CLR_PURPLE);
-  RCLCPP_DEBUG(
-    rclcpp::get_logger("NitrosDetection3DArray"),
-    "[convert_to_ros_message] Conversion started for handle=%ld", source.handle);
   auto context = nvidia::isaac_ros::nitros::GetTypeAdapterNitrosContext().getContext();
   auto maybe_msg_entity = nvidia::gxf::Entity::Shared(context, source.handle);
   if (!maybe_msg_entity) {
     throw std::runtime_error("Unable to get entity!");
   }
 
+  if (nvidia::isaac::IsDetection3DColumnarMessage(maybe_msg_entity.value())) {
+    auto maybe_columnar_parts =
+      nvidia::isaac::GetDetection3DColumnarMessage(maybe_msg_entity.value());
+    nvidia::isaac::Detection3DSoa & detections = ScratchDetections();
+    auto read_result = maybe_columnar_parts.map(
+      [&](const nvidia::isaac::Detection3DColumnarParts & parts) {
+        return nvidia::isaac::ReadDetection3DColumnarMessage(parts, detections);
+      });
+    if (!read_result) {
+      std::stringstream error_msg;
+      error_msg <<
+        "[convert_to_ros_message] failed to get columnar detection3d data from message " <<
+        "entity: " << GxfResultStr(read_result.error());
+      RCLCPP_ERROR(
+        rclcpp::get_logger("NitrosDetection3DArray"), error_msg.str().c_str());
+      throw std::runtime_error(error_msg.str().c_str());
+    }
+
+    const uint64_t acqtime = maybe_columnar_parts->timestamp->acqtime;
+    destination.header.stamp.sec = static_cast<int32_t>(acqtime / static_cast<uint64_t>(1e9));
+    destination.header.stamp.nanosec = static_cast<uint32_t>(
+      acqtime % static_cast<uint64_t>(1e9));
+    destination.header.frame_id = source.frame_id;
+    SetDetection3DMsgs(detections, destination.header, destination.detections);
+    return;
+  }
+
   auto maybe_detection3d_list = nvidia::isaac::GetDetection3DListMessage(maybe_msg_entity.value());
   if (!maybe_detection3d_list) {
     std::stringstream error_msg;
@@ -79,7 +187,7 @@ void rclcpp::TypeAdapter<
       rclcpp::get_logger("NitrosDetection3DArray"), error_msg.str().c_str());
     throw std::runtime_error(error_msg.str().c_str());
   }
-  auto detection3_d_parts = maybe_detection3d_list.value();
+  const auto & detection3_d_parts = maybe_detection3d_list.value();
 
   // Set timestamp for ros message from gxf message
   nvidia::gxf::Timestamp detection3_d_timestamp = *(detection3_d_parts.timestamp);
@@ -90,68 +198,54 @@ void rclcpp::TypeAdapter<
   destination.header.frame_id = source.frame_id;
 
   size_t n_detections = detection3_d_parts.poses.size();
+  destination.detections.resize(n_detections);
 
   for (size_t i = 0; i < n_detections; ++i) {
-    vision_msgs::msg::Detection3D detection;
-    detection.header.frame_id = source.frame_id;
-    detection.header.stamp = destination.header.stamp;
-    vision_msgs::msg::BoundingBox3D bbox;
-
-    bbox.center.position.x = detection3_d_parts.poses.at(i).value()->translation.x();
-    bbox.center.position.y = detection3_d_parts.poses.at(i).value()->translation.y();
-    bbox.center.position.z = detection3_d_parts.poses.at(i).value()->translation.z();
-
-    bbox.center.orientation.x = detection3_d_parts.poses.at(i).value()->rotation.quaternion().x();
-    bbox.center.orientation.y = detection3_d_parts.poses.at(i).value()->rotation.quaternion().y();
-    bbox.center.orientation.z = detection3_d_parts.poses.at(i).value()->rotation.quaternion().z();
-    bbox.center.orientation.w = detection3_d_parts.poses.at(i).value()->rotation.quaternion().w();
-
-    bbox.size.x = detection3_d_parts.bbox_sizes.at(i).value()->x();
-    bbox.size.y = detection3_d_parts.bbox_sizes.at(i).value()->y();
-    bbox.size.z = detection3_d_parts.bbox_sizes.at(i).value()->z();
-    detection.bbox = bbox;
-
-    for (size_t j = 0; j < detection3_d_parts.hypothesis.at(i).value()->scores.size(); ++j) {
-      vision_msgs::msg::ObjectHypothesisWithPose object_hypothesis;
-      object_hypothesis.hypothesis.class_id =
-        detection3_d_parts.hypothesis.at(i).value()->class_ids[j];
-      object_hypothesis.hypothesis.score = detection3_d_parts.hypothesis.at(i).value()->scores[j];
-      object_hypothesis.pose.pose = bbox.center;
-      detection.results.push_back(object_hypothesis);
-    }
+    vision_msgs::msg::Detection3D & detection = destination.detections[i];
+    detection.header = destination.header;
+    const ::nvidia::isaac::Pose3d & pose = *detection3_d_parts.poses[i].value();
+    const ::nvidia::isaac::Vector3f & bbox_size = *detection3_d_parts.bbox_sizes[i].value();
+    const ::nvidia::isaac::ObjectHypothesis & hypothesis =
+      *detection3_d_parts.hypothesis[i].value();
+    vision_msgs::msg::BoundingBox3D & bbox = detection.bbox;
+
+    bbox.center.position.x = pose.translation.x();
+    bbox.center.position.y = pose.translation.y();
+    bbox.center.position.z = pose.translation.z();
+
+    const auto quaternion = pose.rotation.quaternion();
+    bbox.center.orientation.x = quaternion.x();
+    bbox.center.orientation.y = quaternion.y();
+    bbox.center.orientation.z = quaternion.z();
+    bbox.center.orientation.w = quaternion.w();
+
+    bbox.size.x = bbox_size.x();
+    bbox.size.y = bbox_size.y();
+    bbox.size.z = bbox_size.z();
+
     // If no hypothesis is found, populate results array with the pose of the bounding box
     // This is requirement for vision_msgs_rviz_plugins
     // If results is empty, vision_msgs_rviz_plugins will give a Segmentation fault
-    if (detection3_d_parts.hypothesis.at(i).value()->scores.size() == 0) {
-      vision_msgs::msg::ObjectHypothesisWithPose object_hypothesis;
+    const size_t n_hypotheses = hypothesis.scores.size();
+    detection.results.resize(std::max<size_t>(n_hypotheses, 1));
+    detection.results[0] = vision_msgs::msg::ObjectHypothesisWithPose();
+    for (size_t j = 0; j < n_hypotheses; ++j) {
+      detection.results[j].hypothesis.class_id = hypothesis.class_ids[j];
+      detection.results[j].hypothesis.score = hypothesis.scores[j];
+    }
+    for (auto & object_hypothesis : detection.results) {
       object_hypothesis.pose.pose = bbox.center;
-      detection.results.push_back(object_hypothesis);
     }
-
-    destination.detections.push_back(detection);
   }
-
-  RCLCPP_DEBUG(
-    rclcpp::get_logger("NitrosDetection3DArray"),
-    "[convert_to_ros_message] Conversion completed");
-
-  nvidia::isaac_ros::nitros::nvtxRangePopWrapper();
 }
 
-void rclcpp::TypeAdapter<
-  nvidia::isaac_ros::nitros::NitrosDetection3DArray,
-  vision_msgs::msg::Detection3DArray>::convert_to_custom(
-  const ros_message_type & source,
-  custom_type & destination)
+// Converts a Detection3DArray into a new message entity, with a pose, a bounding box size and an
+// object hypothesis component per detection, or with the columnar layout if columnar is set
+void ConvertToCustom(
+  const vision_msgs::msg::Detection3DArray & source,
+  nvidia::isaac_ros::nitros::NitrosTypeBase & destination,
+  bool columnar)
 {
-  nvidia::isaac_ros::nitros::nvtxRangePushWrapper(
-    "NitrosDetection3DArray::convert_to_custom",
-    nvidia::isaac_ros::nitros::CLR_PURPLE);
-
-  RCLCPP_DEBUG(
-    rclcpp::get_logger("NitrosDetection3DArray"),
-    "[convert_to_custom] Conversion started");
-
   auto context = nvidia::isaac_ros::nitros::GetTypeAdapterNitrosContext().getContext();
 
   // Get pointer to allocator component
@@ -181,45 +275,56 @@ void rclcpp::TypeAdapter<
   size_t num_detections = source.detections.size();
 
   nvidia::gxf::Entity message;
-  auto detection3_d_result = nvidia::isaac::CreateDetection3DListMessage(context, num_detections)
-    .map(
-    [&](nvidia::isaac::Detection3DListMessageParts message_parts) {
-      for (size_t i = 0; i < num_detections; ++i) {
-        vision_msgs::msg::Detection3D detection = source.detections[i];
-        message_parts.bbox_sizes[i].value()->x() = detection.bbox.size.x;
-        message_parts.bbox_sizes[i].value()->y() = detection.bbox.size.y;
-        message_parts.bbox_sizes[i].value()->z() = detection.bbox.size.z;
-
-        const float translation[] = {
-          static_cast<float>(detection.bbox.center.position.x),
-          static_cast<float>(detection.bbox.center.position.y),
-          static_cast<float>(detection.bbox.center.position.z)
-        };
-
-        // Follow Eigen convention
-        const float rotation[] = {
-          static_cast<float>(detection.bbox.center.orientation.w),
-          static_cast<float>(detection.bbox.center.orientation.x),
-          static_cast<float>(detection.bbox.center.orientation.y),
-          static_cast<float>(detection.bbox.center.orientation.z)
-        };
-
-        *message_parts.poses[i].value() = DetectionToPose3d(
-          translation,
-          rotation);
-
-        for (const auto & object_hypothesis : detection.results) {
-          message_parts.hypothesis[i].value()->class_ids.push_back(
-            object_hypothesis.hypothesis.
-            class_id);
-          message_parts.hypothesis[i].value()->scores.push_back(
-            object_hypothesis.hypothesis.score
-          );
+  nvidia::gxf::Expected<void> detection3_d_result;
+  if (columnar) {
+    nvidia::isaac::Detection3DSoa & detections = ScratchDetections();
+    GetColumnarDetections(source.detections, detections);
+    detection3_d_result = nvidia::isaac::CreateDetection3DColumnarMessage(context, detections)
+      .map(
+      [&](nvidia::isaac::Detection3DColumnarParts message_parts) {
+        message_parts.timestamp->acqtime = input_timestamp;
+        message = message_parts.entity;
+      });
+  } else {
+    detection3_d_result = nvidia::isaac::CreateDetection3DListMessage(context, num_detections)
+      .map(
+      [&](nvidia::isaac::Detection3DListMessageParts message_parts) {
+        for (size_t i = 0; i < num_detections; ++i) {
+          const vision_msgs::msg::Detection3D & detection = source.detections[i];
+          message_parts.bbox_sizes[i].value()->x() = detection.bbox.size.x;
+          message_parts.bbox_sizes[i].value()->y() = detection.bbox.size.y;
+          message_parts.bbox_sizes[i].value()->z() = detection.bbox.size.z;
+
+          const float translation[] = {
+            static_cast<float>(detection.bbox.center.position.x),
+            static_cast<float>(detection.bbox.center.position.y),
+            static_cast<float>(detection.bbox.center.position.z)
+          };
+
+          // Follow Eigen convention
+          const float rotation[] = {
+            static_cast<float>(detection.bbox.center.orientation.w),
+            static_cast<float>(detection.bbox.center.orientation.x),
+            static_cast<float>(detection.bbox.center.orientation.y),
+            static_cast<float>(detection.bbox.center.orientation.z)
+          };
+
+          *message_parts.poses[i].value() = DetectionToPose3d(
+            translation,
+            rotation);
+
+          ::nvidia::isaac::ObjectHypothesis & hypothesis = *message_parts.hypothesis[i].value();
+          hypothesis.class_ids.reserve(detection.results.size());
+          hypothesis.scores.reserve(detection.results.size());
+          for (const auto & object_hypothesis : detection.results) {
+            hypothesis.class_ids.push_back(object_hypothesis.hypothesis.class_id);
+            hypothesis.scores.push_back(object_hypothesis.hypothesis.score);
+          }
         }
-      }
-      message_parts.timestamp->acqtime = input_timestamp;
-      message = message_parts.entity;
-    });
+        message_parts.timestamp->acqtime = input_timestamp;
+        message = message_parts.entity;
+      });
+  }
 
   if (!detection3_d_result) {
     std::stringstream error_msg;
@@ -236,9 +341,94 @@ void rclcpp::TypeAdapter<
   // Set Entity Id
   destination.handle = message.eid();
   GxfEntityRefCountInc(context, message.eid());
+}
+
+}  // namespace
+
+void rclcpp::TypeAdapter<
+  nvidia::isaac_ros::nitros::NitrosDetection3DArray,
+  vision_msgs::msg::Detection3DArray>::convert_to_ros_message(
+  const custom_type & source, ros_message_type & destination)
+{
+  nvidia::isaac_ros::nitros::nvtxRangePushWrapper(
+    "NitrosDetection3DArray::convert_to_ros_message",
+    nvidia::isaac_ros::nitros::CLR_PURPLE);
+  RCLCPP_DEBUG(
+    rclcpp::get_logger("NitrosDetection3DArray"),
+    "[convert_to_ros_message] Conversion started for handle=%ld", source.handle);
+
+  ConvertToRosMessage(source, destination);
+
+  RCLCPP_DEBUG(
+    rclcpp::get_logger("NitrosDetection3DArray"),
+    "[convert_to_ros_message] Conversion completed");
+
   nvidia::isaac_ros::nitros::nvtxRangePopWrapper();
+}
+
+void rclcpp::TypeAdapter<
+  nvidia::isaac_ros::nitros::NitrosDetection3DArray,
+  vision_msgs::msg::Detection3DArray>::convert_to_custom(
+  const ros_message_type & source,
+  custom_type & destination)
+{
+  nvidia::isaac_ros::nitros::nvtxRangePushWrapper(
+    "NitrosDetection3DArray::convert_to_custom",
+    nvidia::isaac_ros::nitros::CLR_PURPLE);
+
+  RCLCPP_DEBUG(
+    rclcpp::get_logger("NitrosDetection3DArray"),
+    "[convert_to_custom] Conversion started");
+
+  ConvertToCustom(source, destination, false);
 
   RCLCPP_DEBUG(
     rclcpp::get_logger("NitrosDetection3DArray"),
     "[convert_to_custom] Conversion completed");
+
+  nvidia::isaac_ros::nitros::nvtxRangePopWrapper();
+}
+
+void rclcpp::TypeAdapter<
+  nvidia::isaac_ros::nitros::NitrosDetection3DArrayColumnar,
+  vision_msgs::msg::Detection3DArray>::convert_to_ros_message(
+  const custom_type & source, ros_message_type & destination)
+{
+  nvidia::isaac_ros::nitros::nvtxRangePushWrapper(
+    "NitrosDetection3DArrayColumnar::convert_to_ros_message",
+    nvidia::isaac_ros::nitros::CLR_PURPLE);
+  RCLCPP_DEBUG(
+    rclcpp::get_logger("NitrosDetection3DArrayColumnar"),
+    "[convert_to_ros_message] Conversion started for handle=%ld", source.handle);
+
+  ConvertToRosMessage(source, destination);
+
+  RCLCPP_DEBUG(
+    rclcpp::get_logger("NitrosDetection3DArrayColumnar"),
+    "[convert_to_ros_message] Conversion completed");
+
+  nvidia::isaac_ros::nitros::nvtxRangePopWrapper();
+}
+
+void rclcpp::TypeAdapter<
+  nvidia::isaac_ros::nitros::NitrosDetection3DArrayColumnar,
+  vision_msgs::msg::Detection3DArray>::convert_to_custom(
+  const ros_message_type & source,
+  custom_type & destination)
+{
+  nvidia::isaac_ros::nitros::nvtxRangePushWrapper(
+    "NitrosDetection3DArrayColumnar::convert_to_custom",
+    nvidia::isaac_ros::nitros::CLR_PURPLE);
+
+  RCLCPP_DEBUG(
+    rclcpp::get_logger("NitrosDetection3DArrayColumnar"),
+    "[convert_to_custom] Conversion started");
+
+  ConvertToCustom(source, destination, true);
+
+  RCLCPP_DEBUG(
+    rclcpp::get_logger("NitrosDetection3DArrayColumnar"),
+    "[convert_to_custom] Conversion completed");
+
+  nvidia::isaac_ros::nitros::nvtxRangePopWrapper();
 }
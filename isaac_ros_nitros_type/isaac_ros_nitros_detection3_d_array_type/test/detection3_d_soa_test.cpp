@@ -0,0 +1,259 @@
+// SPDX-FileCopyrightText: NVIDIA CORPORATION & AFFILIATES
+// Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "detection3_d_array_message/detection3_d_soa.hpp"
+
+namespace nvidia
+{
+namespace isaac
+{
+
+namespace
+{
+
+// A detection of the test cases: bounding box center, size and rotation around the z axis, class
+// index and score
+struct TestDetection
+{
+  float x;
+  float y;
+  float z;
+  float size_x;
+  float size_y;
+  float size_z;
+  float yaw;
+  int32_t class_id;
+  float score;
+};
+
+Detection3DSoa MakeDetections(const std::vector<TestDetection> & test_detections)
+{
+  Detection3DSoa detections;
+  detections.resize(test_detections.size());
+  for (size_t i = 0; i < test_detections.size(); i++) {
+    const TestDetection & detection = test_detections[i];
+    detections.centers[i * 3] = detection.x;
+    detections.centers[i * 3 + 1] = detection.y;
+    detections.centers[i * 3 + 2] = detection.z;
+    detections.sizes[i * 3] = detection.size_x;
+    detections.sizes[i * 3 + 1] = detection.size_y;
+    detections.sizes[i * 3 + 2] = detection.size_z;
+    detections.orientations[i * 4] = 0.0f;
+    detections.orientations[i * 4 + 1] = 0.0f;
+    detections.orientations[i * 4 + 2] = std::sin(0.5f * detection.yaw);
+    detections.orientations[i * 4 + 3] = std::cos(0.5f * detection.yaw);
+    detections.class_ids[i] = detection.class_id;
+    detections.scores[i] = detection.score;
+  }
+  return detections;
+}
+
+// Intersection over union of two boxes which are not rotated
+float IntersectionOverUnion(const Detection3DSoa & detections, size_t a, size_t b)
+{
+  float intersection = 1.0f;
+  float volume_a = 1.0f;
+  float volume_b = 1.0f;
+  for (size_t d = 0; d < 3; d++) {
+    const float min_a = detections.centers[a * 3 + d] - 0.5f * detections.sizes[a * 3 + d];
+    const float max_a = detections.centers[a * 3 + d] + 0.5f * detections.sizes[a * 3 + d];
+    const float min_b = detections.centers[b * 3 + d] - 0.5f * detections.sizes[b * 3 + d];
+    const float max_b = detections.centers[b * 3 + d] + 0.5f * detections.sizes[b * 3 + d];
+    intersection *= std::max(0.0f, std::min(max_a, max_b) - std::max(min_a, min_b));
+    volume_a *= max_a - min_a;
+    volume_b *= max_b - min_b;
+  }
+  return intersection / (volume_a + volume_b - intersection);
+}
+
+// Textbook greedy NMS: repeatedly keeps the best remaining detection and drops the ones it
+// overlaps, with a division per pair
+std::vector<uint32_t> ReferenceNonMaximumSuppression(
+  const Detection3DSoa & detections, float iou_threshold, bool class_wise)
+{
+  std::vector<uint32_t> order(detections.size());
+  for (uint32_t i = 0; i < order.size(); i++) {
+    order[i] = i;
+  }
+  std::stable_sort(
+    order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+      return detections.scores[a] > detections.scores[b];
+    });
+  std::vector<uint32_t> kept;
+  for (const uint32_t candidate : order) {
+    bool suppressed = false;
+    for (const uint32_t selected : kept) {
+      if ((!class_wise || detections.class_ids[selected] == detections.class_ids[candidate]) &&
+        IntersectionOverUnion(detections, selected, candidate) > iou_threshold)
+      {
+        suppressed = true;
+        break;
+      }
+    }
+    if (!suppressed) {
+      kept.push_back(candidate);
+    }
+  }
+  return kept;
+}
+
+}  // namespace
+
+TEST(Detection3DSoaTest, ThresholdScoresKeepsOrderAndFields)
+{
+  Detection3DSoa detections;
+  detections.resize(4);
+  for (size_t i = 0; i < detections.size(); i++) {
+    for (size_t d = 0; d < 3; d++) {
+      detections.centers[i * 3 + d] = static_cast<float>(i * 10 + d);
+      detections.sizes[i * 3 + d] = static_cast<float>(i * 10 + d + 3);
+    }
+    for (size_t d = 0; d < 4; d++) {
+      detections.orientations[i * 4 + d] = static_cast<float>(i * 10 + d + 6);
+    }
+    detections.class_ids[i] = static_cast<int32_t>(i);
+  }
+  detections.scores = {0.2f, std::numeric_limits<float>::quiet_NaN(), 0.5f, 0.7f};
+
+  EXPECT_EQ(ThresholdScores(detections, 0.5f), 2u);
+  ASSERT_EQ(detections.size(), 2u);
+  EXPECT_EQ(detections.centers, (std::vector<float>{20, 21, 22, 30, 31, 32}));
+  EXPECT_EQ(detections.sizes, (std::vector<float>{23, 24, 25, 33, 34, 35}));
+  EXPECT_EQ(detections.orientations, (std::vector<float>{26, 27, 28, 29, 36, 37, 38, 39}));
+  EXPECT_EQ(detections.class_ids, (std::vector<int32_t>{2, 3}));
+  EXPECT_EQ(detections.scores, (std::vector<float>{0.5f, 0.7f}));
+
+  EXPECT_EQ(ThresholdScores(detections, 1.0f), 0u);
+  EXPECT_TRUE(detections.empty());
+  EXPECT_TRUE(detections.orientations.empty());
+}
+
+TEST(Detection3DSoaTest, SelectDetectionsReorders)
+{
+  Detection3DSoa detections = MakeDetections(
+  {
+    {1, 2, 3, 4, 5, 6, 0, 0, 0.1f},
+    {7, 8, 9, 10, 11, 12, 0, 1, 0.2f},
+    {13, 14, 15, 16, 17, 18, 0, 2, 0.3f},
+  });
+  detections.orientations = {0, 0, 0, 1, 0, 0, 1, 0, 0, 1, 0, 0};
+
+  SelectDetections(detections, {2, 0});
+  ASSERT_EQ(detections.size(), 2u);
+  EXPECT_EQ(detections.centers, (std::vector<float>{13, 14, 15, 1, 2, 3}));
+  EXPECT_EQ(detections.sizes, (std::vector<float>{16, 17, 18, 4, 5, 6}));
+  EXPECT_EQ(detections.orientations, (std::vector<float>{0, 1, 0, 0, 0, 0, 0, 1}));
+  EXPECT_EQ(detections.class_ids, (std::vector<int32_t>{2, 0}));
+  EXPECT_EQ(detections.scores, (std::vector<float>{0.3f, 0.1f}));
+}
+
+TEST(Detection3DSoaTest, NonMaximumSuppressionOverlaps)
+{
+  const Detection3DSoa detections = MakeDetections(
+  {
+    // Overlaps the next box with an IoU of 0.6
+    {10, 10, 10, 10, 10, 10, 0, 0, 0.8f},
+    {12.5f, 10, 10, 10, 10, 10, 0, 0, 0.9f},
+    // Same box as the first one, in another class
+    {10, 10, 10, 10, 10, 10, 0, 1, 0.7f},
+    // Overlaps the second box with an IoU of 1/3
+    {17.5f, 10, 10, 10, 10, 10, 0, 0, 0.6f},
+    // Disjoint
+    {100, 100, 100, 5, 5, 5, 0, 0, 0.1f},
+  });
+
+  EXPECT_EQ(NonMaximumSuppression(detections, 0.5f, true), (std::vector<uint32_t>{1, 2, 3, 4}));
+  EXPECT_EQ(NonMaximumSuppression(detections, 0.5f, false), (std::vector<uint32_t>{1, 3, 4}));
+  EXPECT_EQ(NonMaximumSuppression(detections, 0.3f, true), (std::vector<uint32_t>{1, 2, 4}));
+  EXPECT_EQ(
+    NonMaximumSuppression(detections, 0.7f, true), (std::vector<uint32_t>{1, 0, 2, 3, 4}));
+
+  // The limit applies to the detections kept by decreasing score
+  EXPECT_EQ(NonMaximumSuppression(detections, 0.5f, true, 2), (std::vector<uint32_t>{1, 2}));
+
+  EXPECT_TRUE(NonMaximumSuppression(Detection3DSoa{}, 0.5f, true).empty());
+}
+
+TEST(Detection3DSoaTest, NonMaximumSuppressionRotated)
+{
+  const float quarter_turn = 0.5f * static_cast<float>(M_PI);
+  const Detection3DSoa detections = MakeDetections(
+  {
+    {0, 0, 0, 4, 2, 2, 0, 0, 0.9f},
+    // Same box, rotated by a quarter turn around the z axis
+    {0, 0, 0, 2, 4, 2, quarter_turn, 0, 0.8f},
+    // Overlaps the first box with an IoU of 1/3
+    {1, 0, 0, 2, 4, 2, 0, 0, 0.7f},
+  });
+
+  EXPECT_EQ(NonMaximumSuppression(detections, 0.9f, true), (std::vector<uint32_t>{0, 2}));
+  EXPECT_EQ(NonMaximumSuppression(detections, 0.3f, true), (std::vector<uint32_t>{0}));
+}
+
+TEST(Detection3DSoaTest, NonMaximumSuppressionNan)
+{
+  const float nan = std::numeric_limits<float>::quiet_NaN();
+  const Detection3DSoa detections = MakeDetections(
+  {
+    // NaN scores are sorted last, so this box is suppressed by the next one
+    {10, 10, 10, 10, 10, 10, 0, 0, nan},
+    {10, 10, 10, 10, 10, 10, 0, 0, 0.5f},
+    // Boxes with NaN coordinates never suppress nor get suppressed
+    {nan, 10, 10, 10, 10, 10, 0, 0, 0.9f},
+    {10, 10, nan, 10, 10, 10, 0, 0, 0.1f},
+  });
+
+  EXPECT_EQ(NonMaximumSuppression(detections, 0.5f, true), (std::vector<uint32_t>{2, 1, 3}));
+}
+
+TEST(Detection3DSoaTest, NonMaximumSuppressionMatchesReference)
+{
+  std::mt19937 rng(0);
+  std::uniform_real_distribution<float> position(0.0f, 50.0f);
+  std::uniform_real_distribution<float> size(1.0f, 15.0f);
+  std::uniform_real_distribution<float> score(0.0f, 1.0f);
+  std::uniform_int_distribution<int32_t> class_id(0, 4);
+  for (const size_t count : {1, 2, 10, 100, 1000}) {
+    std::vector<TestDetection> test_detections(count);
+    for (TestDetection & detection : test_detections) {
+      detection = {
+        position(rng), position(rng), position(rng), size(rng), size(rng), size(rng), 0.0f,
+        class_id(rng), score(rng)};
+    }
+    const Detection3DSoa detections = MakeDetections(test_detections);
+    for (const bool class_wise : {false, true}) {
+      for (const float iou_threshold : {0.1f, 0.5f, 0.9f}) {
+        const std::vector<uint32_t> expected =
+          ReferenceNonMaximumSuppression(detections, iou_threshold, class_wise);
+        EXPECT_EQ(NonMaximumSuppression(detections, iou_threshold, class_wise), expected) <<
+          count << " detections, class_wise=" << class_wise << ", iou_threshold=" <<
+          iou_threshold;
+      }
+    }
+  }
+}
+
+}  // namespace isaac
+}  // namespace nvidia
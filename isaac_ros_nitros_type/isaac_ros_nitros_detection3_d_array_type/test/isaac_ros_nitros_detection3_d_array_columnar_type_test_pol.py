@@ -0,0 +1,151 @@
+# SPDX-FileCopyrightText: NVIDIA CORPORATION & AFFILIATES
+# Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+# SPDX-License-Identifier: Apache-2.0
+
+"""Proof-of-Life test for the NitrosDetection3DArrayColumnar type adapter."""
+
+import time
+
+from isaac_ros_test import IsaacROSBaseTest
+
+from launch_ros.actions import ComposableNodeContainer
+from launch_ros.descriptions import ComposableNode
+
+import pytest
+import rclpy
+from vision_msgs.msg import Detection3D, Detection3DArray, ObjectHypothesisWithPose
+
+# Detections of the test message: bounding box center, orientation (x, y, z, w) and size, and
+# hypotheses (class ID, score). Values are exact in single precision.
+TEST_DETECTIONS = [
+    ((1.0, 2.0, 3.0), (0.0, 0.0, 0.0, 1.0), (0.5, 0.25, 2.0), [('0', 0.25), ('1', 0.5)]),
+    ((-4.5, 0.0, 10.0), (0.5, 0.5, 0.5, 0.5), (1.0, 1.0, 1.0), [('chair', 0.75)]),
+    ((0.0, 0.0, 0.0), (0.0, 1.0, 0.0, 0.0), (3.0, 2.0, 1.0), []),
+    ((7.0, 8.0, 9.0), (0.0, 0.0, 0.0, 1.0), (0.125, 0.125, 0.125),
+     [('1', 0.125), ('chair', 0.0625)]),
+]
+
+
+@pytest.mark.rostest
+def generate_test_description():
+    """Generate launch description with all ROS 2 nodes for testing."""
+    test_ns = IsaacROSNitrosDetection3DArrayColumnarTest.generate_namespace()
+    container = ComposableNodeContainer(
+        name='test_container',
+        namespace='isaac_ros_nitros_container',
+        package='rclcpp_components',
+        executable='component_container_mt',
+        composable_node_descriptions=[
+            ComposableNode(
+                package='isaac_ros_nitros_detection3_d_array_type',
+                plugin='nvidia::isaac_ros::nitros::NitrosDetection3DArrayForwardNode',
+                name='NitrosDetection3DArrayForwardNode',
+                namespace=test_ns,
+                parameters=[{
+                    'compatible_format': 'nitros_detection3_d_array_columnar'
+                }],
+                remappings=[
+                    (test_ns+'/topic_forward_input', test_ns+'/input'),
+                    (test_ns+'/topic_forward_output', test_ns+'/output'),
+                ]
+            ),
+        ],
+        output='both',
+        arguments=['--ros-args', '--log-level', 'info'],
+    )
+
+    return IsaacROSNitrosDetection3DArrayColumnarTest.generate_test_description(
+        [container],
+        node_startup_delay=2.5
+    )
+
+
+class IsaacROSNitrosDetection3DArrayColumnarTest(IsaacROSBaseTest):
+    """Validate NitrosDetection3DArrayColumnar type adapter."""
+
+    def test_nitros_detection3_d_array_columnar_type_conversions(self) -> None:
+        """Expect every detection back with its bounding box and best hypothesis only."""
+        self.generate_namespace_lookup(['input', 'output'])
+        received_arrays = []
+
+        received_array_sub = self.node.create_subscription(
+            Detection3DArray, self.namespaces['output'],
+            lambda msg: received_arrays.append(msg), self.DEFAULT_QOS)
+
+        detection3_d_array_pub = self.node.create_publisher(
+            Detection3DArray, self.namespaces['input'], self.DEFAULT_QOS)
+
+        try:
+            detection3_d_array = Detection3DArray()
+            detection3_d_array.header.frame_id = 'tf_camera'
+            for center, orientation, size, hypotheses in TEST_DETECTIONS:
+                detection3_d = Detection3D()
+                position = detection3_d.bbox.center.position
+                position.x, position.y, position.z = center
+                quaternion = detection3_d.bbox.center.orientation
+                quaternion.x, quaternion.y, quaternion.z, quaternion.w = orientation
+                bbox_size = detection3_d.bbox.size
+                bbox_size.x, bbox_size.y, bbox_size.z = size
+                for class_id, score in hypotheses:
+                    result = ObjectHypothesisWithPose()
+                    result.hypothesis.class_id = class_id
+                    result.hypothesis.score = score
+                    detection3_d.results.append(result)
+                detection3_d_array.detections.append(detection3_d)
+            detection3_d_array.header.stamp = self.node.get_clock().now().to_msg()
+
+            # Wait at most TIMEOUT seconds for subscriber to respond
+            TIMEOUT = 10
+            end_time = time.time() + TIMEOUT
+
+            received_array = None
+            while received_array is None and time.time() < end_time:
+                detection3_d_array_pub.publish(detection3_d_array)
+                rclpy.spin_once(self.node, timeout_sec=0.1)
+                for msg in received_arrays:
+                    if msg.header.stamp == detection3_d_array.header.stamp:
+                        received_array = msg
+
+            self.assertIsNotNone(received_array, "Didn't receive output on the output topic!")
+            self.assertEqual(len(TEST_DETECTIONS), len(received_array.detections))
+            for index, (center, orientation, size, hypotheses) in enumerate(TEST_DETECTIONS):
+                received_bbox = received_array.detections[index].bbox
+                position = received_bbox.center.position
+                quaternion = received_bbox.center.orientation
+                self.assertEqual(center, (position.x, position.y, position.z),
+                                 f'Center of detection {index} does not match')
+                self.assertEqual(orientation,
+                                 (quaternion.x, quaternion.y, quaternion.z, quaternion.w),
+                                 f'Orientation of detection {index} does not match')
+                self.assertEqual(size,
+                                 (received_bbox.size.x, received_bbox.size.y,
+                                  received_bbox.size.z),
+                                 f'Size of detection {index} does not match')
+
+                # The columnar layout keeps the best hypothesis, or an empty class with score 0
+                best_class_id, best_score = max(
+                    hypotheses, key=lambda hypothesis: hypothesis[1], default=('', 0.0))
+                received_results = received_array.detections[index].results
+                self.assertEqual(1, len(received_results),
+                                 f'Detection {index} does not have a single hypothesis')
+                self.assertEqual(best_class_id, received_results[0].hypothesis.class_id,
+                                 f'Class ID of detection {index} does not match')
+                self.assertEqual(best_score, received_results[0].hypothesis.score,
+                                 f'Score of detection {index} does not match')
+            print('The received columnar detection 3D array has been verified successfully')
+        finally:
+            self.node.destroy_subscription(received_array_sub)
+            self.node.destroy_publisher(detection3_d_array_pub)
@@ -16,6 +16,7 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include "isaac_ros_nitros_detection3_d_array_type/nitros_detection3_d_array.hpp"
+#include "isaac_ros_nitros_detection3_d_array_type/nitros_detection3_d_array_columnar.hpp"
 #include "isaac_ros_nitros/nitros_node.hpp"
 
 #include "rclcpp_components/register_node_macro.hpp"
@@ -81,6 +82,7 @@ public:
     }
 
     registerSupportedType<nvidia::isaac_ros::nitros::NitrosDetection3DArray>();
+    registerSupportedType<nvidia::isaac_ros::nitros::NitrosDetection3DArrayColumnar>();
 
     startNitrosNode();
   }
@@ -19,6 +19,7 @@
 #include <cstdint>
 #include <string>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #pragma GCC diagnostic push
@@ -26,6 +27,8 @@
 #pragma GCC diagnostic ignored "-Wmissing-field-initializers"
 #pragma GCC diagnostic ignored "-Wpedantic"
 #include "messages/flat_scan_message.hpp"
+#include "gems/flatscan/flatscan_soa.hpp"
+#include "gems/flatscan/flatscan_types.hpp"
 #include "gems/pose_tree/pose_tree.hpp"
 #include "extensions/atlas/pose_tree_frame.hpp"
 #pragma GCC diagnostic pop
@@ -44,13 +47,17 @@ constexpr char kPoseTreeEntityName[] = "global_pose_tree";
 constexpr char kPoseTreeComponentName[] = "pose_tree";
 constexpr char kPoseTreeComponentTypeName[] = "nvidia::isaac::PoseTree";
 constexpr char kNameBeamsDevice[] = "beams";
-constexpr int kFlatscanAngleIndx = 0;
-constexpr int kFlatscanRangeIndx = 2;
-constexpr int kNFieldsFlatscanMsg = 5;
-}  // namespace
+constexpr int kNFieldsFlatscanMsg = nvidia::isaac::FlatscanIndices::kSize;
 
-template<typename Deleter>
-using unique_p = std::unique_ptr<double[], Deleter>;
+// Host copy of the beams of device tensors. The buffer of each thread is reused across messages.
+std::vector<double> & BeamsStagingBuffer(size_t num_values)
+{
+  thread_local std::vector<double> buffer;
+  buffer.resize(num_values);
+  return buffer;
+}
+
+}  // namespace
 
 void rclcpp::TypeAdapter<
   nvidia::isaac_ros::nitros::NitrosFlatScan,
@@ -109,34 +116,23 @@ void rclcpp::TypeAdapter<
   // Tensor is assumed to be of shape (num_points,kNFieldsFlatscanMsg)
   size_t num_points = beams_tensor_shape.dimension(0);
 
-  // allocate CPU memory in case tensor for use
-  // in case tensor is GPU based
-  // using char to represnt 1 byte pointer
-  auto deleter = [](double * ptr) {cudaFreeHost(ptr);};
-  auto pointerCudaMalloc = [](size_t mySize) {
-      void * ptr; cudaMallocHost(reinterpret_cast<void **>(&ptr), mySize); return ptr;
-    };
-  unique_p<decltype(deleter)> beams_cpu_pointer(
-    reinterpret_cast<double *>(pointerCudaMalloc(beams_tensor->size())), deleter);
-
-  ::nvidia::isaac::CpuTensorView2d beams_tensor_view;
+  // Beams are read in place from host tensors, and copied off the device with a single copy
+  const double * beams = nullptr;
   switch (beams_tensor->storage_type()) {
     case nvidia::gxf::MemoryStorageType::kHost:
+    case nvidia::gxf::MemoryStorageType::kSystem:
       {
         // CPU based tensor
-        beams_tensor_view = ::nvidia::isaac::CreateCpuTensorViewFromData<double,
-            2>(
-          beams_tensor->data<double>().value(), beams_tensor_shape.size(),
-          ::nvidia::isaac::Vector2i(
-            beams_tensor_shape.dimension(0), beams_tensor_shape.dimension(1)));
+        beams = beams_tensor->data<double>().value();
       }
       break;
     case nvidia::gxf::MemoryStorageType::kDevice:
       {
         // GPU based tensor
         // Copy beams tensor off device to CPU memory
+        auto & staging = BeamsStagingBuffer(num_points * kNFieldsFlatscanMsg);
         const cudaError_t cuda_error = cudaMemcpy(
-          beams_cpu_pointer.get(), beams_tensor->pointer(),
+          staging.data(), beams_tensor->pointer(),
           beams_tensor->size(), cudaMemcpyDeviceToHost);
         if (cuda_error != cudaSuccess) {
           std::stringstream error_msg;
@@ -149,11 +145,7 @@ void rclcpp::TypeAdapter<
             rclcpp::get_logger("NitrosFlatScan"), error_msg.str().c_str());
           throw std::runtime_error(error_msg.str().c_str());
         }
-        beams_tensor_view =
-          ::nvidia::isaac::CreateCpuTensorViewFromData<double, 2>(
-          beams_cpu_pointer.get(), beams_tensor_shape.size(),
-          ::nvidia::isaac::Vector2i(
-            beams_tensor_shape.dimension(0), beams_tensor_shape.dimension(1)));
+        beams = staging.data();
       }
       break;
     default:
@@ -165,15 +157,12 @@ void rclcpp::TypeAdapter<
       throw std::runtime_error(error_msg.c_str());
   }
 
-  // iterate through each point and convert float64 beam range and intensity to float32
-  // This is required since the data is stored as a double in the isaac message but as a float32
-  // in the ros message
-  for (size_t i = 0; i < num_points; i += 1) {
-    // index 0 corresponds to angle refer flatscan_types.hpp
-    destination.ranges.push_back(static_cast<float>(beams_tensor_view(i, kFlatscanRangeIndx)));
-    // index 2 corresponds to range refer flatscan_types.hpp
-    destination.angles.push_back(static_cast<float>(beams_tensor_view(i, kFlatscanAngleIndx)));
-  }
+  // Convert the float64 beam angles and ranges to float32 arrays, which are moved into the ROS
+  // message without another copy
+  nvidia::isaac::FlatscanSoa scan;
+  nvidia::isaac::UnpackFlatscanBeams(beams, num_points, scan);
+  destination.angles = std::move(scan.angles);
+  destination.ranges = std::move(scan.ranges);
 
   destination.range_max = static_cast<float>(flatscan_parts.info->out_of_range);
   destination.range_min = 0.0;  // range_min not present in gxf flatscan message
@@ -281,51 +270,28 @@ void rclcpp::TypeAdapter<
 
   auto beams_tensor = flatscan_parts.beams;
 
-  // allocate CPU memory in case tensor for use
-  // in case tensor is GPU based
-  // using char to represnt 1 byte pointer
-  size_t beams_size_bytes = n_points * sizeof(double) * kNFieldsFlatscanMsg;
-  auto deleter = [](double * ptr) {cudaFreeHost(ptr);};
-  unique_p<decltype(deleter)> beams_cpu_pointer(new double[n_points], deleter);
-  cudaMallocHost(reinterpret_cast<void **>(&beams_cpu_pointer), beams_size_bytes);
-  ::nvidia::isaac::CpuTensorView2d beams_tensor_view =
-    ::nvidia::isaac::CreateCpuTensorViewFromData<double, 2>(
-    beams_cpu_pointer.get(), beams_size_bytes,
-    ::nvidia::isaac::Vector2i(n_points, kNFieldsFlatscanMsg));
-  for (int point_index = 0; point_index < n_points; point_index++) {
-    beams_tensor_view(point_index, kFlatscanAngleIndx) = source.angles[point_index];
-    beams_tensor_view(point_index, kFlatscanRangeIndx) = source.ranges[point_index];
-  }
+  // Beams are written in place into host tensors, and copied to the device with a single copy
   switch (beams_tensor->storage_type()) {
     case nvidia::gxf::MemoryStorageType::kHost:
+    case nvidia::gxf::MemoryStorageType::kSystem:
       {
         // CPU based tensor
-        // Copy data from CPU to CPU backed gxf tensor.
-        const cudaError_t cuda_error = cudaMemcpy(
-          beams_tensor->data<double>().value(),
-          beams_cpu_pointer.get(),
-          beams_size_bytes, cudaMemcpyHostToHost);
-        if (cuda_error != cudaSuccess) {
-          std::stringstream error_msg;
-          error_msg <<
-            "[convert_to_custom] cudaMemcpy failed for copying data from "
-            "CPU to CPU: " <<
-            cudaGetErrorName(cuda_error) <<
-            " (" << cudaGetErrorString(cuda_error) << ")";
-          RCLCPP_ERROR(
-            rclcpp::get_logger("NitrosFlatScan"), error_msg.str().c_str());
-          throw std::runtime_error(error_msg.str().c_str());
-        }
+        nvidia::isaac::PackFlatscanBeams(
+          source.angles.data(), source.ranges.data(), n_points,
+          beams_tensor->data<double>().value());
       }
       break;
     case nvidia::gxf::MemoryStorageType::kDevice:
       {
         // GPU based tensor
         // Copy data from CPU to GPU backed gxf tensor.
+        auto & staging = BeamsStagingBuffer(n_points * kNFieldsFlatscanMsg);
+        nvidia::isaac::PackFlatscanBeams(
+          source.angles.data(), source.ranges.data(), n_points, staging.data());
         const cudaError_t cuda_error = cudaMemcpy(
           beams_tensor->data<double>().value(),
-          beams_cpu_pointer.get(),
-          beams_size_bytes, cudaMemcpyHostToDevice);
+          staging.data(),
+          staging.size() * sizeof(double), cudaMemcpyHostToDevice);
         if (cuda_error != cudaSuccess) {
           std::stringstream error_msg;
           error_msg <<
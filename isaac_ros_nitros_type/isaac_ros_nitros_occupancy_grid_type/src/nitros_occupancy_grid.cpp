@@ -17,7 +17,15 @@
 
 #include <cuda_runtime.h>
 
+#include <algorithm>
+#include <cstring>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <random>
 #include <string>
+#include <tuple>
+#include <utility>
 #include <vector>
 
 #pragma GCC diagnostic push
@@ -31,6 +39,7 @@
 #pragma GCC diagnostic pop
 
 #include "isaac_ros_nitros_occupancy_grid_type/nitros_occupancy_grid.hpp"
+#include "isaac_ros_nitros_occupancy_grid_type/nitros_occupancy_grid_tiled_delta.hpp"
 #include "isaac_ros_nitros/types/type_adapter_nitros_context.hpp"
 
 #include "rclcpp/rclcpp.hpp"
@@ -47,19 +56,432 @@ constexpr char kHeightName[] = "height";
 constexpr char kOriginName[] = "origin";
 constexpr char kDataName[] = "data";
 
-void rclcpp::TypeAdapter<
-  nvidia::isaac_ros::nitros::NitrosOccupancyGrid,
-  nav_msgs::msg::OccupancyGrid>::convert_to_ros_message(
-  const custom_type & source, ros_message_type & destination)
+// Components of the tiled delta transport
+constexpr char kDirtyTilesName[] = "dirty_tiles";
+constexpr char kDeltaStreamIdName[] = "delta_stream_id";
+constexpr char kDeltaSequenceName[] = "delta_sequence";
+constexpr char kDeltaKeyframeSequenceName[] = "delta_keyframe_sequence";
+// Each changed region is stored as 4 ints: first row, first column, rows and columns
+constexpr int kDirtyRegionSize = 4;
+// Grids are compared in tiles of kTileSize x kTileSize cells
+constexpr int kTileSize = 64;
+// Every kKeyframeInterval-th grid of a stream is copied in full
+constexpr int kKeyframeInterval = 30;
+// Tiled delta states are kept for at most kMaxDeltaStreams streams in each direction
+constexpr size_t kMaxDeltaStreams = 8;
+
+namespace
 {
-  nvidia::isaac_ros::nitros::nvtxRangePushWrapper(
-    "NitrosOccupancyGrid::convert_to_ros_message",
-    nvidia::isaac_ros::nitros::CLR_PURPLE);
+
+// Throws if a CUDA call failed
+void CheckCudaError(cudaError_t cuda_error, const char * description)
+{
+  if (cuda_error != cudaSuccess) {
+    std::stringstream error_msg;
+    error_msg <<
+      description << ": " <<
+      cudaGetErrorName(cuda_error) <<
+      " (" << cudaGetErrorString(cuda_error) << ")";
+    RCLCPP_ERROR(
+      rclcpp::get_logger("NitrosOccupancyGrid"), error_msg.str().c_str());
+    throw std::runtime_error(error_msg.str().c_str());
+  }
+}
+
+bool IsHostStorage(nvidia::gxf::MemoryStorageType storage_type)
+{
+  return storage_type == nvidia::gxf::MemoryStorageType::kHost ||
+         storage_type == nvidia::gxf::MemoryStorageType::kSystem;
+}
+
+// Copies the content of a tensor into host memory
+void CopyTensorToHost(const nvidia::gxf::Tensor & tensor, void * destination)
+{
+  if (IsHostStorage(tensor.storage_type())) {
+    std::memcpy(destination, tensor.pointer(), tensor.size());
+    return;
+  }
+  if (tensor.storage_type() != nvidia::gxf::MemoryStorageType::kDevice) {
+    std::string error_msg =
+      "[convert_to_ros_message] MemoryStorageType not supported: conversion from "
+      "gxf::Tensor to ROS int8 array failed!";
+    RCLCPP_ERROR(
+      rclcpp::get_logger("NitrosOccupancyGrid"), error_msg.c_str());
+    throw std::runtime_error(error_msg.c_str());
+  }
+  CheckCudaError(
+    cudaMemcpy(destination, tensor.pointer(), tensor.size(), cudaMemcpyDeviceToHost),
+    "[convert_to_ros_message] cudaMemcpy failed for conversion from gxf::Tensor to ROS");
+}
+
+// Copies host memory into a tensor
+void CopyHostToTensor(const void * source, nvidia::gxf::Tensor & tensor)
+{
+  if (IsHostStorage(tensor.storage_type())) {
+    std::memcpy(tensor.pointer(), source, tensor.size());
+    return;
+  }
+  CheckCudaError(
+    cudaMemcpy(tensor.pointer(), source, tensor.size(), cudaMemcpyHostToDevice),
+    "[convert_to_custom] cudaMemcpy failed for copying data from ROS to GXF tensor");
+}
+
+// Compares a grid with the previous grid tile by tile, copies the tiles which changed into
+// `previous` and returns the changed regions. Changed tiles which are next to each other in a row
+// of tiles are merged into a single region.
+std::vector<int32_t> UpdateDirtyTiles(
+  const int8_t * grid, int8_t * previous, int width, int height, int tile_size)
+{
+  std::vector<int32_t> regions;
+  const int tile_columns = (width + tile_size - 1) / tile_size;
+  std::vector<uint8_t> dirty(tile_columns);
+  for (int row = 0; row < height; row += tile_size) {
+    const int rows = std::min(tile_size, height - row);
+    // Rows are compared in full first, as most of them do not change
+    std::fill(dirty.begin(), dirty.end(), 0);
+    for (int y = row; y < row + rows; y++) {
+      const int8_t * line = grid + static_cast<size_t>(y) * width;
+      const int8_t * previous_line = previous + static_cast<size_t>(y) * width;
+      if (std::memcmp(line, previous_line, width) == 0) {
+        continue;
+      }
+      for (int tile = 0; tile < tile_columns; tile++) {
+        const int column = tile * tile_size;
+        dirty[tile] = dirty[tile] ||
+          std::memcmp(
+          line + column, previous_line + column, std::min(tile_size, width - column)) != 0;
+      }
+    }
+
+    for (int tile = 0; tile < tile_columns; ) {
+      if (!dirty[tile]) {
+        tile++;
+        continue;
+      }
+      const int first_tile = tile;
+      while (tile < tile_columns && dirty[tile]) {
+        tile++;
+      }
+      const int column = first_tile * tile_size;
+      const int columns = std::min(tile * tile_size, width) - column;
+      for (int y = row; y < row + rows; y++) {
+        const size_t offset = static_cast<size_t>(y) * width + column;
+        std::memcpy(previous + offset, grid + offset, columns);
+      }
+      regions.insert(regions.end(), {row, column, rows, columns});
+    }
+  }
+  return regions;
+}
+
+// Copies the given regions of a grid in host memory into a grid in device memory
+void CopyRegionsToDevice(
+  const int8_t * grid, int width, const std::vector<int32_t> & regions, void * device_grid)
+{
+  for (size_t i = 0; i < regions.size(); i += kDirtyRegionSize) {
+    const size_t offset = static_cast<size_t>(regions[i]) * width + regions[i + 1];
+    CheckCudaError(
+      cudaMemcpy2D(
+        static_cast<int8_t *>(device_grid) + offset, width, grid + offset, width,
+        regions[i + 3], regions[i + 2], cudaMemcpyHostToDevice),
+      "[convert_to_custom] cudaMemcpy2D failed for copying dirty tiles to GXF tensor");
+  }
+}
+
+// Copies the given regions of a grid tensor into a grid in host memory. Throws if a region is
+// not within the width x height grid.
+void CopyRegionsToHost(
+  const nvidia::gxf::Tensor & tensor, int width, int height,
+  const std::vector<int32_t> & regions, int8_t * grid)
+{
+  for (size_t i = 0; i < regions.size(); i += kDirtyRegionSize) {
+    const int64_t row = regions[i];
+    const int64_t column = regions[i + 1];
+    const int64_t rows = regions[i + 2];
+    const int64_t columns = regions[i + 3];
+    if (row < 0 || column < 0 || rows < 0 || columns < 0 ||
+      row + rows > height || column + columns > width)
+    {
+      std::stringstream error_msg;
+      error_msg <<
+        "[convert_to_ros_message] Dirty tile (row " << row << ", column " << column << ", " <<
+        rows << "x" << columns << ") is outside of the " << height << "x" << width << " grid";
+      RCLCPP_ERROR(
+        rclcpp::get_logger("NitrosOccupancyGrid"), error_msg.str().c_str());
+      throw std::runtime_error(error_msg.str().c_str());
+    }
+  }
+
+  const int8_t * source = reinterpret_cast<const int8_t *>(tensor.pointer());
+  const bool host = IsHostStorage(tensor.storage_type());
+  for (size_t i = 0; i < regions.size(); i += kDirtyRegionSize) {
+    const size_t offset = static_cast<size_t>(regions[i]) * width + regions[i + 1];
+    if (host) {
+      for (int y = 0; y < regions[i + 2]; y++) {
+        std::memcpy(
+          grid + offset + static_cast<size_t>(y) * width,
+          source + offset + static_cast<size_t>(y) * width, regions[i + 3]);
+      }
+      continue;
+    }
+    CheckCudaError(
+      cudaMemcpy2D(
+        grid + offset, width, source + offset, width, regions[i + 3], regions[i + 2],
+        cudaMemcpyDeviceToHost),
+      "[convert_to_ros_message] cudaMemcpy2D failed for copying dirty tiles to ROS");
+  }
+}
+
+struct CudaFree
+{
+  void operator()(void * pointer) const {cudaFree(pointer);}
+};
+
+// Tiled delta state of the grids converted to NITROS with a given frame ID and size
+struct DeltaUploadState
+{
+  // Identifies this state in the messages, so that receivers never apply tiles to a grid of
+  // another stream
+  uint64_t stream_id = 0;
+  uint64_t sequence = 0;
+  uint64_t keyframe_sequence = 0;
+  int width = 0;
+  int height = 0;
+  // Last converted grid, which the next grid is compared with
+  std::vector<int8_t> grid;
+  // Persistent copy of the last grid in device memory
+  std::unique_ptr<void, CudaFree> device_grid;
+};
+
+// Tiled delta state of the grids converted to ROS from a given stream
+struct DeltaDownloadState
+{
+  uint64_t sequence = 0;
+  int width = 0;
+  int height = 0;
+  std::vector<int8_t> grid;
+};
+
+// Tiled delta states of the most recently converted streams. Type adapters are stateless and do
+// not know the publisher of a message, so states are keyed by what the messages carry. When a new
+// stream starts and kMaxDeltaStreams states are kept, the least recently used state is evicted
+// with its device memory, and the next grid of its stream is sent as a keyframe.
+template<typename Key, typename State>
+class DeltaStates
+{
+public:
+  // Returns the state of the given stream, which is new if the stream was not seen or evicted
+  State & get(const Key & key)
+  {
+    for (auto it = states_.begin(); it != states_.end(); ++it) {
+      if (it->first == key) {
+        states_.splice(states_.end(), states_, it);
+        return states_.back().second;
+      }
+    }
+    if (states_.size() >= kMaxDeltaStreams) {
+      states_.pop_front();
+    }
+    states_.emplace_back(key, State{});
+    return states_.back().second;
+  }
+
+private:
+  // States by increasing time of last use
+  std::list<std::pair<Key, State>> states_;
+};
+
+// Uploaded grids are keyed by frame ID, width and height, so that publishers of grids of
+// different sizes in the same frame do not force keyframes on each other
+using DeltaUploadKey = std::tuple<std::string, int, int>;
+
+std::mutex & DeltaStateMutex()
+{
+  static std::mutex mutex;
+  return mutex;
+}
+
+// The state containers are never destroyed, so that no device memory is released after the CUDA
+// runtime was unloaded at exit
+DeltaStates<DeltaUploadKey, DeltaUploadState> & DeltaUploadStates()
+{
+  static auto * states = new DeltaStates<DeltaUploadKey, DeltaUploadState>();
+  return *states;
+}
+
+// Downloaded grids are keyed by the stream ID of their messages
+DeltaStates<uint64_t, DeltaDownloadState> & DeltaDownloadStates()
+{
+  static auto * states = new DeltaStates<uint64_t, DeltaDownloadState>();
+  return *states;
+}
+
+uint64_t NewDeltaStreamId()
+{
+  std::random_device random_device;
+  return (static_cast<uint64_t>(random_device()) << 32) ^ random_device();
+}
+
+// Adds a uint64_t component to the message
+void AddUInt64(nvidia::gxf::Entity & message, const char * name, uint64_t value)
+{
+  auto component = message.add<uint64_t>(name);
+  if (!component) {
+    std::stringstream error_msg;
+    error_msg <<
+      "[convert_to_custom] Failed to add " << name << " to message: " <<
+      GxfResultStr(component.error());
+    RCLCPP_ERROR(
+      rclcpp::get_logger("NitrosOccupancyGrid"), error_msg.str().c_str());
+    throw std::runtime_error(error_msg.str().c_str());
+  }
+  *component.value() = value;
+}
+
+// Writes the cells of a grid into the data tensor, in device memory, with the tiled delta
+// transport
+void WriteTiledDelta(
+  const nav_msgs::msg::OccupancyGrid & source,
+  nvidia::gxf::Entity & message, nvidia::gxf::Tensor & data_tensor,
+  nvidia::gxf::Handle<nvidia::gxf::Allocator> allocator_handle)
+{
+  const int width = static_cast<int>(source.info.width);
+  const int height = static_cast<int>(source.info.height);
+  const size_t cell_count = source.data.size();
+  const int8_t * cells = source.data.data();
+
+  std::lock_guard<std::mutex> lock(DeltaStateMutex());
+  DeltaUploadState & state =
+    DeltaUploadStates().get(DeltaUploadKey{source.header.frame_id, width, height});
+  const bool keyframe = state.grid.empty() ||
+    state.sequence - state.keyframe_sequence + 1 >= static_cast<uint64_t>(kKeyframeInterval);
+
+  std::vector<int32_t> regions;
+  size_t uploaded_bytes = cell_count;
+  if (keyframe) {
+    if (state.grid.empty()) {
+      state.stream_id = NewDeltaStreamId();
+    }
+    if (!state.device_grid) {
+      void * device_grid = nullptr;
+      CheckCudaError(
+        cudaMalloc(&device_grid, cell_count),
+        "[convert_to_custom] cudaMalloc failed for the persistent occupancy grid");
+      state.device_grid.reset(device_grid);
+    }
+    state.width = width;
+    state.height = height;
+    state.grid.assign(cells, cells + cell_count);
+    CheckCudaError(
+      cudaMemcpy(state.device_grid.get(), cells, cell_count, cudaMemcpyHostToDevice),
+      "[convert_to_custom] cudaMemcpy failed for copying data from ROS to GXF tensor");
+    state.keyframe_sequence = state.sequence + 1;
+  } else {
+    regions = UpdateDirtyTiles(cells, state.grid.data(), width, height, kTileSize);
+    uploaded_bytes = 0;
+    for (size_t i = 0; i < regions.size(); i += kDirtyRegionSize) {
+      uploaded_bytes += static_cast<size_t>(regions[i + 2]) * regions[i + 3];
+    }
+    CopyRegionsToDevice(cells, width, regions, state.device_grid.get());
+  }
+  state.sequence++;
+
+  // Every message gets its own copy, so that later grids do not change published messages
+  CheckCudaError(
+    cudaMemcpy(
+      data_tensor.pointer(), state.device_grid.get(), cell_count, cudaMemcpyDeviceToDevice),
+    "[convert_to_custom] cudaMemcpy failed for copying the persistent occupancy grid");
+
+  AddUInt64(message, kDeltaStreamIdName, state.stream_id);
+  AddUInt64(message, kDeltaSequenceName, state.sequence);
+  AddUInt64(message, kDeltaKeyframeSequenceName, state.keyframe_sequence);
+  if (!regions.empty()) {
+    auto gxf_dirty_tiles = message.add<nvidia::gxf::Tensor>(kDirtyTilesName);
+    auto result = gxf_dirty_tiles.value()->reshape<int32_t>(
+      nvidia::gxf::Shape{static_cast<int>(regions.size() / kDirtyRegionSize), kDirtyRegionSize},
+      nvidia::gxf::MemoryStorageType::kHost, allocator_handle);
+    if (!result) {
+      std::stringstream error_msg;
+      error_msg <<
+        "[convert_to_custom] Error initializing GXF dirty tiles tensor: " <<
+        GxfResultStr(result.error());
+      RCLCPP_ERROR(
+        rclcpp::get_logger("NitrosOccupancyGrid"), error_msg.str().c_str());
+      throw std::runtime_error(error_msg.str().c_str());
+    }
+    std::memcpy(
+      gxf_dirty_tiles.value()->pointer(), regions.data(), regions.size() * sizeof(int32_t));
+  }
 
   RCLCPP_DEBUG(
     rclcpp::get_logger("NitrosOccupancyGrid"),
-    "[convert_to_ros_message] Conversion started for handle=%ld", source.handle);
+    "[convert_to_custom] Tiled delta %s: copied %zu of %zu cells",
+    keyframe ? "keyframe" : "update", uploaded_bytes, cell_count);
+}
+
+// Reads the cells of a grid written with the tiled delta transport. Only the dirty tiles are
+// copied when the previous grid of the stream was converted before. Returns false if the message
+// does not have tiled delta components.
+bool ReadTiledDelta(
+  const nvidia::gxf::Entity & message, const nvidia::gxf::Tensor & data_tensor,
+  int width, int height, std::vector<int8_t> & cells)
+{
+  auto stream_id = message.get<uint64_t>(kDeltaStreamIdName);
+  auto sequence = message.get<uint64_t>(kDeltaSequenceName);
+  auto keyframe_sequence = message.get<uint64_t>(kDeltaKeyframeSequenceName);
+  if (!stream_id || !sequence || !keyframe_sequence ||
+    data_tensor.size() != static_cast<size_t>(width) * height)
+  {
+    return false;
+  }
+
+  std::lock_guard<std::mutex> lock(DeltaStateMutex());
+  DeltaDownloadState & state = DeltaDownloadStates().get(*stream_id.value());
+  const bool same_stream = state.width == width && state.height == height && !state.grid.empty();
+  if (same_stream && state.sequence == *sequence.value()) {
+    // The message was already converted, e.g. for another subscriber
+    cells = state.grid;
+    return true;
+  }
 
+  if (same_stream && state.sequence + 1 == *sequence.value() &&
+    *keyframe_sequence.value() != *sequence.value())
+  {
+    std::vector<int32_t> regions;
+    auto dirty_tiles = message.get<nvidia::gxf::Tensor>(kDirtyTilesName);
+    if (dirty_tiles) {
+      const nvidia::gxf::Tensor & tensor = *dirty_tiles.value();
+      if (tensor.element_type() != nvidia::gxf::PrimitiveType::kInt32 || tensor.rank() != 2 ||
+        tensor.shape().dimension(1) != kDirtyRegionSize)
+      {
+        std::string error_msg =
+          "[convert_to_ros_message] Dirty tiles tensor must be an (N, 4) int32 tensor";
+        RCLCPP_ERROR(
+          rclcpp::get_logger("NitrosOccupancyGrid"), error_msg.c_str());
+        throw std::runtime_error(error_msg.c_str());
+      }
+      regions.resize(tensor.element_count());
+      CopyTensorToHost(tensor, regions.data());
+    }
+    CopyRegionsToHost(data_tensor, width, height, regions, state.grid.data());
+  } else {
+    state.grid.resize(data_tensor.size());
+    CopyTensorToHost(data_tensor, state.grid.data());
+  }
+  state.sequence = *sequence.value();
+  state.width = width;
+  state.height = height;
+  cells = state.grid;
+  return true;
+}
+
+// Converts a NitrosOccupancyGrid or NitrosOccupancyGridTiledDelta message entity into an
+// OccupancyGrid. Cells in int8 or int32 tensors, in device or host memory, with or without tiled
+// delta components, are accepted.
+void ConvertToRosMessage(
+  const nvidia::isaac_ros::nitros::NitrosTypeBase & source,
+  nav_msgs::msg::OccupancyGrid & destination)
+{
   auto context = nvidia::isaac_ros::nitros::GetTypeAdapterNitrosContext().getContext();
   auto msg_entity = nvidia::gxf::Entity::Shared(context, source.handle);
 
@@ -176,38 +598,32 @@ void rclcpp::TypeAdapter<
   }
   auto gxf_data_tensor = maybe_gxf_data_tensor.value();
 
-  // Resize before copying GXF cell data as contiguous block
-  destination.data.resize(gxf_data_tensor->size());
-
   // Copy data tensor off device to CPU memory
-  switch (gxf_data_tensor->storage_type()) {
-    case nvidia::gxf::MemoryStorageType::kHost:
+  switch (gxf_data_tensor->element_type()) {
+    case nvidia::gxf::PrimitiveType::kInt8:
+    case nvidia::gxf::PrimitiveType::kUnsigned8:
       {
-        std::memcpy(destination.data.data(), gxf_data_tensor->pointer(), gxf_data_tensor->size());
+        if (!ReadTiledDelta(
+            *msg_entity, *gxf_data_tensor, destination.info.width,
+            destination.info.height, destination.data))
+        {
+          destination.data.resize(gxf_data_tensor->size());
+          CopyTensorToHost(*gxf_data_tensor, destination.data.data());
+        }
       }
       break;
-    case nvidia::gxf::MemoryStorageType::kDevice:
+    case nvidia::gxf::PrimitiveType::kInt32:
       {
-        const cudaError_t cuda_error = cudaMemcpy(
-          destination.data.data(), gxf_data_tensor->pointer(),
-          gxf_data_tensor->size(), cudaMemcpyDeviceToHost);
-        if (cuda_error != cudaSuccess) {
-          std::stringstream error_msg;
-          error_msg <<
-            "[convert_to_ros_message] cudaMemcpy failed for conversion from "
-            "gxf::Tensor to ROS int8 array: " <<
-            cudaGetErrorName(cuda_error) <<
-            " (" << cudaGetErrorString(cuda_error) << ")";
-          RCLCPP_ERROR(
-            rclcpp::get_logger("NitrosOccupancyGrid"), error_msg.str().c_str());
-          throw std::runtime_error(error_msg.str().c_str());
-        }
+        // One int per cell
+        std::vector<int32_t> cells(gxf_data_tensor->element_count());
+        CopyTensorToHost(*gxf_data_tensor, cells.data());
+        destination.data.resize(cells.size());
+        std::copy(cells.begin(), cells.end(), destination.data.begin());
       }
       break;
     default:
       std::string error_msg =
-        "[convert_to_ros_message] MemoryStorageType not supported: conversion from "
-        "gxf::Tensor to ROS int8 array failed!";
+        "[convert_to_ros_message] Data tensor must hold int8 or int32 cells";
       RCLCPP_ERROR(
         rclcpp::get_logger("NitrosOccupancyGrid"), error_msg.c_str());
       throw std::runtime_error(error_msg.c_str());
@@ -227,28 +643,15 @@ void rclcpp::TypeAdapter<
 
   // Set frame ID
   destination.header.frame_id = source.frame_id;
-
-  RCLCPP_DEBUG(
-    rclcpp::get_logger("NitrosOccupancyGrid"),
-    "[convert_to_ros_message] Conversion completed");
-
-  nvidia::isaac_ros::nitros::nvtxRangePopWrapper();
 }
 
-void rclcpp::TypeAdapter<
-  nvidia::isaac_ros::nitros::NitrosOccupancyGrid,
-  nav_msgs::msg::OccupancyGrid>::convert_to_custom(
-  const ros_message_type & source,
-  custom_type & destination)
+// Converts an OccupancyGrid into a new message entity, with one int8 per cell in device memory.
+// If tiled_delta is set, the cells are written with the tiled delta transport.
+void ConvertToCustom(
+  const nav_msgs::msg::OccupancyGrid & source,
+  nvidia::isaac_ros::nitros::NitrosTypeBase & destination,
+  bool tiled_delta)
 {
-  nvidia::isaac_ros::nitros::nvtxRangePushWrapper(
-    "NitrosOccupancyGrid::convert_to_custom",
-    nvidia::isaac_ros::nitros::CLR_PURPLE);
-
-  RCLCPP_DEBUG(
-    rclcpp::get_logger("NitrosOccupancyGrid"),
-    "[convert_to_custom] Conversion started");
-
   // Get pointer to allocator component
   gxf_uid_t cid;
   nvidia::isaac_ros::nitros::GetTypeAdapterNitrosContext().getCid(
@@ -280,6 +683,8 @@ void rclcpp::TypeAdapter<
     throw std::runtime_error(error_msg.str().c_str());
   }
 
+  const nvidia::gxf::MemoryStorageType storage_type = nvidia::gxf::MemoryStorageType::kDevice;
+
   // Primitive metadata
   auto gxf_resolution = message->add<float>(kResolutionName);
   *gxf_resolution.value() = source.info.resolution;
@@ -293,8 +698,7 @@ void rclcpp::TypeAdapter<
   // Initializing GXF tensor
   auto gxf_pose_tensor = message->add<nvidia::gxf::Tensor>(kOriginName);
   auto result = gxf_pose_tensor.value()->reshape<double>(
-    nvidia::gxf::Shape{kExpectedPoseAsTensorSize}, nvidia::gxf::MemoryStorageType::kDevice,
-    allocator_handle);
+    nvidia::gxf::Shape{kExpectedPoseAsTensorSize}, storage_type, allocator_handle);
 
   if (!result) {
     std::stringstream error_msg;
@@ -332,30 +736,12 @@ void rclcpp::TypeAdapter<
   };
 
   // Populate ROS Pose data into GXF Tensor
-  cudaError_t cuda_error = cudaMemcpy(
-    gxf_pose_tensor.value()->pointer(),
-    ros_pose_tensor.data(),
-    gxf_pose_tensor.value()->size(),
-    cudaMemcpyHostToDevice
-  );
-  if (cuda_error != cudaSuccess) {
-    std::stringstream error_msg;
-    error_msg <<
-      "[convert_to_custom] cudaMemcpy failed for copying data from "
-      "ROS Pose Tensor to GXF Tensor: " <<
-      cudaGetErrorName(cuda_error) <<
-      " (" << cudaGetErrorString(cuda_error) << ")";
-    RCLCPP_ERROR(
-      rclcpp::get_logger("NitrosPoseArray"), error_msg.str().c_str());
-    throw std::runtime_error(error_msg.str().c_str());
-  }
+  CopyHostToTensor(ros_pose_tensor.data(), *gxf_pose_tensor.value());
 
   // Initializing GXF tensor
   auto gxf_data_tensor = message->add<nvidia::gxf::Tensor>(kDataName);
-  result = gxf_data_tensor.value()->reshape<int>(
-    nvidia::gxf::Shape{static_cast<int>(source.data.size())},
-    nvidia::gxf::MemoryStorageType::kDevice,
-    allocator_handle);
+  result = gxf_data_tensor.value()->reshape<int8_t>(
+    nvidia::gxf::Shape{static_cast<int>(source.data.size())}, storage_type, allocator_handle);
 
   if (!result) {
     std::stringstream error_msg;
@@ -368,35 +754,13 @@ void rclcpp::TypeAdapter<
     throw std::runtime_error(error_msg.str().c_str());
   }
 
-  // Get pointer to first element of data tensor
-  auto maybe_data = gxf_data_tensor.value()->data<int>();
-  if (!maybe_data) {
-    std::stringstream error_msg;
-    error_msg <<
-      "[convert_to_ros_message] Could not get data pointer from data tensor: " <<
-      gxf_data_tensor.value();
-    RCLCPP_ERROR(
-      rclcpp::get_logger("NitrosOccupancyGrid"), error_msg.str().c_str());
-    throw std::runtime_error(error_msg.str().c_str());
-  }
-
   // Populate ROS data into GXF Tensor
-  cuda_error = cudaMemcpy(
-    gxf_data_tensor.value()->pointer(),
-    source.data.data(),
-    gxf_data_tensor.value()->size(),
-    cudaMemcpyHostToDevice
-  );
-  if (cuda_error != cudaSuccess) {
-    std::stringstream error_msg;
-    error_msg <<
-      "[convert_to_custom] cudaMemcpy failed for copying data from "
-      "ROS data tensor to GXF tensor: " <<
-      cudaGetErrorName(cuda_error) <<
-      " (" << cudaGetErrorString(cuda_error) << ")";
-    RCLCPP_ERROR(
-      rclcpp::get_logger("NitrosOccupancyGrid"), error_msg.str().c_str());
-    throw std::runtime_error(error_msg.str().c_str());
+  if (tiled_delta && !source.data.empty() &&
+    source.data.size() == static_cast<size_t>(source.info.width) * source.info.height)
+  {
+    WriteTiledDelta(source, *message, *gxf_data_tensor.value(), allocator_handle);
+  } else {
+    CopyHostToTensor(source.data.data(), *gxf_data_tensor.value());
   }
 
   // Add timestamp to the message
@@ -421,9 +785,95 @@ void rclcpp::TypeAdapter<
   destination.handle = message->eid();
   GxfEntityRefCountInc(
     nvidia::isaac_ros::nitros::GetTypeAdapterNitrosContext().getContext(), message->eid());
+}
+
+}  // namespace
+
+void rclcpp::TypeAdapter<
+  nvidia::isaac_ros::nitros::NitrosOccupancyGrid,
+  nav_msgs::msg::OccupancyGrid>::convert_to_ros_message(
+  const custom_type & source, ros_message_type & destination)
+{
+  nvidia::isaac_ros::nitros::nvtxRangePushWrapper(
+    "NitrosOccupancyGrid::convert_to_ros_message",
+    nvidia::isaac_ros::nitros::CLR_PURPLE);
 
   RCLCPP_DEBUG(
     rclcpp::get_logger("NitrosOccupancyGrid"),
+    "[convert_to_ros_message] Conversion started for handle=%ld", source.handle);
+
+  ConvertToRosMessage(source, destination);
+
+  RCLCPP_DEBUG(
+    rclcpp::get_logger("NitrosOccupancyGrid"),
+    "[convert_to_ros_message] Conversion completed");
+
+  nvidia::isaac_ros::nitros::nvtxRangePopWrapper();
+}
+
+void rclcpp::TypeAdapter<
+  nvidia::isaac_ros::nitros::NitrosOccupancyGrid,
+  nav_msgs::msg::OccupancyGrid>::convert_to_custom(
+  const ros_message_type & source,
+  custom_type & destination)
+{
+  nvidia::isaac_ros::nitros::nvtxRangePushWrapper(
+    "NitrosOccupancyGrid::convert_to_custom",
+    nvidia::isaac_ros::nitros::CLR_PURPLE);
+
+  RCLCPP_DEBUG(
+    rclcpp::get_logger("NitrosOccupancyGrid"),
+    "[convert_to_custom] Conversion started");
+
+  ConvertToCustom(source, destination, false);
+
+  RCLCPP_DEBUG(
+    rclcpp::get_logger("NitrosOccupancyGrid"),
+    "[convert_to_custom] Conversion completed");
+
+  nvidia::isaac_ros::nitros::nvtxRangePopWrapper();
+}
+
+void rclcpp::TypeAdapter<
+  nvidia::isaac_ros::nitros::NitrosOccupancyGridTiledDelta,
+  nav_msgs::msg::OccupancyGrid>::convert_to_ros_message(
+  const custom_type & source, ros_message_type & destination)
+{
+  nvidia::isaac_ros::nitros::nvtxRangePushWrapper(
+    "NitrosOccupancyGridTiledDelta::convert_to_ros_message",
+    nvidia::isaac_ros::nitros::CLR_PURPLE);
+
+  RCLCPP_DEBUG(
+    rclcpp::get_logger("NitrosOccupancyGridTiledDelta"),
+    "[convert_to_ros_message] Conversion started for handle=%ld", source.handle);
+
+  ConvertToRosMessage(source, destination);
+
+  RCLCPP_DEBUG(
+    rclcpp::get_logger("NitrosOccupancyGridTiledDelta"),
+    "[convert_to_ros_message] Conversion completed");
+
+  nvidia::isaac_ros::nitros::nvtxRangePopWrapper();
+}
+
+void rclcpp::TypeAdapter<
+  nvidia::isaac_ros::nitros::NitrosOccupancyGridTiledDelta,
+  nav_msgs::msg::OccupancyGrid>::convert_to_custom(
+  const ros_message_type & source,
+  custom_type & destination)
+{
+  nvidia::isaac_ros::nitros::nvtxRangePushWrapper(
+    "NitrosOccupancyGridTiledDelta::convert_to_custom",
+    nvidia::isaac_ros::nitros::CLR_PURPLE);
+
+  RCLCPP_DEBUG(
+    rclcpp::get_logger("NitrosOccupancyGridTiledDelta"),
+    "[convert_to_custom] Conversion started");
+
+  ConvertToCustom(source, destination, true);
+
+  RCLCPP_DEBUG(
+    rclcpp::get_logger("NitrosOccupancyGridTiledDelta"),
     "[convert_to_custom] Conversion completed");
 
   nvidia::isaac_ros::nitros::nvtxRangePopWrapper();
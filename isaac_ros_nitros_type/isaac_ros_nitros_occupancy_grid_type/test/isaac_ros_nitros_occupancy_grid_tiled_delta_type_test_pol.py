@@ -0,0 +1,160 @@
+# SPDX-FileCopyrightText: NVIDIA CORPORATION & AFFILIATES
+# Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+# SPDX-License-Identifier: Apache-2.0
+
+"""Proof-of-Life test for the NitrosOccupancyGridTiledDelta type adapter."""
+
+import array
+import copy
+import os
+import pathlib
+import random
+import time
+
+from isaac_ros_test import IsaacROSBaseTest, JSONConversion
+
+from launch_ros.actions import ComposableNodeContainer
+from launch_ros.descriptions import ComposableNode
+from nav_msgs.msg import OccupancyGrid
+
+import pytest
+import rclpy
+
+# Grid size, so that the grid has several 64 x 64 tiles, including partial tiles on the edges
+GRID_WIDTH = 200
+GRID_HEIGHT = 150
+
+# Every KEYFRAME_INTERVAL-th grid of a stream is sent in full by the type adapter
+KEYFRAME_INTERVAL = 30
+
+
+@pytest.mark.rostest
+def generate_test_description():
+    """Generate launch description with all ROS 2 nodes for testing."""
+    test_ns = IsaacROSNitrosOccupancyGridTiledDeltaTest.generate_namespace()
+    container = ComposableNodeContainer(
+        name='test_container',
+        namespace='isaac_ros_nitros_container',
+        package='rclcpp_components',
+        executable='component_container_mt',
+        composable_node_descriptions=[
+            ComposableNode(
+                package='isaac_ros_nitros_occupancy_grid_type',
+                plugin='nvidia::isaac_ros::nitros::NitrosOccupancyGridForwardNode',
+                name='NitrosOccupancyGridForwardNode',
+                namespace=test_ns,
+                parameters=[{
+                    'compatible_format': 'nitros_occupancy_grid_tiled_delta'
+                }],
+                remappings=[
+                    (test_ns+'/topic_forward_input', test_ns+'/input'),
+                    (test_ns+'/topic_forward_output', test_ns+'/output'),
+                ]
+            ),
+        ],
+        output='both',
+        arguments=['--ros-args', '--log-level', 'info'],
+    )
+
+    return IsaacROSNitrosOccupancyGridTiledDeltaTest.generate_test_description(
+        [container],
+        node_startup_delay=2.5
+    )
+
+
+class IsaacROSNitrosOccupancyGridTiledDeltaTest(IsaacROSBaseTest):
+    """Validate NitrosOccupancyGridTiledDelta type adapter."""
+
+    filepath = pathlib.Path(os.path.dirname(__file__))
+
+    @IsaacROSBaseTest.for_each_test_case()
+    def test_nitros_occupancy_grid_tiled_delta_type_conversions(self, test_folder) -> None:
+        """Expect every grid of a stream to round trip unchanged through the tiled delta."""
+        self.generate_namespace_lookup(['input', 'output'])
+        received_grids = []
+
+        received_grid_sub = self.node.create_subscription(
+            OccupancyGrid, self.namespaces['output'],
+            lambda msg: received_grids.append(msg), self.DEFAULT_QOS)
+
+        occupancy_grid_pub = self.node.create_publisher(
+            OccupancyGrid, self.namespaces['input'], self.DEFAULT_QOS)
+
+        def round_trip(occupancy_grid: OccupancyGrid, description: str) -> None:
+            """Publish a grid and expect the same cells back, byte for byte."""
+            occupancy_grid.header.stamp = self.node.get_clock().now().to_msg()
+
+            # Wait at most TIMEOUT seconds for subscriber to respond
+            TIMEOUT = 2
+            end_time = time.time() + TIMEOUT
+
+            received_grid = None
+            while received_grid is None and time.time() < end_time:
+                occupancy_grid_pub.publish(occupancy_grid)
+                rclpy.spin_once(self.node, timeout_sec=0.1)
+                for grid in received_grids:
+                    if grid.header.stamp == occupancy_grid.header.stamp:
+                        received_grid = grid
+                received_grids.clear()
+
+            self.assertIsNotNone(
+                received_grid, f"Didn't receive the {description} on the output topic!")
+            self.assertEqual(occupancy_grid.info.width, received_grid.info.width,
+                             f'Width of the {description} does not match')
+            self.assertEqual(occupancy_grid.info.height, received_grid.info.height,
+                             f'Height of the {description} does not match')
+            self.assertEqual(occupancy_grid.data.tobytes(), received_grid.data.tobytes(),
+                             f'Occupancy data of the {description} does not match')
+
+        try:
+            occupancy_grid: OccupancyGrid = JSONConversion.load_occupancy_grid_from_json(
+                test_folder / 'occupancy_grid.json')
+            rng = random.Random(0)
+            occupancy_grid.info.width = GRID_WIDTH
+            occupancy_grid.info.height = GRID_HEIGHT
+            occupancy_grid.data = array.array(
+                'b', (rng.choice((-1, 0, 100)) for _ in range(GRID_WIDTH * GRID_HEIGHT)))
+
+            # The first grid of the stream is a keyframe
+            round_trip(occupancy_grid, 'first grid')
+
+            # Regions crossing tile boundaries and the partial tiles of the last row and column
+            changed_grid = copy.deepcopy(occupancy_grid)
+            for row in range(60, 70):
+                for column in range(50, 140):
+                    changed_grid.data[row * GRID_WIDTH + column] = 50
+            changed_grid.data[GRID_WIDTH * GRID_HEIGHT - 1] = 42
+            round_trip(changed_grid, 'partly changed grid')
+
+            round_trip(copy.deepcopy(changed_grid), 'unchanged grid')
+
+            # One cell changes per grid, until the stream is past its next keyframe
+            for index in range(KEYFRAME_INTERVAL):
+                changed_grid = copy.deepcopy(changed_grid)
+                cell = rng.randrange(GRID_WIDTH * GRID_HEIGHT)
+                changed_grid.data[cell] = (changed_grid.data[cell] + 1) % 101
+                round_trip(changed_grid, f'grid {index + 4}')
+
+            # A grid of another size starts over with a keyframe
+            resized_grid = copy.deepcopy(changed_grid)
+            resized_grid.info.height = GRID_HEIGHT - 1
+            resized_grid.data = changed_grid.data[:GRID_WIDTH * (GRID_HEIGHT - 1)]
+            round_trip(resized_grid, 'resized grid')
+
+            print('The received occupancy grids are verified successfully')
+        finally:
+            self.node.destroy_subscription(received_grid_sub)
+            self.node.destroy_publisher(occupancy_grid_pub)
@@ -153,6 +153,8 @@ class IsaacROSNitrosOccupancyGridTest(IsaacROSBaseTest):
                 'Orientation w value does not match')
 
             # data
+            self.assertEqual(len(occupancy_grid.data), len(received_occupancy_grid.data),
+                             'Occupancy data size does not match')
             for cell, received_cell in zip(occupancy_grid.data, received_occupancy_grid.data):
                 self.assertEqual(cell, received_cell, 'Occupancy data does not match')
 
@@ -16,6 +16,7 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include "isaac_ros_nitros_occupancy_grid_type/nitros_occupancy_grid.hpp"
+#include "isaac_ros_nitros_occupancy_grid_type/nitros_occupancy_grid_tiled_delta.hpp"
 #include "isaac_ros_nitros/nitros_node.hpp"
 
 #include "rclcpp_components/register_node_macro.hpp"
@@ -79,6 +80,7 @@ public:
     }
 
     registerSupportedType<nvidia::isaac_ros::nitros::NitrosOccupancyGrid>();
+    registerSupportedType<nvidia::isaac_ros::nitros::NitrosOccupancyGridTiledDelta>();
 
     startNitrosNode();
   }
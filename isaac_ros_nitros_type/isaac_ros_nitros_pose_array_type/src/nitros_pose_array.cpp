@@ -17,6 +17,7 @@
 
 #include <cuda_runtime.h>
 
+#include <cstring>
 #include <string>
 #include <vector>
 
@@ -31,6 +32,7 @@
 #pragma GCC diagnostic pop
 
 #include "isaac_ros_nitros_pose_array_type/nitros_pose_array.hpp"
+#include "isaac_ros_nitros_pose_array_type/nitros_pose_array_packed.hpp"
 #include "isaac_ros_nitros/types/type_adapter_nitros_context.hpp"
 
 #include "rclcpp/rclcpp.hpp"
@@ -39,22 +41,133 @@ constexpr char kEntityName[] = "memory_pool";
 constexpr char kComponentName[] = "unbounded_allocator";
 constexpr char kComponentTypeName[] = "nvidia::gxf::UnboundedAllocator";
 
-// Each pose is stored as a (7,) tensor: position (xyz) and orientation (quaternion, xyzw)
+// Each pose is stored as 7 doubles: position (xyz) and orientation (quaternion, xyzw)
 constexpr int kExpectedPoseAsTensorSize = (3 + 4);
+// Name of the (N, 7) tensor holding all poses in the packed layout
+constexpr char kPackedPosesTensorName[] = "poses";
 
-void rclcpp::TypeAdapter<
-  nvidia::isaac_ros::nitros::NitrosPoseArray,
-  geometry_msgs::msg::PoseArray>::convert_to_ros_message(
-  const custom_type & source, ros_message_type & destination)
+namespace
 {
-  nvidia::isaac_ros::nitros::nvtxRangePushWrapper(
-    "NitrosPoseArray::convert_to_ros_message",
-    nvidia::isaac_ros::nitros::CLR_PURPLE);
 
-  RCLCPP_DEBUG(
-    rclcpp::get_logger("NitrosPoseArray"),
-    "[convert_to_ros_message] Conversion started for handle=%ld", source.handle);
+// Copies the content of a pose tensor into host memory
+void CopyPoseTensorToHost(const nvidia::gxf::Tensor & tensor, double * destination)
+{
+  switch (tensor.storage_type()) {
+    case nvidia::gxf::MemoryStorageType::kHost:
+    case nvidia::gxf::MemoryStorageType::kSystem:
+      {
+        std::memcpy(destination, tensor.pointer(), tensor.size());
+      }
+      break;
+    case nvidia::gxf::MemoryStorageType::kDevice:
+      {
+        const cudaError_t cuda_error = cudaMemcpy(
+          destination, tensor.pointer(), tensor.size(), cudaMemcpyDeviceToHost);
+        if (cuda_error != cudaSuccess) {
+          std::stringstream error_msg;
+          error_msg <<
+            "[convert_to_ros_message] cudaMemcpy failed for conversion from "
+            "gxf::Tensor to ROS Pose: " <<
+            cudaGetErrorName(cuda_error) <<
+            " (" << cudaGetErrorString(cuda_error) << ")";
+          RCLCPP_ERROR(
+            rclcpp::get_logger("NitrosPoseArray"), error_msg.str().c_str());
+          throw std::runtime_error(error_msg.str().c_str());
+        }
+      }
+      break;
+    default:
+      std::string error_msg =
+        "[convert_to_ros_message] MemoryStorageType not supported: conversion from "
+        "gxf::Tensor to ROS Pose failed!";
+      RCLCPP_ERROR(
+        rclcpp::get_logger("NitrosPoseArray"), error_msg.c_str());
+      throw std::runtime_error(error_msg.c_str());
+  }
+}
+
+// Fills a ROS Pose from 7 contiguous doubles
+void ReadPose(const double * data, geometry_msgs::msg::Pose & ros_pose)
+{
+  ros_pose.position.x = data[0];
+  ros_pose.position.y = data[1];
+  ros_pose.position.z = data[2];
+
+  ros_pose.orientation.x = data[3];
+  ros_pose.orientation.y = data[4];
+  ros_pose.orientation.z = data[5];
+  ros_pose.orientation.w = data[6];
+}
+
+// Writes a ROS Pose as 7 contiguous doubles
+void WritePose(const geometry_msgs::msg::Pose & ros_pose, double * data)
+{
+  data[0] = ros_pose.position.x;
+  data[1] = ros_pose.position.y;
+  data[2] = ros_pose.position.z;
+
+  data[3] = ros_pose.orientation.x;
+  data[4] = ros_pose.orientation.y;
+  data[5] = ros_pose.orientation.z;
+  data[6] = ros_pose.orientation.w;
+}
+
+// Copies poses from host memory into a device tensor
+void CopyPosesToTensor(const std::vector<double> & poses, nvidia::gxf::Tensor & tensor)
+{
+  const cudaError_t cuda_error = cudaMemcpy(
+    tensor.pointer(), poses.data(), tensor.size(), cudaMemcpyHostToDevice);
+  if (cuda_error != cudaSuccess) {
+    std::stringstream error_msg;
+    error_msg <<
+      "[convert_to_custom] cudaMemcpy failed for copying data from "
+      "ROS Pose Tensor to GXF Tensor: " <<
+      cudaGetErrorName(cuda_error) <<
+      " (" << cudaGetErrorString(cuda_error) << ")";
+    RCLCPP_ERROR(
+      rclcpp::get_logger("NitrosPoseArray"), error_msg.str().c_str());
+    throw std::runtime_error(error_msg.str().c_str());
+  }
+}
+
+// Adds a device tensor of the given shape to the message
+nvidia::gxf::Handle<nvidia::gxf::Tensor> AddPoseTensor(
+  nvidia::gxf::Entity & message, const char * name, const nvidia::gxf::Shape & shape,
+  nvidia::gxf::Handle<nvidia::gxf::Allocator> allocator_handle)
+{
+  auto gxf_pose_tensor = message.add<nvidia::gxf::Tensor>(name);
+  if (!gxf_pose_tensor) {
+    std::stringstream error_msg;
+    error_msg <<
+      "[convert_to_custom] Failed to add a GXF pose tensor to message: " <<
+      GxfResultStr(gxf_pose_tensor.error());
+    RCLCPP_ERROR(
+      rclcpp::get_logger("NitrosPoseArray"), error_msg.str().c_str());
+    throw std::runtime_error(error_msg.str().c_str());
+  }
+
+  // Initializing GXF tensor
+  auto result = gxf_pose_tensor.value()->reshape<double>(
+    shape, nvidia::gxf::MemoryStorageType::kDevice, allocator_handle);
+  if (!result) {
+    std::stringstream error_msg;
+    error_msg <<
+      "[convert_to_custom] Error initializing GXF pose tensor of rank " << shape.rank() <<
+      " and " << shape.size() << " elements: " <<
+      GxfResultStr(result.error());
+    RCLCPP_ERROR(
+      rclcpp::get_logger("NitrosPoseArray"), error_msg.str().c_str());
+    throw std::runtime_error(error_msg.str().c_str());
+  }
+  return gxf_pose_tensor.value();
+}
 
+// Converts a NitrosPoseArray or NitrosPoseArrayPacked message entity into a PoseArray. Both
+// layouts are accepted.
+void ConvertToRosMessage(
+  const nvidia::isaac_ros::nitros::NitrosTypeBase & source,
+  geometry_msgs::msg::PoseArray & destination)
+{
   auto context = nvidia::isaac_ros::nitros::GetTypeAdapterNitrosContext().getContext();
   auto msg_entity = nvidia::gxf::Entity::Shared(context, source.handle);
 
@@ -70,8 +183,44 @@ void rclcpp::TypeAdapter<
   }
   for (auto gxf_pose_tensor_handle : gxf_tensors.value()) {
     auto gxf_pose_tensor = gxf_pose_tensor_handle.value();
+    const nvidia::gxf::Shape shape = gxf_pose_tensor->shape();
+
+    if (shape.rank() == 2 && shape.dimension(1) == kExpectedPoseAsTensorSize) {
+      // Packed layout: all poses in one (N, 7) tensor, copied in a single transfer
+      if (gxf_pose_tensor->element_type() != nvidia::gxf::PrimitiveType::kFloat64) {
+        std::string error_msg =
+          "[convert_to_ros_message] Packed Pose Tensor does not hold doubles";
+        RCLCPP_ERROR(
+          rclcpp::get_logger("NitrosPoseArray"), error_msg.c_str());
+        throw std::runtime_error(error_msg.c_str());
+      }
+      const size_t num_poses = static_cast<size_t>(shape.dimension(0));
+      if (num_poses == 0) {
+        continue;
+      }
+      const double * poses = nullptr;
+      std::vector<double> host_poses;
+      if (gxf_pose_tensor->storage_type() == nvidia::gxf::MemoryStorageType::kHost ||
+        gxf_pose_tensor->storage_type() == nvidia::gxf::MemoryStorageType::kSystem)
+      {
+        // Host memory is read in place
+        poses = reinterpret_cast<const double *>(gxf_pose_tensor->pointer());
+      } else {
+        host_poses.resize(num_poses * kExpectedPoseAsTensorSize);
+        CopyPoseTensorToHost(*gxf_pose_tensor, host_poses.data());
+        poses = host_poses.data();
+      }
+
+      const size_t offset = destination.poses.size();
+      destination.poses.resize(offset + num_poses);
+      for (size_t i = 0; i < num_poses; i++) {
+        ReadPose(poses + i * kExpectedPoseAsTensorSize, destination.poses[offset + i]);
+      }
+      continue;
+    }
+
     // Ensure pose tensor has correct shape
-    if (gxf_pose_tensor->shape() != nvidia::gxf::Shape{kExpectedPoseAsTensorSize}) {
+    if (shape != nvidia::gxf::Shape{kExpectedPoseAsTensorSize}) {
       std::stringstream error_msg;
       error_msg <<
         "[convert_to_ros_message] Pose Tensor was not the correct shape: " <<
@@ -85,51 +234,11 @@ void rclcpp::TypeAdapter<
     std::array<double, kExpectedPoseAsTensorSize> ros_pose_tensor{};
 
     // Copy pose tensor off device to CPU memory
-    switch (gxf_pose_tensor->storage_type()) {
-      case nvidia::gxf::MemoryStorageType::kHost:
-        {
-          std::memcpy(ros_pose_tensor.data(), gxf_pose_tensor->pointer(), gxf_pose_tensor->size());
-        }
-        break;
-      case nvidia::gxf::MemoryStorageType::kDevice:
-        {
-          const cudaError_t cuda_error = cudaMemcpy(
-            ros_pose_tensor.data(), gxf_pose_tensor->pointer(),
-            gxf_pose_tensor->size(), cudaMemcpyDeviceToHost);
-          if (cuda_error != cudaSuccess) {
-            std::stringstream error_msg;
-            error_msg <<
-              "[convert_to_ros_message] cudaMemcpy failed for conversion from "
-              "gxf::Tensor to ROS Pose: " <<
-              cudaGetErrorName(cuda_error) <<
-              " (" << cudaGetErrorString(cuda_error) << ")";
-            RCLCPP_ERROR(
-              rclcpp::get_logger("NitrosPoseArray"), error_msg.str().c_str());
-            throw std::runtime_error(error_msg.str().c_str());
-          }
-        }
-        break;
-      default:
-        std::string error_msg =
-          "[convert_to_ros_message] MemoryStorageType not supported: conversion from "
-          "gxf::Tensor to ROS Pose failed!";
-        RCLCPP_ERROR(
-          rclcpp::get_logger("NitrosPoseArray"), error_msg.c_str());
-        throw std::runtime_error(error_msg.c_str());
-    }
+    CopyPoseTensorToHost(*gxf_pose_tensor, ros_pose_tensor.data());
 
-    // Create corresponding ROS 2 Pose and populate the message object's fields
+    // Create corresponding ROS 2 Pose and add it to the PoseArray
     auto ros_pose = geometry_msgs::msg::Pose{};
-    ros_pose.position.x = ros_pose_tensor.at(0);
-    ros_pose.position.y = ros_pose_tensor.at(1);
-    ros_pose.position.z = ros_pose_tensor.at(2);
-
-    ros_pose.orientation.x = ros_pose_tensor.at(3);
-    ros_pose.orientation.y = ros_pose_tensor.at(4);
-    ros_pose.orientation.z = ros_pose_tensor.at(5);
-    ros_pose.orientation.w = ros_pose_tensor.at(6);
-
-    // Add the completed Pose to the PoseArray
+    ReadPose(ros_pose_tensor.data(), ros_pose);
     destination.poses.push_back(ros_pose);
   }
 
@@ -147,28 +256,15 @@ void rclcpp::TypeAdapter<
 
   // Set frame ID
   destination.header.frame_id = source.frame_id;
-
-  RCLCPP_DEBUG(
-    rclcpp::get_logger("NitrosPoseArray"),
-    "[convert_to_ros_message] Conversion completed");
-
-  nvidia::isaac_ros::nitros::nvtxRangePopWrapper();
 }
 
-void rclcpp::TypeAdapter<
-  nvidia::isaac_ros::nitros::NitrosPoseArray,
-  geometry_msgs::msg::PoseArray>::convert_to_custom(
-  const ros_message_type & source,
-  custom_type & destination)
+// Converts a PoseArray into a new message entity, with one (7,) tensor per pose or, if packed
+// is set, a single (N, 7) tensor
+void ConvertToCustom(
+  const geometry_msgs::msg::PoseArray & source,
+  nvidia::isaac_ros::nitros::NitrosTypeBase & destination,
+  bool packed)
 {
-  nvidia::isaac_ros::nitros::nvtxRangePushWrapper(
-    "NitrosPoseArray::convert_to_custom",
-    nvidia::isaac_ros::nitros::CLR_PURPLE);
-
-  RCLCPP_DEBUG(
-    rclcpp::get_logger("NitrosPoseArray"),
-    "[convert_to_custom] Conversion started");
-
   // Get pointer to allocator component
   gxf_uid_t cid;
   nvidia::isaac_ros::nitros::GetTypeAdapterNitrosContext().getCid(
@@ -199,68 +295,27 @@ void rclcpp::TypeAdapter<
       rclcpp::get_logger("NitrosPoseArray"), error_msg.str().c_str());
     throw std::runtime_error(error_msg.str().c_str());
   }
-  for (auto ros_pose : source.poses) {
-    auto gxf_pose_tensor = message->add<nvidia::gxf::Tensor>();
-
-    // Initializing GXF tensor
-    auto result = gxf_pose_tensor.value()->reshape<double>(
-      nvidia::gxf::Shape{kExpectedPoseAsTensorSize}, nvidia::gxf::MemoryStorageType::kDevice,
-      allocator_handle);
-
-    if (!result) {
-      std::stringstream error_msg;
-      error_msg <<
-        "[convert_to_custom] Error initializing GXF pose tensor of shape (" <<
-        kExpectedPoseAsTensorSize << ",): " <<
-        GxfResultStr(result.error());
-      RCLCPP_ERROR(
-        rclcpp::get_logger("NitrosPoseArray"), error_msg.str().c_str());
-      throw std::runtime_error(error_msg.str().c_str());
+  if (packed) {
+    // All poses are staged in one buffer and copied with a single transfer. An empty pose array
+    // has no tensor, as in the per-pose layout.
+    if (!source.poses.empty()) {
+      const int32_t num_poses = static_cast<int32_t>(source.poses.size());
+      std::vector<double> ros_poses(source.poses.size() * kExpectedPoseAsTensorSize);
+      for (size_t i = 0; i < source.poses.size(); i++) {
+        WritePose(source.poses[i], ros_poses.data() + i * kExpectedPoseAsTensorSize);
+      }
+      auto gxf_poses_tensor = AddPoseTensor(
+        message.value(), kPackedPosesTensorName,
+        nvidia::gxf::Shape{num_poses, kExpectedPoseAsTensorSize}, allocator_handle);
+      CopyPosesToTensor(ros_poses, *gxf_poses_tensor);
     }
-
-    // Get pointer to first element of pose tensor
-    auto maybe_data = gxf_pose_tensor.value()->data<double>();
-    if (!maybe_data) {
-      std::stringstream error_msg;
-      error_msg <<
-        "[convert_to_ros_message] Could not get data pointer from Pose Tensor: " <<
-        gxf_pose_tensor.value();
-      RCLCPP_ERROR(
-        rclcpp::get_logger("NitrosPoseArray"), error_msg.str().c_str());
-      throw std::runtime_error(error_msg.str().c_str());
-    }
-
-    // Allocate array for copying ROS Pose data as contiguous block
-    std::array<double, kExpectedPoseAsTensorSize> ros_pose_tensor{
-      ros_pose.position.x,
-      ros_pose.position.y,
-      ros_pose.position.z,
-
-      ros_pose.orientation.x,
-      ros_pose.orientation.y,
-      ros_pose.orientation.z,
-      ros_pose.orientation.w
-    };
-
-    // Populate ROS Pose data into GXF Tensor
-    const cudaMemcpyKind operation = cudaMemcpyHostToDevice;
-    const cudaError_t cuda_error = cudaMemcpy(
-      gxf_pose_tensor.value()->pointer(),
-      ros_pose_tensor.data(),
-      gxf_pose_tensor.value()->size(),
-      operation
-    );
-
-    if (cuda_error != cudaSuccess) {
-      std::stringstream error_msg;
-      error_msg <<
-        "[convert_to_custom] cudaMemcpy failed for copying data from "
-        "ROS Pose Tensor to GXF Tensor: " <<
-        cudaGetErrorName(cuda_error) <<
-        " (" << cudaGetErrorString(cuda_error) << ")";
-      RCLCPP_ERROR(
-        rclcpp::get_logger("NitrosPoseArray"), error_msg.str().c_str());
-      throw std::runtime_error(error_msg.str().c_str());
+  } else {
+    std::vector<double> ros_pose_tensor(kExpectedPoseAsTensorSize);
+    for (const auto & ros_pose : source.poses) {
+      auto gxf_pose_tensor = AddPoseTensor(
+        message.value(), nullptr, nvidia::gxf::Shape{kExpectedPoseAsTensorSize}, allocator_handle);
+      WritePose(ros_pose, ros_pose_tensor.data());
+      CopyPosesToTensor(ros_pose_tensor, *gxf_pose_tensor);
     }
   }
 
@@ -286,9 +341,95 @@ void rclcpp::TypeAdapter<
   destination.handle = message->eid();
   GxfEntityRefCountInc(
     nvidia::isaac_ros::nitros::GetTypeAdapterNitrosContext().getContext(), message->eid());
+}
+
+}  // namespace
+
+void rclcpp::TypeAdapter<
+  nvidia::isaac_ros::nitros::NitrosPoseArray,
+  geometry_msgs::msg::PoseArray>::convert_to_ros_message(
+  const custom_type & source, ros_message_type & destination)
+{
+  nvidia::isaac_ros::nitros::nvtxRangePushWrapper(
+    "NitrosPoseArray::convert_to_ros_message",
+    nvidia::isaac_ros::nitros::CLR_PURPLE);
 
   RCLCPP_DEBUG(
     rclcpp::get_logger("NitrosPoseArray"),
+    "[convert_to_ros_message] Conversion started for handle=%ld", source.handle);
+
+  ConvertToRosMessage(source, destination);
+
+  RCLCPP_DEBUG(
+    rclcpp::get_logger("NitrosPoseArray"),
+    "[convert_to_ros_message] Conversion completed");
+
+  nvidia::isaac_ros::nitros::nvtxRangePopWrapper();
+}
+
+void rclcpp::TypeAdapter<
+  nvidia::isaac_ros::nitros::NitrosPoseArray,
+  geometry_msgs::msg::PoseArray>::convert_to_custom(
+  const ros_message_type & source,
+  custom_type & destination)
+{
+  nvidia::isaac_ros::nitros::nvtxRangePushWrapper(
+    "NitrosPoseArray::convert_to_custom",
+    nvidia::isaac_ros::nitros::CLR_PURPLE);
+
+  RCLCPP_DEBUG(
+    rclcpp::get_logger("NitrosPoseArray"),
+    "[convert_to_custom] Conversion started");
+
+  ConvertToCustom(source, destination, false);
+
+  RCLCPP_DEBUG(
+    rclcpp::get_logger("NitrosPoseArray"),
+    "[convert_to_custom] Conversion completed");
+
+  nvidia::isaac_ros::nitros::nvtxRangePopWrapper();
+}
+
+void rclcpp::TypeAdapter<
+  nvidia::isaac_ros::nitros::NitrosPoseArrayPacked,
+  geometry_msgs::msg::PoseArray>::convert_to_ros_message(
+  const custom_type & source, ros_message_type & destination)
+{
+  nvidia::isaac_ros::nitros::nvtxRangePushWrapper(
+    "NitrosPoseArrayPacked::convert_to_ros_message",
+    nvidia::isaac_ros::nitros::CLR_PURPLE);
+
+  RCLCPP_DEBUG(
+    rclcpp::get_logger("NitrosPoseArrayPacked"),
+    "[convert_to_ros_message] Conversion started for handle=%ld", source.handle);
+
+  ConvertToRosMessage(source, destination);
+
+  RCLCPP_DEBUG(
+    rclcpp::get_logger("NitrosPoseArrayPacked"),
+    "[convert_to_ros_message] Conversion completed");
+
+  nvidia::isaac_ros::nitros::nvtxRangePopWrapper();
+}
+
+void rclcpp::TypeAdapter<
+  nvidia::isaac_ros::nitros::NitrosPoseArrayPacked,
+  geometry_msgs::msg::PoseArray>::convert_to_custom(
+  const ros_message_type & source,
+  custom_type & destination)
+{
+  nvidia::isaac_ros::nitros::nvtxRangePushWrapper(
+    "NitrosPoseArrayPacked::convert_to_custom",
+    nvidia::isaac_ros::nitros::CLR_PURPLE);
+
+  RCLCPP_DEBUG(
+    rclcpp::get_logger("NitrosPoseArrayPacked"),
+    "[convert_to_custom] Conversion started");
+
+  ConvertToCustom(source, destination, true);
+
+  RCLCPP_DEBUG(
+    rclcpp::get_logger("NitrosPoseArrayPacked"),
     "[convert_to_custom] Conversion completed");
 
   nvidia::isaac_ros::nitros::nvtxRangePopWrapper();
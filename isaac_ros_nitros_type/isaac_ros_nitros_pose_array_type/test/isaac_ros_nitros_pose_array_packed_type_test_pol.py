@@ -0,0 +1,145 @@
+# SPDX-FileCopyrightText: NVIDIA CORPORATION & AFFILIATES
+# Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+# SPDX-License-Identifier: Apache-2.0
+
+"""Proof-of-Life test for the NitrosPoseArrayPacked type adapter."""
+
+import os
+import pathlib
+import random
+import time
+
+from geometry_msgs.msg import Pose, PoseArray
+
+from isaac_ros_test import IsaacROSBaseTest, JSONConversion
+
+from launch_ros.actions import ComposableNodeContainer
+from launch_ros.descriptions import ComposableNode
+
+import pytest
+import rclpy
+
+# Number of random poses appended to every test case, so that the packed tensor has many rows
+NUM_RANDOM_POSES = 1000
+
+
+@pytest.mark.rostest
+def generate_test_description():
+    """Generate launch description with all ROS 2 nodes for testing."""
+    test_ns = IsaacROSNitrosPoseArrayPackedTest.generate_namespace()
+    container = ComposableNodeContainer(
+        name='test_container',
+        namespace='isaac_ros_nitros_container',
+        package='rclcpp_components',
+        executable='component_container_mt',
+        composable_node_descriptions=[
+            ComposableNode(
+                package='isaac_ros_nitros_pose_array_type',
+                plugin='nvidia::isaac_ros::nitros::NitrosPoseArrayForwardNode',
+                name='NitrosPoseArrayForwardNode',
+                namespace=test_ns,
+                parameters=[{
+                    'compatible_format': 'nitros_pose_array_packed'
+                }],
+                remappings=[
+                    (test_ns+'/topic_forward_input', test_ns+'/input'),
+                    (test_ns+'/topic_forward_output', test_ns+'/output'),
+                ]
+            ),
+        ],
+        output='both',
+        arguments=['--ros-args', '--log-level', 'info'],
+    )
+
+    return IsaacROSNitrosPoseArrayPackedTest.generate_test_description(
+        [container],
+        node_startup_delay=2.5
+    )
+
+
+class IsaacROSNitrosPoseArrayPackedTest(IsaacROSBaseTest):
+    """Validate NitrosPoseArrayPacked type adapter."""
+
+    filepath = pathlib.Path(os.path.dirname(__file__))
+
+    @IsaacROSBaseTest.for_each_test_case()
+    def test_nitros_pose_array_packed_type_conversions(self, test_folder) -> None:
+        """Expect the poses to round trip unchanged through a single (N, 7) tensor."""
+        self.generate_namespace_lookup(['input', 'output'])
+        received_messages = {}
+
+        received_message_sub = self.create_logging_subscribers(
+            subscription_requests=[('output', PoseArray)],
+            received_messages=received_messages
+        )
+
+        pose_array_pub = self.node.create_publisher(
+            PoseArray, self.namespaces['input'], self.DEFAULT_QOS)
+
+        try:
+            pose_array = JSONConversion.load_pose_array_from_json(
+                test_folder / 'pose_array.json')
+            rng = random.Random(0)
+            for _ in range(NUM_RANDOM_POSES):
+                pose = Pose()
+                pose.position.x = rng.uniform(-100.0, 100.0)
+                pose.position.y = rng.uniform(-100.0, 100.0)
+                pose.position.z = rng.uniform(-100.0, 100.0)
+                pose.orientation.x = rng.uniform(-1.0, 1.0)
+                pose.orientation.y = rng.uniform(-1.0, 1.0)
+                pose.orientation.z = rng.uniform(-1.0, 1.0)
+                pose.orientation.w = rng.uniform(-1.0, 1.0)
+                pose_array.poses.append(pose)
+
+            # Wait at most TIMEOUT seconds for subscriber to respond
+            TIMEOUT = 2
+            end_time = time.time() + TIMEOUT
+
+            done = False
+            while time.time() < end_time:
+                timestamp = self.node.get_clock().now().to_msg()
+                pose_array.header.stamp = timestamp
+
+                pose_array_pub.publish(pose_array)
+
+                rclpy.spin_once(self.node, timeout_sec=0.1)
+
+                # If we have received a message on the output topic, break
+                if 'output' in received_messages:
+                    done = True
+                    break
+
+            self.assertTrue(done, "Didn't receive output on the output topic!")
+
+            received_pose_array = received_messages['output']
+
+            # Poses are copied as doubles, so they must match exactly and keep their order
+            self.assertEqual(len(pose_array.poses), len(
+                received_pose_array.poses), 'Number of poses does not match')
+
+            for index, (pose, received_pose) in enumerate(
+                    zip(pose_array.poses, received_pose_array.poses)):
+                self.assertEqual(
+                    pose.position, received_pose.position,
+                    f'Position of pose {index} does not match')
+                self.assertEqual(
+                    pose.orientation, received_pose.orientation,
+                    f'Orientation of pose {index} does not match')
+
+            print('The received packed pose array is verified successfully')
+        finally:
+            self.node.destroy_subscription(received_message_sub)
+            self.node.destroy_publisher(pose_array_pub)
@@ -0,0 +1,96 @@
+// SPDX-FileCopyrightText: NVIDIA CORPORATION & AFFILIATES
+// Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef ISAAC_ROS_NITROS_TENSOR_LIST_TYPE__NITROS_TENSOR_LIST_BATCHED_HPP_
+#define ISAAC_ROS_NITROS_TENSOR_LIST_TYPE__NITROS_TENSOR_LIST_BATCHED_HPP_
+/*
+ * Type adaptation for:
+ *   Nitros type: NitrosTensorListBatched
+ *   ROS type:    isaac_ros_tensor_list_interfaces::msg::TensorList
+ *
+ * Same message as NitrosTensorList, with all tensors of a list in a single device buffer instead
+ * of one allocation per tensor. Every tensor starts at a multiple of 256 bytes in the buffer,
+ * which is filled from a pinned staging buffer with a single copy and released together with the
+ * last tensor. Both NitrosTensorList and NitrosTensorListBatched accept either layout when
+ * converting back to ROS.
+ */
+
+#include <string>
+
+#include "isaac_ros_nitros/types/nitros_format_agent.hpp"
+#include "isaac_ros_nitros/types/nitros_type_base.hpp"
+#include "isaac_ros_tensor_list_interfaces/msg/tensor_list.hpp"
+
+#include "rclcpp/type_adapter.hpp"
+
+
+namespace nvidia
+{
+namespace isaac_ros
+{
+namespace nitros
+{
+
+// Type forward declaration
+struct NitrosTensorListBatched;
+
+// Formats
+struct nitros_tensor_list_batched_t
+{
+  using MsgT = NitrosTensorListBatched;
+  static const inline std::string supported_type_name = "nitros_tensor_list_batched";
+};
+
+// NITROS data type registration factory
+NITROS_TYPE_FACTORY_BEGIN(NitrosTensorListBatched)
+// Supported data formats
+NITROS_FORMAT_FACTORY_BEGIN()
+NITROS_FORMAT_ADD(nitros_tensor_list_batched_t)
+NITROS_FORMAT_FACTORY_END()
+// Required extensions
+NITROS_TYPE_EXTENSION_FACTORY_BEGIN()
+NITROS_TYPE_EXTENSION_FACTORY_END()
+NITROS_TYPE_FACTORY_END()
+
+}  // namespace nitros
+}  // namespace isaac_ros
+}  // namespace nvidia
+
+
+template<>
+struct rclcpp::TypeAdapter<
+  nvidia::isaac_ros::nitros::NitrosTensorListBatched,
+  isaac_ros_tensor_list_interfaces::msg::TensorList>
+{
+  using is_specialized = std::true_type;
+  using custom_type = nvidia::isaac_ros::nitros::NitrosTensorListBatched;
+  using ros_message_type = isaac_ros_tensor_list_interfaces::msg::TensorList;
+
+  static void convert_to_ros_message(
+    const custom_type & source,
+    ros_message_type & destination);
+
+  static void convert_to_custom(
+    const ros_message_type & source,
+    custom_type & destination);
+};
+
+RCLCPP_USING_CUSTOM_TYPE_AS_ROS_MESSAGE_TYPE(
+  nvidia::isaac_ros::nitros::NitrosTensorListBatched,
+  isaac_ros_tensor_list_interfaces::msg::TensorList);
+
+#endif  // ISAAC_ROS_NITROS_TENSOR_LIST_TYPE__NITROS_TENSOR_LIST_BATCHED_HPP_
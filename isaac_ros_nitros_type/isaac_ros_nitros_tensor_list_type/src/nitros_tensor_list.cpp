@@ -17,6 +17,10 @@
 
 #include <cuda_runtime.h>
 
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -26,11 +30,13 @@
 #pragma GCC diagnostic ignored "-Wpedantic"
 #include "gxf/core/entity.hpp"
 #include "gxf/core/gxf.h"
+#include "gxf/std/allocator.hpp"
 #include "gxf/std/tensor.hpp"
 #include "gxf/std/timestamp.hpp"
 #pragma GCC diagnostic pop
 
 #include "isaac_ros_nitros_tensor_list_type/nitros_tensor_list.hpp"
+#include "isaac_ros_nitros_tensor_list_type/nitros_tensor_list_batched.hpp"
 #include "isaac_ros_nitros/types/type_adapter_nitros_context.hpp"
 
 #include "rclcpp/rclcpp.hpp"
@@ -40,20 +46,266 @@ constexpr char kEntityName[] = "memory_pool";
 constexpr char kComponentName[] = "unbounded_allocator";
 constexpr char kComponentTypeName[] = "nvidia::gxf::UnboundedAllocator";
 
-void rclcpp::TypeAdapter<
-  nvidia::isaac_ros::nitros::NitrosTensorList,
-  isaac_ros_tensor_list_interfaces::msg::TensorList>::convert_to_ros_message(
-  const custom_type & source,
-  ros_message_type & destination)
+// Every tensor of a batched tensor list starts at a multiple of kBatchAlignment bytes
+constexpr size_t kBatchAlignment = 256;
+
+namespace
 {
-  nvidia::isaac_ros::nitros::nvtxRangePushWrapper(
-    "NitrosTensorList::convert_to_ros_message",
-    nvidia::isaac_ros::nitros::CLR_PURPLE);
 
-  RCLCPP_DEBUG(
-    rclcpp::get_logger("NitrosTensorList"),
-    "[convert_to_ros_message] Conversion started for handle = %ld", source.handle);
+// Throws if a CUDA call failed
+void CheckCudaError(cudaError_t cuda_error, const char * description)
+{
+  if (cuda_error != cudaSuccess) {
+    std::stringstream error_msg;
+    error_msg <<
+      description << ": " <<
+      cudaGetErrorName(cuda_error) <<
+      " (" << cudaGetErrorString(cuda_error) << ")";
+    RCLCPP_ERROR(
+      rclcpp::get_logger("NitrosTensorList"), error_msg.str().c_str());
+    throw std::runtime_error(error_msg.str().c_str());
+  }
+}
+
+void ThrowError(const std::string & error_msg)
+{
+  RCLCPP_ERROR(rclcpp::get_logger("NitrosTensorList"), error_msg.c_str());
+  throw std::runtime_error(error_msg.c_str());
+}
+
+bool IsSupportedType(nvidia::gxf::PrimitiveType type)
+{
+  switch (type) {
+    case nvidia::gxf::PrimitiveType::kUnsigned8:
+    case nvidia::gxf::PrimitiveType::kInt8:
+    case nvidia::gxf::PrimitiveType::kUnsigned16:
+    case nvidia::gxf::PrimitiveType::kInt16:
+    case nvidia::gxf::PrimitiveType::kUnsigned32:
+    case nvidia::gxf::PrimitiveType::kInt32:
+    case nvidia::gxf::PrimitiveType::kUnsigned64:
+    case nvidia::gxf::PrimitiveType::kInt64:
+    case nvidia::gxf::PrimitiveType::kFloat32:
+    case nvidia::gxf::PrimitiveType::kFloat64:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Returns the shape of a ROS tensor
+nvidia::gxf::Shape GetShape(const isaac_ros_tensor_list_interfaces::msg::Tensor & ros_tensor)
+{
+  if (ros_tensor.shape.rank > nvidia::gxf::Shape::kMaxRank ||
+    ros_tensor.shape.dims.size() < ros_tensor.shape.rank)
+  {
+    std::stringstream error_msg;
+    error_msg <<
+      "[convert_to_custom] Invalid shape of rank " << static_cast<int>(ros_tensor.shape.rank) <<
+      " for tensor " << ros_tensor.name;
+    ThrowError(error_msg.str());
+  }
+  std::array<int32_t, nvidia::gxf::Shape::kMaxRank> dims;
+  std::copy(
+    std::begin(ros_tensor.shape.dims),
+    std::begin(ros_tensor.shape.dims) + ros_tensor.shape.rank,
+    std::begin(dims));
+  return nvidia::gxf::Shape(dims, ros_tensor.shape.rank);
+}
+
+// Throws if a ROS tensor holds less data than its shape requires
+void CheckDataSize(
+  const isaac_ros_tensor_list_interfaces::msg::Tensor & ros_tensor, uint64_t size)
+{
+  if (ros_tensor.data.size() < size) {
+    std::stringstream error_msg;
+    error_msg <<
+      "[convert_to_custom] Tensor " << ros_tensor.name << " holds " <<
+      ros_tensor.data.size() << " bytes but its shape requires " << size << " bytes";
+    ThrowError(error_msg.str());
+  }
+}
 
+// Pinned host memory from which a batched tensor list is copied to the device. It grows to the
+// largest list it was used for.
+struct StagingBuffer
+{
+  uint8_t * data = nullptr;
+  size_t capacity = 0;
+};
+
+// Staging buffers which are not in use. A conversion takes a buffer out of the pool for the
+// duration of its copy, so that concurrent conversions do not wait for each other. There are at
+// most as many buffers as concurrent conversions, and they are never released.
+class StagingBufferPool
+{
+public:
+  StagingBuffer acquire()
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (buffers_.empty()) {
+      return StagingBuffer{};
+    }
+    StagingBuffer buffer = buffers_.back();
+    buffers_.pop_back();
+    return buffer;
+  }
+
+  void release(StagingBuffer buffer)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    buffers_.push_back(buffer);
+  }
+
+private:
+  std::mutex mutex_;
+  std::vector<StagingBuffer> buffers_;
+};
+
+StagingBufferPool & GetStagingBufferPool()
+{
+  static StagingBufferPool * pool = new StagingBufferPool();
+  return *pool;
+}
+
+// A staging buffer of at least a given size, which is returned to the pool when it goes out of
+// scope
+class ScopedStagingBuffer
+{
+public:
+  explicit ScopedStagingBuffer(size_t size)
+  : buffer_(GetStagingBufferPool().acquire())
+  {
+    if (buffer_.capacity < size) {
+      if (buffer_.data != nullptr) {
+        cudaFreeHost(buffer_.data);
+        buffer_ = StagingBuffer{};
+      }
+      void * data = nullptr;
+      CheckCudaError(
+        cudaMallocHost(&data, size),
+        "[convert_to_custom] cudaMallocHost failed for tensor list staging buffer");
+      buffer_.data = static_cast<uint8_t *>(data);
+      buffer_.capacity = size;
+    }
+  }
+
+  ~ScopedStagingBuffer()
+  {
+    if (buffer_.data != nullptr) {
+      GetStagingBufferPool().release(buffer_);
+    }
+  }
+
+  ScopedStagingBuffer(const ScopedStagingBuffer &) = delete;
+  ScopedStagingBuffer & operator=(const ScopedStagingBuffer &) = delete;
+
+  uint8_t * data() const {return buffer_.data;}
+
+private:
+  StagingBuffer buffer_;
+};
+
+// Adds the tensors of a ROS tensor list to a message entity. All tensors share a single device
+// buffer from the given allocator, which is released together with the last of them.
+void AddBatchedTensors(
+  const isaac_ros_tensor_list_interfaces::msg::TensorList & source,
+  nvidia::gxf::Entity & message,
+  nvidia::gxf::Handle<nvidia::gxf::Allocator> allocator_handle)
+{
+  constexpr size_t alignment = kBatchAlignment;
+
+  // Place the tensors in the buffer
+  const size_t count = source.tensors.size();
+  std::vector<nvidia::gxf::Shape> shapes;
+  std::vector<size_t> offsets;
+  std::vector<uint64_t> sizes;
+  shapes.reserve(count);
+  offsets.reserve(count);
+  sizes.reserve(count);
+  size_t buffer_size = 0;
+  for (const auto & ros_tensor : source.tensors) {
+    const auto type = static_cast<nvidia::gxf::PrimitiveType>(ros_tensor.data_type);
+    if (!IsSupportedType(type)) {
+      ThrowError("[convert_to_custom] Tensor data type not supported.");
+    }
+    shapes.push_back(GetShape(ros_tensor));
+    const uint64_t element_size = nvidia::gxf::PrimitiveTypeSize(type);
+    const uint64_t size = shapes.back().size() * element_size;
+    CheckDataSize(ros_tensor, size);
+    const size_t tensor_alignment = std::max<size_t>(alignment, element_size);
+    buffer_size = (buffer_size + tensor_alignment - 1) / tensor_alignment * tensor_alignment;
+    offsets.push_back(buffer_size);
+    sizes.push_back(size);
+    buffer_size += size;
+  }
+  buffer_size = (buffer_size + alignment - 1) / alignment * alignment;
+
+  // Allocate the buffer and copy all tensors into it
+  std::shared_ptr<nvidia::byte> buffer;
+  if (buffer_size > 0) {
+    auto device_data = allocator_handle->allocate(
+      buffer_size, nvidia::gxf::MemoryStorageType::kDevice);
+    if (!device_data) {
+      std::stringstream error_msg;
+      error_msg <<
+        "[convert_to_custom] Failed to allocate " << buffer_size <<
+        " bytes for tensor list: " << GxfResultStr(device_data.error());
+      ThrowError(error_msg.str());
+    }
+    buffer.reset(
+      device_data.value(), [allocator_handle](nvidia::byte * pointer) {
+        allocator_handle->free(pointer);
+      });
+
+    ScopedStagingBuffer staging(buffer_size);
+    for (size_t i = 0; i < count; i++) {
+      std::memcpy(staging.data() + offsets[i], source.tensors[i].data.data(), sizes[i]);
+    }
+    // Copies from pinned memory return once the copy is complete
+    CheckCudaError(
+      cudaMemcpy(buffer.get(), staging.data(), buffer_size, cudaMemcpyHostToDevice),
+      "[convert_to_custom] cudaMemcpy failed for copying data from "
+      "ROS Tensor List to GXF Tensors");
+  }
+
+  // Create the tensors
+  for (size_t i = 0; i < count; i++) {
+    const auto & ros_tensor = source.tensors[i];
+    const auto type = static_cast<nvidia::gxf::PrimitiveType>(ros_tensor.data_type);
+    auto gxf_tensor = message.add<nvidia::gxf::Tensor>(ros_tensor.name.c_str());
+    if (!gxf_tensor) {
+      std::stringstream error_msg;
+      error_msg <<
+        "[convert_to_custom] Failed to add a tensor component to message: " <<
+        GxfResultStr(gxf_tensor.error());
+      ThrowError(error_msg.str());
+    }
+    auto result = gxf_tensor.value()->wrapMemory(
+      shapes[i], type, nvidia::gxf::PrimitiveTypeSize(type),
+      nvidia::gxf::Unexpected{GXF_UNINITIALIZED_VALUE},
+      nvidia::gxf::MemoryStorageType::kDevice,
+      buffer.get() + offsets[i],
+      [buffer](void *) mutable {
+        buffer.reset();
+        return nvidia::gxf::Success;
+      });
+    if (!result) {
+      std::stringstream error_msg;
+      error_msg <<
+        "[convert_to_custom] Error initializing GXF tensor of type " <<
+        static_cast<int>(type) << ": " <<
+        GxfResultStr(result.error());
+      ThrowError(error_msg.str());
+    }
+  }
+}
+
+// Converts a NitrosTensorList or NitrosTensorListBatched message entity into a TensorList.
+// Tensors in device or host memory are accepted.
+void ConvertToRosMessage(
+  const nvidia::isaac_ros::nitros::NitrosTypeBase & source,
+  isaac_ros_tensor_list_interfaces::msg::TensorList & destination)
+{
   auto msg_entity = nvidia::gxf::Entity::Shared(
     nvidia::isaac_ros::nitros::GetTypeAdapterNitrosContext().getContext(), source.handle);
 
@@ -67,55 +319,49 @@ void rclcpp::TypeAdapter<
       rclcpp::get_logger("NitrosTensorList"), error_msg.str().c_str());
     throw std::runtime_error(error_msg.str().c_str());
   }
+  destination.tensors.reserve(destination.tensors.size() + gxf_tensors->size());
   for (auto gxf_tensor_handle : gxf_tensors.value()) {
     auto gxf_tensor = gxf_tensor_handle.value();
-    // Create ROS 2 Tensor and populate the message object's fields
-    auto ros_tensor = isaac_ros_tensor_list_interfaces::msg::Tensor();
+    // Create ROS 2 Tensor in place and populate the message object's fields
+    destination.tensors.emplace_back();
+    auto & ros_tensor = destination.tensors.back();
     ros_tensor.name = gxf_tensor.name();
     ros_tensor.data_type = static_cast<int32_t>(gxf_tensor->element_type());
     ros_tensor.shape.rank = gxf_tensor->shape().rank();
 
     // Moving data from GXF tensor to ROS tensor message
-    ros_tensor.data.resize(gxf_tensor->size());
-
     switch (gxf_tensor->storage_type()) {
       case nvidia::gxf::MemoryStorageType::kHost:
+      case nvidia::gxf::MemoryStorageType::kSystem:
         {
-          std::memcpy(ros_tensor.data.data(), gxf_tensor->pointer(), gxf_tensor->size());
+          ros_tensor.data.assign(
+            gxf_tensor->pointer(), gxf_tensor->pointer() + gxf_tensor->size());
         }
         break;
       case nvidia::gxf::MemoryStorageType::kDevice:
         {
-          cudaError_t cuda_error = cudaMemcpy(
-            ros_tensor.data.data(), gxf_tensor->pointer(),
-            gxf_tensor->size(), cudaMemcpyDeviceToHost);
-          if (cuda_error != cudaSuccess) {
-            std::stringstream error_msg;
-            error_msg <<
-              "[convert_to_ros_message] cudaMemcpy failed for conversion from "
-              "gxf::Tensor to ROS Tensor: " <<
-              cudaGetErrorName(cuda_error) <<
-              " (" << cudaGetErrorString(cuda_error) << ")";
-            RCLCPP_ERROR(
-              rclcpp::get_logger("NitrosTensorList"), error_msg.str().c_str());
-            throw std::runtime_error(error_msg.str().c_str());
-          }
+          ros_tensor.data.resize(gxf_tensor->size());
+          CheckCudaError(
+            cudaMemcpy(
+              ros_tensor.data.data(), gxf_tensor->pointer(),
+              gxf_tensor->size(), cudaMemcpyDeviceToHost),
+            "[convert_to_ros_message] cudaMemcpy failed for conversion from "
+            "gxf::Tensor to ROS Tensor");
         }
         break;
       default:
-        std::string error_msg =
+        ThrowError(
           "[convert_to_ros_message] MemoryStorageType not supported: conversion from "
-          "gxf::Tensor to ROS Tensor failed!";
-        RCLCPP_ERROR(
-          rclcpp::get_logger("NitrosTensorList"), error_msg.c_str());
-        throw std::runtime_error(error_msg.c_str());
+          "gxf::Tensor to ROS Tensor failed!");
     }
 
-    for (size_t i = 0; i < gxf_tensor->shape().rank(); i++) {
+    const uint32_t rank = gxf_tensor->shape().rank();
+    ros_tensor.shape.dims.reserve(rank);
+    ros_tensor.strides.reserve(rank);
+    for (size_t i = 0; i < rank; i++) {
       ros_tensor.shape.dims.push_back(gxf_tensor->shape().dimension(i));
       ros_tensor.strides.push_back(gxf_tensor->stride(i));
     }
-    destination.tensors.push_back(ros_tensor);
   }
 
   // Populate timestamp information back into ROS header
@@ -132,27 +378,15 @@ void rclcpp::TypeAdapter<
 
   // Set frame ID
   destination.header.frame_id = source.frame_id;
-
-  RCLCPP_DEBUG(
-    rclcpp::get_logger("NitrosTensorList"),
-    "[convert_to_ros_message] Conversion completed");
-
-  nvidia::isaac_ros::nitros::nvtxRangePopWrapper();
 }
 
-void rclcpp::TypeAdapter<
-  nvidia::isaac_ros::nitros::NitrosTensorList,
-  isaac_ros_tensor_list_interfaces::msg::TensorList>::convert_to_custom(
-  const ros_message_type & source, custom_type & destination)
+// Converts a TensorList into a new message entity, with one device allocation per tensor or, if
+// batched is set, a single device buffer shared by all tensors
+void ConvertToCustom(
+  const isaac_ros_tensor_list_interfaces::msg::TensorList & source,
+  nvidia::isaac_ros::nitros::NitrosTypeBase & destination,
+  bool batched)
 {
-  nvidia::isaac_ros::nitros::nvtxRangePushWrapper(
-    "NitrosTensorList::convert_to_custom",
-    nvidia::isaac_ros::nitros::CLR_PURPLE);
-
-  RCLCPP_DEBUG(
-    rclcpp::get_logger("NitrosTensorList"),
-    "[convert_to_custom] Conversion started");
-
   // Get pointer to allocator component
   gxf_uid_t cid;
   nvidia::isaac_ros::nitros::GetTypeAdapterNitrosContext().getCid(
@@ -183,98 +417,102 @@ void rclcpp::TypeAdapter<
       rclcpp::get_logger("NitrosTensorList"), error_msg.str().c_str());
     throw std::runtime_error(error_msg.str().c_str());
   }
-  for (size_t i = 0; i < source.tensors.size(); i++) {
-    auto ros_tensor = source.tensors[i];
-    auto gxf_tensor = message->add<nvidia::gxf::Tensor>(ros_tensor.name.c_str());
-    std::array<int32_t, nvidia::gxf::Shape::kMaxRank> dims;
-    std::copy(
-      std::begin(ros_tensor.shape.dims), std::end(ros_tensor.shape.dims),
-      std::begin(dims));
-
-    nvidia::gxf::Expected<void> result;
-    nvidia::gxf::MemoryStorageType storage_type = nvidia::gxf::MemoryStorageType::kDevice;
-    // Initializing GXF tensor
-    nvidia::gxf::PrimitiveType type =
-      static_cast<nvidia::gxf::PrimitiveType>(ros_tensor.data_type);
-    RCLCPP_DEBUG(
-      rclcpp::get_logger("NitrosTensorList"),
-      "[convert_to_custom] dims[0]=%d, rank=%d, storage_type=%d",
-      dims[0], ros_tensor.shape.rank, (int)storage_type);
-    switch (type) {
-      case nvidia::gxf::PrimitiveType::kUnsigned8:
-        result = gxf_tensor.value()->reshape<uint8_t>(
-          nvidia::gxf::Shape(dims, ros_tensor.shape.rank), storage_type, allocator_handle);
-        break;
-      case nvidia::gxf::PrimitiveType::kInt8:
-        result = gxf_tensor.value()->reshape<int8_t>(
-          nvidia::gxf::Shape(dims, ros_tensor.shape.rank), storage_type, allocator_handle);
-        break;
-      case nvidia::gxf::PrimitiveType::kUnsigned16:
-        result = gxf_tensor.value()->reshape<uint16_t>(
-          nvidia::gxf::Shape(dims, ros_tensor.shape.rank), storage_type, allocator_handle);
-        break;
-      case nvidia::gxf::PrimitiveType::kInt16:
-        result = gxf_tensor.value()->reshape<int16_t>(
-          nvidia::gxf::Shape(dims, ros_tensor.shape.rank), storage_type, allocator_handle);
-        break;
-      case nvidia::gxf::PrimitiveType::kUnsigned32:
-        result = gxf_tensor.value()->reshape<uint32_t>(
-          nvidia::gxf::Shape(dims, ros_tensor.shape.rank), storage_type, allocator_handle);
-        break;
-      case nvidia::gxf::PrimitiveType::kInt32:
-        result = gxf_tensor.value()->reshape<int32_t>(
-          nvidia::gxf::Shape(dims, ros_tensor.shape.rank), storage_type, allocator_handle);
-        break;
-      case nvidia::gxf::PrimitiveType::kUnsigned64:
-        result = gxf_tensor.value()->reshape<uint64_t>(
-          nvidia::gxf::Shape(dims, ros_tensor.shape.rank), storage_type, allocator_handle);
-        break;
-      case nvidia::gxf::PrimitiveType::kInt64:
-        result = gxf_tensor.value()->reshape<int32_t>(
-          nvidia::gxf::Shape(dims, ros_tensor.shape.rank), storage_type, allocator_handle);
-        break;
-      case nvidia::gxf::PrimitiveType::kFloat32:
-        result = gxf_tensor.value()->reshape<float>(
-          nvidia::gxf::Shape(dims, ros_tensor.shape.rank), storage_type, allocator_handle);
-        break;
-      case nvidia::gxf::PrimitiveType::kFloat64:
-        result = gxf_tensor.value()->reshape<double>(
-          nvidia::gxf::Shape(dims, ros_tensor.shape.rank), storage_type, allocator_handle);
-        break;
-      default:
-        std::string error_msg = "[convert_to_custom] Tensor data type not supported.";
+
+  if (batched) {
+    AddBatchedTensors(source, message.value(), allocator_handle);
+  } else {
+    for (size_t i = 0; i < source.tensors.size(); i++) {
+      const auto & ros_tensor = source.tensors[i];
+      auto gxf_tensor = message->add<nvidia::gxf::Tensor>(ros_tensor.name.c_str());
+      const nvidia::gxf::Shape shape = GetShape(ros_tensor);
+
+      nvidia::gxf::Expected<void> result;
+      nvidia::gxf::MemoryStorageType storage_type = nvidia::gxf::MemoryStorageType::kDevice;
+      // Initializing GXF tensor
+      nvidia::gxf::PrimitiveType type =
+        static_cast<nvidia::gxf::PrimitiveType>(ros_tensor.data_type);
+      RCLCPP_DEBUG(
+        rclcpp::get_logger("NitrosTensorList"),
+        "[convert_to_custom] dims[0]=%d, rank=%d, storage_type=%d",
+        shape.dimension(0), ros_tensor.shape.rank, (int)storage_type);
+      switch (type) {
+        case nvidia::gxf::PrimitiveType::kUnsigned8:
+          result = gxf_tensor.value()->reshape<uint8_t>(
+            shape, storage_type, allocator_handle);
+          break;
+        case nvidia::gxf::PrimitiveType::kInt8:
+          result = gxf_tensor.value()->reshape<int8_t>(
+            shape, storage_type, allocator_handle);
+          break;
+        case nvidia::gxf::PrimitiveType::kUnsigned16:
+          result = gxf_tensor.value()->reshape<uint16_t>(
+            shape, storage_type, allocator_handle);
+          break;
+        case nvidia::gxf::PrimitiveType::kInt16:
+          result = gxf_tensor.value()->reshape<int16_t>(
+            shape, storage_type, allocator_handle);
+          break;
+        case nvidia::gxf::PrimitiveType::kUnsigned32:
+          result = gxf_tensor.value()->reshape<uint32_t>(
+            shape, storage_type, allocator_handle);
+          break;
+        case nvidia::gxf::PrimitiveType::kInt32:
+          result = gxf_tensor.value()->reshape<int32_t>(
+            shape, storage_type, allocator_handle);
+          break;
+        case nvidia::gxf::PrimitiveType::kUnsigned64:
+          result = gxf_tensor.value()->reshape<uint64_t>(
+            shape, storage_type, allocator_handle);
+          break;
+        case nvidia::gxf::PrimitiveType::kInt64:
+          result = gxf_tensor.value()->reshape<int64_t>(
+            shape, storage_type, allocator_handle);
+          break;
+        case nvidia::gxf::PrimitiveType::kFloat32:
+          result = gxf_tensor.value()->reshape<float>(
+            shape, storage_type, allocator_handle);
+          break;
+        case nvidia::gxf::PrimitiveType::kFloat64:
+          result = gxf_tensor.value()->reshape<double>(
+            shape, storage_type, allocator_handle);
+          break;
+        default:
+          std::string error_msg = "[convert_to_custom] Tensor data type not supported.";
+          RCLCPP_ERROR(
+            rclcpp::get_logger("NitrosTensorList"), error_msg.c_str());
+          throw std::runtime_error(error_msg.c_str());
+      }
+      if (!result) {
+        std::stringstream error_msg;
+        error_msg <<
+          "[convert_to_custom] Error initializing GXF tensor of type " <<
+          static_cast<int>(type) << ": " <<
+          GxfResultStr(result.error());
         RCLCPP_ERROR(
-          rclcpp::get_logger("NitrosTensorList"), error_msg.c_str());
-        throw std::runtime_error(error_msg.c_str());
-    }
-    if (!result) {
-      std::stringstream error_msg;
-      error_msg <<
-        "[convert_to_custom] Error initializing GXF tensor of type " <<
-        static_cast<int>(type) << ": " <<
-        GxfResultStr(result.error());
-      RCLCPP_ERROR(
-        rclcpp::get_logger("NitrosTensorList"), error_msg.str().c_str());
-      throw std::runtime_error(error_msg.str().c_str());
-    }
+          rclcpp::get_logger("NitrosTensorList"), error_msg.str().c_str());
+        throw std::runtime_error(error_msg.str().c_str());
+      }
 
-    const cudaMemcpyKind operation = cudaMemcpyHostToDevice;
-    const cudaError_t cuda_error = cudaMemcpy(
-      gxf_tensor.value()->pointer(),
-      ros_tensor.data.data(),
-      gxf_tensor.value()->size(),
-      operation);
+      CheckDataSize(ros_tensor, gxf_tensor.value()->size());
 
-    if (cuda_error != cudaSuccess) {
-      std::stringstream error_msg;
-      error_msg <<
-        "[convert_to_custom] cudaMemcpy failed for copying data from "
-        "ROS Tensor to GXF Tensor: " <<
-        cudaGetErrorName(cuda_error) <<
-        " (" << cudaGetErrorString(cuda_error) << ")";
-      RCLCPP_ERROR(
-        rclcpp::get_logger("NitrosTensorList"), error_msg.str().c_str());
-      throw std::runtime_error(error_msg.str().c_str());
+      const cudaMemcpyKind operation = cudaMemcpyHostToDevice;
+      const cudaError_t cuda_error = cudaMemcpy(
+        gxf_tensor.value()->pointer(),
+        ros_tensor.data.data(),
+        gxf_tensor.value()->size(),
+        operation);
+
+      if (cuda_error != cudaSuccess) {
+        std::stringstream error_msg;
+        error_msg <<
+          "[convert_to_custom] cudaMemcpy failed for copying data from "
+          "ROS Tensor to GXF Tensor: " <<
+          cudaGetErrorName(cuda_error) <<
+          " (" << cudaGetErrorString(cuda_error) << ")";
+        RCLCPP_ERROR(
+          rclcpp::get_logger("NitrosTensorList"), error_msg.str().c_str());
+        throw std::runtime_error(error_msg.str().c_str());
+      }
     }
   }
 
@@ -300,6 +538,47 @@ void rclcpp::TypeAdapter<
   destination.handle = message->eid();
   GxfEntityRefCountInc(
     nvidia::isaac_ros::nitros::GetTypeAdapterNitrosContext().getContext(), message->eid());
+}
+
+}  // namespace
+
+void rclcpp::TypeAdapter<
+  nvidia::isaac_ros::nitros::NitrosTensorList,
+  isaac_ros_tensor_list_interfaces::msg::TensorList>::convert_to_ros_message(
+  const custom_type & source,
+  ros_message_type & destination)
+{
+  nvidia::isaac_ros::nitros::nvtxRangePushWrapper(
+    "NitrosTensorList::convert_to_ros_message",
+    nvidia::isaac_ros::nitros::CLR_PURPLE);
+
+  RCLCPP_DEBUG(
+    rclcpp::get_logger("NitrosTensorList"),
+    "[convert_to_ros_message] Conversion started for handle = %ld", source.handle);
+
+  ConvertToRosMessage(source, destination);
+
+  RCLCPP_DEBUG(
+    rclcpp::get_logger("NitrosTensorList"),
+    "[convert_to_ros_message] Conversion completed");
+
+  nvidia::isaac_ros::nitros::nvtxRangePopWrapper();
+}
+
+void rclcpp::TypeAdapter<
+  nvidia::isaac_ros::nitros::NitrosTensorList,
+  isaac_ros_tensor_list_interfaces::msg::TensorList>::convert_to_custom(
+  const ros_message_type & source, custom_type & destination)
+{
+  nvidia::isaac_ros::nitros::nvtxRangePushWrapper(
+    "NitrosTensorList::convert_to_custom",
+    nvidia::isaac_ros::nitros::CLR_PURPLE);
+
+  RCLCPP_DEBUG(
+    rclcpp::get_logger("NitrosTensorList"),
+    "[convert_to_custom] Conversion started");
+
+  ConvertToCustom(source, destination, false);
 
   RCLCPP_DEBUG(
     rclcpp::get_logger("NitrosTensorList"),
@@ -307,3 +586,48 @@ void rclcpp::TypeAdapter<
 
   nvidia::isaac_ros::nitros::nvtxRangePopWrapper();
 }
+
+void rclcpp::TypeAdapter<
+  nvidia::isaac_ros::nitros::NitrosTensorListBatched,
+  isaac_ros_tensor_list_interfaces::msg::TensorList>::convert_to_ros_message(
+  const custom_type & source,
+  ros_message_type & destination)
+{
+  nvidia::isaac_ros::nitros::nvtxRangePushWrapper(
+    "NitrosTensorListBatched::convert_to_ros_message",
+    nvidia::isaac_ros::nitros::CLR_PURPLE);
+
+  RCLCPP_DEBUG(
+    rclcpp::get_logger("NitrosTensorListBatched"),
+    "[convert_to_ros_message] Conversion started for handle = %ld", source.handle);
+
+  ConvertToRosMessage(source, destination);
+
+  RCLCPP_DEBUG(
+    rclcpp::get_logger("NitrosTensorListBatched"),
+    "[convert_to_ros_message] Conversion completed");
+
+  nvidia::isaac_ros::nitros::nvtxRangePopWrapper();
+}
+
+void rclcpp::TypeAdapter<
+  nvidia::isaac_ros::nitros::NitrosTensorListBatched,
+  isaac_ros_tensor_list_interfaces::msg::TensorList>::convert_to_custom(
+  const ros_message_type & source, custom_type & destination)
+{
+  nvidia::isaac_ros::nitros::nvtxRangePushWrapper(
+    "NitrosTensorListBatched::convert_to_custom",
+    nvidia::isaac_ros::nitros::CLR_PURPLE);
+
+  RCLCPP_DEBUG(
+    rclcpp::get_logger("NitrosTensorListBatched"),
+    "[convert_to_custom] Conversion started");
+
+  ConvertToCustom(source, destination, true);
+
+  RCLCPP_DEBUG(
+    rclcpp::get_logger("NitrosTensorListBatched"),
+    "[convert_to_custom] Conversion completed");
+
+  nvidia::isaac_ros::nitros::nvtxRangePopWrapper();
+}
@@ -0,0 +1,157 @@
+# SPDX-FileCopyrightText: NVIDIA CORPORATION & AFFILIATES
+# Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+# SPDX-License-Identifier: Apache-2.0
+
+import time
+
+from isaac_ros_tensor_list_interfaces.msg import Tensor, TensorList, TensorShape
+from isaac_ros_test import IsaacROSBaseTest
+
+import launch
+from launch_ros.actions import ComposableNodeContainer
+from launch_ros.descriptions import ComposableNode
+import launch_testing
+import numpy as np
+import pytest
+import rclpy
+
+# Tensors of the test tensor list: name, GXF primitive type, element size and dimensions. The
+# sizes are not multiples of the batch alignment, so that every tensor but the first one starts
+# at a padded offset in the shared buffer.
+TEST_TENSORS = [
+    ('input', 9, 4, [1, 3, 100, 100]),
+    ('mask', 2, 1, [1, 17, 59]),
+    ('ids', 7, 8, [3, 5]),
+    ('scores', 10, 8, [7]),
+]
+
+
+@pytest.mark.rostest
+def generate_test_description():
+    """Generate launch description with NitrosNode test node."""
+    test_ns = IsaacROSNitrosTensorListBatchedTest.generate_namespace()
+    container = ComposableNodeContainer(
+        name='image_container',
+        namespace='isaac_ros_nitros_container',
+        package='rclcpp_components',
+        executable='component_container_mt',
+        composable_node_descriptions=[
+            ComposableNode(
+                package='isaac_ros_nitros_tensor_list_type',
+                plugin='nvidia::isaac_ros::nitros::NitrosTensorListForwardNode',
+                name='NitrosTensorListForwardNode',
+                namespace=test_ns,
+                parameters=[{
+                    'compatible_format': 'nitros_tensor_list_batched'
+                }]
+            ),
+        ],
+        output='both',
+        arguments=['--ros-args', '--log-level', 'info'],
+    )
+
+    return IsaacROSNitrosTensorListBatchedTest.generate_test_description([
+        container,
+        launch.actions.TimerAction(
+            period=2.5, actions=[launch_testing.actions.ReadyToTest()])
+    ])
+
+
+class IsaacROSNitrosTensorListBatchedTest(IsaacROSBaseTest):
+    """
+    Proof-of-Life Test for the NitrosTensorListBatched type adapter.
+
+    1. Sets up ROS publisher to send a TensorList with tensors of several types and sizes
+    2. Sets up ROS subscriber to listen to output channel of NitrosNode
+    3. Verify that every tensor is received unchanged from the shared buffer
+    """
+
+    def test_forward_node(self) -> None:
+        self.node._logger.info('Starting Isaac ROS NitrosNode batched POL Test')
+
+        # Subscriber
+        received_messages = {}
+
+        subscriber_topic_namespace = self.generate_namespace('topic_forward_output')
+        test_subscribers = [
+            (subscriber_topic_namespace, TensorList)
+        ]
+
+        subs = self.create_logging_subscribers(
+            subscription_requests=test_subscribers,
+            received_messages=received_messages,
+            use_namespace_lookup=False,
+            accept_multiple_messages=True,
+            add_received_message_timestamps=True
+        )
+
+        # Publisher
+        publisher_topic_namespace = self.generate_namespace('topic_forward_input')
+        pub = self.node.create_publisher(
+            TensorList,
+            publisher_topic_namespace,
+            self.DEFAULT_QOS)
+
+        try:
+            # Construct test tensor list
+            tensor_list = TensorList()
+            for name, data_type, element_size, dims in TEST_TENSORS:
+                tensor = Tensor()
+                tensor_shape = TensorShape()
+                tensor_shape.rank = len(dims)
+                tensor_shape.dims = dims
+                tensor.shape = tensor_shape
+                tensor.name = name
+                tensor.data_type = data_type
+                tensor.strides = []
+                data_length = element_size * int(np.prod(dims))
+                tensor.data = np.random.randint(256, size=data_length).tolist()
+                tensor_list.tensors.append(tensor)
+
+            timestamp = self.node.get_clock().now().to_msg()
+            tensor_list.header.stamp = timestamp
+
+            # Start sending messages
+            self.node.get_logger().info('Start publishing messages')
+            end_time = time.time() + 2.0
+            while time.time() < end_time:
+                pub.publish(tensor_list)
+                rclpy.spin_once(self.node, timeout_sec=0.2)
+
+            self.assertGreater(len(received_messages[subscriber_topic_namespace]), 0)
+            received_tensor_list = received_messages[subscriber_topic_namespace][-1][0]
+            self.assertEqual(str(timestamp), str(received_tensor_list.header.stamp),
+                             'Timestamps do not match.')
+
+            received_tensors = {
+                tensor.name: tensor for tensor in received_tensor_list.tensors}
+            self.assertEqual(len(tensor_list.tensors), len(received_tensors),
+                             'Number of tensors does not match')
+            for tensor in tensor_list.tensors:
+                self.assertIn(tensor.name, received_tensors)
+                received_tensor = received_tensors[tensor.name]
+                self.assertEqual(tensor.data_type, received_tensor.data_type,
+                                 f'Data type of tensor {tensor.name} does not match')
+                self.assertEqual(list(tensor.shape.dims), list(received_tensor.shape.dims),
+                                 f'Shape of tensor {tensor.name} does not match')
+                self.assertEqual(bytes(tensor.data), bytes(received_tensor.data),
+                                 f'Data of tensor {tensor.name} does not match')
+
+            self.node._logger.info('Source and received tensor lists are matched.')
+
+        finally:
+            [self.node.destroy_subscription(sub) for sub in subs]
+            self.assertTrue(self.node.destroy_publisher(pub))
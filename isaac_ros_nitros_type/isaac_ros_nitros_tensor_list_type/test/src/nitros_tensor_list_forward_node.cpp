@@ -16,6 +16,7 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include "isaac_ros_nitros_tensor_list_type/nitros_tensor_list.hpp"
+#include "isaac_ros_nitros_tensor_list_type/nitros_tensor_list_batched.hpp"
 #include "isaac_ros_nitros/nitros_node.hpp"
 
 #include "rclcpp_components/register_node_macro.hpp"
@@ -79,6 +80,7 @@ public:
     }
 
     registerSupportedType<nvidia::isaac_ros::nitros::NitrosTensorList>();
+    registerSupportedType<nvidia::isaac_ros::nitros::NitrosTensorListBatched>();
 
     startNitrosNode();
   }